@@ -57,6 +57,7 @@ void ComponentContextImpl::InitializeServicesCache()
     throw ComponentException("Context is invalid");
   }
   
+  auto cacheHandle = boundServicesCache.lock();
   const auto refManagers = configManagerPtr->GetAllDependencyManagers();
   for(const auto& refManager : refManagers) {
     const auto& sRefs = refManager->GetBoundReferences();
@@ -67,24 +68,75 @@ void ComponentContextImpl::InitializeServicesCache()
                   , [&](const cppmicroservices::ServiceReferenceBase& sRef) {
                       if(sRef)
                       {
-                        ServiceReferenceU sRefU(sRef);
-                        auto bc = GetBundleContext();
-                        auto& serviceMap = boundServicesCache[refName];
-                        if(refScope == cppmicroservices::Constants::SCOPE_BUNDLE)
-                        {
-                          serviceMap.push_back(bc.GetService(sRefU));
-                        }
-                        else
-                        {
-                          auto registeredScope = sRef.GetProperty(cppmicroservices::Constants::SERVICE_SCOPE).ToStringNoExcept();
-                          cppmicroservices::ServiceObjects<void> sObjs = bc.GetServiceObjects(sRefU);
-                          serviceMap.push_back(sObjs.GetService());
-                        }
+                        auto& serviceMap = (*cacheHandle)[refName];
+                        serviceMap.emplace_back(sRef, GetBoundService(refScope, sRef));
                       }
                     });
   }
 }
 
+cppmicroservices::InterfaceMapConstPtr ComponentContextImpl::GetBoundService(const std::string& refScope,
+                                                                             const cppmicroservices::ServiceReferenceBase& sRef) const
+{
+  ServiceReferenceU sRefU(sRef);
+  auto bc = GetBundleContext();
+  if(refScope == cppmicroservices::Constants::SCOPE_BUNDLE)
+  {
+    return bc.GetService(sRefU);
+  }
+  cppmicroservices::ServiceObjects<void> sObjs = bc.GetServiceObjects(sRefU);
+  return sObjs.GetService();
+}
+
+cppmicroservices::InterfaceMapConstPtr ComponentContextImpl::AddToBoundServicesCache(const std::string& refName,
+                                                                                     const cppmicroservices::ServiceReferenceBase& sRef)
+{
+  const auto configManagerPtr = configManager.lock();
+  const auto refManager = configManagerPtr ? configManagerPtr->GetDependencyManager(refName) : nullptr;
+  if(!refManager || !sRef) {
+    return nullptr;
+  }
+  auto cacheHandle = boundServicesCache.lock();
+  auto& serviceMap = (*cacheHandle)[refName];
+  auto itr = std::find_if(serviceMap.begin()
+                          , serviceMap.end()
+                          , [&sRef](const BoundServices::value_type& bound) {
+                              return !(sRef < bound.first);
+                            });
+  if(itr != serviceMap.end() && itr->first == sRef) {
+    return nullptr;
+  }
+  auto service = GetBoundService(refManager->GetReferenceScope(), sRef);
+  if(service) {
+    serviceMap.emplace(itr, sRef, service);
+  }
+  return service;
+}
+
+cppmicroservices::InterfaceMapConstPtr ComponentContextImpl::RemoveFromBoundServicesCache(const std::string& refName,
+                                                                                          const cppmicroservices::ServiceReferenceBase& sRef)
+{
+  // the service object is released by the caller, outside of the lock,
+  // releasing it may call into the service's factory
+  cppmicroservices::InterfaceMapConstPtr service;
+  auto cacheHandle = boundServicesCache.lock();
+  auto serviceMapItr = cacheHandle->find(refName);
+  if(serviceMapItr == cacheHandle->end()) {
+    return service;
+  }
+  auto& serviceMap = serviceMapItr->second;
+  auto itr = std::find_if(serviceMap.begin()
+                          , serviceMap.end()
+                          , [&sRef](const BoundServices::value_type& bound) {
+                              return bound.first == sRef;
+                            });
+  if(itr != serviceMap.end()) {
+    service = std::move(itr->second);
+    serviceMap.erase(itr);
+  }
+  return service;
+}
+
 std::unordered_map<std::string, cppmicroservices::Any> ComponentContextImpl::GetProperties() const
 {
   const auto configManagerPtr = configManager.lock();
@@ -101,11 +153,12 @@ std::shared_ptr<void> ComponentContextImpl::LocateService(const std::string& nam
     throw ComponentException("Context is invalid");
   }
   std::shared_ptr<void> service;
-  auto serviceMapItr = boundServicesCache.find(name);
-  if(serviceMapItr != boundServicesCache.end()) {
+  auto cacheHandle = boundServicesCache.lock();
+  auto serviceMapItr = cacheHandle->find(name);
+  if(serviceMapItr != cacheHandle->end()) {
     auto& serviceMaps = serviceMapItr->second;
     if(!serviceMaps.empty()) {
-      service = ExtractInterface(serviceMaps.at(0), type);
+      service = ExtractInterface(serviceMaps.at(0).second, type);
     }
   }
   return service;
@@ -118,13 +171,14 @@ std::vector<std::shared_ptr<void>> ComponentContextImpl::LocateServices(const st
     throw ComponentException("Context is invalid");
   }
   std::vector<std::shared_ptr<void>> services;
-  auto serviceMapItr = boundServicesCache.find(name);
-  if(serviceMapItr != boundServicesCache.end()) {
+  auto cacheHandle = boundServicesCache.lock();
+  auto serviceMapItr = cacheHandle->find(name);
+  if(serviceMapItr != cacheHandle->end()) {
     auto& serviceMaps = serviceMapItr->second;
     std::for_each(serviceMaps.begin()
                   , serviceMaps.end()
-                  , [&services, &type](const InterfaceMapConstPtr& iMap) {
-                      services.push_back(ExtractInterface(iMap, type));
+                  , [&services, &type](const BoundServices::value_type& bound) {
+                      services.push_back(ExtractInterface(bound.second, type));
                     });
   }
   return services;
@@ -197,7 +251,7 @@ ServiceReferenceBase ComponentContextImpl::GetServiceReference() const
 void ComponentContextImpl::Invalidate()
 {
   configManager = std::weak_ptr<ComponentConfiguration>();
-  boundServicesCache.clear();
+  boundServicesCache.lock()->clear();
 }
 
 }} 
@@ -26,6 +26,8 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -37,6 +39,7 @@
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/servicecomponent/ComponentContext.hpp"
 #include "manager/ComponentConfiguration.hpp"
+#include "manager/ConcurrencyUtil.hpp"
 
 namespace cppmicroservices {
 namespace scrimpl {
@@ -196,7 +199,31 @@ public:
    */
   void Invalidate();
 
+  /**
+   * Adds the service referenced by \c sRef to the services bound to the
+   * reference \c refName. Used when a reference with dynamic policy binds a
+   * new service while the component instance is active.
+   *
+   * \return the added service object, the same object is later returned by
+   *         {@link #LocateService}. nullptr if the service was already bound
+   *         or could not be retrieved.
+   */
+  cppmicroservices::InterfaceMapConstPtr AddToBoundServicesCache(const std::string& refName,
+                                                                 const cppmicroservices::ServiceReferenceBase& sRef);
+
+  /**
+   * Removes the service referenced by \c sRef from the services bound to the
+   * reference \c refName. Used when a reference with dynamic policy unbinds a
+   * service while the component instance is active.
+   *
+   * \return the removed service object, nullptr if the service was not bound.
+   */
+  cppmicroservices::InterfaceMapConstPtr RemoveFromBoundServicesCache(const std::string& refName,
+                                                                      const cppmicroservices::ServiceReferenceBase& sRef);
+
 private:
+  using BoundServices = std::vector<std::pair<cppmicroservices::ServiceReferenceBase, cppmicroservices::InterfaceMapConstPtr>>;
+
   /**
    * Returns the Id of the bundle containing the component
    *
@@ -206,9 +233,16 @@ private:
 
   void InitializeServicesCache();
 
+  /**
+   * Returns the service object for \c sRef, retrieved according to the
+   * reference scope \c refScope.
+   */
+  cppmicroservices::InterfaceMapConstPtr GetBoundService(const std::string& refScope,
+                                                          const cppmicroservices::ServiceReferenceBase& sRef) const;
+
   std::weak_ptr<ComponentConfiguration> configManager;
   cppmicroservices::Bundle usingBundle;
-  std::unordered_map<std::string, std::vector<cppmicroservices::InterfaceMapConstPtr>> boundServicesCache;
+  mutable Guarded<std::unordered_map<std::string, BoundServices>> boundServicesCache; ///< bound services of each reference, best ranked first
 };
 }
 }
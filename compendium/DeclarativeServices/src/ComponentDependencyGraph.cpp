@@ -0,0 +1,284 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include "ComponentDependencyGraph.hpp"
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+ComponentDependencyGraph::ComponentDependencyGraph(std::vector<ComponentMetadataPtr> comps)
+  : components(std::move(comps))
+  , refProviders(components.size())
+  , batchIndices(components.size(), 0)
+  , resolved(components.size(), false)
+{
+  std::unordered_map<std::string, std::vector<std::size_t>> providersByInterface;
+  for (std::size_t i = 0; i < components.size(); ++i)
+  {
+    for (auto const& interfaceName : components[i]->serviceMetadata.interfaces)
+    {
+      providersByInterface[interfaceName].push_back(i);
+    }
+  }
+
+  for (std::size_t i = 0; i < components.size(); ++i)
+  {
+    for (auto const& refMetadata : components[i]->refsMetadata)
+    {
+      if (refMetadata.minCardinality == 0)
+      {
+        continue;
+      }
+      auto providers = providersByInterface.find(refMetadata.interfaceName);
+      // references to services registered outside of this graph can not be planned for
+      if (providers != providersByInterface.end())
+      {
+        refProviders[i].push_back(providers->second);
+      }
+    }
+  }
+  ComputeBatches();
+}
+
+void ComponentDependencyGraph::ComputeBatches()
+{
+  // Kahn's algorithm. The in-degree of a component is the number of its
+  // references without a placed provider. A reference is satisfied by the
+  // first of its providers to be placed. Components are placed batch by
+  // batch, so that provider is from the earliest possible batch.
+  std::vector<std::size_t> inDegree(components.size());
+  std::vector<std::vector<bool>> refSatisfied(components.size());
+  // for every provider, the consuming components and the indices of their references
+  std::vector<std::vector<std::pair<std::size_t, std::size_t>>> consumers(components.size());
+  std::vector<std::size_t> current;
+  for (std::size_t i = 0; i < components.size(); ++i)
+  {
+    inDegree[i] = refProviders[i].size();
+    refSatisfied[i].assign(refProviders[i].size(), false);
+    for (std::size_t r = 0; r < refProviders[i].size(); ++r)
+    {
+      for (auto p : refProviders[i][r])
+      {
+        consumers[p].emplace_back(i, r);
+      }
+    }
+    if (inDegree[i] == 0)
+    {
+      current.push_back(i);
+    }
+  }
+
+  std::size_t batch = 0;
+  while (!current.empty())
+  {
+    std::vector<std::size_t> next;
+    for (auto p : current)
+    {
+      resolved[p] = true;
+      batchIndices[p] = batch;
+      for (auto const& consumer : consumers[p])
+      {
+        if (!refSatisfied[consumer.first][consumer.second])
+        {
+          refSatisfied[consumer.first][consumer.second] = true;
+          if (--inDegree[consumer.first] == 0)
+          {
+            next.push_back(consumer.first);
+          }
+        }
+      }
+    }
+    current.swap(next);
+    ++batch;
+  }
+
+  for (std::size_t i = 0; i < components.size(); ++i)
+  {
+    if (!resolved[i])
+    {
+      batchIndices[i] = batch;
+    }
+  }
+}
+
+std::vector<std::vector<ComponentDependencyGraph::ComponentMetadataPtr>> ComponentDependencyGraph::GetEnableBatches() const
+{
+  std::vector<std::vector<ComponentMetadataPtr>> batches;
+  for (std::size_t i = 0; i < components.size(); ++i)
+  {
+    if (batches.size() <= batchIndices[i])
+    {
+      batches.resize(batchIndices[i] + 1);
+    }
+    batches[batchIndices[i]].push_back(components[i]);
+  }
+  return batches;
+}
+
+std::vector<std::vector<std::string>> ComponentDependencyGraph::GetCycles() const
+{
+  // Tarjan's strongly connected components algorithm, restricted to the
+  // components which could not be placed in a batch.
+  const std::size_t unvisited = components.size();
+  std::vector<std::size_t> index(components.size(), unvisited);
+  std::vector<std::size_t> lowLink(components.size(), 0);
+  std::vector<bool> onStack(components.size(), false);
+  std::vector<std::size_t> stack;
+  std::size_t nextIndex = 0;
+  std::vector<std::vector<std::string>> cycles;
+
+  std::function<void(std::size_t)> connect = [&](std::size_t v) {
+    index[v] = lowLink[v] = nextIndex++;
+    stack.push_back(v);
+    onStack[v] = true;
+    bool selfLoop = false;
+    for (auto const& providers : refProviders[v])
+    {
+      for (auto w : providers)
+      {
+        if (resolved[w])
+        {
+          continue;
+        }
+        selfLoop = selfLoop || (w == v);
+        if (index[w] == unvisited)
+        {
+          connect(w);
+          lowLink[v] = std::min(lowLink[v], lowLink[w]);
+        }
+        else if (onStack[w])
+        {
+          lowLink[v] = std::min(lowLink[v], index[w]);
+        }
+      }
+    }
+    if (lowLink[v] == index[v])
+    {
+      std::vector<std::string> names;
+      std::size_t w;
+      do
+      {
+        w = stack.back();
+        stack.pop_back();
+        onStack[w] = false;
+        names.push_back(components[w]->name);
+      } while (w != v);
+      if (names.size() > 1 || selfLoop)
+      {
+        std::reverse(names.begin(), names.end());
+        cycles.push_back(std::move(names));
+      }
+    }
+  };
+
+  for (std::size_t v = 0; v < components.size(); ++v)
+  {
+    if (!resolved[v] && index[v] == unvisited)
+    {
+      connect(v);
+    }
+  }
+  return cycles;
+}
+
+std::vector<std::vector<std::size_t>> ComponentDependencyGraph::GetOwnerGroups(const std::vector<std::size_t>& owners,
+                                                                              std::size_t ownerCount) const
+{
+  // an edge from the owner of a provider to the owner of its consumer
+  std::vector<std::vector<std::size_t>> consumerOwners(ownerCount);
+  for (std::size_t i = 0; i < components.size(); ++i)
+  {
+    for (auto const& providers : refProviders[i])
+    {
+      auto ownProvider = std::find_if(providers.begin(), providers.end(), [&](std::size_t p) {
+                                        return owners[p] == owners[i];
+                                      });
+      if (ownProvider != providers.end())
+      {
+        continue;
+      }
+      for (auto p : providers)
+      {
+        consumerOwners[owners[p]].push_back(owners[i]);
+      }
+    }
+  }
+
+  // Tarjan's strongly connected components algorithm. The groups are found
+  // consumers first, so they are reversed at the end. Visiting the owners in
+  // reverse order keeps unrelated owners in their original order.
+  const std::size_t unvisited = ownerCount;
+  std::vector<std::size_t> index(ownerCount, unvisited);
+  std::vector<std::size_t> lowLink(ownerCount, 0);
+  std::vector<bool> onStack(ownerCount, false);
+  std::vector<std::size_t> stack;
+  std::size_t nextIndex = 0;
+  std::vector<std::vector<std::size_t>> groups;
+
+  std::function<void(std::size_t)> connect = [&](std::size_t v) {
+    index[v] = lowLink[v] = nextIndex++;
+    stack.push_back(v);
+    onStack[v] = true;
+    for (auto w : consumerOwners[v])
+    {
+      if (index[w] == unvisited)
+      {
+        connect(w);
+        lowLink[v] = std::min(lowLink[v], lowLink[w]);
+      }
+      else if (onStack[w])
+      {
+        lowLink[v] = std::min(lowLink[v], index[w]);
+      }
+    }
+    if (lowLink[v] == index[v])
+    {
+      std::vector<std::size_t> group;
+      std::size_t w;
+      do
+      {
+        w = stack.back();
+        stack.pop_back();
+        onStack[w] = false;
+        group.push_back(w);
+      } while (w != v);
+      std::sort(group.begin(), group.end());
+      groups.push_back(std::move(group));
+    }
+  };
+
+  for (std::size_t v = ownerCount; v-- > 0;)
+  {
+    if (index[v] == unvisited)
+    {
+      connect(v);
+    }
+  }
+  std::reverse(groups.begin(), groups.end());
+  return groups;
+}
+} // scrimpl
+} // cppmicroservices
@@ -0,0 +1,117 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef __COMPONENT_DEPENDENCY_GRAPH_HPP__
+#define __COMPONENT_DEPENDENCY_GRAPH_HPP__
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "metadata/ComponentMetadata.hpp"
+
+namespace cppmicroservices {
+namespace scrimpl {
+/**
+ * This class builds the static reference graph of a set of component
+ * descriptions. A component depends on the components providing the
+ * interfaces of its mandatory references. Optional references never
+ * prevent a component from becoming satisfied and are ignored.
+ *
+ * The graph is used to enable components in batches, where every batch only
+ * depends on earlier batches. Enabling components in this order lets each
+ * component find its references already satisfied when it is enabled, instead
+ * of waiting for one service event per level of the graph.
+ */
+class ComponentDependencyGraph
+{
+public:
+  using ComponentMetadataPtr = std::shared_ptr<const metadata::ComponentMetadata>;
+
+  /**
+   * Builds the graph and computes the enable order.
+   *
+   * \param components the component descriptions to analyze. Components
+   *        providing an interface which nobody in this set references are
+   *        still part of the graph.
+   */
+  explicit ComponentDependencyGraph(std::vector<ComponentMetadataPtr> components);
+  ComponentDependencyGraph(const ComponentDependencyGraph&) = delete;
+  ComponentDependencyGraph& operator=(const ComponentDependencyGraph&) = delete;
+  ComponentDependencyGraph(ComponentDependencyGraph&&) = default;
+  ComponentDependencyGraph& operator=(ComponentDependencyGraph&&) = default;
+  ~ComponentDependencyGraph() = default;
+
+  /**
+   * Returns the components grouped into batches. For every mandatory
+   * reference of a component, at least one provider of the referenced
+   * interface is in an earlier batch, or no provider exists in this graph.
+   * Components which are part of a cycle, or which only depend on one,
+   * are returned in a final batch in their original order.
+   */
+  std::vector<std::vector<ComponentMetadataPtr>> GetEnableBatches() const;
+
+  /**
+   * Returns the batch index of every component, in the order the components
+   * were passed to the constructor.
+   */
+  const std::vector<std::size_t>& GetBatchIndices() const { return batchIndices; }
+
+  /**
+   * Returns every cycle of mandatory references found in the graph. Each
+   * cycle is the list of the names of the components forming it. The
+   * components of a cycle can never become satisfied by each other.
+   */
+  std::vector<std::vector<std::string>> GetCycles() const;
+
+  /**
+   * Groups the owners of the components, e.g. their bundles, in the order
+   * they should be enabled. An owner comes after the owners providing the
+   * mandatory references of its components, unless one of its own
+   * components provides the reference. Owners whose components reference
+   * each other form one group; the components of such a group must be
+   * enabled together, in batch order. Unrelated owners keep their order.
+   *
+   * \param owners the owner index of every component, in the order the
+   *        components were passed to the constructor
+   * \param ownerCount the number of owners
+   */
+  std::vector<std::vector<std::size_t>> GetOwnerGroups(const std::vector<std::size_t>& owners,
+                                                       std::size_t ownerCount) const;
+
+private:
+  /**
+   * Assigns a batch index to every component. A component is placed in the
+   * first batch in which each of its mandatory references is satisfiable by
+   * a component from an earlier batch. Runs in time linear in the number of
+   * components and reference providers.
+   */
+  void ComputeBatches();
+
+  std::vector<ComponentMetadataPtr> components; ///< the analyzed component descriptions
+  std::vector<std::vector<std::vector<std::size_t>>> refProviders; ///< for every component and mandatory reference, the indices of the components providing the referenced interface
+  std::vector<std::size_t> batchIndices; ///< batch index of every component
+  std::vector<bool> resolved; ///< false for components which are part of, or depend on, a cycle
+};
+} // scrimpl
+} // cppmicroservices
+
+#endif // __COMPONENT_DEPENDENCY_GRAPH_HPP__
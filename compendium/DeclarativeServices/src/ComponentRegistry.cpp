@@ -25,24 +25,40 @@
 namespace cppmicroservices {
 namespace scrimpl {
 
+ComponentRegistry::ComponentRegistry()
+  : mSnapshot(std::make_shared<const Snapshot>())
+{
+}
+
+std::shared_ptr<const ComponentRegistry::Snapshot> ComponentRegistry::GetSnapshot() const
+{
+  return std::atomic_load(&mSnapshot);
+}
+
 std::vector<std::shared_ptr<ComponentManager>> ComponentRegistry::GetComponentManagers() const
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex); 
+  auto snapshot = GetSnapshot();
   std::vector<std::shared_ptr<ComponentManager>> managers;
-  for (const auto& kv : mComponentsByName)
+  managers.reserve(snapshot->count);
+  for (const auto& bundleComponents : snapshot->componentsByBundle)
   {
-    managers.push_back(kv.second);
+    for (const auto& kv : *(bundleComponents.second))
+    {
+      managers.push_back(kv.second);
+    }
   }
   return managers;
 }
 
 std::vector<std::shared_ptr<ComponentManager>> ComponentRegistry::GetComponentManagers(unsigned long bundleId) const
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex);
+  auto snapshot = GetSnapshot();
   std::vector<std::shared_ptr<ComponentManager>> managers;
-  for (const auto& kv : mComponentsByName)
+  auto iter = snapshot->componentsByBundle.find(bundleId);
+  if(iter != snapshot->componentsByBundle.end())
   {
-    if(kv.first.first == bundleId)
+    managers.reserve(iter->second->size());
+    for (const auto& kv : *(iter->second))
     {
       managers.push_back(kv.second);
     }
@@ -53,22 +69,55 @@ std::vector<std::shared_ptr<ComponentManager>> ComponentRegistry::GetComponentMa
 std::shared_ptr<ComponentManager> ComponentRegistry::GetComponentManager(unsigned long bundleId,
                                                                          const std::string& compName) const
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex);
-  return mComponentsByName.at(std::make_pair(bundleId, compName));
+  auto snapshot = GetSnapshot();
+  return snapshot->componentsByBundle.at(bundleId)->at(compName);
 }
 
 bool ComponentRegistry::AddComponentManager(const std::shared_ptr<ComponentManager>& cm)
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex);
-  auto result = mComponentsByName.insert(std::make_pair(std::make_pair(static_cast<unsigned long>(cm->GetBundleId()), cm->GetName()), cm));
-  return result.second;
+  const auto bundleId = static_cast<unsigned long>(cm->GetBundleId());
+  const auto compName = cm->GetName();
+  std::lock_guard<std::mutex> lock(mWriteMutex);
+  auto snapshot = GetSnapshot();
+  auto iter = snapshot->componentsByBundle.find(bundleId);
+  auto bundleComponents = (iter != snapshot->componentsByBundle.end())
+                          ? std::make_shared<ComponentsByName>(*(iter->second))
+                          : std::make_shared<ComponentsByName>();
+  if(!bundleComponents->insert(std::make_pair(compName, cm)).second)
+  {
+    return false;
+  }
+  // copies the bundle map, the indices of the other bundles are shared
+  auto newSnapshot = std::make_shared<Snapshot>(*snapshot);
+  newSnapshot->componentsByBundle[bundleId] = std::move(bundleComponents);
+  ++(newSnapshot->count);
+  std::atomic_store(&mSnapshot, std::shared_ptr<const Snapshot>(std::move(newSnapshot)));
+  return true;
 }
 
 void ComponentRegistry::RemoveComponentManager(unsigned long bundleId,
                                                const std::string& compName)
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex);
-  mComponentsByName.erase(std::make_pair(bundleId, compName));
+  std::lock_guard<std::mutex> lock(mWriteMutex);
+  auto snapshot = GetSnapshot();
+  auto iter = snapshot->componentsByBundle.find(bundleId);
+  if(iter == snapshot->componentsByBundle.end() || iter->second->count(compName) == 0)
+  {
+    return;
+  }
+  auto newSnapshot = std::make_shared<Snapshot>(*snapshot);
+  if(iter->second->size() == 1)
+  {
+    newSnapshot->componentsByBundle.erase(bundleId);
+  }
+  else
+  {
+    auto bundleComponents = std::make_shared<ComponentsByName>(*(iter->second));
+    bundleComponents->erase(compName);
+    newSnapshot->componentsByBundle[bundleId] = std::move(bundleComponents);
+  }
+  --(newSnapshot->count);
+  std::atomic_store(&mSnapshot, std::shared_ptr<const Snapshot>(std::move(newSnapshot)));
 }
 
 void ComponentRegistry::RemoveComponentManager(const std::shared_ptr<ComponentManager>& cm)
@@ -79,14 +128,13 @@ void ComponentRegistry::RemoveComponentManager(const std::shared_ptr<ComponentMa
 
 void ComponentRegistry::Clear()
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex);
-  mComponentsByName.clear();
+  std::lock_guard<std::mutex> lock(mWriteMutex);
+  std::atomic_store(&mSnapshot, std::make_shared<const Snapshot>());
 }
 
 size_t ComponentRegistry::Count() const
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex);
-  return mComponentsByName.size();
+  return GetSnapshot()->count;
 }
 }
 }
@@ -23,7 +23,9 @@
 #ifndef __COMPONENT_REGISTRY_HPP__
 #define __COMPONENT_REGISTRY_HPP__
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "manager/ComponentManager.hpp"
 
@@ -32,11 +34,19 @@ namespace scrimpl {
 /**
  * This class provides a thread-safe store for ComponentManager objects
  * created by the runtime.
+ *
+ * The registry contents are held in an immutable snapshot. Lookups load the
+ * current snapshot without taking a lock, so introspection through the
+ * {@link ServiceComponentRuntime} never blocks components from being added
+ * or removed. Modifications are serialized and publish a new snapshot. Each
+ * one copies the component index of the affected bundle and the map from
+ * bundle ids to indices. The indices of the other bundles are shared with the
+ * previous snapshot, so only their pointers are copied.
  */
 class ComponentRegistry
 {
 public:
-  ComponentRegistry() = default;
+  ComponentRegistry();
   virtual ~ComponentRegistry() = default;
   ComponentRegistry(const ComponentRegistry&) = delete;
   ComponentRegistry& operator=(const ComponentRegistry&) = delete;
@@ -121,8 +131,25 @@ public:
    */
   size_t Count() const;
 private:
-  std::map<std::pair<unsigned long,std::string>,std::shared_ptr<ComponentManager>> mComponentsByName;
-  mutable std::mutex mMapsMutex;
+  using ComponentsByName = std::map<std::string, std::shared_ptr<ComponentManager>>;
+  using ComponentsByBundle = std::map<unsigned long, std::shared_ptr<const ComponentsByName>>;
+
+  /**
+   * An immutable view of the registry contents
+   */
+  struct Snapshot
+  {
+    ComponentsByBundle componentsByBundle; ///< component managers indexed by bundle id and component name
+    std::size_t count{0};                  ///< total number of component managers in the snapshot
+  };
+
+  /**
+   * Returns the current snapshot. This method never blocks.
+   */
+  std::shared_ptr<const Snapshot> GetSnapshot() const;
+
+  std::shared_ptr<const Snapshot> mSnapshot; ///< current snapshot, only accessed through std::atomic_load and std::atomic_store
+  std::mutex mWriteMutex; ///< serializes modifications of the registry
 };
 } // scrimpl
 } // cppmicroservices
@@ -20,23 +20,29 @@
 
   =============================================================================*/
 
+#include <algorithm>
 #include <iostream>
+#include <numeric>
 #include <vector>
 #include <memory>
 #include <future>
 #include <functional>
 #include <stdexcept>
+#include <utility>
 #include "SCRActivator.hpp"
 #include "SCRLogger.hpp"
 #include "manager/ComponentManager.hpp"
 #include "manager/ReferenceManager.hpp"
 #include "ServiceComponentRuntimeImpl.hpp"
+#include "ComponentDependencyGraph.hpp"
+#include "metadata/ComponentMetadata.hpp"
 
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
 #include "cppmicroservices/servicecomponent/runtime/dto/ComponentDescriptionDTO.hpp"
 #include "cppmicroservices/servicecomponent/runtime/dto/ComponentConfigurationDTO.hpp"
 #include "cppmicroservices/servicecomponent/runtime/dto/ReferenceDTO.hpp"
 
+using cppmicroservices::logservice::LogFormat;
 using cppmicroservices::logservice::SeverityLevel;
 using cppmicroservices::service::component::ComponentConstants::SERVICE_COMPONENT;
 
@@ -53,14 +59,10 @@ void SCRActivator::Start(BundleContext context)
   logger->Log(SeverityLevel::LOG_DEBUG, "Starting SCR bundle");
   // Add bundle listener
   bundleListenerToken = context.AddBundleListener(std::bind(&SCRActivator::BundleChanged, this, std::placeholders::_1));
-  // HACK: Workaround for lack of Bundle Tracker. Iterate over all bundles and call the tracker method manually
-  for (const auto& bundle : context.GetBundles())
+  // HACK: Workaround for lack of Bundle Tracker. Iterate over all active bundles and create their extensions manually
+  for (const auto& group : GetExtensionsInDependencyOrder(context.GetBundles()))
   {
-    if (bundle.GetState() == cppmicroservices::Bundle::State::STATE_ACTIVE)
-    {
-      cppmicroservices::BundleEvent evt(cppmicroservices::BundleEvent::BUNDLE_STARTED, bundle);
-      BundleChanged(evt);
-    }
+    CreateExtensions(group);
   }
   // Publish ServiceComponentRuntimeService
   auto service = std::make_shared<ServiceComponentRuntimeImpl>(runtimeContext, componentRegistry, logger);
@@ -99,14 +101,16 @@ void SCRActivator::Stop(cppmicroservices::BundleContext context)
 
 void SCRActivator::CreateExtension(const cppmicroservices::Bundle& bundle)
 {
-  auto headers = bundle.GetHeaders();
-  // bundle has no "scr" property
-  if (headers.count(SERVICE_COMPONENT) == 0u)
+  std::vector<std::shared_ptr<metadata::ComponentMetadata>> componentsMetadata;
+  if (ParseComponentsMetadata(bundle, componentsMetadata))
   {
-    logger->Log(SeverityLevel::LOG_DEBUG, "No SCR components found in bundle " + bundle.GetSymbolicName());
-    return;
+    CreateExtension(bundle, componentsMetadata);
   }
+}
 
+void SCRActivator::CreateExtension(const cppmicroservices::Bundle& bundle,
+                                   const std::vector<std::shared_ptr<metadata::ComponentMetadata>>& componentsMetadata)
+{
   bool extensionFound = false;
   {
     std::lock_guard<std::mutex> l(bundleRegMutex);
@@ -115,11 +119,11 @@ void SCRActivator::CreateExtension(const cppmicroservices::Bundle& bundle)
   // bundle components have not been loaded, so create the extension which will load the components
   if (!extensionFound)
   {
-    logger->Log(SeverityLevel::LOG_DEBUG, "Creating SCRBundleExtension ... " + bundle.GetSymbolicName());
+    static const LogFormat creatingFormat("Creating SCRBundleExtension ... {}");
+    logger->LogStructured(SeverityLevel::LOG_DEBUG, creatingFormat, bundle.GetSymbolicName());
     try
     {
-      auto const& scrMap = ref_any_cast<cppmicroservices::AnyMap>(headers.at(SERVICE_COMPONENT));
-      auto ba = std::make_unique<SCRBundleExtension>(bundle.GetBundleContext(), scrMap, componentRegistry, logger);
+      auto ba = std::make_unique<SCRBundleExtension>(bundle.GetBundleContext(), componentsMetadata, componentRegistry, logger);
       {
         std::lock_guard<std::mutex> l(bundleRegMutex);
         bundleRegistry.insert(std::make_pair(bundle.GetBundleId(),std::move(ba)));
@@ -132,17 +136,43 @@ void SCRActivator::CreateExtension(const cppmicroservices::Bundle& bundle)
   }
   else
   {
-    logger->Log(SeverityLevel::LOG_DEBUG, "SCR components already loaded from bundle " + bundle.GetSymbolicName());
+    static const LogFormat alreadyLoadedFormat("SCR components already loaded from bundle {}");
+    logger->LogStructured(SeverityLevel::LOG_DEBUG, alreadyLoadedFormat, bundle.GetSymbolicName());
+  }
+}
+
+bool SCRActivator::ParseComponentsMetadata(const cppmicroservices::Bundle& bundle,
+                                           std::vector<std::shared_ptr<metadata::ComponentMetadata>>& componentsMetadata)
+{
+  auto const& headers = bundle.GetHeaders();
+  // bundle has no "scr" property
+  if (headers.count(SERVICE_COMPONENT) == 0u)
+  {
+    static const LogFormat noComponentsFormat("No SCR components found in bundle {}");
+    logger->LogStructured(SeverityLevel::LOG_DEBUG, noComponentsFormat, bundle.GetSymbolicName());
+    return false;
+  }
+  try
+  {
+    auto const& scrMap = ref_any_cast<cppmicroservices::AnyMap>(headers.at(SERVICE_COMPONENT));
+    componentsMetadata = SCRBundleExtension::ParseComponentsMetadata(scrMap, logger);
+    return true;
   }
+  catch (const std::exception&)
+  {
+    logger->Log(SeverityLevel::LOG_DEBUG, "Failed to create SCRBundleExtension for " + bundle.GetSymbolicName(), std::current_exception());
+  }
+  return false;
 }
 
 void SCRActivator::DisposeExtension(const cppmicroservices::Bundle& bundle)
 {
-  auto headers = bundle.GetHeaders();
+  auto const& headers = bundle.GetHeaders();
   // bundle has no scr-component property
   if (headers.count(SERVICE_COMPONENT) == 0u)
   {
-    logger->Log(SeverityLevel::LOG_DEBUG, "Found No SCR Metadata for " + bundle.GetSymbolicName());
+    static const LogFormat noMetadataFormat("Found No SCR Metadata for {}");
+    logger->LogStructured(SeverityLevel::LOG_DEBUG, noMetadataFormat, bundle.GetSymbolicName());
     return;
   }
 
@@ -153,7 +183,8 @@ void SCRActivator::DisposeExtension(const cppmicroservices::Bundle& bundle)
   }
   if (extensionFound)
   {
-    logger->Log(SeverityLevel::LOG_DEBUG, "Found SCRBundleExtension for " + bundle.GetSymbolicName());
+    static const LogFormat foundFormat("Found SCRBundleExtension for {}");
+    logger->LogStructured(SeverityLevel::LOG_DEBUG, foundFormat, bundle.GetSymbolicName());
     // remove the bundle extension object from the map.
     {
       std::lock_guard<std::mutex> l(bundleRegMutex);
@@ -162,8 +193,122 @@ void SCRActivator::DisposeExtension(const cppmicroservices::Bundle& bundle)
   }
   else
   {
-    logger->Log(SeverityLevel::LOG_DEBUG, "Found No SCRBundleExtension for " + bundle.GetSymbolicName());
+    static const LogFormat notFoundFormat("Found No SCRBundleExtension for {}");
+    logger->LogStructured(SeverityLevel::LOG_DEBUG, notFoundFormat, bundle.GetSymbolicName());
+  }
+}
+
+void SCRActivator::CreateExtensions(const std::vector<BundleComponents>& group)
+{
+  if (group.size() == 1)
+  {
+    CreateExtension(group.front().first, group.front().second);
+    return;
+  }
+
+  std::vector<std::pair<long, std::unique_ptr<SCRBundleExtension>>> extensions;
+  std::vector<ComponentDependencyGraph::ComponentMetadataPtr> componentsMetadata;
+  std::vector<std::size_t> owners; // index of the extension each component description belongs to
+  std::string names;
+  for (auto const& bundleComponents : group)
+  {
+    auto const& bundle = bundleComponents.first;
+    {
+      std::lock_guard<std::mutex> l(bundleRegMutex);
+      if (bundleRegistry.count(bundle.GetBundleId()) != 0u)
+      {
+        continue;
+      }
+    }
+    try
+    {
+      // the components are added below, in the order of the whole group
+      extensions.emplace_back(bundle.GetBundleId(),
+                              std::make_unique<SCRBundleExtension>(bundle.GetBundleContext(),
+                                                                   std::vector<std::shared_ptr<metadata::ComponentMetadata>>(),
+                                                                   componentRegistry,
+                                                                   logger));
+    }
+    catch (const std::exception&)
+    {
+      logger->Log(SeverityLevel::LOG_DEBUG, "Failed to create SCRBundleExtension for " + bundle.GetSymbolicName(), std::current_exception());
+      continue;
+    }
+    for (auto const& oneCompMetadata : bundleComponents.second)
+    {
+      componentsMetadata.push_back(oneCompMetadata);
+      owners.push_back(extensions.size() - 1);
+    }
+    names += (names.empty() ? "" : ", ") + bundle.GetSymbolicName();
+  }
+
+  ComponentDependencyGraph graph(componentsMetadata);
+  for (auto const& cycle : graph.GetCycles())
+  {
+    std::string cycleNames;
+    for (auto const& name : cycle)
+    {
+      cycleNames += (cycleNames.empty() ? "" : ", ") + name;
+    }
+    logger->Log(SeverityLevel::LOG_WARNING,
+                "Components " + cycleNames + " from bundles " + names + " have circular mandatory references. They are enabled last and stay unsatisfied until a service they reference is provided from outside the cycle");
+  }
+  auto const& batchIndices = graph.GetBatchIndices();
+  std::vector<std::size_t> order(componentsMetadata.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&batchIndices](std::size_t lhs, std::size_t rhs) {
+                                                 return batchIndices[lhs] < batchIndices[rhs];
+                                               });
+  for (auto i : order)
+  {
+    extensions[owners[i]].second->AddComponent(componentsMetadata[i]);
+  }
+
+  std::lock_guard<std::mutex> l(bundleRegMutex);
+  for (auto& extension : extensions)
+  {
+    bundleRegistry.insert(std::move(extension));
+  }
+}
+
+std::vector<std::vector<SCRActivator::BundleComponents>>
+SCRActivator::GetExtensionsInDependencyOrder(const std::vector<cppmicroservices::Bundle>& bundles)
+{
+  std::vector<BundleComponents> extensions;
+  std::vector<ComponentDependencyGraph::ComponentMetadataPtr> componentsMetadata;
+  std::vector<std::size_t> owners; // index of the extension each component description belongs to
+  for (auto const& bundle : bundles)
+  {
+    if (bundle.GetState() != cppmicroservices::Bundle::State::STATE_ACTIVE ||
+        bundle == runtimeContext.GetBundle())
+    {
+      continue;
+    }
+    std::vector<std::shared_ptr<metadata::ComponentMetadata>> bundleComponents;
+    if (!ParseComponentsMetadata(bundle, bundleComponents))
+    {
+      continue;
+    }
+    for (auto const& oneCompMetadata : bundleComponents)
+    {
+      componentsMetadata.push_back(oneCompMetadata);
+      owners.push_back(extensions.size());
+    }
+    extensions.emplace_back(bundle, std::move(bundleComponents));
+  }
+
+  // extend a bundle only after the bundles providing its components' references
+  ComponentDependencyGraph graph(componentsMetadata);
+  std::vector<std::vector<BundleComponents>> groups;
+  for (auto const& ownerGroup : graph.GetOwnerGroups(owners, extensions.size()))
+  {
+    groups.emplace_back();
+    for (auto i : ownerGroup)
+    {
+      groups.back().push_back(std::move(extensions[i]));
+    }
   }
+  return groups;
 }
 
 void SCRActivator::BundleChanged(const cppmicroservices::BundleEvent& evt)
@@ -23,6 +23,7 @@
 #ifndef SCRACTIVATOR_HPP
 #define SCRACTIVATOR_HPP
 #include <map>
+#include <utility>
 #include <vector>
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/BundleActivator.h"
@@ -61,11 +62,49 @@ protected:
    * with declarative services metadata
    */
   void CreateExtension(const cppmicroservices::Bundle& bundle);
+  /*
+   * This method creates the BundleExtension object for a bundle from
+   * its already parsed component descriptions
+   */
+  void CreateExtension(const cppmicroservices::Bundle& bundle,
+                       const std::vector<std::shared_ptr<metadata::ComponentMetadata>>& componentsMetadata);
   /*
    * This method removes the BundleExtension object for a bundle
    * with declarative services metadata
    */
   void DisposeExtension(const cppmicroservices::Bundle& bundle);
+
+  /*
+   * This method parses the declarative services metadata of a bundle into
+   * \c componentsMetadata. Returns false if the bundle has no metadata or
+   * if the metadata is invalid, in which case the failure is logged.
+   */
+  bool ParseComponentsMetadata(const cppmicroservices::Bundle& bundle,
+                               std::vector<std::shared_ptr<metadata::ComponentMetadata>>& componentsMetadata);
+
+  /*
+   * A bundle together with its parsed component descriptions
+   */
+  using BundleComponents = std::pair<cppmicroservices::Bundle, std::vector<std::shared_ptr<metadata::ComponentMetadata>>>;
+
+  /*
+   * This method creates the BundleExtension objects for a group of bundles
+   * whose components reference each other. The components of all bundles
+   * are enabled in one combined dependency order.
+   */
+  void CreateExtensions(const std::vector<BundleComponents>& group);
+
+  /*
+   * This method returns the active bundles with declarative services metadata
+   * among \c bundles, together with their parsed component descriptions. The
+   * bundles providing services through their components come before the
+   * bundles whose components reference those services. Bundles whose
+   * components reference each other are returned in one group. Used when the
+   * runtime starts after other bundles are already active, so that each
+   * bundle's components are satisfied as soon as they are enabled.
+   */
+  std::vector<std::vector<BundleComponents>>
+  GetExtensionsInDependencyOrder(const std::vector<cppmicroservices::Bundle>& bundles);
 private:
   cppmicroservices::BundleContext runtimeContext;
   cppmicroservices::ServiceRegistration<ServiceComponentRuntime> scrServiceReg;
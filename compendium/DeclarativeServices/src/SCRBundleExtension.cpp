@@ -21,6 +21,7 @@
   =============================================================================*/
 
 #include "SCRBundleExtension.hpp"
+#include "ComponentDependencyGraph.hpp"
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
 #include "metadata/MetadataParserFactory.hpp"
 #include "metadata/MetadataParser.hpp"
@@ -39,48 +40,91 @@ SCRBundleExtension::SCRBundleExtension(const cppmicroservices::BundleContext& bu
                                        const cppmicroservices::AnyMap& scrMetadata,
                                        const std::shared_ptr<ComponentRegistry>& registry,
                                        const std::shared_ptr<LogService>& logger)
+  : SCRBundleExtension(bundleContext, ParseComponentsMetadata(scrMetadata, logger), registry, logger)
+{
+}
+
+SCRBundleExtension::SCRBundleExtension(const cppmicroservices::BundleContext& bundleContext,
+                                       const std::vector<std::shared_ptr<ComponentMetadata>>& componentsMetadata,
+                                       const std::shared_ptr<ComponentRegistry>& registry,
+                                       const std::shared_ptr<LogService>& logger)
   : bundleContext(bundleContext)
   , registry(registry)
   , logger(logger)
 {
-  if(!bundleContext || !registry || !logger || scrMetadata.empty())
+  if(!bundleContext || !registry || !logger)
   {
     throw std::invalid_argument("Invalid parameters passed to SCRBundleExtension constructor");
   }
 
-  auto version = ObjectValidator(scrMetadata, "version").GetValue<int>();
-  auto metadataparser = metadata::MetadataParserFactory::Create(version, logger);
-  std::vector<std::shared_ptr<ComponentMetadata>> componentsMetadata;
-  componentsMetadata = metadataparser->ParseAndGetComponentsMetadata(scrMetadata);
-  for (auto& oneCompMetadata : componentsMetadata)
+  // enable the providers before their consumers, so that the consumers are
+  // satisfied as soon as they are enabled.
+  ComponentDependencyGraph graph({componentsMetadata.begin(), componentsMetadata.end()});
+  for (auto const& cycle : graph.GetCycles())
+  {
+    std::string names;
+    for (auto const& name : cycle)
+    {
+      names += (names.empty() ? "" : ", ") + name;
+    }
+    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_WARNING,
+                "Components " + names + " from bundle " + bundleContext.GetBundle().GetSymbolicName() + " have circular mandatory references. They are enabled last and stay unsatisfied until a service they reference is provided from outside the cycle");
+  }
+  for (auto const& batch : graph.GetEnableBatches())
   {
-    try
+    for (auto const& oneCompMetadata : batch)
     {
-      auto compManager = std::make_shared<ComponentManagerImpl>(oneCompMetadata,
-                                                                registry,
-                                                                bundleContext,
-                                                                logger);
-      if(registry->AddComponentManager(compManager))
-      {
-        managers.push_back(compManager);
-        compManager->Initialize();
-      }
+      AddComponent(oneCompMetadata);
     }
-    catch (const std::exception&)
+  }
+  static const cppmicroservices::logservice::LogFormat createdFormat("Created instance of SCRBundleExtension for {}");
+  cppmicroservices::logservice::LogStructured(*logger,
+                                              cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+                                              createdFormat,
+                                              bundleContext.GetBundle().GetSymbolicName());
+}
+
+void SCRBundleExtension::AddComponent(const std::shared_ptr<const ComponentMetadata>& oneCompMetadata)
+{
+  try
+  {
+    auto compManager = std::make_shared<ComponentManagerImpl>(oneCompMetadata,
+                                                              registry,
+                                                              bundleContext,
+                                                              logger);
+    if(registry->AddComponentManager(compManager))
     {
-      logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR,
-                  "Failed to create ComponentManager with name " + oneCompMetadata->name + " from bundle with Id " + std::to_string(bundleContext.GetBundle().GetBundleId()),
-                  std::current_exception());
+      managers.push_back(compManager);
+      compManager->Initialize();
     }
   }
-  logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-              "Created instance of SCRBundleExtension for " + bundleContext.GetBundle().GetSymbolicName());
+  catch (const std::exception&)
+  {
+    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR,
+                "Failed to create ComponentManager with name " + oneCompMetadata->name + " from bundle with Id " + std::to_string(bundleContext.GetBundle().GetBundleId()),
+                std::current_exception());
+  }
+}
+
+std::vector<std::shared_ptr<ComponentMetadata>> SCRBundleExtension::ParseComponentsMetadata(const cppmicroservices::AnyMap& scrMetadata,
+                                                                                             const std::shared_ptr<LogService>& logger)
+{
+  if(!logger || scrMetadata.empty())
+  {
+    throw std::invalid_argument("Invalid parameters passed to SCRBundleExtension::ParseComponentsMetadata");
+  }
+  auto version = ObjectValidator(scrMetadata, "version").GetValue<int>();
+  auto metadataparser = metadata::MetadataParserFactory::Create(version, logger);
+  return metadataparser->ParseAndGetComponentsMetadata(scrMetadata);
 }
 
 SCRBundleExtension::~SCRBundleExtension()
 {
-  logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-              "Deleting instance of SCRBundleExtension for " + bundleContext.GetBundle().GetSymbolicName());
+  static const cppmicroservices::logservice::LogFormat deletingFormat("Deleting instance of SCRBundleExtension for {}");
+  cppmicroservices::logservice::LogStructured(*logger,
+                                              cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+                                              deletingFormat,
+                                              bundleContext.GetBundle().GetSymbolicName());
   for(auto compManager : managers)
   {
     auto fut = compManager->Disable();
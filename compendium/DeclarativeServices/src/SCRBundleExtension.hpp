@@ -24,11 +24,13 @@
 #define __SCRBUNDLEEXTENSION_HPP__
 
 #include <memory>
+#include <vector>
 #include "gtest/gtest_prod.h"
 #include "cppmicroservices/BundleContext.h"
 #include "ComponentRegistry.hpp"
 #include "manager/ComponentManager.hpp"
 #include "cppmicroservices/logservice/LogService.hpp"
+#include "metadata/ComponentMetadata.hpp"
 #include "metadata/Util.hpp"
 
 using cppmicroservices::logservice::LogService;
@@ -48,11 +50,36 @@ public:
                      const cppmicroservices::AnyMap& scrMetadata,
                      const std::shared_ptr<ComponentRegistry>& registry,
                      const std::shared_ptr<LogService>& logger);
+  /**
+   * Creates the extension from component descriptions which were already
+   * parsed by {@link #ParseComponentsMetadata}
+   */
+  SCRBundleExtension(const cppmicroservices::BundleContext& bundleContext,
+                     const std::vector<std::shared_ptr<metadata::ComponentMetadata>>& componentsMetadata,
+                     const std::shared_ptr<ComponentRegistry>& registry,
+                     const std::shared_ptr<LogService>& logger);
   SCRBundleExtension(const SCRBundleExtension&) = delete;
   SCRBundleExtension(SCRBundleExtension&&) = delete;
   SCRBundleExtension& operator=(const SCRBundleExtension&) = delete;
   SCRBundleExtension& operator=(SCRBundleExtension&&) = delete;
   ~SCRBundleExtension();
+
+  /**
+   * Returns the component descriptions found in the declarative services
+   * metadata \c scrMetadata of a bundle.
+   *
+   * \throws std::invalid_argument if \c scrMetadata is empty or \c logger is nullptr
+   * \throws std::exception if \c scrMetadata is not valid
+   */
+  static std::vector<std::shared_ptr<metadata::ComponentMetadata>> ParseComponentsMetadata(const cppmicroservices::AnyMap& scrMetadata,
+                                                                                           const std::shared_ptr<LogService>& logger);
+
+  /**
+   * Creates and enables the component manager for one more component
+   * description of this bundle. Used to enable the components of bundles
+   * which reference each other in one combined order.
+   */
+  void AddComponent(const std::shared_ptr<const metadata::ComponentMetadata>& oneCompMetadata);
 private:
   FRIEND_TEST(SCRBundleExtensionTest, CtorWithValidArgs);
 
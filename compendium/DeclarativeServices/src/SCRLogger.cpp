@@ -119,6 +119,38 @@ void SCRLogger::Log(const cppmicroservices::ServiceReferenceBase &sr,
     currLogger->Log(sr, level, message, ex);
   }
 }
+
+bool SCRLogger::IsEnabled(logservice::SeverityLevel level) const
+{
+  // nothing is logged while no LogService is available
+  auto currLogger = std::atomic_load(&logService);
+  if (!currLogger)
+  {
+    return false;
+  }
+  auto structured = std::dynamic_pointer_cast<logservice::StructuredLogService>(currLogger);
+  return structured ? structured->IsEnabled(level) : true;
+}
+
+void SCRLogger::LogRecord(logservice::SeverityLevel level,
+                          const logservice::LogFormat& format,
+                          const logservice::LogArg* args,
+                          std::size_t argCount)
+{
+  auto currLogger = std::atomic_load(&logService);
+  if (!currLogger)
+  {
+    return;
+  }
+  if (auto structured = std::dynamic_pointer_cast<logservice::StructuredLogService>(currLogger))
+  {
+    structured->LogRecord(level, format, args, argCount);
+  }
+  else
+  {
+    currLogger->Log(level, logservice::FormatLogMessage(format.GetPattern(), args, argCount));
+  }
+}
 } // scrimpl
 } // cppmicroservices
 
@@ -37,6 +37,7 @@ namespace scrimpl {
  */
 class SCRLogger
   : public cppmicroservices::logservice::LogService
+  , public cppmicroservices::logservice::StructuredLogService
   , public cppmicroservices::ServiceTrackerCustomizer<cppmicroservices::logservice::LogService>
 {
 public:
@@ -53,6 +54,10 @@ public:
   void Log(const ServiceReferenceBase& sr, logservice::SeverityLevel level, const std::string& message) override;
   void Log(const ServiceReferenceBase& sr, logservice::SeverityLevel level, const std::string& message, const std::exception_ptr ex) override;
 
+  // methods from the cppmicroservices::logservice::StructuredLogService interface
+  bool IsEnabled(logservice::SeverityLevel level) const override;
+  void LogRecord(logservice::SeverityLevel level, const logservice::LogFormat& format, const logservice::LogArg* args, std::size_t argCount) override;
+
   // methods from the cppmicroservices::ServiceTrackerCustomizer interface
   std::shared_ptr<TrackedParamType> AddingService(const ServiceReference<cppmicroservices::logservice::LogService>& reference) override;
   void ModifiedService(const ServiceReference<cppmicroservices::logservice::LogService>& reference, const std::shared_ptr<cppmicroservices::logservice::LogService>& service) override;
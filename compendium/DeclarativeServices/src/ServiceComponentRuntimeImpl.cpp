@@ -123,7 +123,8 @@ std::vector<ComponentDescriptionDTO> ServiceComponentRuntimeImpl::GetComponentDe
     }
   }
   std::vector<ComponentDescriptionDTO> componentDTOs;
-  for (auto holder : compMgrs)
+  componentDTOs.reserve(compMgrs.size());
+  for (const auto& holder : compMgrs)
   {
     componentDTOs.push_back(CreateDTO(holder));
   }
@@ -152,11 +153,16 @@ std::vector<ComponentConfigurationDTO> ServiceComponentRuntimeImpl::GetComponent
   if(manager)
   {
     std::vector<std::shared_ptr<ComponentConfiguration>> configs = manager->GetComponentConfigurations();
-    for(auto& aConfig : configs)
+    if(!configs.empty())
     {
-      auto compConfigDTO = CreateComponentConfigurationDTO(aConfig);
-      compConfigDTO.description = CreateDTO(manager);
-      compConfigDTOs.push_back(compConfigDTO);
+      // all configurations share the description of their component
+      const auto descriptionDTO = CreateDTO(manager);
+      compConfigDTOs.reserve(configs.size());
+      for(auto& aConfig : configs)
+      {
+        compConfigDTOs.push_back(CreateComponentConfigurationDTO(aConfig));
+        compConfigDTOs.back().description = descriptionDTO;
+      }
     }
   }
   return compConfigDTOs;
@@ -193,13 +199,13 @@ ComponentDescriptionDTO ServiceComponentRuntimeImpl::CreateDTO(const std::shared
     compDescription.activate = compMetadata->activateMethodName;
     compDescription.deactivate = compMetadata->deactivateMethodName;
     compDescription.modified = compMetadata->modifiedMethodName;
-    auto serviceData = compMetadata->serviceMetadata;
+    const auto& serviceData = compMetadata->serviceMetadata;
     compDescription.scope = serviceData.scope;
     compDescription.serviceInterfaces = serviceData.interfaces;
     compDescription.implementationClass = compMetadata->implClassName;
     compDescription.defaultEnabled = compMetadata->enabled;
     compDescription.properties = compMetadata->properties;
-    for (auto oneRef : compMetadata->refsMetadata)
+    for (const auto& oneRef : compMetadata->refsMetadata)
     {
       compDescription.references.push_back(ToDTO(oneRef));
     }
@@ -213,6 +219,9 @@ ComponentConfigurationDTO ServiceComponentRuntimeImpl::CreateComponentConfigurat
   configDTO.id = config->GetId();
   configDTO.properties = config->GetProperties();
   configDTO.state = config->GetConfigState();
+  auto poolStats = config->GetInstancePoolStats();
+  configDTO.instancePoolHits = poolStats.hits;
+  configDTO.instancePoolMisses = poolStats.misses;
   auto refManagers = config->GetAllDependencyManagers();
   for(auto& refManager : refManagers)
   {
@@ -20,6 +20,9 @@
 
   =============================================================================*/
 
+#include <algorithm>
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/BundleEvent.h"
 #include "BundleOrPrototypeComponentConfiguration.hpp"
 
 namespace cppmicroservices {
@@ -30,6 +33,8 @@ BundleOrPrototypeComponentConfigurationImpl::BundleOrPrototypeComponentConfigura
                                                                                          std::shared_ptr<const ComponentRegistry> registry,
                                                                                          std::shared_ptr<cppmicroservices::logservice::LogService> logger)
   : ComponentConfigurationImpl(metadata, bundle, registry, logger)
+  , poolHits(0)
+  , poolMisses(0)
 {
 }
 
@@ -51,6 +56,15 @@ std::shared_ptr<ComponentInstance> BundleOrPrototypeComponentConfigurationImpl::
     return nullptr;
   }
   auto compInstCtxtPairList = compInstanceMap.lock();
+  if(IsInstancePoolEnabled())
+  {
+    if(auto pooledInstance = TakeFromInstancePool(bundle, *compInstCtxtPairList))
+    {
+      ++poolHits;
+      return pooledInstance;
+    }
+    ++poolMisses;
+  }
   try
   {
     auto instCtxtTuple = CreateAndActivateComponentInstanceHelper(bundle);
@@ -74,6 +88,66 @@ void BundleOrPrototypeComponentConfigurationImpl::DestroyComponentInstances()
     DeactivateComponentInstance(valPair);
   }
   compInstCtxtPairList->clear();
+  cppmicroservices::ListenerToken listenerToken;
+  {
+    auto pooledInstances = instancePool.lock();
+    for(auto& bundlePool : pooledInstances->instances)
+    {
+      for(auto& valPair : bundlePool.second)
+      {
+        DeactivateComponentInstance(valPair);
+      }
+    }
+    pooledInstances->instances.clear();
+    listenerToken = std::move(pooledInstances->bundleListenerToken);
+  }
+  if(listenerToken)
+  {
+    try
+    {
+      GetBundle().GetBundleContext().RemoveListener(std::move(listenerToken));
+    }
+    catch(...)
+    {
+      // the listener was removed by the framework when the bundle stopped
+    }
+  }
+}
+
+void BundleOrPrototypeComponentConfigurationImpl::BindReference(const std::string& refName,
+                                                                const ServiceReferenceBase& sRef)
+{
+  auto compInstCtxtPairList = compInstanceMap.lock();
+  for(auto& valPair : *compInstCtxtPairList)
+  {
+    BindReferenceToInstance(valPair, refName, sRef);
+  }
+  auto pooledInstances = instancePool.lock();
+  for(auto& bundlePool : pooledInstances->instances)
+  {
+    for(auto& valPair : bundlePool.second)
+    {
+      BindReferenceToInstance(valPair, refName, sRef);
+    }
+  }
+}
+
+void BundleOrPrototypeComponentConfigurationImpl::UnbindReference(const std::string& refName,
+                                                                  const ServiceReferenceBase& sRef)
+{
+  auto compInstCtxtPairList = compInstanceMap.lock();
+  for(auto& valPair : *compInstCtxtPairList)
+  {
+    UnbindReferenceFromInstance(valPair, refName, sRef);
+  }
+  auto pooledInstances = instancePool.lock();
+  for(auto& bundlePool : pooledInstances->instances)
+  {
+    for(auto& valPair : bundlePool.second)
+    {
+      UnbindReferenceFromInstance(valPair, refName, sRef);
+    }
+  }
 }
 
 void BundleOrPrototypeComponentConfigurationImpl::DeactivateComponentInstance(const InstanceContextPair& instCtxt)
@@ -111,10 +185,100 @@ void BundleOrPrototypeComponentConfigurationImpl::UngetService(const cppmicroser
     });
   if(itr != compInstCtxtPairList->end())
   {
-    DeactivateComponentInstance(*itr);
+    auto instCtxt = *itr;
     compInstCtxtPairList->erase(itr);
+    if(!ReturnToInstancePool(instCtxt))
+    {
+      DeactivateComponentInstance(instCtxt);
+    }
   }
 }
+
+InstancePoolStats BundleOrPrototypeComponentConfigurationImpl::GetInstancePoolStats() const
+{
+  return InstancePoolStats{poolHits.load(), poolMisses.load()};
 }
+
+bool BundleOrPrototypeComponentConfigurationImpl::IsInstancePoolEnabled() const
+{
+  auto const& compMetadata = GetMetadata();
+  return (compMetadata->instancePoolSize > 0 &&
+          compMetadata->serviceMetadata.scope == cppmicroservices::Constants::SCOPE_PROTOTYPE);
+}
+
+std::shared_ptr<ComponentInstance> BundleOrPrototypeComponentConfigurationImpl::TakeFromInstancePool(const cppmicroservices::Bundle& bundle,
+                                                                                                      std::vector<InstanceContextPair>& activeInstances)
+{
+  auto pooledInstances = instancePool.lock();
+  // the context of a pooled instance is bound to the bundle which requested it
+  auto bundlePool = pooledInstances->instances.find(bundle.GetBundleId());
+  if(bundlePool == pooledInstances->instances.end())
+  {
+    return nullptr;
+  }
+  auto instCtxt = bundlePool->second.back();
+  bundlePool->second.pop_back();
+  if(bundlePool->second.empty())
+  {
+    pooledInstances->instances.erase(bundlePool);
+  }
+  activeInstances.emplace_back(instCtxt);
+  return instCtxt.first;
+}
+
+bool BundleOrPrototypeComponentConfigurationImpl::ReturnToInstancePool(const InstanceContextPair& instCtxt)
+{
+  if(!IsInstancePoolEnabled() || GetState()->GetValue() != service::component::runtime::dto::ACTIVE)
+  {
+    return false;
+  }
+  auto pooledInstances = instancePool.lock();
+  auto& bundlePool = pooledInstances->instances[instCtxt.second->GetUsingBundle().GetBundleId()];
+  if(bundlePool.size() >= GetMetadata()->instancePoolSize)
+  {
+    return false;
+  }
+  if(!pooledInstances->bundleListenerToken)
+  {
+    // drain the instances pooled for a bundle once it stops using this component
+    std::weak_ptr<BundleOrPrototypeComponentConfigurationImpl> weakThis =
+      std::dynamic_pointer_cast<BundleOrPrototypeComponentConfigurationImpl>(shared_from_this());
+    try
+    {
+      pooledInstances->bundleListenerToken = GetBundle().GetBundleContext().AddBundleListener([weakThis](const cppmicroservices::BundleEvent& evt) {
+          auto thisPtr = weakThis.lock();
+          if(thisPtr && evt.GetType() == cppmicroservices::BundleEvent::BUNDLE_STOPPED)
+          {
+            thisPtr->DrainInstancePool(evt.GetBundle());
+          }
+        });
+    }
+    catch(...)
+    {
+      return false;
+    }
+  }
+  bundlePool.emplace_back(instCtxt);
+  return true;
 }
 
+void BundleOrPrototypeComponentConfigurationImpl::DrainInstancePool(const cppmicroservices::Bundle& bundle)
+{
+  std::vector<InstanceContextPair> drainedInstances;
+  {
+    auto pooledInstances = instancePool.lock();
+    auto bundlePool = pooledInstances->instances.find(bundle.GetBundleId());
+    if(bundlePool == pooledInstances->instances.end())
+    {
+      return;
+    }
+    drainedInstances.swap(bundlePool->second);
+    pooledInstances->instances.erase(bundlePool);
+  }
+  for(auto& instCtxt : drainedInstances)
+  {
+    DeactivateComponentInstance(instCtxt);
+  }
+}
+}
+}
@@ -23,8 +23,12 @@
 #ifndef __BUNDLEORPROTOTYPECOMPONENTCONFIGURATIONIMPL_HPP__
 #define __BUNDLEORPROTOTYPECOMPONENTCONFIGURATIONIMPL_HPP__
 
+#include <atomic>
+#include <unordered_map>
+#include <vector>
 #include "ComponentConfigurationImpl.hpp"
 #include "ConcurrencyUtil.hpp"
+#include <cppmicroservices/ListenerToken.h>
 #include <cppmicroservices/ServiceFactory.h>
 
 namespace cppmicroservices {
@@ -67,6 +71,18 @@ public:
    */
   void DestroyComponentInstances() override;
 
+  /**
+   * Calls the bind method of the active component instances for the
+   * service \c sRef of the reference \c refName
+   */
+  void BindReference(const std::string& refName, const ServiceReferenceBase& sRef) override;
+
+  /**
+   * Calls the unbind method of the active component instances for the
+   * service \c sRef of the reference \c refName
+   */
+  void UnbindReference(const std::string& refName, const ServiceReferenceBase& sRef) override;
+
   /**
    * Implements the {@link ServiceFactory#GetService} interface. This method
    * wraps the service implementation object in an {@link InterfaceMapConstPtr}
@@ -82,7 +98,60 @@ public:
   void UngetService(const cppmicroservices::Bundle& bundle,
                     const cppmicroservices::ServiceRegistrationBase& registration,
                     const cppmicroservices::InterfaceMapConstPtr& service) override;
+
+  /**
+   * Returns the number of service requests served from, and missed by, the
+   * instance pool
+   */
+  InstancePoolStats GetInstancePoolStats() const override;
 private:
+  FRIEND_TEST(BundleOrPrototypeComponentConfigurationTest, TestInstancePoolReuse);
+  FRIEND_TEST(BundleOrPrototypeComponentConfigurationTest, TestInstancePoolLimit);
+  FRIEND_TEST(BundleOrPrototypeComponentConfigurationTest, TestInstancePoolDisabled);
+  FRIEND_TEST(BundleOrPrototypeComponentConfigurationTest, TestInstancePoolLimitPerBundle);
+  FRIEND_TEST(BundleOrPrototypeComponentConfigurationTest, TestInstancePoolDrainedOnBundleStop);
+
+  /**
+   * Released instances kept active for reuse, keyed by the id of the bundle
+   * which released them. The listener drains the instances of a bundle
+   * when it stops.
+   */
+  struct InstancePool
+  {
+    std::unordered_map<long, std::vector<InstanceContextPair>> instances;
+    cppmicroservices::ListenerToken bundleListenerToken;
+  };
+
+  /**
+   * Returns true if released instances of this component are pooled. Only
+   * prototype scoped components with a non-zero \c instance-pool-size in
+   * their component description pool their instances.
+   */
+  bool IsInstancePoolEnabled() const;
+
+  /**
+   * Moves an active instance released by \c bundle from the pool to
+   * \c activeInstances. Must be called with the \c compInstanceMap lock held.
+   *
+   * \return the pooled instance, or nullptr if the pool has none for \c bundle
+   */
+  std::shared_ptr<ComponentInstance> TakeFromInstancePool(const cppmicroservices::Bundle& bundle,
+                                                          std::vector<InstanceContextPair>& activeInstances);
+
+  /**
+   * Keeps the released instance active in the pool if the pool of the
+   * bundle which released it is not full. Must be called with the
+   * \c compInstanceMap lock held.
+   *
+   * \return true if the instance was pooled, false if it must be deactivated
+   */
+  bool ReturnToInstancePool(const InstanceContextPair& instCtxt);
+
+  /**
+   * Deactivates the instances pooled for \c bundle. Called when \c bundle
+   * stops, its pooled instances can no longer be reused.
+   */
+  void DrainInstancePool(const cppmicroservices::Bundle& bundle);
 
   /**
    * Helper method to deactivate the component instance and invalidate the
@@ -91,6 +160,9 @@ private:
   void DeactivateComponentInstance(const InstanceContextPair& instCtxt);
 
   Guarded<std::vector<InstanceContextPair>> compInstanceMap; ///< map of component instance and context objects associated with this configuration
+  Guarded<InstancePool> instancePool; ///< released instances kept active for reuse, always locked after compInstanceMap
+  std::atomic<unsigned long> poolHits; ///< number of service requests served from the instance pool
+  std::atomic<unsigned long> poolMisses; ///< number of service requests which created a new instance while pooling is enabled
 };
 }
 }
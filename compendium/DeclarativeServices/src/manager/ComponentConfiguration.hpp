@@ -36,6 +36,16 @@ class ComponentRegistry;
 class ReferenceManager;
 class RegistrationManager;
 
+/**
+ * Usage counters of the instance pool of a component configuration.
+ * Both counters stay zero if the component does not pool its instances.
+ */
+struct InstancePoolStats
+{
+  unsigned long hits;   ///< service requests served by a pooled component instance
+  unsigned long misses; ///< service requests which had to create a new component instance
+};
+
 /**
  * This interface represents a component configuration. The implementations of
  * this interface are responsible for managing the lifecycle of a component
@@ -95,6 +105,11 @@ public:
    * Returns the current {@code ComponentState} of this component configuration
    */
   virtual ComponentState GetConfigState() const = 0;
+
+  /**
+   * Returns the usage counters of this component configuration's instance pool
+   */
+  virtual InstancePoolStats GetInstancePoolStats() const = 0;
 };
 } // scrimpl
 } // cppmicroservices
@@ -122,6 +122,9 @@ void ComponentConfigurationImpl::RefChangedState(const RefChangeNotification& no
     case RefEvent::BECAME_UNSATISFIED:
       RefUnsatisfied(notification.senderName);
       break;
+    case RefEvent::REBIND:
+      RefRebind(notification);
+      break;
     default:
       break;
   }
@@ -201,6 +204,18 @@ void ComponentConfigurationImpl::RefUnsatisfied(const std::string& refName)
   }
 }
 
+void ComponentConfigurationImpl::RefRebind(const RefChangeNotification& notification)
+{
+  // Configurations without instances pick up the bound services when they are activated.
+  // Bind before unbind, so that the instance is never left without the replaced service.
+  if(notification.serviceRefToBind) {
+    BindReference(notification.senderName, notification.serviceRefToBind);
+  }
+  if(notification.serviceRefToUnbind) {
+    UnbindReference(notification.senderName, notification.serviceRefToUnbind);
+  }
+}
+
 void ComponentConfigurationImpl::Register()
 {
   GetState()->Register(*this);
@@ -255,4 +270,47 @@ InstanceContextPair ComponentConfigurationImpl::CreateAndActivateComponentInstan
   return std::make_pair(componentInstance, ctxt);
 }
 
+void ComponentConfigurationImpl::BindReferenceToInstance(const InstanceContextPair& instCtxt,
+                                                         const std::string& refName,
+                                                         const ServiceReferenceBase& sRef)
+{
+  if(!instCtxt.first || !instCtxt.second) {
+    return;
+  }
+  // the instance is bound to the same service object the context returns
+  auto service = instCtxt.second->AddToBoundServicesCache(refName, sRef);
+  if(!service) {
+    return;
+  }
+  try {
+    instCtxt.first->InvokeBindMethodWithService(refName, sRef, service);
+  }
+  catch(...) {
+    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR,
+                "Exception received from user code while binding reference " + refName,
+                std::current_exception());
+  }
+}
+
+void ComponentConfigurationImpl::UnbindReferenceFromInstance(const InstanceContextPair& instCtxt,
+                                                             const std::string& refName,
+                                                             const ServiceReferenceBase& sRef)
+{
+  if(!instCtxt.first || !instCtxt.second) {
+    return;
+  }
+  auto service = instCtxt.second->RemoveFromBoundServicesCache(refName, sRef);
+  if(!service) {
+    return;
+  }
+  try {
+    instCtxt.first->InvokeUnbindMethodWithService(refName, sRef, service);
+  }
+  catch(...) {
+    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR,
+                "Exception received from user code while unbinding reference " + refName,
+                std::current_exception());
+  }
+}
+
 }} // namespaces
@@ -110,6 +110,11 @@ public:
    */
   ComponentState GetConfigState() const override;
 
+  /** @copydoc ComponentConfiguration::GetInstancePoolStats()
+   * Configurations which do not pool instances report zero for both counters.
+   */
+  InstancePoolStats GetInstancePoolStats() const override { return InstancePoolStats{0, 0}; }
+
   /**
    * This method returns the {@link ComponentMetadata} object created by
    * parsing the component description.
@@ -163,6 +168,27 @@ public:
    */
   virtual void DestroyComponentInstances() = 0;
 
+  /**
+   * Method called before this component configuration leaves the \c ACTIVE
+   * state. Subclasses that serve service objects without consulting the
+   * state must stop doing so before this method returns.
+   */
+  virtual void RetractCachedServices() {}
+
+  /**
+   * Method called when a reference with dynamic policy binds the service
+   * \c sRef while this configuration may have active instances. Subclasses
+   * must call the bind method of each of their component instances.
+   */
+  virtual void BindReference(const std::string& refName, const ServiceReferenceBase& sRef) = 0;
+
+  /**
+   * Method called when a reference with dynamic policy unbinds the service
+   * \c sRef while this configuration may have active instances. Subclasses
+   * must call the unbind method of each of their component instances.
+   */
+  virtual void UnbindReference(const std::string& refName, const ServiceReferenceBase& sRef) = 0;
+
   /**
    * Method used to kick start the state machine of this configuration
    */
@@ -225,6 +251,25 @@ protected:
    */
   InstanceContextPair CreateAndActivateComponentInstanceHelper(const cppmicroservices::Bundle& bundle);
 
+  /**
+   * Helper function used by sub-classes to bind the service \c sRef to a
+   * component instance. The bind method is only invoked if the service is
+   * not already bound to the instance's context. Exceptions from user code
+   * are logged.
+   */
+  void BindReferenceToInstance(const InstanceContextPair& instCtxt,
+                               const std::string& refName,
+                               const ServiceReferenceBase& sRef);
+
+  /**
+   * Helper function used by sub-classes to unbind the service \c sRef from a
+   * component instance. The unbind method is only invoked if the service is
+   * bound to the instance's context. Exceptions from user code are logged.
+   */
+  void UnbindReferenceFromInstance(const InstanceContextPair& instCtxt,
+                                   const std::string& refName,
+                                   const ServiceReferenceBase& sRef);
+
   /**
    * Sets the function pointers used to create and delete a {@link ComponentInstance} object
    */
@@ -267,6 +312,15 @@ private:
    */
   void RefUnsatisfied(const std::string& refName);
 
+  /**
+   * Utility method with actions to be performed when the bound services of a
+   * reference with dynamic policy change. This method is called from
+   * {@link #RefChangedState} when {@link RefChangeNotification#event} is
+   * \c REBIND. The services are swapped on the active component instances
+   * without deactivating them.
+   */
+  void RefRebind(const RefChangeNotification& notification);
+
   /**
    * Method is responsible for loading the bundle and populating the function
    * objects \c newCompInstanceFunc & \c deleteCompInstanceFunc used to create
@@ -288,6 +342,7 @@ private:
   FRIEND_TEST(ComponentConfigurationImplTest, VerifyConcurrentActivateDeactivate);
   FRIEND_TEST(ComponentConfigurationImplTest, VerifyRefSatisfied);
   FRIEND_TEST(ComponentConfigurationImplTest, VerifyRefUnsatisfied);
+  FRIEND_TEST(ComponentConfigurationImplTest, VerifyRefRebind);
   FRIEND_TEST(ComponentConfigurationImplTest, VerifyStateChangeDelegation);
   FRIEND_TEST(ComponentConfigurationImplTest, TestGetDependencyManagers);
 
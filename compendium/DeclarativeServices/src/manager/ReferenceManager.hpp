@@ -41,6 +41,9 @@ enum class RefEvent
                         become satisfied */
   BECAME_UNSATISFIED,/* used to notify the listener that the reference has
                         become unsatisfied */
+  REBIND,            /* used to notify the listener that the bound services
+                        of a reference with dynamic policy have changed while
+                        the reference stayed satisfied */
 };
 
 /**
@@ -49,8 +52,22 @@ enum class RefEvent
  */
 struct RefChangeNotification
 {
+  RefChangeNotification(std::string name,
+                        RefEvent evt,
+                        cppmicroservices::ServiceReferenceU refToBind = {},
+                        cppmicroservices::ServiceReferenceU refToUnbind = {})
+    : senderName(std::move(name))
+    , event(evt)
+    , serviceRefToBind(std::move(refToBind))
+    , serviceRefToUnbind(std::move(refToUnbind))
+  {}
+
   std::string senderName;
   RefEvent event;
+  cppmicroservices::ServiceReferenceU serviceRefToBind;   /* the service bound by a REBIND,
+                                                             invalid if no service is bound */
+  cppmicroservices::ServiceReferenceU serviceRefToUnbind; /* the service unbound by a REBIND,
+                                                             invalid if no service is unbound */
 };
 
 /**
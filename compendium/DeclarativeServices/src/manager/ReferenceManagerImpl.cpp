@@ -19,12 +19,16 @@
   limitations under the License.
 
   =============================================================================*/
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 #include "cppmicroservices/ServiceReference.h"
 #include "cppmicroservices/LDAPProp.h"
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
 #include "ReferenceManagerImpl.hpp"
 
+using cppmicroservices::logservice::LogFormat;
+using cppmicroservices::logservice::LogStructured;
 using cppmicroservices::logservice::SeverityLevel;
 using cppmicroservices::service::component::ComponentConstants::REFERENCE_SCOPE_PROTOTYPE_REQUIRED;
 using cppmicroservices::Constants::SERVICE_SCOPE;
@@ -109,6 +113,29 @@ long GetServiceId(const ServiceReferenceBase& sRef)
   return cppmicroservices::any_cast<long>(idAny);
 }
 
+namespace {
+
+// formats of the debug messages logged when notifying listeners
+const LogFormat& NotifyRebindFormat()
+{
+  static const LogFormat format("Notify REBIND for reference {}");
+  return format;
+}
+
+const LogFormat& NotifyUnsatisfiedFormat()
+{
+  static const LogFormat format("Notify UNSATISFIED for reference {}");
+  return format;
+}
+
+const LogFormat& NotifySatisfiedFormat()
+{
+  static const LogFormat format("Notify SATISFIED for reference {}");
+  return format;
+}
+
+}
+
 bool ReferenceManagerImpl::IsOptional() const
 {
   return (metadata.minCardinality == 0);
@@ -144,6 +171,57 @@ bool ReferenceManagerImpl::UpdateBoundRefs()
   // release locks on matchedRefs and boundRefs
 }
 
+std::vector<RefChangeNotification> ReferenceManagerImpl::RebindBoundRefs()
+{
+  // Build the new bound references first and publish them with a single
+  // swap, so that concurrent readers never see an empty set.
+  std::vector<RefChangeNotification> notifications;
+  std::set<cppmicroservices::ServiceReferenceBase> currBoundRefs;
+  std::set<cppmicroservices::ServiceReferenceBase> prevBoundRefs;
+  {
+    auto matchedRefsHandle = matchedRefs.lock(); // acquires lock on matchedRefs
+    const auto matchedRefsHandleSize = matchedRefsHandle->size();
+    if(matchedRefsHandleSize < metadata.minCardinality)
+    {
+      boundRefs.lock()->clear();
+      notifications.push_back(RefChangeNotification{metadata.name, RefEvent::BECAME_UNSATISFIED});
+      return notifications;
+    }
+    std::copy_n(matchedRefsHandle->rbegin(),
+                std::min(metadata.maxCardinality, matchedRefsHandleSize),
+                std::inserter(currBoundRefs, currBoundRefs.begin()));
+    prevBoundRefs = currBoundRefs;
+    boundRefs.lock()->swap(prevBoundRefs);
+  }
+
+  // best ranked services first, so that a replacement is bound before
+  // the service it replaces is unbound
+  std::vector<cppmicroservices::ServiceReferenceBase> refsToBind;
+  std::vector<cppmicroservices::ServiceReferenceBase> refsToUnbind;
+  std::set_difference(currBoundRefs.rbegin(), currBoundRefs.rend(),
+                      prevBoundRefs.rbegin(), prevBoundRefs.rend(),
+                      std::back_inserter(refsToBind),
+                      [](const ServiceReferenceBase& lhs, const ServiceReferenceBase& rhs) { return rhs < lhs; });
+  std::set_difference(prevBoundRefs.rbegin(), prevBoundRefs.rend(),
+                      currBoundRefs.rbegin(), currBoundRefs.rend(),
+                      std::back_inserter(refsToUnbind),
+                      [](const ServiceReferenceBase& lhs, const ServiceReferenceBase& rhs) { return rhs < lhs; });
+  for(std::size_t i = 0; i < std::max(refsToBind.size(), refsToUnbind.size()); ++i)
+  {
+    RefChangeNotification notification{metadata.name, RefEvent::REBIND};
+    if(i < refsToBind.size())
+    {
+      notification.serviceRefToBind = refsToBind[i];
+    }
+    if(i < refsToUnbind.size())
+    {
+      notification.serviceRefToUnbind = refsToUnbind[i];
+    }
+    notifications.push_back(std::move(notification));
+  }
+  return notifications;
+}
+
 // This method implements the following algorithm
 //
 //  if reference becomes satisfied
@@ -154,10 +232,15 @@ bool ReferenceManagerImpl::UpdateBoundRefs()
 //      ignore the new servcie
 //    else if policyOption is GREEDY
 //      if the new service is better than any of the existing services in #boundRefs
-//        send UNSATISFIED notification to listeners
-//        clear #boundRefs
-//        copy #matchedRefs to #boundRefs
-//        send a SATISFIED notification to listeners
+//        if policy is DYNAMIC
+//          update #boundRefs from #matchedRefs
+//          send REBIND notifications to listeners
+//        else
+//          send UNSATISFIED notification to listeners
+//          clear #boundRefs
+//          copy #matchedRefs to #boundRefs
+//          send a SATISFIED notification to listeners
+//        endif
 //      endif
 //    endif
 //  endif
@@ -166,7 +249,8 @@ void ReferenceManagerImpl::ServiceAdded(const cppmicroservices::ServiceReference
   std::vector<RefChangeNotification> notifications;
   if(!reference)
   {
-    logger->Log(SeverityLevel::LOG_DEBUG, "ServiceAdded: service with id " + std::to_string(GetServiceId(reference)) + " has already been unregistered, no-op");
+    static const LogFormat unregisteredFormat("ServiceAdded: service with id {} has already been unregistered, no-op");
+    LogStructured(*logger, SeverityLevel::LOG_DEBUG, unregisteredFormat, GetServiceId(reference));
     return;
   }
   // const auto minCardinality = metadata.minCardinality;
@@ -205,9 +289,15 @@ void ReferenceManagerImpl::ServiceAdded(const cppmicroservices::ServiceReference
     }
   }
 
+  if(replacementNeeded && IsDynamic())
+  {
+    LogStructured(*logger, SeverityLevel::LOG_DEBUG, NotifyRebindFormat(), metadata.name);
+    BatchNotifyAllListeners(RebindBoundRefs());
+    return;
+  }
   if(replacementNeeded)
   {
-    logger->Log(SeverityLevel::LOG_DEBUG, "Notify UNSATISFIED for reference " + metadata.name);
+    LogStructured(*logger, SeverityLevel::LOG_DEBUG, NotifyUnsatisfiedFormat(), metadata.name);
     RefChangeNotification notification{metadata.name, RefEvent::BECAME_UNSATISFIED};
     notifications.push_back(std::move(notification));
     // The following "clear and copy" strategy is sufficient for
@@ -221,7 +311,7 @@ void ReferenceManagerImpl::ServiceAdded(const cppmicroservices::ServiceReference
   }
   if(notifySatisfied)
   {
-    logger->Log(SeverityLevel::LOG_DEBUG, "Notify SATISFIED for reference " + metadata.name);
+    LogStructured(*logger, SeverityLevel::LOG_DEBUG, NotifySatisfiedFormat(), metadata.name);
     RefChangeNotification notification{metadata.name, RefEvent::BECAME_SATISFIED};
     notifications.push_back(std::move(notification));
   }
@@ -254,12 +344,18 @@ void ReferenceManagerImpl::ModifiedService(const cppmicroservices::ServiceRefere
  *This method implements the following algorithm
  *
  * If the removed service is found in the #boundRefs
- *   send a UNSATISFIED notification to listeners
- *   clear the #boundRefs member
- *   copy #matchedRefs to #boundRefs
- *   if reference is still satisfied
- *     send a SATISFIED notification to listeners
- *  endif
+ *   if policy is DYNAMIC
+ *     update #boundRefs from #matchedRefs
+ *     send REBIND notifications, or a UNSATISFIED notification if the
+ *     reference is no longer satisfied, to listeners
+ *   else
+ *     send a UNSATISFIED notification to listeners
+ *     clear the #boundRefs member
+ *     copy #matchedRefs to #boundRefs
+ *     if reference is still satisfied
+ *       send a SATISFIED notification to listeners
+ *     endif
+ *   endif
  * endif
  */
 void ReferenceManagerImpl::ServiceRemoved(const cppmicroservices::ServiceReferenceBase& reference)
@@ -273,9 +369,15 @@ void ReferenceManagerImpl::ServiceRemoved(const cppmicroservices::ServiceReferen
     removeBoundRef = (itr != boundRefsHandle->end());
   } // end lock on boundRefs
 
+  if(removeBoundRef && IsDynamic())
+  {
+    LogStructured(*logger, SeverityLevel::LOG_DEBUG, NotifyRebindFormat(), metadata.name);
+    BatchNotifyAllListeners(RebindBoundRefs());
+    return;
+  }
   if(removeBoundRef)
   {
-    logger->Log(SeverityLevel::LOG_DEBUG, "Notify UNSATISFIED for reference " + metadata.name);
+    LogStructured(*logger, SeverityLevel::LOG_DEBUG, NotifyUnsatisfiedFormat(), metadata.name);
     RefChangeNotification notification { metadata.name, RefEvent::BECAME_UNSATISFIED };
     notifications.push_back(std::move(notification));
     {
@@ -285,7 +387,7 @@ void ReferenceManagerImpl::ServiceRemoved(const cppmicroservices::ServiceReferen
     auto notifySatisfied = UpdateBoundRefs();
     if(notifySatisfied)
     {
-      logger->Log(SeverityLevel::LOG_DEBUG, "Notify SATISFIED for reference " + metadata.name);
+      LogStructured(*logger, SeverityLevel::LOG_DEBUG, NotifySatisfiedFormat(), metadata.name);
       RefChangeNotification notification{metadata.name, RefEvent::BECAME_SATISFIED};
       notifications.push_back(std::move(notification));
     }
@@ -162,6 +162,24 @@ private:
    */
   bool UpdateBoundRefs();
 
+  /**
+   * Helper method used for references with dynamic policy. The #boundRefs
+   * are recomputed from #matchedRefs and the difference is reported as
+   * \c REBIND notifications, each pairing a newly bound service with a
+   * service which is no longer bound. The component configuration keeps its
+   * instances and only calls their bind and unbind methods.
+   *
+   * \return the notifications for the listeners. A single \c BECAME_UNSATISFIED
+   *         notification is returned if the reference can no longer be satisfied.
+   */
+  std::vector<RefChangeNotification> RebindBoundRefs();
+
+  /**
+   * Returns true if the bound services of this reference may change
+   * while the component configuration stays active
+   */
+  bool IsDynamic() const { return metadata.policy == "dynamic"; }
+
   /**
    * Helper method called from the ServiceTracker#AddingService
    * callback implemented in this class. This method adds the provided
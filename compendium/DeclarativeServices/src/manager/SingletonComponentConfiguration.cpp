@@ -21,6 +21,10 @@
   =============================================================================*/
 
 #include <iostream>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
 #include "SingletonComponentConfiguration.hpp"
 #include "RegistrationManager.hpp"
@@ -36,11 +40,62 @@ using cppmicroservices::service::component::ComponentConstants::COMPONENT_NAME;
 namespace cppmicroservices {
 namespace scrimpl {
 
+namespace {
+
+/**
+ * Owns one reference to a published interface map. The padding keeps the
+ * reference counts of the holders of different fast path slots apart.
+ */
+struct FastPathHolder
+{
+  explicit FastPathHolder(InterfaceMapConstPtr map) : iMap(std::move(map)) {}
+
+  InterfaceMapConstPtr iMap;
+  char padding[64];
+};
+
+/**
+ * Returns the fast path slot index of the calling thread. Threads are
+ * assigned round robin on their first call.
+ */
+std::size_t GetFastPathSlotIndex()
+{
+  static std::atomic<std::size_t> nextIndex(0);
+  static thread_local const std::size_t index = nextIndex.fetch_add(1);
+  return index;
+}
+
+}
+
+SingletonComponentConfigurationImpl::FastPathSlots::FastPathSlots()
+  : storage(new char[sizeof(FastPathSlot) * FastPathSlotCount + alignof(FastPathSlot) - 1])
+  , slots(nullptr)
+{
+  void* aligned = storage.get();
+  std::size_t space = sizeof(FastPathSlot) * FastPathSlotCount + alignof(FastPathSlot) - 1;
+  std::align(alignof(FastPathSlot), sizeof(FastPathSlot) * FastPathSlotCount, aligned, space);
+  slots = static_cast<FastPathSlot*>(aligned);
+  for(auto& slot : *this)
+  {
+    new (&slot) FastPathSlot();
+  }
+}
+
+SingletonComponentConfigurationImpl::FastPathSlots::~FastPathSlots()
+{
+  for(auto& slot : *this)
+  {
+    slot.~FastPathSlot();
+  }
+}
+
 SingletonComponentConfigurationImpl::SingletonComponentConfigurationImpl(std::shared_ptr<const metadata::ComponentMetadata> metadata,
                                                                          const Bundle& bundle,
                                                                          std::shared_ptr<const ComponentRegistry> registry,
                                                                          std::shared_ptr<cppmicroservices::logservice::LogService> logger)
   : ComponentConfigurationImpl(metadata, bundle, registry, logger)
+  , fastPathEnabled(false)
+  , fastPathPublished(false)
 {
 }
 
@@ -70,6 +125,7 @@ std::shared_ptr<ComponentInstance> SingletonComponentConfigurationImpl::CreateAn
       auto instCtxtTuple = CreateAndActivateComponentInstanceHelper(Bundle());
       instanceContextPair->first = instCtxtTuple.first;
       instanceContextPair->second = instCtxtTuple.second;
+      fastPathEnabled = true;
     }
     catch(...)
     {
@@ -84,6 +140,7 @@ std::shared_ptr<ComponentInstance> SingletonComponentConfigurationImpl::CreateAn
 void SingletonComponentConfigurationImpl::DestroyComponentInstances()
 {
   auto instanceContextPair = data.lock();
+  RetractInterfaceMap();
   try
   {
     if(instanceContextPair->first)
@@ -106,12 +163,45 @@ void SingletonComponentConfigurationImpl::DestroyComponentInstances()
   instanceContextPair->second.reset();
 }
 
+void SingletonComponentConfigurationImpl::RetractCachedServices()
+{
+  auto instanceContextPair = data.lock();
+  fastPathEnabled = false;
+  RetractInterfaceMap();
+}
+
+void SingletonComponentConfigurationImpl::BindReference(const std::string& refName,
+                                                        const ServiceReferenceBase& sRef)
+{
+  auto instanceContextPair = data.lock();
+  BindReferenceToInstance(*instanceContextPair, refName, sRef);
+}
+
+void SingletonComponentConfigurationImpl::UnbindReference(const std::string& refName,
+                                                          const ServiceReferenceBase& sRef)
+{
+  auto instanceContextPair = data.lock();
+  UnbindReferenceFromInstance(*instanceContextPair, refName, sRef);
+}
+
 InterfaceMapConstPtr SingletonComponentConfigurationImpl::GetService(const cppmicroservices::Bundle& bundle,
                                                                      const cppmicroservices::ServiceRegistrationBase& /*registration*/)
 {
+  // fast path: the instance is already active, serve the cached interface map
+  if(auto iMap = GetCachedInterfaceMap())
+  {
+    return iMap;
+  }
+
   // if activation passed, return the interface map from the instance
   auto compInstance = Activate(bundle);
-  return compInstance ? compInstance->GetInterfaceMap() : nullptr;
+  if(!compInstance)
+  {
+    return nullptr;
+  }
+  auto iMap = compInstance->GetInterfaceMap();
+  PublishInterfaceMap(compInstance, iMap);
+  return iMap;
 }
 
 void SingletonComponentConfigurationImpl::UngetService(const cppmicroservices::Bundle& /*bundle*/,
@@ -122,6 +212,55 @@ void SingletonComponentConfigurationImpl::UngetService(const cppmicroservices::B
   // The instance is reset when the component is deactivated.
 }
 
+InterfaceMapConstPtr SingletonComponentConfigurationImpl::GetCachedInterfaceMap()
+{
+  // The slot's reader count must be raised before the flag is loaded. RetractInterfaceMap
+  // clears the flag before it waits for the counts to drop, so a reader either
+  // sees false or is waited for.
+  auto& slot = fastPathSlots[GetFastPathSlotIndex() % FastPathSlotCount];
+  InterfaceMapConstPtr iMap;
+  slot.readers.fetch_add(1);
+  if(fastPathPublished.load())
+  {
+    iMap = slot.iMap;
+  }
+  slot.readers.fetch_sub(1);
+  return iMap;
+}
+
+void SingletonComponentConfigurationImpl::PublishInterfaceMap(const std::shared_ptr<ComponentInstance>& instance,
+                                                              const InterfaceMapConstPtr& iMap)
+{
+  auto instanceContextPair = data.lock();
+  // a concurrent deactivation may already have retracted the map or destroyed the instance
+  if(!iMap || !fastPathEnabled || instanceContextPair->first != instance || fastPathPublished.load())
+  {
+    return;
+  }
+  for(auto& slot : fastPathSlots)
+  {
+    auto holder = std::make_shared<FastPathHolder>(iMap);
+    slot.iMap = InterfaceMapConstPtr(holder, iMap.get());
+  }
+  fastPathPublished.store(true);
+}
+
+void SingletonComponentConfigurationImpl::RetractInterfaceMap()
+{
+  if(!fastPathPublished.exchange(false))
+  {
+    return;
+  }
+  for(auto& slot : fastPathSlots)
+  {
+    while(slot.readers.load() != 0)
+    {
+      std::this_thread::yield();
+    }
+    slot.iMap.reset();
+  }
+}
+
 void SingletonComponentConfigurationImpl::SetComponentInstancePair(InstanceContextPair instCtxtPair)
 {
   auto instanceContextPair = data.lock();
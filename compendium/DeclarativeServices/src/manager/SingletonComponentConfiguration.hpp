@@ -23,6 +23,9 @@
 #ifndef __SINGLETONCOMPONENTCONFIGURATION_HPP__
 #define __SINGLETONCOMPONENTCONFIGURATION_HPP__
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
 #include "ComponentConfigurationImpl.hpp"
 #include "ConcurrencyUtil.hpp"
 
@@ -67,11 +70,32 @@ public:
    */
   void DestroyComponentInstances() /* noexcept */ override;
 
+  /**
+   * Withdraws the cached interface map of the singleton instance. The
+   * instance is served through the state object until it is re-created.
+   */
+  void RetractCachedServices() override;
+
+  /**
+   * Calls the bind method of the active component instance for the
+   * service \c sRef of the reference \c refName
+   */
+  void BindReference(const std::string& refName, const ServiceReferenceBase& sRef) override;
+
+  /**
+   * Calls the unbind method of the active component instance for the
+   * service \c sRef of the reference \c refName
+   */
+  void UnbindReference(const std::string& refName, const ServiceReferenceBase& sRef) override;
+
   /**
    * Implements the {@link ServiceFactory#GetService} interface. This method
    * wraps the service implementation object in an {@link InterfaceMapConstPtr}
    * This method always returns the same service implementation object.
    * A nullptr is returned if a service instance cannot be created or activated.
+   *
+   * Once the singleton instance is active, its interface map is cached and
+   * subsequent calls return it without going through the state object.
    */
   cppmicroservices::InterfaceMapConstPtr GetService(const cppmicroservices::Bundle& bundle,
                                                     const cppmicroservices::ServiceRegistrationBase& registration) override;
@@ -89,6 +113,9 @@ private:
   FRIEND_TEST(SingletonComponentConfigurationTest, TestDestroyComponentInstances);
   FRIEND_TEST(SingletonComponentConfigurationTest, TestGetService);
   FRIEND_TEST(SingletonComponentConfigurationTest, TestDestroyComponentInstances_DeactivateFailure);
+  FRIEND_TEST(SingletonComponentConfigurationTest, TestGetServiceFastPath);
+  FRIEND_TEST(SingletonComponentConfigurationTest, TestGetServiceDuringDeactivation);
+  FRIEND_TEST(SingletonComponentConfigurationTest, TestConcurrentGetServiceFastPath);
 
   /**
    * Set the member data, only used in tests
@@ -105,7 +132,69 @@ private:
    */
   std::shared_ptr<ComponentInstance> GetComponentInstance();
 
+  /**
+   * Returns the cached interface map of the active singleton instance, or
+   * nullptr if none is published. This method never blocks.
+   */
+  InterfaceMapConstPtr GetCachedInterfaceMap();
+
+  /**
+   * Publishes \c iMap as the cached interface map, provided \c instance is
+   * still the current singleton instance and nothing is published yet.
+   */
+  void PublishInterfaceMap(const std::shared_ptr<ComponentInstance>& instance,
+                           const InterfaceMapConstPtr& iMap);
+
+  /**
+   * Withdraws the cached interface map and waits for in-flight readers
+   * to finish copying it. Must be called with the \c data lock held.
+   */
+  void RetractInterfaceMap();
+
+  static constexpr std::size_t FastPathSlotCount = 8;
+
+  /**
+   * A reader slot of the fast path. Each slot holds its own copy of the
+   * published interface map, backed by a control block of its own, so that
+   * readers on different slots touch neither a shared counter nor a shared
+   * reference count. Each slot occupies a cache line of its own.
+   */
+  struct alignas(64) FastPathSlot
+  {
+    std::atomic<unsigned long> readers; ///< number of threads currently copying \c iMap
+    InterfaceMapConstPtr iMap; ///< aliases the published interface map, only modified while holding the \c data lock
+
+    FastPathSlot() : readers(0) {}
+  };
+  static_assert(alignof(FastPathSlot) == 64 && sizeof(FastPathSlot) == 64,
+                "a fast path slot must fill exactly one cache line");
+
+  /**
+   * The fast path slots. They live in a separate, 64 byte aligned allocation
+   * because std::make_shared does not honour the alignment of FastPathSlot
+   * before C++17.
+   */
+  class FastPathSlots
+  {
+  public:
+    FastPathSlots();
+    FastPathSlots(const FastPathSlots&) = delete;
+    FastPathSlots& operator=(const FastPathSlots&) = delete;
+    ~FastPathSlots();
+
+    FastPathSlot& operator[](std::size_t index) { return slots[index]; }
+    FastPathSlot* begin() { return slots; }
+    FastPathSlot* end() { return slots + FastPathSlotCount; }
+
+  private:
+    std::unique_ptr<char[]> storage;
+    FastPathSlot* slots;
+  };
+
   Guarded<InstanceContextPair> data; ///< singleton pair of component instance and context associated with this configuration
+  bool fastPathEnabled; ///< false once the cached interface map was retracted for a deactivation, only accessed while holding the \c data lock
+  std::atomic<bool> fastPathPublished; ///< true while the slots hold the interface map of the active instance
+  FastPathSlots fastPathSlots;
 };
 }
 }
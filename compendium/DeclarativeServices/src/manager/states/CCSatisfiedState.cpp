@@ -38,6 +38,9 @@ void CCSatisfiedState::Deactivate(ComponentConfigurationImpl& mgr)
                                         mgr.DestroyComponentInstances();
                                       });
   auto unsatisfiedState = std::make_shared<CCUnsatisfiedReferenceState>(task.get_future().share());
+  // stop serving cached service objects before the state is swapped, callers
+  // must not get an instance which is about to be deactivated
+  mgr.RetractCachedServices();
   while(currentState->GetValue() != service::component::runtime::dto::UNSATISFIED_REFERENCE)
   {
     if(mgr.CompareAndSetState(&currentState, unsatisfiedState))
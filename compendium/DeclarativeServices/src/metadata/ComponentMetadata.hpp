@@ -56,6 +56,7 @@ struct ComponentMetadata
   std::vector<ReferenceMetadata> refsMetadata;
   ServiceMetadata serviceMetadata;
   std::unordered_map<std::string, cppmicroservices::Any> properties;
+  std::size_t instancePoolSize{0}; // max number of released prototype instances kept for reuse per bundle, 0 disables pooling
 };
 }
 }
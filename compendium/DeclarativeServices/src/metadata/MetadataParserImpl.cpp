@@ -146,6 +146,22 @@ MetadataParserImplV1::CreateComponentMetadata(const AnyMap& metadata) const
     compMetadata->refsMetadata = CreateReferenceMetadatas(object.GetValue<std::vector<cppmicroservices::Any>>());
   }
 
+  // component.instance-pool-size
+  object = ObjectValidator(metadata, "instance-pool-size", /*isOptional=*/true);
+  if (object.KeyExists())
+  {
+    const auto poolSize = object.GetValue<int>();
+    if(poolSize < 0)
+    {
+      throw std::runtime_error("Invalid value specified for the name 'instance-pool-size'. Expected a non-negative integer.");
+    }
+    if(poolSize > 0 && compMetadata->serviceMetadata.scope != cppmicroservices::Constants::SCOPE_PROTOTYPE)
+    {
+      throw std::runtime_error("The name 'instance-pool-size' is only valid for components with prototype service scope.");
+    }
+    compMetadata->instancePoolSize = static_cast<std::size_t>(poolSize);
+  }
+
   return compMetadata;
 }
 
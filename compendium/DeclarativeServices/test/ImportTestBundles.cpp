@@ -24,6 +24,7 @@ CPPMICROSERVICES_INITIALIZE_STATIC_BUNDLE(TestBundleDSTOI2)
 CPPMICROSERVICES_INITIALIZE_STATIC_BUNDLE(TestBundleDSTOI3)
 CPPMICROSERVICES_INITIALIZE_STATIC_BUNDLE(TestBundleDSTOI5)
 CPPMICROSERVICES_INITIALIZE_STATIC_BUNDLE(TestBundleDSTOI6)
+CPPMICROSERVICES_INITIALIZE_STATIC_BUNDLE(TestBundleDSTOI8)
 CPPMICROSERVICES_INITIALIZE_STATIC_BUNDLE(TestBundleDSTOI9)
 CPPMICROSERVICES_IMPORT_BUNDLE(declarative_services)
 #endif
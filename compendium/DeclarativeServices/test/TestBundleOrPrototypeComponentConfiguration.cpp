@@ -0,0 +1,254 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkFactory.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "Mocks.hpp"
+#include "TestUtils.hpp"
+#include "../src/manager/BundleOrPrototypeComponentConfiguration.hpp"
+#include "../src/manager/states/CCActiveState.hpp"
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+class BundleOrPrototypeComponentConfigurationTest
+  : public ::testing::Test
+{
+protected:
+  BundleOrPrototypeComponentConfigurationTest() : framework(cppmicroservices::FrameworkFactory().NewFramework())
+  { }
+
+  virtual ~BundleOrPrototypeComponentConfigurationTest() = default;
+
+  virtual void SetUp()
+  {
+    framework.Start();
+  }
+
+  virtual void TearDown()
+  {
+    obj.reset();
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  /**
+   * Creates a prototype scoped configuration. The tests activate it using
+   * the mock instance factory from #CreateInstance and #DeleteInstance.
+   */
+  void CreateConfiguration(std::size_t instancePoolSize)
+  {
+    auto mockMetadata = std::make_shared<metadata::ComponentMetadata>();
+    mockMetadata->serviceMetadata.scope = cppmicroservices::Constants::SCOPE_PROTOTYPE;
+    mockMetadata->instancePoolSize = instancePoolSize;
+    auto mockRegistry = std::make_shared<MockComponentRegistry>();
+    auto fakeLogger = std::make_shared<FakeLogger>();
+    obj = std::make_shared<BundleOrPrototypeComponentConfigurationImpl>(mockMetadata,
+                                                                        framework,
+                                                                        mockRegistry,
+                                                                        fakeLogger);
+  }
+
+  ComponentInstance* CreateInstance()
+  {
+    auto instance = new testing::NiceMock<MockComponentInstance>();
+    auto implObj = std::make_shared<int>(++createdInstances);
+    ON_CALL(*instance, GetInterfaceMap())
+      .WillByDefault(testing::Invoke([implObj]() {
+                                       return std::make_shared<InterfaceMap>(InterfaceMap{{"", implObj}});
+                                     }));
+    ON_CALL(*instance, Deactivate())
+      .WillByDefault(testing::Invoke([this]() { ++deactivatedInstances; }));
+    return instance;
+  }
+
+  static void DeleteInstance(ComponentInstance* instance)
+  {
+    delete instance;
+  }
+
+  /**
+   * Installs and starts a bundle used as a second consumer of the
+   * configuration's service.
+   */
+  cppmicroservices::Bundle StartConsumerBundle()
+  {
+    auto context = framework.GetBundleContext();
+    test::InstallLib(context, "TestBundleDSTOI1");
+    for(auto& bundle : context.GetBundles())
+    {
+      if(bundle.GetSymbolicName() == "TestBundleDSTOI1")
+      {
+        bundle.Start();
+        return bundle;
+      }
+    }
+    return cppmicroservices::Bundle();
+  }
+
+  cppmicroservices::InterfaceMapConstPtr GetService()
+  {
+    return GetService(framework);
+  }
+
+  cppmicroservices::InterfaceMapConstPtr GetService(const cppmicroservices::Bundle& consumer)
+  {
+    return obj->GetService(consumer, ServiceRegistrationU());
+  }
+
+  void UngetService(const cppmicroservices::InterfaceMapConstPtr& service)
+  {
+    UngetService(framework, service);
+  }
+
+  void UngetService(const cppmicroservices::Bundle& consumer,
+                    const cppmicroservices::InterfaceMapConstPtr& service)
+  {
+    obj->UngetService(consumer, ServiceRegistrationU(), service);
+  }
+
+  cppmicroservices::Framework framework;
+  std::shared_ptr<BundleOrPrototypeComponentConfigurationImpl> obj;
+  int createdInstances = 0;
+  int deactivatedInstances = 0;
+};
+
+TEST_F(BundleOrPrototypeComponentConfigurationTest, TestInstancePoolDisabled)
+{
+  CreateConfiguration(0);
+  obj->SetState(std::make_shared<CCActiveState>());
+  obj->SetComponentInstanceCreateDeleteMethods([this]() { return CreateInstance(); }, &DeleteInstance);
+  auto service = GetService();
+  ASSERT_NE(service, nullptr);
+  UngetService(service);
+  EXPECT_EQ(deactivatedInstances, 1) << "instance must be deactivated when it is released";
+  auto service1 = GetService();
+  EXPECT_EQ(createdInstances, 2) << "a new instance must be created for every request";
+  EXPECT_EQ(obj->GetInstancePoolStats().hits, 0ul);
+  EXPECT_EQ(obj->GetInstancePoolStats().misses, 0ul);
+}
+
+TEST_F(BundleOrPrototypeComponentConfigurationTest, TestInstancePoolReuse)
+{
+  CreateConfiguration(1);
+  obj->SetState(std::make_shared<CCActiveState>());
+  obj->SetComponentInstanceCreateDeleteMethods([this]() { return CreateInstance(); }, &DeleteInstance);
+  auto service = GetService();
+  ASSERT_NE(service, nullptr);
+  auto implObj = ExtractInterface(service, "");
+  UngetService(service);
+  EXPECT_EQ(deactivatedInstances, 0) << "released instance must stay active in the pool";
+  EXPECT_EQ(obj->instancePool.lock()->instances.at(framework.GetBundleId()).size(), 1ul);
+
+  auto service1 = GetService();
+  EXPECT_EQ(ExtractInterface(service1, ""), implObj) << "pooled instance must be reused";
+  EXPECT_EQ(createdInstances, 1);
+  EXPECT_TRUE(obj->instancePool.lock()->instances.empty());
+  EXPECT_EQ(obj->GetInstancePoolStats().hits, 1ul);
+  EXPECT_EQ(obj->GetInstancePoolStats().misses, 1ul);
+
+  // pooled instances are deactivated with the configuration
+  UngetService(service1);
+  obj->DestroyComponentInstances();
+  EXPECT_EQ(deactivatedInstances, 1);
+  EXPECT_TRUE(obj->instancePool.lock()->instances.empty());
+}
+
+TEST_F(BundleOrPrototypeComponentConfigurationTest, TestInstancePoolLimit)
+{
+  CreateConfiguration(2);
+  obj->SetState(std::make_shared<CCActiveState>());
+  obj->SetComponentInstanceCreateDeleteMethods([this]() { return CreateInstance(); }, &DeleteInstance);
+  std::vector<cppmicroservices::InterfaceMapConstPtr> services;
+  for(int i = 0; i < 4; ++i)
+  {
+    services.push_back(GetService());
+  }
+  for(auto& service : services)
+  {
+    UngetService(service);
+  }
+  EXPECT_EQ(obj->instancePool.lock()->instances.at(framework.GetBundleId()).size(), 2ul) << "pool must not grow beyond instance-pool-size";
+  EXPECT_EQ(deactivatedInstances, 2) << "instances released to a full pool must be deactivated";
+
+  services.clear();
+  for(int i = 0; i < 3; ++i)
+  {
+    services.push_back(GetService());
+  }
+  EXPECT_EQ(createdInstances, 5);
+  EXPECT_EQ(obj->GetInstancePoolStats().hits, 2ul);
+  EXPECT_EQ(obj->GetInstancePoolStats().misses, 5ul);
+}
+
+TEST_F(BundleOrPrototypeComponentConfigurationTest, TestInstancePoolLimitPerBundle)
+{
+  CreateConfiguration(1);
+  obj->SetState(std::make_shared<CCActiveState>());
+  obj->SetComponentInstanceCreateDeleteMethods([this]() { return CreateInstance(); }, &DeleteInstance);
+  auto consumer = StartConsumerBundle();
+  ASSERT_TRUE(static_cast<bool>(consumer));
+  auto service = GetService();
+  auto consumerService = GetService(consumer);
+  auto consumerImplObj = ExtractInterface(consumerService, "");
+  UngetService(service);
+  UngetService(consumer, consumerService);
+  EXPECT_EQ(deactivatedInstances, 0) << "each bundle must have its own pool";
+  EXPECT_EQ(obj->instancePool.lock()->instances.at(framework.GetBundleId()).size(), 1ul);
+  EXPECT_EQ(obj->instancePool.lock()->instances.at(consumer.GetBundleId()).size(), 1ul);
+
+  auto consumerService1 = GetService(consumer);
+  EXPECT_EQ(ExtractInterface(consumerService1, ""), consumerImplObj) << "instance pooled for the bundle must be reused";
+  EXPECT_EQ(createdInstances, 2);
+  EXPECT_EQ(obj->instancePool.lock()->instances.at(framework.GetBundleId()).size(), 1ul);
+  EXPECT_EQ(obj->instancePool.lock()->instances.count(consumer.GetBundleId()), 0ul);
+}
+
+TEST_F(BundleOrPrototypeComponentConfigurationTest, TestInstancePoolDrainedOnBundleStop)
+{
+  CreateConfiguration(2);
+  obj->SetState(std::make_shared<CCActiveState>());
+  obj->SetComponentInstanceCreateDeleteMethods([this]() { return CreateInstance(); }, &DeleteInstance);
+  auto consumer = StartConsumerBundle();
+  ASSERT_TRUE(static_cast<bool>(consumer));
+  std::vector<cppmicroservices::InterfaceMapConstPtr> consumerServices;
+  for(int i = 0; i < 2; ++i)
+  {
+    consumerServices.push_back(GetService(consumer));
+  }
+  auto service = GetService();
+  for(auto& consumerService : consumerServices)
+  {
+    UngetService(consumer, consumerService);
+  }
+  UngetService(service);
+  EXPECT_EQ(deactivatedInstances, 0);
+
+  consumer.Stop();
+  EXPECT_EQ(deactivatedInstances, 2) << "instances pooled for a stopped bundle must be deactivated";
+  EXPECT_EQ(obj->instancePool.lock()->instances.count(consumer.GetBundleId()), 0ul);
+  EXPECT_EQ(obj->instancePool.lock()->instances.at(framework.GetBundleId()).size(), 1ul) << "instances pooled for other bundles must be kept";
+}
+
+}
+}
@@ -198,6 +198,35 @@ TEST_F(ComponentConfigurationImplTest, VerifyRefUnsatisfied)
   fakeCompConfig->referenceManagers.clear(); // remove the mock reference managers
 }
 
+TEST_F(ComponentConfigurationImplTest, VerifyRefRebind)
+{
+  auto mockMetadata = std::make_shared<metadata::ComponentMetadata>();
+  auto mockRegistry = std::make_shared<MockComponentRegistry>();
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  auto fakeCompConfig = std::make_shared<MockComponentConfigurationImpl>(mockMetadata,
+                                                                         GetFramework(),
+                                                                         mockRegistry,
+                                                                         fakeLogger);
+  auto bc = GetFramework().GetBundleContext();
+  auto reg = bc.RegisterService<dummy::Reference1>(std::make_shared<dummy::Reference1>());
+  auto reg1 = bc.RegisterService<dummy::Reference1>(std::make_shared<dummy::Reference1>());
+  ServiceReferenceBase refToBind = reg1.GetReference();
+  ServiceReferenceBase refToUnbind = reg.GetReference();
+  {
+    // the replacement is bound before the replaced service is unbound
+    testing::InSequence dummy;
+    EXPECT_CALL(*fakeCompConfig, BindReference("ref1", refToBind)).Times(1);
+    EXPECT_CALL(*fakeCompConfig, UnbindReference("ref1", refToUnbind)).Times(1);
+  }
+  fakeCompConfig->RefChangedState(RefChangeNotification{"ref1", RefEvent::REBIND, reg1.GetReference(), reg.GetReference()});
+  EXPECT_EQ(fakeCompConfig->GetConfigState(), ComponentState::UNSATISFIED_REFERENCE) << "a rebind must not change the state";
+
+  // notifications carrying only one of the references
+  EXPECT_CALL(*fakeCompConfig, BindReference("ref1", refToBind)).Times(1);
+  EXPECT_CALL(*fakeCompConfig, UnbindReference(testing::_, testing::_)).Times(0);
+  fakeCompConfig->RefChangedState(RefChangeNotification{"ref1", RefEvent::REBIND, reg1.GetReference(), ServiceReferenceU()});
+}
+
 TEST_F(ComponentConfigurationImplTest, VerifyRefChangedState)
 {
   std::cout << "unimplemented testpoint" << std::endl;
@@ -327,6 +327,83 @@ TEST_F(ComponentContextImplTest, VerifyLocateServiceWithHighestRank)
     });
 }
 
+TEST_F(ComponentContextImplTest, VerifyBoundServicesCacheUpdate)
+{
+  auto mockConfig = std::make_shared<MockComponentConfiguration>();
+  auto mockRefMgrFoo = std::make_shared<MockReferenceManager>();
+  auto fooServ = std::make_shared<test::Foo>();
+  auto reg = GetFramework().GetBundleContext().RegisterService<test::Foo>(fooServ);
+  std::set<cppmicroservices::ServiceReferenceBase> refsSet{ reg.GetReference() };
+  EXPECT_CALL(*mockRefMgrFoo, GetBoundReferences())
+    .WillRepeatedly(testing::Return(refsSet));
+  EXPECT_CALL(*mockRefMgrFoo, GetReferenceName())
+    .WillRepeatedly(testing::Return("foo"));
+  EXPECT_CALL(*mockRefMgrFoo, GetReferenceScope())
+    .WillRepeatedly(testing::Return(cppmicroservices::Constants::SCOPE_BUNDLE));
+  EXPECT_CALL(*mockConfig, GetBundle())
+    .WillRepeatedly(testing::Return(GetFramework()));
+  std::vector<std::shared_ptr<ReferenceManager>> depMgrs{mockRefMgrFoo};
+  EXPECT_CALL(*mockConfig, GetAllDependencyManagers())
+    .WillRepeatedly(testing::Return(depMgrs));
+  EXPECT_CALL(*mockConfig, GetDependencyManager("foo"))
+    .WillRepeatedly(testing::Return(mockRefMgrFoo));
+  auto ctxtImpl = std::make_shared<ComponentContextImpl>(mockConfig);
+  std::shared_ptr<ComponentContext> ctxt = ctxtImpl;
+
+  auto fooServ1 = std::make_shared<test::Foo>();
+  auto reg1 = GetFramework().GetBundleContext().RegisterService<test::Foo>(fooServ1, {{cppmicroservices::Constants::SERVICE_RANKING, 20}});
+  auto boundService = ctxtImpl->AddToBoundServicesCache("foo", reg1.GetReference());
+  EXPECT_NE(boundService, nullptr);
+  EXPECT_EQ(ctxtImpl->AddToBoundServicesCache("foo", reg1.GetReference()), nullptr) << "a service must only be bound once";
+  EXPECT_EQ(ctxt->LocateService<test::Foo>("foo"), fooServ1) << "the best ranked service must be located";
+  EXPECT_EQ(ctxt->LocateServices<test::Foo>("foo").size(), 2ul);
+
+  EXPECT_EQ(ctxtImpl->RemoveFromBoundServicesCache("foo", reg1.GetReference()), boundService) << "the bound service object must be returned";
+  EXPECT_EQ(ctxtImpl->RemoveFromBoundServicesCache("foo", reg1.GetReference()), nullptr) << "a service must only be unbound once";
+  EXPECT_EQ(ctxt->LocateService<test::Foo>("foo"), fooServ);
+  EXPECT_EQ(ctxtImpl->RemoveFromBoundServicesCache("bar", reg.GetReference()), nullptr);
+}
+
+TEST_F(ComponentContextImplTest, VerifyBoundServicesCacheUpdateWithPrototypeScope)
+{
+  // every GetService call on a prototype scope service returns a new object,
+  // the object added to the cache must be the one located through the context
+  auto mockServiceFactory = std::make_shared<MockFactory>();
+  EXPECT_CALL(*mockServiceFactory, GetService(testing::_, testing::_))
+    .WillRepeatedly(testing::Invoke([](const cppmicroservices::Bundle&,
+                                       const cppmicroservices::ServiceRegistrationBase&) {
+                                      InterfaceMapConstPtr iMap = MakeInterfaceMap<dummy::ServiceImpl>(std::make_shared<dummy::ServiceImpl>());
+                                      return iMap;
+                                    }));
+  EXPECT_CALL(*mockServiceFactory, UngetService(testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+  auto reg = GetFramework().GetBundleContext().RegisterService<dummy::ServiceImpl>(ToFactory(mockServiceFactory),
+                                                                                   {{cppmicroservices::Constants::SERVICE_SCOPE, Any(SCOPE_PROTOTYPE)}});
+
+  auto mockConfig = std::make_shared<MockComponentConfiguration>();
+  auto mockRefMgrFoo = std::make_shared<MockReferenceManager>();
+  EXPECT_CALL(*mockRefMgrFoo, GetBoundReferences())
+    .WillRepeatedly(testing::Return(std::set<cppmicroservices::ServiceReferenceBase>()));
+  EXPECT_CALL(*mockRefMgrFoo, GetReferenceName())
+    .WillRepeatedly(testing::Return("foo"));
+  EXPECT_CALL(*mockRefMgrFoo, GetReferenceScope())
+    .WillRepeatedly(testing::Return(REFERENCE_SCOPE_PROTOTYPE_REQUIRED));
+  EXPECT_CALL(*mockConfig, GetBundle())
+    .WillRepeatedly(testing::Return(GetFramework()));
+  std::vector<std::shared_ptr<ReferenceManager>> depMgrs{mockRefMgrFoo};
+  EXPECT_CALL(*mockConfig, GetAllDependencyManagers())
+    .WillRepeatedly(testing::Return(depMgrs));
+  EXPECT_CALL(*mockConfig, GetDependencyManager("foo"))
+    .WillRepeatedly(testing::Return(mockRefMgrFoo));
+  auto ctxtImpl = std::make_shared<ComponentContextImpl>(mockConfig);
+  std::shared_ptr<ComponentContext> ctxt = ctxtImpl;
+
+  auto boundService = ctxtImpl->AddToBoundServicesCache("foo", reg.GetReference());
+  ASSERT_NE(boundService, nullptr);
+  EXPECT_EQ(ctxt->LocateService<dummy::ServiceImpl>("foo"),
+            cppmicroservices::ExtractInterface<dummy::ServiceImpl>(boundService));
+  EXPECT_EQ(ctxtImpl->RemoveFromBoundServicesCache("foo", reg.GetReference()), boundService);
+}
+
 TEST_F(ComponentContextImplTest, VerifyLocateServiceWithLowestId)
 {
   auto mockConfig = std::make_shared<MockComponentConfiguration>();
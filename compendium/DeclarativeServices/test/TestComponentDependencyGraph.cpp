@@ -0,0 +1,209 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "../src/ComponentDependencyGraph.hpp"
+#include "../src/metadata/ComponentMetadata.hpp"
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+using metadata::ComponentMetadata;
+using metadata::ReferenceMetadata;
+
+namespace {
+
+std::shared_ptr<ComponentMetadata> MakeComponent(const std::string& name,
+                                                 const std::vector<std::string>& provides,
+                                                 const std::vector<std::string>& references,
+                                                 std::size_t minCardinality = 1)
+{
+  auto compMetadata = std::make_shared<ComponentMetadata>();
+  compMetadata->name = name;
+  compMetadata->serviceMetadata.interfaces = provides;
+  for (auto const& interfaceName : references)
+  {
+    ReferenceMetadata refMetadata;
+    refMetadata.name = interfaceName;
+    refMetadata.interfaceName = interfaceName;
+    refMetadata.minCardinality = minCardinality;
+    compMetadata->refsMetadata.push_back(refMetadata);
+  }
+  return compMetadata;
+}
+
+std::vector<std::vector<std::string>> GetBatchNames(const ComponentDependencyGraph& graph)
+{
+  std::vector<std::vector<std::string>> names;
+  for (auto const& batch : graph.GetEnableBatches())
+  {
+    names.emplace_back();
+    for (auto const& compMetadata : batch)
+    {
+      names.back().push_back(compMetadata->name);
+    }
+  }
+  return names;
+}
+
+}
+
+TEST(ComponentDependencyGraphTest, TestEmptyGraph)
+{
+  ComponentDependencyGraph graph({});
+  EXPECT_TRUE(graph.GetEnableBatches().empty());
+  EXPECT_TRUE(graph.GetCycles().empty());
+}
+
+TEST(ComponentDependencyGraphTest, TestTreeIsEnabledBottomUp)
+{
+  // same shape as the DSGraph test bundles, listed consumers first
+  ComponentDependencyGraph graph({ MakeComponent("g01", { "DSGraph01" }, { "DSGraph02", "DSGraph03" }),
+                                   MakeComponent("g02", { "DSGraph02" }, { "DSGraph04", "DSGraph05" }),
+                                   MakeComponent("g03", { "DSGraph03" }, { "DSGraph06", "DSGraph07" }),
+                                   MakeComponent("g04", { "DSGraph04" }, {}),
+                                   MakeComponent("g05", { "DSGraph05" }, { "DSGraph06" }),
+                                   MakeComponent("g06", { "DSGraph06" }, { "DSGraph07" }),
+                                   MakeComponent("g07", { "DSGraph07" }, {}) });
+  std::vector<std::vector<std::string>> expected{ { "g04", "g07" },
+                                                  { "g06" },
+                                                  { "g03", "g05" },
+                                                  { "g02" },
+                                                  { "g01" } };
+  EXPECT_EQ(GetBatchNames(graph), expected);
+  EXPECT_EQ(graph.GetBatchIndices(), (std::vector<std::size_t>{ 4, 3, 2, 0, 2, 1, 0 }));
+  EXPECT_TRUE(graph.GetCycles().empty());
+}
+
+TEST(ComponentDependencyGraphTest, TestExternalAndOptionalReferencesAreIgnored)
+{
+  ComponentDependencyGraph graph({ MakeComponent("consumer", {}, { "Provided" }),
+                                   MakeComponent("optional", {}, { "Provided" }, 0),
+                                   MakeComponent("external", { "Provided" }, { "NotInGraph" }) });
+  std::vector<std::vector<std::string>> expected{ { "optional", "external" }, { "consumer" } };
+  EXPECT_EQ(GetBatchNames(graph), expected);
+}
+
+TEST(ComponentDependencyGraphTest, TestAnyProviderSatisfiesReference)
+{
+  // the reference is satisfiable as soon as the first provider is enabled
+  ComponentDependencyGraph graph({ MakeComponent("consumer", {}, { "Service" }),
+                                   MakeComponent("slowProvider", { "Service" }, { "Other" }),
+                                   MakeComponent("fastProvider", { "Service" }, {}),
+                                   MakeComponent("other", { "Other" }, {}) });
+  std::vector<std::vector<std::string>> expected{ { "fastProvider", "other" }, { "consumer", "slowProvider" } };
+  EXPECT_EQ(GetBatchNames(graph), expected);
+}
+
+TEST(ComponentDependencyGraphTest, TestLongChain)
+{
+  // every component of the chain gets a batch of its own, listed consumers first
+  const std::size_t length = 2000;
+  std::vector<ComponentDependencyGraph::ComponentMetadataPtr> components;
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    std::vector<std::string> references;
+    if (i + 1 < length)
+    {
+      references.push_back("Chain" + std::to_string(i + 1));
+    }
+    components.push_back(MakeComponent("c" + std::to_string(i), { "Chain" + std::to_string(i) }, references));
+  }
+  ComponentDependencyGraph graph(components);
+  auto const& batchIndices = graph.GetBatchIndices();
+  ASSERT_EQ(batchIndices.size(), length);
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    EXPECT_EQ(batchIndices[i], length - 1 - i);
+  }
+  EXPECT_TRUE(graph.GetCycles().empty());
+}
+
+TEST(ComponentDependencyGraphTest, TestCycles)
+{
+  ComponentDependencyGraph graph({ MakeComponent("a", { "A" }, { "B" }),
+                                   MakeComponent("b", { "B" }, { "C" }),
+                                   MakeComponent("c", { "C" }, { "A" }),
+                                   MakeComponent("behindCycle", {}, { "A" }),
+                                   MakeComponent("self", { "Self" }, { "Self" }),
+                                   MakeComponent("free", { "Free" }, {}) });
+  std::vector<std::vector<std::string>> expectedBatches{ { "free" }, { "a", "b", "c", "behindCycle", "self" } };
+  EXPECT_EQ(GetBatchNames(graph), expectedBatches);
+
+  auto cycles = graph.GetCycles();
+  ASSERT_EQ(cycles.size(), 2u);
+  for (auto& cycle : cycles)
+  {
+    std::sort(cycle.begin(), cycle.end());
+  }
+  std::sort(cycles.begin(), cycles.end());
+  std::vector<std::vector<std::string>> expectedCycles{ { "a", "b", "c" }, { "self" } };
+  EXPECT_EQ(cycles, expectedCycles);
+}
+
+TEST(ComponentDependencyGraphTest, TestOwnersOfProvidersComeFirst)
+{
+  // Bundle 0 mixes an early provider "p" with a late consumer "c". Bundle 1
+  // only needs "p", so it must come right after bundle 0 and not after the
+  // bundles 2 and 3 which "c" waits for.
+  ComponentDependencyGraph graph({ MakeComponent("q", { "Q" }, { "P" }),
+                                   MakeComponent("p", { "P" }, {}),
+                                   MakeComponent("c", {}, { "S" }),
+                                   MakeComponent("s", { "S" }, { "T" }),
+                                   MakeComponent("t", { "T" }, {}) });
+  std::vector<std::size_t> owners{ 1, 0, 0, 3, 2 };
+  EXPECT_EQ(graph.GetBatchIndices(), (std::vector<std::size_t>{ 1, 0, 2, 1, 0 }));
+  std::vector<std::vector<std::size_t>> expected{ { 2 }, { 3 }, { 0 }, { 1 } };
+  EXPECT_EQ(graph.GetOwnerGroups(owners, 4), expected);
+}
+
+TEST(ComponentDependencyGraphTest, TestOwnersKeepTheirOrderAndOwnProviders)
+{
+  // bundle 1 provides "Shared" itself, so it does not wait for bundle 2
+  ComponentDependencyGraph graph({ MakeComponent("free", {}, {}),
+                                   MakeComponent("consumer", {}, { "Shared" }),
+                                   MakeComponent("ownProvider", { "Shared" }, {}),
+                                   MakeComponent("otherProvider", { "Shared" }, {}) });
+  std::vector<std::vector<std::size_t>> expected{ { 0 }, { 1 }, { 2 } };
+  EXPECT_EQ(graph.GetOwnerGroups({ 0, 1, 1, 2 }, 3), expected);
+}
+
+TEST(ComponentDependencyGraphTest, TestOwnersReferencingEachOtherAreGrouped)
+{
+  // bundles 0 and 1 need each other's providers, bundle 2 needs both
+  ComponentDependencyGraph graph({ MakeComponent("a", { "A" }, {}),
+                                   MakeComponent("b", {}, { "C" }),
+                                   MakeComponent("c", { "C" }, { "A" }),
+                                   MakeComponent("d", {}, { "A", "C" }) });
+  std::vector<std::vector<std::size_t>> expected{ { 0, 1 }, { 2 } };
+  EXPECT_EQ(graph.GetOwnerGroups({ 0, 0, 1, 2 }, 3), expected);
+  // the combined components are still enabled providers first
+  std::vector<std::vector<std::string>> expectedBatches{ { "a" }, { "c" }, { "b", "d" } };
+  EXPECT_EQ(GetBatchNames(graph), expectedBatches);
+}
+
+}
+}
@@ -24,6 +24,7 @@
 #include "TestFixture.hpp"
 #include "TestUtils.hpp"
 #include "TestInterfaces/Interfaces.hpp"
+#include "cppmicroservices/Constants.h"
 #include "cppmicroservices/ServiceEvent.h"
 
 namespace sc  = cppmicroservices::service::component;
@@ -186,6 +187,67 @@ TEST_F(tServiceComponent, testImmediateComponent_LifeCycle_Dynamic) // DS_TOI_51
   EXPECT_FALSE(static_cast<bool>(sRef2)) << "Service must not be available after it's dependency is removed";
 }
 
+namespace
+{
+class RankedInterface1 : public test::Interface1
+{
+public:
+  explicit RankedInterface1(std::string desc) : description(std::move(desc)) {}
+  std::string Description() override { return description; }
+private:
+  std::string description;
+};
+}
+
+/**
+ * verify that a dynamic greedy reference is rebound to a higher ranked
+ * service, and back again, without reactivating the component
+ */
+TEST_F(tServiceComponent, testImmediateComponent_DynamicGreedyRebind)
+{
+  auto ctxt = framework.GetBundleContext();
+  auto lowReg = ctxt.RegisterService<test::Interface1>(std::make_shared<RankedInterface1>("low"),
+                                                       {{ cppmicroservices::Constants::SERVICE_RANKING, cppmicroservices::Any(1) }});
+  auto testBundle = StartTestBundle("TestBundleDSTOI8");
+  auto compDescDTO = dsRuntimeService->GetComponentDescriptionDTO(testBundle, "sample::ServiceComponent8");
+  std::vector<scr::dto::ComponentConfigurationDTO> compConfigDTOs;
+  auto result = RepeatTaskUntilOrTimeout([&compConfigDTOs, service = this->dsRuntimeService, &compDescDTO]() {
+                                           compConfigDTOs = service->GetComponentConfigurationDTOs(compDescDTO);
+                                         },
+    [&compConfigDTOs]()->bool {
+      return compConfigDTOs.size() == 1 && compConfigDTOs.at(0).state == scr::dto::ComponentState::ACTIVE;
+    });
+  ASSERT_TRUE(result) << "Timed out waiting for state to change to ACTIVE";
+
+  auto sRef = ctxt.GetServiceReference<test::Interface2>();
+  ASSERT_TRUE(static_cast<bool>(sRef));
+  auto serviceId = test::GetServiceId(sRef);
+  auto service = ctxt.GetService<test::Interface2>(sRef);
+  ASSERT_NE(service, nullptr);
+  EXPECT_EQ(service->ExtendedDescription(), "low");
+
+  auto waitForDescription = [&service](const std::string& expected) {
+    std::string actual;
+    return RepeatTaskUntilOrTimeout([&]() {
+                                      try { actual = service->ExtendedDescription(); }
+                                      catch (const std::exception&) { actual.clear(); }
+                                    },
+                                    [&]()->bool { return actual == expected; });
+  };
+
+  auto highReg = ctxt.RegisterService<test::Interface1>(std::make_shared<RankedInterface1>("high"),
+                                                        {{ cppmicroservices::Constants::SERVICE_RANKING, cppmicroservices::Any(10) }});
+  EXPECT_TRUE(waitForDescription("high")) << "Greedy reference must rebind to the higher ranked service";
+  EXPECT_EQ(test::GetServiceId(ctxt.GetServiceReference<test::Interface2>()), serviceId) << "Component must not be reactivated on rebind";
+
+  highReg.Unregister();
+  EXPECT_TRUE(waitForDescription("low")) << "Greedy reference must rebind to the remaining service";
+  EXPECT_EQ(test::GetServiceId(ctxt.GetServiceReference<test::Interface2>()), serviceId) << "Component must not be reactivated on rebind";
+
+  lowReg.Unregister();
+  testBundle.Stop();
+}
+
 /**
  * verify state progressions for a delayed component
  * UNSATISFIED_REFERENCE -> SATISFIED -> ACTIVE -> UNSATISFIED_REFERENCE
@@ -165,6 +165,78 @@ TEST_F(ComponentRegistryTest, VerifyRemoveComponentManagerByIdName)
   EXPECT_EQ(registry->Count(), 0ul);
 }
 
+TEST_F(ComponentRegistryTest, VerifyBundleIndex)
+{
+  auto registry = GetRegistry();
+  auto mockCompMgr = std::make_shared<MockComponentManager>();
+  EXPECT_CALL(*mockCompMgr, GetBundleId()).WillRepeatedly(testing::Return(121));
+  EXPECT_CALL(*mockCompMgr, GetName()).WillRepeatedly(testing::Return(std::string("Foo")));
+  auto mockCompMgr1 = std::make_shared<MockComponentManager>();
+  EXPECT_CALL(*mockCompMgr1, GetBundleId()).WillRepeatedly(testing::Return(122));
+  EXPECT_CALL(*mockCompMgr1, GetName()).WillRepeatedly(testing::Return(std::string("Foo")));
+  EXPECT_TRUE(registry->GetComponentManagers(121).empty());
+  EXPECT_TRUE(registry->AddComponentManager(mockCompMgr));
+  EXPECT_FALSE(registry->AddComponentManager(mockCompMgr)) << "duplicate entries must be rejected";
+  EXPECT_TRUE(registry->AddComponentManager(mockCompMgr1));
+  EXPECT_EQ(registry->Count(), 2ul);
+  EXPECT_EQ(registry->GetComponentManagers(122).front(), mockCompMgr1);
+  EXPECT_THROW(registry->GetComponentManager(121, "Bar"), std::out_of_range);
+
+  // removing an unknown entry leaves the registry unchanged
+  registry->RemoveComponentManager(121, "Bar");
+  registry->RemoveComponentManager(123, "Foo");
+  EXPECT_EQ(registry->Count(), 2ul);
+
+  registry->RemoveComponentManager(mockCompMgr);
+  EXPECT_TRUE(registry->GetComponentManagers(121).empty());
+  EXPECT_THROW(registry->GetComponentManager(121, "Foo"), std::out_of_range);
+  EXPECT_EQ(registry->GetComponentManager(122, "Foo"), mockCompMgr1);
+  registry->Clear();
+  EXPECT_EQ(registry->Count(), 0ul);
+  EXPECT_TRUE(registry->GetComponentManagers().empty());
+}
+
+TEST_F(ComponentRegistryTest, VerifyConcurrentReadsDuringUpdates)
+{
+  auto registry = GetRegistry();
+  std::atomic<bool> done(false);
+  std::vector<std::future<void>> readers;
+  for(int i = 0; i < 4; ++i)
+  {
+    readers.push_back(std::async(std::launch::async,
+                                 [registry, &done]()
+                                 {
+                                   while(!done)
+                                   {
+                                     // every manager a reader sees belongs to the bundle it asked for
+                                     for(const auto& cm : registry->GetComponentManagers())
+                                     {
+                                       auto bundleManagers = registry->GetComponentManagers(cm->GetBundleId());
+                                       EXPECT_LE(bundleManagers.size(), 1ul);
+                                     }
+                                     EXPECT_LE(registry->Count(), 100ul);
+                                   }
+                                 }));
+  }
+
+  std::vector<std::shared_ptr<ComponentManager>> managers;
+  for(int i = 0; i < 100; ++i)
+  {
+    managers.push_back(std::make_shared<FakeComponentManager>());
+    EXPECT_TRUE(registry->AddComponentManager(managers.back()));
+  }
+  for(const auto& cm : managers)
+  {
+    registry->RemoveComponentManager(cm);
+  }
+  done = true;
+  for(auto& reader : readers)
+  {
+    reader.get();
+  }
+  EXPECT_EQ(registry->Count(), 0ul);
+}
+
 TEST_F(ComponentRegistryTest, VerifyConcurrentAddsRemoves)
 {
   auto registry = GetRegistry();
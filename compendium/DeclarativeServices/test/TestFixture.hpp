@@ -84,6 +84,7 @@ public:
     test::InstallLib(context, "TestBundleDSTOI5");
     test::InstallLib(context, "TestBundleDSTOI6");
     test::InstallLib(context, "TestBundleDSTOI7");
+    test::InstallLib(context, "TestBundleDSTOI8");
     test::InstallLib(context, "TestBundleDSTOI9");
 #endif
 
@@ -341,6 +341,14 @@ INSTANTIATE_TEST_SUITE_P(
       "manifest_illegal_scope",
       "Invalid value 'global'. The valid choices are : [bundle, prototype, "
       "singleton]. Could not load the component with index: 0"),
+    MetadataInvalidManifestState(
+      "manifest_illegal_instance_pool_size",
+      "Invalid value specified for the name 'instance-pool-size'. Expected a "
+      "non-negative integer. Could not load the component with index: 0"),
+    MetadataInvalidManifestState(
+      "manifest_instance_pool_size_singleton",
+      "The name 'instance-pool-size' is only valid for components with "
+      "prototype service scope. Could not load the component with index: 0"),
     MetadataInvalidManifestState(
       "manifest_illegal_ref",
       "Unexpected type for the name 'references'. Exception: "
@@ -476,5 +476,78 @@ TEST_F(ReferenceManagerImplTest, TestTargetProperty)
                                               , {{"foo", std::string("bar")}});
   ASSERT_TRUE(refManager.IsSatisfied());
 }
+
+TEST_F(ReferenceManagerImplTest, TestDynamicGreedyRebind)
+{
+  auto bc = GetFramework().GetBundleContext();
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  ReferenceManagerImpl refManager(CreateFakeReferenceMetadata(ReferencePolicy_Dynamic,
+                                                              ReferencePolicyOption_Greedy,
+                                                              ReferenceCardinality_MandatoryUnary),
+                                  bc,
+                                  fakeLogger);
+  std::vector<RefChangeNotification> notifications;
+  auto token = refManager.RegisterListener([&notifications](const RefChangeNotification& notification) {
+                                             notifications.push_back(notification);
+                                           });
+
+  auto reg = bc.RegisterService<dummy::Reference1>(std::make_shared<dummy::Reference1>());
+  ASSERT_EQ(notifications.size(), 1ul);
+  EXPECT_EQ(notifications[0].event, RefEvent::BECAME_SATISFIED);
+  notifications.clear();
+
+  // a better ranked service replaces the bound service without the reference becoming unsatisfied
+  auto reg1 = bc.RegisterService<dummy::Reference1>(std::make_shared<dummy::Reference1>(), {{Constants::SERVICE_RANKING, Any(10)}});
+  ASSERT_EQ(notifications.size(), 1ul);
+  EXPECT_EQ(notifications[0].event, RefEvent::REBIND);
+  EXPECT_EQ(notifications[0].serviceRefToBind, reg1.GetReference());
+  EXPECT_EQ(notifications[0].serviceRefToUnbind, reg.GetReference());
+  EXPECT_EQ(refManager.GetBoundReferences(), std::set<ServiceReferenceBase>{ reg1.GetReference() });
+  notifications.clear();
+
+  // a lower ranked service is ignored
+  auto reg2 = bc.RegisterService<dummy::Reference1>(std::make_shared<dummy::Reference1>());
+  EXPECT_TRUE(notifications.empty());
+
+  refManager.UnregisterListener(token);
+}
+
+TEST_F(ReferenceManagerImplTest, TestDynamicRemovedServiceRebind)
+{
+  auto bc = GetFramework().GetBundleContext();
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  ReferenceManagerImpl refManager(CreateFakeReferenceMetadata(ReferencePolicy_Dynamic,
+                                                              ReferencePolicyOption_Reluctant,
+                                                              ReferenceCardinality_MandatoryUnary),
+                                  bc,
+                                  fakeLogger);
+  std::vector<RefChangeNotification> notifications;
+  auto token = refManager.RegisterListener([&notifications](const RefChangeNotification& notification) {
+                                             notifications.push_back(notification);
+                                           });
+
+  auto reg = bc.RegisterService<dummy::Reference1>(std::make_shared<dummy::Reference1>(), {{Constants::SERVICE_RANKING, Any(10)}});
+  auto reg1 = bc.RegisterService<dummy::Reference1>(std::make_shared<dummy::Reference1>());
+  ASSERT_EQ(notifications.size(), 1ul);
+  EXPECT_EQ(notifications[0].event, RefEvent::BECAME_SATISFIED);
+  notifications.clear();
+
+  // the bound service is replaced by the remaining one
+  auto ref = reg.GetReference();
+  reg.Unregister();
+  ASSERT_EQ(notifications.size(), 1ul);
+  EXPECT_EQ(notifications[0].event, RefEvent::REBIND);
+  EXPECT_EQ(notifications[0].serviceRefToBind, reg1.GetReference());
+  EXPECT_EQ(notifications[0].serviceRefToUnbind, ref);
+  notifications.clear();
+
+  // without a replacement, the reference becomes unsatisfied
+  reg1.Unregister();
+  ASSERT_EQ(notifications.size(), 1ul);
+  EXPECT_EQ(notifications[0].event, RefEvent::BECAME_UNSATISFIED);
+  EXPECT_FALSE(refManager.IsSatisfied());
+
+  refManager.UnregisterListener(token);
+}
 }
 }
@@ -20,6 +20,8 @@
 
   =============================================================================*/
 
+#include <chrono>
+#include <future>
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/FrameworkFactory.h"
 #include "cppmicroservices/FrameworkEvent.h"
@@ -176,6 +178,109 @@ TEST_F(SingletonComponentConfigurationTest, TestGetService)
   }
 }
 
+TEST_F(SingletonComponentConfigurationTest, TestGetServiceFastPath)
+{
+  // once the instance is active, repeated GetService calls must not query the instance again
+  MockComponentInstanceFactory mockCompFactory;
+  auto mockInstance = std::make_shared<MockComponentInstance>();
+  obj->SetState(std::make_shared<CCRegisteredState>());
+  obj->SetComponentInstanceCreateDeleteMethods(std::bind(&MockComponentInstanceFactory::CreateComponentInstance, &mockCompFactory), std::bind(&MockComponentInstanceFactory::DeleteComponentInstance, &mockCompFactory, std::placeholders::_1));
+  EXPECT_CALL(mockCompFactory, CreateComponentInstance())
+    .Times(1)
+    .WillOnce(testing::Return(mockInstance.get()));
+  EXPECT_CALL(mockCompFactory, DeleteComponentInstance(testing::_))
+    .Times(1);
+  auto iMap = std::make_shared<InterfaceMap>();
+  EXPECT_CALL(*mockInstance, CreateInstanceAndBindReferences(testing::_)).Times(1);
+  EXPECT_CALL(*mockInstance, Activate()).Times(1);
+  EXPECT_CALL(*mockInstance, GetInterfaceMap()).Times(1).WillOnce(testing::Return(iMap));
+  for(int i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ(obj->GetService(Bundle(), ServiceRegistrationU()), iMap);
+  }
+
+  // after the deactivation the instance must not be served anymore
+  EXPECT_CALL(*mockInstance, Deactivate()).Times(1);
+  EXPECT_CALL(*mockInstance, UnbindReferences()).Times(1);
+  obj->Deactivate();
+  EXPECT_EQ(obj->GetState()->GetValue(), ComponentState::UNSATISFIED_REFERENCE);
+  EXPECT_EQ(obj->GetService(Bundle(), ServiceRegistrationU()), nullptr);
+}
+
+TEST_F(SingletonComponentConfigurationTest, TestGetServiceDuringDeactivation)
+{
+  // a GetService call made while the service is being unregistered must not get the instance being deactivated
+  auto mockMetadata = std::make_shared<metadata::ComponentMetadata>();
+  mockMetadata->serviceMetadata.interfaces = { "ServiceDuringDeactivation" };
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  auto config = std::make_shared<SingletonComponentConfigurationImpl>(mockMetadata,
+                                                                      framework,
+                                                                      std::make_shared<MockComponentRegistry>(),
+                                                                      fakeLogger);
+  MockComponentInstanceFactory mockCompFactory;
+  auto mockInstance = std::make_shared<MockComponentInstance>();
+  config->SetComponentInstanceCreateDeleteMethods(std::bind(&MockComponentInstanceFactory::CreateComponentInstance, &mockCompFactory), std::bind(&MockComponentInstanceFactory::DeleteComponentInstance, &mockCompFactory, std::placeholders::_1));
+  EXPECT_CALL(mockCompFactory, CreateComponentInstance())
+    .Times(1)
+    .WillOnce(testing::Return(mockInstance.get()));
+  EXPECT_CALL(mockCompFactory, DeleteComponentInstance(testing::_))
+    .Times(1);
+  auto iMap = std::make_shared<InterfaceMap>();
+  EXPECT_CALL(*mockInstance, CreateInstanceAndBindReferences(testing::_)).Times(1);
+  EXPECT_CALL(*mockInstance, Activate()).Times(1);
+  EXPECT_CALL(*mockInstance, GetInterfaceMap()).Times(1).WillOnce(testing::Return(iMap));
+  EXPECT_CALL(*mockInstance, Deactivate()).Times(1);
+  EXPECT_CALL(*mockInstance, UnbindReferences()).Times(1);
+
+  config->Initialize();
+  ASSERT_EQ(config->GetState()->GetValue(), ComponentState::SATISFIED);
+  EXPECT_EQ(config->GetService(Bundle(), ServiceRegistrationU()), iMap);
+
+  bool unregistering = false;
+  InterfaceMapConstPtr racingService;
+  auto ctxt = framework.GetBundleContext();
+  auto token = ctxt.AddServiceListener([&](const ServiceEvent& evt) {
+                                         if(evt.GetType() == ServiceEvent::SERVICE_UNREGISTERING)
+                                         {
+                                           unregistering = true;
+                                           racingService = config->GetService(Bundle(), ServiceRegistrationU());
+                                         }
+                                       }, "(objectclass=ServiceDuringDeactivation)");
+  config->Deactivate();
+  ctxt.RemoveListener(std::move(token));
+  EXPECT_TRUE(unregistering);
+  EXPECT_EQ(racingService, nullptr);
+}
+
+TEST_F(SingletonComponentConfigurationTest, TestConcurrentGetServiceFastPath)
+{
+  MockComponentInstanceFactory mockCompFactory;
+  auto mockInstance = std::make_shared<MockComponentInstance>();
+  obj->SetState(std::make_shared<CCRegisteredState>());
+  obj->SetComponentInstanceCreateDeleteMethods(std::bind(&MockComponentInstanceFactory::CreateComponentInstance, &mockCompFactory), std::bind(&MockComponentInstanceFactory::DeleteComponentInstance, &mockCompFactory, std::placeholders::_1));
+  EXPECT_CALL(mockCompFactory, CreateComponentInstance())
+    .Times(1)
+    .WillOnce(testing::Return(mockInstance.get()));
+  EXPECT_CALL(mockCompFactory, DeleteComponentInstance(testing::_))
+    .Times(1);
+  auto iMap = std::make_shared<InterfaceMap>();
+  EXPECT_CALL(*mockInstance, CreateInstanceAndBindReferences(testing::_)).Times(1);
+  EXPECT_CALL(*mockInstance, Activate()).Times(1);
+  EXPECT_CALL(*mockInstance, GetInterfaceMap()).WillRepeatedly(testing::Return(iMap));
+
+  std::function<InterfaceMapConstPtr(void)> func = [&]() {
+                                                     return obj->GetService(Bundle(), ServiceRegistrationU());
+                                                   };
+  auto results = ConcurrentInvoke(func);
+  EXPECT_TRUE(std::all_of(results.begin(), results.end(), [&](auto const& elem) {
+                                                            return elem == iMap;
+                                                          }));
+
+  EXPECT_CALL(*mockInstance, Deactivate()).Times(1);
+  EXPECT_CALL(*mockInstance, UnbindReferences()).Times(1);
+  obj->Deactivate();
+}
+
 TEST_F(SingletonComponentConfigurationTest, TestDestroyComponentInstances)
 {
   auto mockCompContext = std::make_shared<MockComponentContextImpl>(obj);
@@ -0,0 +1,129 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include "benchmark/benchmark.h"
+
+#include "TestInterfaces/Interfaces.hpp"
+#include "TestUtils.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Installs DSGraph01 ... DSGraph07 and returns them, consumers first
+std::vector<cppmicroservices::Bundle> InstallGraphBundles(cppmicroservices::BundleContext context)
+{
+  std::vector<cppmicroservices::Bundle> graphBundles;
+  for (int i = 1; i <= 7; ++i) {
+    auto name = "DSGraph0" + std::to_string(i);
+    test::InstallLib(context, name);
+    for (auto& bundle : context.GetBundles()) {
+      if (bundle.GetSymbolicName() == name) {
+        graphBundles.push_back(bundle);
+      }
+    }
+  }
+  return graphBundles;
+}
+
+void StopFramework(cppmicroservices::Framework& framework)
+{
+  framework.Stop();
+  framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+} // namespace
+
+/// Benchmark resolving the DSGraph bundles when the DS runtime is started
+/// after all of them are already active. The measured time covers starting
+/// the DS runtime and getting the root service of the graph.
+static void StartRuntimeWithActiveGraphBundles(benchmark::State& state)
+{
+  using namespace cppmicroservices;
+
+  for (auto _ : state) {
+    auto framework = FrameworkFactory().NewFramework();
+    framework.Start();
+    auto context = framework.GetBundleContext();
+    for (auto& bundle : InstallGraphBundles(context)) {
+      bundle.Start();
+    }
+    auto dsBundles = context.InstallBundles(test::GetDSRuntimePluginFilePath());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto& bundle : dsBundles) {
+      bundle.Start();
+    }
+    auto ref = context.GetServiceReference<test::DSGraph01>();
+    auto service = ref ? context.GetService(ref) : nullptr;
+    auto end = std::chrono::high_resolution_clock::now();
+
+    if (!service) {
+      state.SkipWithError("DSGraph01 was not resolved");
+    }
+    state.SetIterationTime(std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count());
+    StopFramework(framework);
+  }
+}
+
+/// Benchmark resolving the DSGraph bundles when they are started, consumers
+/// first, after the DS runtime. The measured time covers starting the
+/// bundles and getting the root service of the graph.
+static void StartGraphBundlesWithActiveRuntime(benchmark::State& state)
+{
+  using namespace cppmicroservices;
+
+  for (auto _ : state) {
+    auto framework = FrameworkFactory().NewFramework();
+    framework.Start();
+    auto context = framework.GetBundleContext();
+    for (auto& bundle : context.InstallBundles(test::GetDSRuntimePluginFilePath())) {
+      bundle.Start();
+    }
+    auto graphBundles = InstallGraphBundles(context);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto& bundle : graphBundles) {
+      bundle.Start();
+    }
+    auto ref = context.GetServiceReference<test::DSGraph01>();
+    auto service = ref ? context.GetService(ref) : nullptr;
+    auto end = std::chrono::high_resolution_clock::now();
+
+    if (!service) {
+      state.SkipWithError("DSGraph01 was not resolved");
+    }
+    state.SetIterationTime(std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count());
+    StopFramework(framework);
+  }
+}
+
+BENCHMARK(StartRuntimeWithActiveGraphBundles)->UseManualTime();
+BENCHMARK(StartGraphBundlesWithActiveRuntime)->UseManualTime();
@@ -0,0 +1,103 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include "benchmark/benchmark.h"
+
+#include "TestInterfaces/Interfaces.hpp"
+#include "TestUtils.hpp"
+
+#include <chrono>
+#include <memory>
+
+namespace {
+
+std::unique_ptr<cppmicroservices::Framework> framework;
+
+/// Starts a framework with the DS runtime and the BenchmarkDS bundle
+void StartFrameworkWithBenchmarkBundle()
+{
+  using namespace cppmicroservices;
+
+  framework = std::make_unique<Framework>(FrameworkFactory().NewFramework());
+  framework->Start();
+  auto context = framework->GetBundleContext();
+  for (auto& bundle : context.InstallBundles(test::GetDSRuntimePluginFilePath())) {
+    bundle.Start();
+  }
+  test::InstallLib(context, "BenchmarkDS");
+  for (auto& bundle : context.GetBundles()) {
+    if (bundle.GetSymbolicName() == "BenchmarkDS") {
+      bundle.Start();
+    }
+  }
+}
+
+void StopFramework()
+{
+  framework->Stop();
+  framework->WaitForStop(std::chrono::milliseconds::zero());
+  framework.reset();
+}
+
+} // namespace
+
+/// Benchmark GetService on an already active DS singleton component, called
+/// concurrently from several threads. Each iteration gets and releases the
+/// service, so the component's ServiceFactory is consulted every time.
+static void GetServiceOnActiveSingletonComponent(benchmark::State& state)
+{
+  if (state.thread_index == 0) {
+    StartFrameworkWithBenchmarkBundle();
+    // activate the delayed component before measuring
+    auto context = framework->GetBundleContext();
+    auto ref = context.GetServiceReference<test::Interface1>();
+    if (!ref || !context.GetService(ref)) {
+      state.SkipWithError("BenchmarkDS component could not be activated");
+    }
+  }
+
+  // The framework is only guaranteed to be set up once all threads entered
+  // the benchmark loop, so each thread looks up its reference lazily.
+  cppmicroservices::BundleContext context;
+  cppmicroservices::ServiceReference<test::Interface1> ref;
+  for (auto _ : state) {
+    if (!ref) {
+      context = framework->GetBundleContext();
+      ref = context.GetServiceReference<test::Interface1>();
+    }
+    auto service = context.GetService(ref);
+    benchmark::DoNotOptimize(service);
+  }
+
+  if (state.thread_index == 0) {
+    StopFramework();
+  }
+}
+
+BENCHMARK(GetServiceOnActiveSingletonComponent)->Threads(1)->Threads(32)->UseRealTime();
@@ -0,0 +1,149 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+#ifndef CPPMICROSERVICES_LOG_BINARY_LOG_H__
+#define CPPMICROSERVICES_LOG_BINARY_LOG_H__
+
+#include "cppmicroservices/logservice/LogService.hpp"
+#include "cppmicroservices/logservice/StructuredLog.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cppmicroservices {
+namespace logservice {
+
+/**
+ * Returns the name of \c level, e.g. "ERROR"
+ */
+US_LogService_EXPORT const char* ToString(SeverityLevel level);
+
+/**
+ * Appends the text form of a log record to \c out. The line consists of the
+ * UTC timestamp in ISO 8601 format, the severity and the message, and ends
+ * with a newline. Text log sinks and the log decoder use this form.
+ */
+US_LogService_EXPORT void AppendLogLine(std::string& out,
+                                        SeverityLevel level,
+                                        std::chrono::system_clock::time_point timestamp,
+                                        const std::string& message);
+
+/**
+ * \defgroup gr_binarylog Binary log format
+ *
+ * A binary log starts with the header written by #AppendBinaryLogHeader,
+ * followed by a sequence of entries. An entry is either the definition of a
+ * format, which maps a format id to its pattern, or a record referring to a
+ * format id. A format is defined before the first record using it. Records
+ * keep their arguments in typed, binary form and are only formatted when the
+ * log is read. All integers are stored in little endian byte order.
+ */
+
+/**
+ * Appends the header of a binary log to \c out
+ */
+US_LogService_EXPORT void AppendBinaryLogHeader(std::string& out);
+
+/**
+ * Appends the definition of the format with id \c formatId and pattern
+ * \c pattern to \c out
+ */
+US_LogService_EXPORT void AppendLogFormatEntry(std::string& out,
+                                               uint32_t formatId,
+                                               const std::string& pattern);
+
+/**
+ * Appends a record entry to \c out
+ */
+US_LogService_EXPORT void AppendLogRecordEntry(std::string& out,
+                                               SeverityLevel level,
+                                               std::chrono::system_clock::time_point timestamp,
+                                               uint32_t formatId,
+                                               const LogArg* args,
+                                               std::size_t argCount);
+
+/**
+ * A record entry decoded from a binary log. String arguments refer to the
+ * buffer the record was decoded from.
+ */
+struct LogRecordView
+{
+  SeverityLevel level;
+  std::chrono::system_clock::time_point timestamp;
+  uint32_t formatId;
+  std::vector<LogArg> args;
+};
+
+/**
+ * Decodes the record entry at the start of \c data, which must have been
+ * created with #AppendLogRecordEntry.
+ *
+ * @return the size of the entry in bytes
+ * @throws std::runtime_error if \c data does not start with a valid record entry
+ */
+US_LogService_EXPORT std::size_t DecodeLogRecordEntry(const char* data,
+                                                      std::size_t size,
+                                                      LogRecordView& record);
+
+/**
+ * Reads the records of a binary log from a stream and formats them.
+ */
+class US_LogService_EXPORT BinaryLogReader
+{
+public:
+  /**
+   * A formatted record
+   */
+  struct Record
+  {
+    SeverityLevel level;
+    std::chrono::system_clock::time_point timestamp;
+    std::string message;
+  };
+
+  /**
+   * @throws std::runtime_error if the stream does not start with a binary log header
+   */
+  explicit BinaryLogReader(std::istream& in);
+
+  /**
+   * Reads the next record. Format definitions are consumed on the way.
+   *
+   * @return \c false if the end of the log is reached
+   * @throws std::runtime_error if the log is corrupt or refers to an undefined format
+   */
+  bool ReadNext(Record& record);
+
+private:
+  std::istream& in;
+  std::unordered_map<uint32_t, std::string> patterns; ///< formats defined so far, by id
+  std::string buffer;                                ///< the entry being decoded
+};
+
+} // namespace logservice
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_LOG_BINARY_LOG_H__
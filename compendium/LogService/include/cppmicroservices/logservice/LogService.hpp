@@ -23,11 +23,13 @@
 #define CPPMICROSERVICES_LOG_SERVICE_H__
 
 #include "cppmicroservices/logservice/LogServiceExport.h"
+#include "cppmicroservices/logservice/StructuredLog.hpp"
 
 #include "cppmicroservices/ServiceReferenceBase.h"
 
 #include <exception>
 #include <string>
+#include <cstddef>
 #include <cstdint>
 
 namespace cppmicroservices {
@@ -91,6 +93,112 @@ class US_LogService_EXPORT LogService
   virtual void Log(const ServiceReferenceBase& sr, SeverityLevel level, const std::string& message, const std::exception_ptr ex) = 0;
 };
 
+/**
+ * An optional extension of LogService for structured records. The message of
+ * a record consists of a format and typed arguments, which implementations may
+ * store in binary form and only format when the record is read.
+ *
+ * This is a separate interface so that the LogService vtable, which
+ * implementations in other bundles were built against, stays unchanged. A log
+ * service opts in by deriving from both classes. Callers holding a LogService
+ * find the extension with \c std::dynamic_pointer_cast, or use the
+ * LogStructured(LogService&, ...) functions, which fall back to
+ * LogService::Log.
+ *
+ * @remarks This class is thread safe.
+ */
+class US_LogService_EXPORT StructuredLogService
+{
+  public:
+  virtual ~StructuredLogService();
+
+  /**
+   * Returns whether messages with the given severity are logged. Callers can use this
+   * to avoid building messages which would be discarded.
+   * @param level The severity to check.
+   */
+  virtual bool IsEnabled(SeverityLevel level) const = 0;
+
+  /**
+   * Logs a structured record.
+   * @param level The severity of the message.
+   * @param format The pattern of the message.
+   * @param args The arguments replacing the placeholders of the pattern.
+   * @param argCount The number of arguments in \c args.
+   */
+  virtual void LogRecord(SeverityLevel level, const LogFormat& format, const LogArg* args, std::size_t argCount) = 0;
+
+  /**
+   * Logs a structured record if messages with the severity \c level are enabled.
+   * Arguments are neither converted nor copied for disabled messages.
+   * @param level The severity of the message.
+   * @param format The pattern of the message.
+   * @param args The arguments replacing the placeholders of the pattern.
+   */
+  template<typename... Args>
+  void LogStructured(SeverityLevel level, const LogFormat& format, const Args&... args)
+  {
+    if (IsEnabled(level))
+    {
+      const LogArg logArgs[] = { LogArg(args)... };
+      LogRecord(level, format, logArgs, sizeof...(Args));
+    }
+  }
+
+  /**
+   * Logs a structured record without arguments if messages with the severity \c level are enabled.
+   * @param level The severity of the message.
+   * @param format The pattern of the message.
+   */
+  void LogStructured(SeverityLevel level, const LogFormat& format)
+  {
+    if (IsEnabled(level))
+    {
+      LogRecord(level, format, nullptr, 0);
+    }
+  }
+};
+
+/**
+ * Logs a structured record through \c logger. If \c logger implements
+ * StructuredLogService, the record is only created if messages with the
+ * severity \c level are enabled. Otherwise the message is formatted with
+ * FormatLogMessage and passed to LogService::Log.
+ * @param logger The log service to log to.
+ * @param level The severity of the message.
+ * @param format The pattern of the message.
+ * @param args The arguments replacing the placeholders of the pattern.
+ */
+template<typename... Args>
+void LogStructured(LogService& logger, SeverityLevel level, const LogFormat& format, const Args&... args)
+{
+  if (auto structured = dynamic_cast<StructuredLogService*>(&logger))
+  {
+    structured->LogStructured(level, format, args...);
+  }
+  else
+  {
+    const LogArg logArgs[] = { LogArg(args)... };
+    logger.Log(level, FormatLogMessage(format.GetPattern(), logArgs, sizeof...(Args)));
+  }
+}
+
+/**
+ * Logs a structured record without arguments through \c logger.
+ * @see LogStructured(LogService&, SeverityLevel, const LogFormat&, const Args&...)
+ */
+inline void LogStructured(LogService& logger, SeverityLevel level, const LogFormat& format)
+{
+  if (auto structured = dynamic_cast<StructuredLogService*>(&logger))
+  {
+    structured->LogStructured(level, format);
+  }
+  else
+  {
+    logger.Log(level, FormatLogMessage(format.GetPattern(), nullptr, 0));
+  }
+}
+
 } // namespace logservice
 
 } // namespace cppmicroservices
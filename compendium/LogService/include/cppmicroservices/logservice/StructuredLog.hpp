@@ -0,0 +1,158 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+#ifndef CPPMICROSERVICES_LOG_STRUCTURED_LOG_H__
+#define CPPMICROSERVICES_LOG_STRUCTURED_LOG_H__
+
+#include "cppmicroservices/logservice/LogServiceExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace cppmicroservices {
+namespace logservice {
+
+/**
+ * The message pattern of a structured log record.
+ *
+ * A pattern contains "{}" placeholders which are replaced, in order, by the
+ * arguments of a record when the record is formatted. Each distinct pattern
+ * is assigned a process-wide id the first time a LogFormat is created for
+ * it, so that records only need to carry the id. Create LogFormat objects
+ * once, e.g. as function-local statics, and reuse them:
+ *
+ * \code
+ * static const LogFormat fmt("Created instance of SCRBundleExtension for {}");
+ * logger->LogStructured(SeverityLevel::LOG_DEBUG, fmt, bundle.GetSymbolicName());
+ * \endcode
+ *
+ * @remarks This class is thread safe.
+ */
+class US_LogService_EXPORT LogFormat
+{
+public:
+  /**
+   * Registers \c pattern, if not already registered, and creates a format
+   * referring to it.
+   */
+  explicit LogFormat(const std::string& pattern);
+
+  /**
+   * Returns the process-wide id of the pattern. Ids are never 0.
+   */
+  uint32_t GetId() const { return id; }
+
+  /**
+   * Returns the pattern of this format
+   */
+  const std::string& GetPattern() const { return pattern; }
+
+  /**
+   * Returns the pattern registered with the given id.
+   * @throws std::out_of_range if no pattern is registered with \c id
+   */
+  static std::string GetPattern(uint32_t id);
+
+private:
+  uint32_t id;
+  std::string pattern;
+};
+
+/**
+ * A typed argument of a structured log record.
+ *
+ * A LogArg does not own string data; it refers to the string it was created
+ * from, which must outlive the LogArg.
+ */
+class LogArg
+{
+public:
+  /**
+   * The type of the argument. The numeric values are part of the binary log
+   * format and must not change.
+   */
+  enum class Type : uint8_t
+  {
+    Int = 1,
+    UInt = 2,
+    Double = 3,
+    Bool = 4,
+    String = 5
+  };
+
+  template<typename T,
+           typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type = 0>
+  LogArg(T value) : type(Type::Int) { data.i = value; }
+
+  template<typename T,
+           typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+  LogArg(T value) : type(Type::UInt) { data.u = value; }
+
+  LogArg(double value) : type(Type::Double) { data.d = value; }
+  LogArg(bool value) : type(Type::Bool) { data.b = value; }
+  LogArg(const std::string& value) : type(Type::String) { data.s.str = value.data(); data.s.size = value.size(); }
+  LogArg(const char* value) : LogArg(value, std::char_traits<char>::length(value)) {}
+  LogArg(const char* value, std::size_t size) : type(Type::String) { data.s.str = value; data.s.size = size; }
+
+  Type GetType() const { return type; }
+  int64_t GetInt() const { return data.i; }
+  uint64_t GetUInt() const { return data.u; }
+  double GetDouble() const { return data.d; }
+  bool GetBool() const { return data.b; }
+  const char* GetString() const { return data.s.str; }
+  std::size_t GetStringSize() const { return data.s.size; }
+
+  /**
+   * Appends the text form of this argument to \c out
+   */
+  US_LogService_EXPORT void AppendTo(std::string& out) const;
+
+private:
+  Type type;
+  union
+  {
+    int64_t i;
+    uint64_t u;
+    double d;
+    bool b;
+    struct
+    {
+      const char* str;
+      std::size_t size;
+    } s;
+  } data;
+};
+
+/**
+ * Formats a structured message by replacing the "{}" placeholders in
+ * \c pattern with the \c argCount arguments in \c args. Placeholders without
+ * a matching argument are kept; surplus arguments are ignored.
+ */
+US_LogService_EXPORT std::string FormatLogMessage(const std::string& pattern,
+                                                  const LogArg* args,
+                                                  std::size_t argCount);
+
+} // namespace logservice
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_LOG_STRUCTURED_LOG_H__
@@ -0,0 +1,346 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "cppmicroservices/logservice/BinaryLog.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <stdexcept>
+
+namespace cppmicroservices {
+namespace logservice {
+
+namespace {
+
+const char Magic[] = { 'C', 'P', 'P', 'M', 'S', 'L', 'O', 'G' };
+const uint8_t Version = 1;
+const std::size_t HeaderSize = sizeof(Magic) + 4; // magic, version and three reserved bytes
+const std::size_t EntryHeaderSize = 5;            // kind and payload size
+
+enum class EntryKind : uint8_t
+{
+  Format = 1,
+  Record = 2
+};
+
+template<typename T>
+void AppendLE(std::string& out, T value)
+{
+  for (std::size_t i = 0; i < sizeof(T); ++i)
+  {
+    out.push_back(static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF));
+  }
+}
+
+template<typename T>
+T ReadLE(const char* data)
+{
+  uint64_t value = 0;
+  for (std::size_t i = 0; i < sizeof(T); ++i)
+  {
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+  }
+  return static_cast<T>(value);
+}
+
+/**
+ * Bounds checked reading of an entry payload
+ */
+class PayloadReader
+{
+public:
+  PayloadReader(const char* data, std::size_t size) : data(data), remaining(size) {}
+
+  template<typename T>
+  T Read()
+  {
+    const char* bytes = Take(sizeof(T));
+    return ReadLE<T>(bytes);
+  }
+
+  const char* Take(std::size_t size)
+  {
+    if (size > remaining)
+    {
+      throw std::runtime_error("Corrupt binary log: entry is truncated");
+    }
+    const char* result = data;
+    data += size;
+    remaining -= size;
+    return result;
+  }
+
+private:
+  const char* data;
+  std::size_t remaining;
+};
+
+/**
+ * Appends the kind and a placeholder for the payload size of an entry, and
+ * returns the offset of the placeholder
+ */
+std::size_t BeginEntry(std::string& out, EntryKind kind)
+{
+  out.push_back(static_cast<char>(kind));
+  const auto sizeOffset = out.size();
+  AppendLE<uint32_t>(out, 0);
+  return sizeOffset;
+}
+
+void EndEntry(std::string& out, std::size_t sizeOffset)
+{
+  const auto payloadSize = static_cast<uint32_t>(out.size() - sizeOffset - sizeof(uint32_t));
+  for (std::size_t i = 0; i < sizeof(uint32_t); ++i)
+  {
+    out[sizeOffset + i] = static_cast<char>((payloadSize >> (8 * i)) & 0xFF);
+  }
+}
+
+}
+
+const char* ToString(SeverityLevel level)
+{
+  switch (level)
+  {
+    case SeverityLevel::LOG_ERROR:
+      return "ERROR";
+    case SeverityLevel::LOG_WARNING:
+      return "WARNING";
+    case SeverityLevel::LOG_INFO:
+      return "INFO";
+    case SeverityLevel::LOG_DEBUG:
+      return "DEBUG";
+  }
+  return "UNKNOWN";
+}
+
+void AppendLogLine(std::string& out,
+                   SeverityLevel level,
+                   std::chrono::system_clock::time_point timestamp,
+                   const std::string& message)
+{
+  const auto time = std::chrono::system_clock::to_time_t(timestamp);
+  const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count() % 1000;
+  std::tm utc{};
+#if defined(_WIN32)
+  gmtime_s(&utc, &time);
+#else
+  gmtime_r(&time, &utc);
+#endif
+  char buf[32];
+  const auto len = std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", &utc);
+  out.append(buf, len);
+  std::snprintf(buf, sizeof(buf), ".%03dZ [", static_cast<int>(millis));
+  out += buf;
+  out += ToString(level);
+  out += "] ";
+  out += message;
+  out += '\n';
+}
+
+void AppendBinaryLogHeader(std::string& out)
+{
+  out.append(Magic, sizeof(Magic));
+  out.push_back(static_cast<char>(Version));
+  out.append(3, '\0');
+}
+
+void AppendLogFormatEntry(std::string& out,
+                          uint32_t formatId,
+                          const std::string& pattern)
+{
+  const auto sizeOffset = BeginEntry(out, EntryKind::Format);
+  AppendLE<uint32_t>(out, formatId);
+  out += pattern;
+  EndEntry(out, sizeOffset);
+}
+
+void AppendLogRecordEntry(std::string& out,
+                          SeverityLevel level,
+                          std::chrono::system_clock::time_point timestamp,
+                          uint32_t formatId,
+                          const LogArg* args,
+                          std::size_t argCount)
+{
+  argCount = std::min<std::size_t>(argCount, std::numeric_limits<uint16_t>::max());
+  const auto sizeOffset = BeginEntry(out, EntryKind::Record);
+  out.push_back(static_cast<char>(level));
+  AppendLE<int64_t>(out, std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count());
+  AppendLE<uint32_t>(out, formatId);
+  AppendLE<uint16_t>(out, static_cast<uint16_t>(argCount));
+  for (std::size_t i = 0; i < argCount; ++i)
+  {
+    const auto& arg = args[i];
+    out.push_back(static_cast<char>(arg.GetType()));
+    switch (arg.GetType())
+    {
+      case LogArg::Type::Int:
+        AppendLE<int64_t>(out, arg.GetInt());
+        break;
+      case LogArg::Type::UInt:
+        AppendLE<uint64_t>(out, arg.GetUInt());
+        break;
+      case LogArg::Type::Double:
+      {
+        uint64_t bits = 0;
+        const double value = arg.GetDouble();
+        std::memcpy(&bits, &value, sizeof(bits));
+        AppendLE<uint64_t>(out, bits);
+        break;
+      }
+      case LogArg::Type::Bool:
+        out.push_back(arg.GetBool() ? 1 : 0);
+        break;
+      case LogArg::Type::String:
+        AppendLE<uint32_t>(out, static_cast<uint32_t>(arg.GetStringSize()));
+        out.append(arg.GetString(), arg.GetStringSize());
+        break;
+    }
+  }
+  EndEntry(out, sizeOffset);
+}
+
+std::size_t DecodeLogRecordEntry(const char* data,
+                                 std::size_t size,
+                                 LogRecordView& record)
+{
+  PayloadReader entry(data, size);
+  if (entry.Read<uint8_t>() != static_cast<uint8_t>(EntryKind::Record))
+  {
+    throw std::runtime_error("Corrupt binary log: expected a record entry");
+  }
+  const auto payloadSize = entry.Read<uint32_t>();
+  PayloadReader payload(entry.Take(payloadSize), payloadSize);
+
+  const auto level = payload.Read<uint8_t>();
+  if (level < static_cast<uint8_t>(SeverityLevel::LOG_ERROR) || level > static_cast<uint8_t>(SeverityLevel::LOG_DEBUG))
+  {
+    throw std::runtime_error("Corrupt binary log: invalid severity level " + std::to_string(static_cast<unsigned int>(level)));
+  }
+  record.level = static_cast<SeverityLevel>(level);
+  record.timestamp = std::chrono::system_clock::time_point(
+    std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(payload.Read<int64_t>())));
+  record.formatId = payload.Read<uint32_t>();
+  const auto argCount = payload.Read<uint16_t>();
+  record.args.clear();
+  record.args.reserve(argCount);
+  for (uint16_t i = 0; i < argCount; ++i)
+  {
+    switch (static_cast<LogArg::Type>(payload.Read<uint8_t>()))
+    {
+      case LogArg::Type::Int:
+        record.args.emplace_back(payload.Read<int64_t>());
+        break;
+      case LogArg::Type::UInt:
+        record.args.emplace_back(payload.Read<uint64_t>());
+        break;
+      case LogArg::Type::Double:
+      {
+        const auto bits = payload.Read<uint64_t>();
+        double value = 0;
+        std::memcpy(&value, &bits, sizeof(value));
+        record.args.emplace_back(value);
+        break;
+      }
+      case LogArg::Type::Bool:
+        record.args.emplace_back(payload.Read<uint8_t>() != 0);
+        break;
+      case LogArg::Type::String:
+      {
+        const auto length = payload.Read<uint32_t>();
+        record.args.emplace_back(payload.Take(length), length);
+        break;
+      }
+      default:
+        throw std::runtime_error("Corrupt binary log: invalid argument type");
+    }
+  }
+  return EntryHeaderSize + payloadSize;
+}
+
+BinaryLogReader::BinaryLogReader(std::istream& in)
+  : in(in)
+{
+  char header[HeaderSize];
+  if (!in.read(header, HeaderSize) || std::memcmp(header, Magic, sizeof(Magic)) != 0)
+  {
+    throw std::runtime_error("Not a binary log: the header is missing");
+  }
+  if (static_cast<uint8_t>(header[sizeof(Magic)]) != Version)
+  {
+    throw std::runtime_error("Unsupported binary log version " + std::to_string(static_cast<unsigned int>(static_cast<uint8_t>(header[sizeof(Magic)]))));
+  }
+}
+
+bool BinaryLogReader::ReadNext(Record& record)
+{
+  LogRecordView view;
+  for (;;)
+  {
+    buffer.resize(EntryHeaderSize);
+    in.read(&buffer[0], EntryHeaderSize);
+    if (in.gcount() == 0 && in.eof())
+    {
+      return false;
+    }
+    if (static_cast<std::size_t>(in.gcount()) != EntryHeaderSize)
+    {
+      throw std::runtime_error("Corrupt binary log: entry is truncated");
+    }
+    const auto kind = static_cast<EntryKind>(buffer[0]);
+    const auto payloadSize = ReadLE<uint32_t>(buffer.data() + 1);
+    buffer.resize(EntryHeaderSize + payloadSize);
+    if (payloadSize > 0 && !in.read(&buffer[EntryHeaderSize], payloadSize))
+    {
+      throw std::runtime_error("Corrupt binary log: entry is truncated");
+    }
+
+    if (kind == EntryKind::Format)
+    {
+      PayloadReader payload(buffer.data() + EntryHeaderSize, payloadSize);
+      const auto formatId = payload.Read<uint32_t>();
+      // a later definition replaces an earlier one, e.g. when a new process appends to the log
+      patterns[formatId] = std::string(buffer.data() + EntryHeaderSize + sizeof(uint32_t),
+                                       payloadSize - sizeof(uint32_t));
+    }
+    else if (kind == EntryKind::Record)
+    {
+      DecodeLogRecordEntry(buffer.data(), buffer.size(), view);
+      auto pattern = patterns.find(view.formatId);
+      if (pattern == patterns.end())
+      {
+        throw std::runtime_error("Corrupt binary log: undefined format id " + std::to_string(view.formatId));
+      }
+      record.level = view.level;
+      record.timestamp = view.timestamp;
+      record.message = FormatLogMessage(pattern->second, view.args.data(), view.args.size());
+      return true;
+    }
+    // skip entries of unknown kinds
+  }
+}
+
+} // namespace logservice
+} // namespace cppmicroservices
@@ -27,5 +27,7 @@ namespace logservice {
 
 LogService::~LogService() = default;
 
+StructuredLogService::~StructuredLogService() = default;
+
 }
 }
@@ -0,0 +1,130 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "cppmicroservices/logservice/StructuredLog.hpp"
+
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace cppmicroservices {
+namespace logservice {
+
+namespace {
+
+/**
+ * The process-wide table of registered patterns. Entries are never removed,
+ * so ids stay valid for the lifetime of the process.
+ */
+struct FormatRegistry
+{
+  std::mutex mutex;
+  std::unordered_map<std::string, uint32_t> idsByPattern;
+  std::vector<std::string> patterns; ///< pattern of id N is at index N - 1
+};
+
+FormatRegistry& GetFormatRegistry()
+{
+  static FormatRegistry registry;
+  return registry;
+}
+
+}
+
+LogFormat::LogFormat(const std::string& pattern)
+  : id(0)
+  , pattern(pattern)
+{
+  auto& registry = GetFormatRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto result = registry.idsByPattern.insert(std::make_pair(pattern, static_cast<uint32_t>(registry.patterns.size() + 1)));
+  if (result.second)
+  {
+    registry.patterns.push_back(pattern);
+  }
+  id = result.first->second;
+}
+
+std::string LogFormat::GetPattern(uint32_t id)
+{
+  auto& registry = GetFormatRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if (id == 0 || id > registry.patterns.size())
+  {
+    throw std::out_of_range("No log format registered with id " + std::to_string(id));
+  }
+  return registry.patterns[id - 1];
+}
+
+void LogArg::AppendTo(std::string& out) const
+{
+  switch (type)
+  {
+    case Type::Int:
+      out += std::to_string(data.i);
+      break;
+    case Type::UInt:
+      out += std::to_string(data.u);
+      break;
+    case Type::Double:
+    {
+      char buf[32];
+      const int len = std::snprintf(buf, sizeof(buf), "%g", data.d);
+      out.append(buf, static_cast<std::size_t>(len));
+      break;
+    }
+    case Type::Bool:
+      out += (data.b ? "true" : "false");
+      break;
+    case Type::String:
+      out.append(data.s.str, data.s.size);
+      break;
+  }
+}
+
+std::string FormatLogMessage(const std::string& pattern,
+                             const LogArg* args,
+                             std::size_t argCount)
+{
+  std::string message;
+  message.reserve(pattern.size() + 16 * argCount);
+  std::size_t argIndex = 0;
+  std::size_t pos = 0;
+  for (;;)
+  {
+    const auto placeholder = pattern.find("{}", pos);
+    if (placeholder == std::string::npos || argIndex == argCount)
+    {
+      message.append(pattern, pos, std::string::npos);
+      break;
+    }
+    message.append(pattern, pos, placeholder - pos);
+    args[argIndex++].AppendTo(message);
+    pos = placeholder + 2;
+  }
+  return message;
+}
+
+} // namespace logservice
+} // namespace cppmicroservices
@@ -0,0 +1,168 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <limits>
+#include <stdexcept>
+
+#include "LogServiceActivator.hpp"
+
+using cppmicroservices::logservice::SeverityLevel;
+
+namespace cppmicroservices {
+namespace logserviceimpl {
+
+const std::string LogServiceActivator::LOG_FILE_PROPERTY = "org.cppmicroservices.logservice.file";
+const std::string LogServiceActivator::LOG_LEVEL_PROPERTY = "org.cppmicroservices.logservice.level";
+const std::string LogServiceActivator::LOG_BUFFER_SIZE_PROPERTY = "org.cppmicroservices.logservice.buffer_size";
+const std::string LogServiceActivator::LOG_FORMAT_PROPERTY = "org.cppmicroservices.logservice.format";
+
+namespace {
+
+SeverityLevel ParseLevel(const cppmicroservices::Any& value)
+{
+  if (value.Empty())
+  {
+    return SeverityLevel::LOG_WARNING;
+  }
+  const auto level = cppmicroservices::any_cast<std::string>(value);
+  if (level == "error") return SeverityLevel::LOG_ERROR;
+  if (level == "warning") return SeverityLevel::LOG_WARNING;
+  if (level == "info") return SeverityLevel::LOG_INFO;
+  if (level == "debug") return SeverityLevel::LOG_DEBUG;
+  throw std::invalid_argument("Invalid value '" + level + "' for the property '" +
+                              LogServiceActivator::LOG_LEVEL_PROPERTY +
+                              "'. The valid choices are : [error, warning, info, debug]");
+}
+
+std::invalid_argument InvalidBufferSize()
+{
+  return std::invalid_argument("The property '" + LogServiceActivator::LOG_BUFFER_SIZE_PROPERTY +
+                               "' must be a positive integer");
+}
+
+template<typename T>
+std::size_t ToBufferSize(T number)
+{
+  if (number <= 0 ||
+      static_cast<unsigned long long>(number) > std::numeric_limits<std::size_t>::max())
+  {
+    throw InvalidBufferSize();
+  }
+  return static_cast<std::size_t>(number);
+}
+
+/**
+ * Stores the value of \c value in \c size if it holds a \c T.
+ *
+ * \return false if \c value does not hold a \c T
+ * \throws std::invalid_argument if the value is not a positive size
+ */
+template<typename T>
+bool TryGetBufferSize(const cppmicroservices::Any& value, std::size_t& size)
+{
+  if (value.Type() != typeid(T))
+  {
+    return false;
+  }
+  size = ToBufferSize(cppmicroservices::any_cast<T>(value));
+  return true;
+}
+
+std::size_t ParseBufferSize(const cppmicroservices::Any& value)
+{
+  if (value.Empty())
+  {
+    return LogServiceImpl::DefaultBufferCapacity;
+  }
+  std::size_t size = 0;
+  if (value.Type() == typeid(std::string))
+  {
+    const auto& text = cppmicroservices::ref_any_cast<std::string>(value);
+    std::size_t parsed = 0;
+    long long number = 0;
+    try
+    {
+      number = std::stoll(text, &parsed);
+    }
+    catch (const std::exception&)
+    {
+      throw InvalidBufferSize();
+    }
+    if (parsed != text.size())
+    {
+      throw InvalidBufferSize();
+    }
+    return ToBufferSize(number);
+  }
+  if (TryGetBufferSize<int>(value, size) ||
+      TryGetBufferSize<unsigned int>(value, size) ||
+      TryGetBufferSize<long>(value, size) ||
+      TryGetBufferSize<unsigned long>(value, size) ||
+      TryGetBufferSize<long long>(value, size) ||
+      TryGetBufferSize<unsigned long long>(value, size) ||
+      TryGetBufferSize<short>(value, size) ||
+      TryGetBufferSize<unsigned short>(value, size))
+  {
+    return size;
+  }
+  throw InvalidBufferSize();
+}
+
+LogSinkFormat ParseSinkFormat(const cppmicroservices::Any& value)
+{
+  if (value.Empty())
+  {
+    return LogSinkFormat::Text;
+  }
+  const auto format = cppmicroservices::any_cast<std::string>(value);
+  if (format == "text") return LogSinkFormat::Text;
+  if (format == "binary") return LogSinkFormat::Binary;
+  throw std::invalid_argument("Invalid value '" + format + "' for the property '" +
+                              LogServiceActivator::LOG_FORMAT_PROPERTY +
+                              "'. The valid choices are : [text, binary]");
+}
+
+}
+
+void LogServiceActivator::Start(cppmicroservices::BundleContext context)
+{
+  const auto filePath = context.GetProperty(LOG_FILE_PROPERTY);
+  logService = std::make_shared<LogServiceImpl>(filePath.Empty() ? std::string() : cppmicroservices::any_cast<std::string>(filePath),
+                                                ParseLevel(context.GetProperty(LOG_LEVEL_PROPERTY)),
+                                                ParseBufferSize(context.GetProperty(LOG_BUFFER_SIZE_PROPERTY)),
+                                                ParseSinkFormat(context.GetProperty(LOG_FORMAT_PROPERTY)));
+  logServiceReg = context.RegisterService<cppmicroservices::logservice::LogService>(logService);
+}
+
+void LogServiceActivator::Stop(cppmicroservices::BundleContext /*context*/)
+{
+  if (logServiceReg)
+  {
+    logServiceReg.Unregister();
+  }
+  // users still holding the service keep it alive; the last one flushes the records
+  logService.reset();
+}
+} // logserviceimpl
+} // cppmicroservices
+
+CPPMICROSERVICES_EXPORT_BUNDLE_ACTIVATOR(cppmicroservices::logserviceimpl::LogServiceActivator) // NOLINT
@@ -0,0 +1,74 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef __LOGSERVICEACTIVATOR_HPP__
+#define __LOGSERVICEACTIVATOR_HPP__
+
+#include <memory>
+#include <string>
+
+#include "cppmicroservices/BundleActivator.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/ServiceRegistration.h"
+#include "cppmicroservices/logservice/LogService.hpp"
+
+#include "LogServiceImpl.hpp"
+
+namespace cppmicroservices {
+namespace logserviceimpl {
+
+/**
+ * Registers a {@link LogServiceImpl} as the {@link LogService} of the
+ * framework. The service is configured through the framework properties
+ * #LOG_FILE_PROPERTY, #LOG_LEVEL_PROPERTY, #LOG_BUFFER_SIZE_PROPERTY and
+ * #LOG_FORMAT_PROPERTY.
+ */
+class LogServiceActivator
+  : public cppmicroservices::BundleActivator
+{
+public:
+  /// Path of the file the log is appended to. The log is written to the standard error stream if not set.
+  static const std::string LOG_FILE_PROPERTY;
+  /// Least severe level which is logged; one of "error", "warning", "info" or "debug". Defaults to "warning".
+  static const std::string LOG_LEVEL_PROPERTY;
+  /// Number of log records which can be queued for the writer thread; an integral value or a decimal string. Defaults to LogServiceImpl::DefaultBufferCapacity.
+  static const std::string LOG_BUFFER_SIZE_PROPERTY;
+  /// Form of the log file; one of "text" or "binary". Defaults to "text". A binary log requires LOG_FILE_PROPERTY.
+  static const std::string LOG_FORMAT_PROPERTY;
+
+  LogServiceActivator() = default;
+  LogServiceActivator(const LogServiceActivator&) = delete;
+  LogServiceActivator(LogServiceActivator&&) = delete;
+  LogServiceActivator& operator=(const LogServiceActivator&) = delete;
+  LogServiceActivator& operator=(LogServiceActivator&&) = delete;
+  ~LogServiceActivator() override = default;
+
+  // callback methods for bundle lifecycle
+  void Start(cppmicroservices::BundleContext context) override;
+  void Stop(cppmicroservices::BundleContext context) override;
+private:
+  std::shared_ptr<LogServiceImpl> logService;
+  cppmicroservices::ServiceRegistration<cppmicroservices::logservice::LogService> logServiceReg;
+};
+} // logserviceimpl
+} // cppmicroservices
+#endif // __LOGSERVICEACTIVATOR_HPP__
@@ -0,0 +1,437 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "LogServiceImpl.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <ctime>
+#include <stdexcept>
+
+#include <algorithm>
+#include <climits>
+
+#if defined(_WIN32)
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/logservice/BinaryLog.hpp"
+
+using cppmicroservices::logservice::LogArg;
+using cppmicroservices::logservice::LogFormat;
+using cppmicroservices::logservice::SeverityLevel;
+
+namespace cppmicroservices {
+namespace logserviceimpl {
+
+constexpr std::size_t LogServiceImpl::DefaultBufferCapacity;
+constexpr std::size_t LogServiceImpl::MaxBatchSize;
+constexpr std::chrono::milliseconds LogServiceImpl::IdleWakeupInterval;
+
+namespace {
+
+/**
+ * The format of records logged through the plain Log methods
+ */
+const LogFormat& GetPlainMessageFormat()
+{
+  static const LogFormat format("{}");
+  return format;
+}
+
+#if defined(_WIN32)
+/**
+ * Writes all \c size bytes of \c data, retrying partial writes.
+ *
+ * \return false if the sink reported an error
+ */
+bool WriteFully(int fd, const char* data, std::size_t size)
+{
+  while (size > 0)
+  {
+    const auto chunkSize = static_cast<unsigned int>(std::min<std::size_t>(size, INT_MAX));
+    const int written = _write(fd, data, chunkSize);
+    if (written < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+  return true;
+}
+#endif
+
+int OpenSink(const std::string& filePath, LogSinkFormat sinkFormat)
+{
+  if (filePath.empty())
+  {
+    if (sinkFormat == LogSinkFormat::Binary)
+    {
+      throw std::invalid_argument("A binary log requires a log file");
+    }
+    return 2; // standard error
+  }
+#if defined(_WIN32)
+  int fd = -1;
+  _sopen_s(&fd, filePath.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _SH_DENYNO, _S_IREAD | _S_IWRITE);
+#else
+  int fd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+#endif
+  if (fd < 0)
+  {
+    throw std::runtime_error("Failed to open the log file '" + filePath + "'");
+  }
+#if defined(_WIN32)
+  const bool isEmpty = (_lseek(fd, 0, SEEK_END) == 0);
+#else
+  const bool isEmpty = (::lseek(fd, 0, SEEK_END) == 0);
+#endif
+  if (sinkFormat == LogSinkFormat::Binary && isEmpty)
+  {
+    std::string header;
+    cppmicroservices::logservice::AppendBinaryLogHeader(header);
+#if defined(_WIN32)
+    if (!WriteFully(fd, header.data(), header.size()))
+    {
+      _close(fd);
+      throw std::runtime_error("Failed to write the header of the log file '" + filePath + "'");
+    }
+#else
+    if (::write(fd, header.data(), header.size()) != static_cast<ssize_t>(header.size()))
+    {
+      ::close(fd);
+      throw std::runtime_error("Failed to write the header of the log file '" + filePath + "'");
+    }
+#endif
+  }
+  return fd;
+}
+
+}
+
+LogServiceImpl::LogServiceImpl(const std::string& filePath,
+                               SeverityLevel threshold,
+                               std::size_t bufferCapacity,
+                               LogSinkFormat sinkFormat)
+  : fd(OpenSink(filePath, sinkFormat))
+  , ownsFd(!filePath.empty())
+  , threshold(threshold)
+  , buffer(bufferCapacity)
+  , acceptedCount(0)
+  , writtenCount(0)
+  , droppedCount(0)
+  , writerIdle(false)
+  , stopping(false)
+  , sinkFormat(sinkFormat)
+  , formatted(MaxBatchSize)
+{
+  writer = std::thread(&LogServiceImpl::WriterLoop, this);
+}
+
+LogServiceImpl::~LogServiceImpl()
+{
+  {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    stopping = true;
+  }
+  wakeWriter.notify_one();
+  writer.join();
+  if (ownsFd)
+  {
+#if defined(_WIN32)
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+  }
+}
+
+void LogServiceImpl::Log(SeverityLevel level, const std::string& message)
+{
+  Enqueue(level, message, nullptr, nullptr);
+}
+
+void LogServiceImpl::Log(SeverityLevel level, const std::string& message, const std::exception_ptr ex)
+{
+  Enqueue(level, message, nullptr, ex);
+}
+
+void LogServiceImpl::Log(const ServiceReferenceBase& sr, SeverityLevel level, const std::string& message)
+{
+  Enqueue(level, message, &sr, nullptr);
+}
+
+void LogServiceImpl::Log(const ServiceReferenceBase& sr, SeverityLevel level, const std::string& message, const std::exception_ptr ex)
+{
+  Enqueue(level, message, &sr, ex);
+}
+
+void LogServiceImpl::SetThreshold(SeverityLevel level)
+{
+  threshold.store(level, std::memory_order_relaxed);
+}
+
+SeverityLevel LogServiceImpl::GetThreshold() const
+{
+  return threshold.load(std::memory_order_relaxed);
+}
+
+bool LogServiceImpl::IsEnabled(SeverityLevel level) const
+{
+  return level <= threshold.load(std::memory_order_relaxed);
+}
+
+void LogServiceImpl::LogRecord(SeverityLevel level,
+                               const LogFormat& format,
+                               const LogArg* args,
+                               std::size_t argCount)
+{
+  if (!IsEnabled(level))
+  {
+    return;
+  }
+  std::string record;
+  cppmicroservices::logservice::AppendLogRecordEntry(record, level, std::chrono::system_clock::now(), format.GetId(), args, argCount);
+  Enqueue(std::move(record));
+}
+
+void LogServiceImpl::Flush()
+{
+  const auto target = acceptedCount.load();
+  std::unique_lock<std::mutex> lock(writerMutex);
+  wakeWriter.notify_one();
+  recordsWritten.wait(lock, [this, target]() { return writtenCount.load() >= target; });
+}
+
+unsigned long long LogServiceImpl::GetDroppedCount() const
+{
+  return droppedCount.load();
+}
+
+void LogServiceImpl::Enqueue(SeverityLevel level,
+                             const std::string& message,
+                             const ServiceReferenceBase* sr,
+                             const std::exception_ptr& ex)
+{
+  // filter before paying for any formatting
+  if (!IsEnabled(level))
+  {
+    return;
+  }
+
+  std::string text;
+  if (sr && *sr)
+  {
+    text += "[service.id=";
+    text += sr->GetProperty(cppmicroservices::Constants::SERVICE_ID).ToStringNoExcept();
+    text += "] ";
+  }
+  text += message;
+  if (ex)
+  {
+    try
+    {
+      std::rethrow_exception(ex);
+    }
+    catch (const std::exception& e)
+    {
+      text += " Exception: ";
+      text += e.what();
+    }
+    catch (...)
+    {
+      text += " Exception: unknown";
+    }
+  }
+
+  const LogArg arg(text);
+  std::string record;
+  cppmicroservices::logservice::AppendLogRecordEntry(record, level, std::chrono::system_clock::now(), GetPlainMessageFormat().GetId(), &arg, 1);
+  Enqueue(std::move(record));
+}
+
+void LogServiceImpl::Enqueue(std::string&& record)
+{
+  if (!buffer.TryPush(std::move(record)))
+  {
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  acceptedCount.fetch_add(1);
+  // The writer thread also wakes up periodically, so a wakeup missed
+  // here only delays the record by at most IdleWakeupInterval.
+  if (writerIdle.load())
+  {
+    wakeWriter.notify_one();
+  }
+}
+
+void LogServiceImpl::WriterLoop()
+{
+  std::vector<std::string> batch;
+  batch.reserve(MaxBatchSize);
+  std::string record;
+  for (;;)
+  {
+    while (batch.size() < MaxBatchSize && buffer.TryPop(record))
+    {
+      batch.push_back(std::move(record));
+    }
+
+    if (!batch.empty())
+    {
+      PrepareBatch(batch);
+      WriteChunks();
+      writtenCount.fetch_add(batch.size());
+      batch.clear();
+      {
+        // synchronize with Flush, which checks writtenCount under the lock
+        std::lock_guard<std::mutex> lock(writerMutex);
+      }
+      recordsWritten.notify_all();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(writerMutex);
+    if (stopping)
+    {
+      return;
+    }
+    writerIdle = true;
+    wakeWriter.wait_for(lock, IdleWakeupInterval, [this]() { return stopping || !buffer.Empty(); });
+    writerIdle = false;
+  }
+}
+
+void LogServiceImpl::PrepareBatch(const std::vector<std::string>& batch)
+{
+  chunks.clear();
+  // Each record needs at most one formatted string, so the preallocated
+  // strings suffice and keep their capacity from earlier batches.
+  std::size_t used = 0;
+  auto nextFormatted = [this, &used]() -> std::string& {
+    auto& str = formatted[used++];
+    str.clear();
+    return str;
+  };
+
+  cppmicroservices::logservice::LogRecordView view;
+  for (const auto& record : batch)
+  {
+    try
+    {
+      cppmicroservices::logservice::DecodeLogRecordEntry(record.data(), record.size(), view);
+      if (sinkFormat == LogSinkFormat::Binary)
+      {
+        if (definedFormats.insert(view.formatId).second)
+        {
+          auto& definition = nextFormatted();
+          cppmicroservices::logservice::AppendLogFormatEntry(definition, view.formatId, LogFormat::GetPattern(view.formatId));
+          chunks.push_back(&definition);
+        }
+        chunks.push_back(&record);
+      }
+      else
+      {
+        auto pattern = patterns.find(view.formatId);
+        if (pattern == patterns.end())
+        {
+          pattern = patterns.emplace(view.formatId, LogFormat::GetPattern(view.formatId)).first;
+        }
+        auto& line = nextFormatted();
+        cppmicroservices::logservice::AppendLogLine(line,
+                                                    view.level,
+                                                    view.timestamp,
+                                                    cppmicroservices::logservice::FormatLogMessage(pattern->second, view.args.data(), view.args.size()));
+        chunks.push_back(&line);
+      }
+    }
+    catch (const std::exception&)
+    {
+      // records are created by this object, so this is not expected; skip the record
+    }
+  }
+}
+
+void LogServiceImpl::WriteChunks()
+{
+#if defined(_WIN32)
+  for (const auto* chunk : chunks)
+  {
+    if (!WriteFully(fd, chunk->data(), chunk->size()))
+    {
+      return; // the sink is unusable, there is nowhere to report the error
+    }
+  }
+#else
+  // a batch writes at most one format definition per record
+  static_assert(2 * MaxBatchSize <= IOV_MAX, "a batch must fit into a single writev call");
+  struct iovec iov[2 * MaxBatchSize];
+  int count = 0;
+  for (const auto* chunk : chunks)
+  {
+    iov[count].iov_base = const_cast<char*>(chunk->data());
+    iov[count].iov_len = chunk->size();
+    ++count;
+  }
+  struct iovec* next = iov;
+  while (count > 0)
+  {
+    auto written = ::writev(fd, next, count);
+    if (written < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return; // the sink is unusable, there is nowhere to report the error
+    }
+    // skip the fully written chunks and adjust a partially written one
+    while (count > 0 && static_cast<std::size_t>(written) >= next->iov_len)
+    {
+      written -= next->iov_len;
+      ++next;
+      --count;
+    }
+    if (count > 0)
+    {
+      next->iov_base = static_cast<char*>(next->iov_base) + written;
+      next->iov_len -= written;
+    }
+  }
+#endif
+}
+
+} // logserviceimpl
+} // cppmicroservices
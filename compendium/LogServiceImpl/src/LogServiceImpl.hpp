@@ -0,0 +1,197 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef __LOGSERVICEIMPL_HPP__
+#define __LOGSERVICEIMPL_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cppmicroservices/logservice/LogService.hpp"
+#include "MPSCRingBuffer.hpp"
+
+namespace cppmicroservices {
+namespace logserviceimpl {
+
+/**
+ * The form in which a {@link LogServiceImpl} writes its records
+ */
+enum class LogSinkFormat
+{
+  Text,   ///< one line per record, see cppmicroservices::logservice::AppendLogLine
+  Binary  ///< the binary log format, see cppmicroservices::logservice::BinaryLogReader
+};
+
+/**
+ * An asynchronous implementation of the {@link LogService} interface.
+ *
+ * Messages below the severity threshold are discarded before any formatting
+ * takes place. Accepted messages are encoded on the calling thread as
+ * binary records, which keep structured arguments in typed form, and handed
+ * to a lock-free ring buffer. A background writer thread drains the buffer,
+ * formats the records if the sink is a text sink, and appends them to the
+ * sink in batches, using a single \c writev call per batch where available.
+ *
+ * Log methods never block on I/O. If the writer cannot keep up and the ring
+ * buffer is full, the message is dropped and counted, see #GetDroppedCount.
+ *
+ * @remarks This class is thread safe.
+ */
+class LogServiceImpl final
+  : public cppmicroservices::logservice::LogService
+  , public cppmicroservices::logservice::StructuredLogService
+{
+public:
+  static constexpr std::size_t DefaultBufferCapacity = 8192;
+
+  /**
+   * Creates the log service and starts its writer thread.
+   *
+   * \param filePath the file the log records are appended to. The file is
+   *        created if it does not exist. An empty path selects the standard
+   *        error stream.
+   * \param threshold the least severe level which is logged
+   * \param bufferCapacity the number of records which can be queued for
+   *        the writer thread
+   * \param sinkFormat the form in which records are written. A binary log
+   *        requires a file path.
+   * \throws std::runtime_error if the file cannot be opened
+   * \throws std::invalid_argument if a binary log is requested without a file path
+   */
+  LogServiceImpl(const std::string& filePath,
+                 cppmicroservices::logservice::SeverityLevel threshold,
+                 std::size_t bufferCapacity = DefaultBufferCapacity,
+                 LogSinkFormat sinkFormat = LogSinkFormat::Text);
+  LogServiceImpl(const LogServiceImpl&) = delete;
+  LogServiceImpl(LogServiceImpl&&) = delete;
+  LogServiceImpl& operator=(const LogServiceImpl&) = delete;
+  LogServiceImpl& operator=(LogServiceImpl&&) = delete;
+
+  /**
+   * Writes all queued records, stops the writer thread and closes the sink.
+   */
+  ~LogServiceImpl() override;
+
+  // methods from the cppmicroservices::logservice::LogService interface
+  void Log(cppmicroservices::logservice::SeverityLevel level, const std::string& message) override;
+  void Log(cppmicroservices::logservice::SeverityLevel level, const std::string& message, const std::exception_ptr ex) override;
+  void Log(const ServiceReferenceBase& sr, cppmicroservices::logservice::SeverityLevel level, const std::string& message) override;
+  void Log(const ServiceReferenceBase& sr, cppmicroservices::logservice::SeverityLevel level, const std::string& message, const std::exception_ptr ex) override;
+
+  // methods from the cppmicroservices::logservice::StructuredLogService interface
+  bool IsEnabled(cppmicroservices::logservice::SeverityLevel level) const override;
+  void LogRecord(cppmicroservices::logservice::SeverityLevel level,
+                 const cppmicroservices::logservice::LogFormat& format,
+                 const cppmicroservices::logservice::LogArg* args,
+                 std::size_t argCount) override;
+
+  /**
+   * Changes the least severe level which is logged
+   */
+  void SetThreshold(cppmicroservices::logservice::SeverityLevel level);
+
+  /**
+   * Returns the least severe level which is logged
+   */
+  cppmicroservices::logservice::SeverityLevel GetThreshold() const;
+
+  /**
+   * Blocks until every record accepted before this call is written to the
+   * sink. Must not be called from the writer thread.
+   */
+  void Flush();
+
+  /**
+   * Returns the number of records dropped because the ring buffer was full
+   */
+  unsigned long long GetDroppedCount() const;
+
+private:
+  /**
+   * Formats the message of a plain Log call and queues it for the writer
+   * thread, if \c level passes the threshold.
+   */
+  void Enqueue(cppmicroservices::logservice::SeverityLevel level,
+               const std::string& message,
+               const ServiceReferenceBase* sr,
+               const std::exception_ptr& ex);
+
+  /**
+   * Queues an encoded record for the writer thread
+   */
+  void Enqueue(std::string&& record);
+
+  /**
+   * Body of the writer thread
+   */
+  void WriterLoop();
+
+  /**
+   * Converts the encoded records in \c batch into the chunks written to
+   * the sink
+   */
+  void PrepareBatch(const std::vector<std::string>& batch);
+
+  /**
+   * Writes the prepared chunks to the sink
+   */
+  void WriteChunks();
+
+  /// Maximum number of records written with one system call
+  static constexpr std::size_t MaxBatchSize = 64;
+
+  /// Maximum time the writer thread sleeps before checking the buffer again
+  static constexpr std::chrono::milliseconds IdleWakeupInterval{ 20 };
+
+  int fd;                                                                ///< file descriptor of the sink
+  bool ownsFd;                                                           ///< true if \c fd is closed by this object
+  std::atomic<cppmicroservices::logservice::SeverityLevel> threshold;    ///< least severe level which is logged
+  MPSCRingBuffer<std::string> buffer;                                    ///< formatted records waiting for the writer thread
+  std::atomic<unsigned long long> acceptedCount;                         ///< number of records queued
+  std::atomic<unsigned long long> writtenCount;                          ///< number of records written by the writer thread
+  std::atomic<unsigned long long> droppedCount;                          ///< number of records dropped because the buffer was full
+  std::atomic<bool> writerIdle;                                          ///< true while the writer thread waits for records
+  std::atomic<bool> stopping;                                            ///< set when the writer thread must exit
+  std::mutex writerMutex;                                                ///< used with the condition variables below
+  std::condition_variable wakeWriter;                                    ///< signalled when records are queued
+  std::condition_variable recordsWritten;                                ///< signalled after each batch is written
+  std::thread writer;                                                    ///< the writer thread
+
+  // state only accessed by the writer thread
+  const LogSinkFormat sinkFormat;                                        ///< the form in which records are written
+  std::unordered_map<uint32_t, std::string> patterns;                    ///< patterns of the formats seen so far, for text sinks
+  std::unordered_set<uint32_t> definedFormats;                           ///< formats already defined in the binary log
+  std::vector<std::string> formatted;                                    ///< text lines or format definitions of the current batch
+  std::vector<const std::string*> chunks;                                ///< data written for the current batch, in order
+};
+
+} // logserviceimpl
+} // cppmicroservices
+
+#endif // __LOGSERVICEIMPL_HPP__
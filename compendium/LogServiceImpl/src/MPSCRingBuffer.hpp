@@ -0,0 +1,197 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef __MPSCRINGBUFFER_HPP__
+#define __MPSCRINGBUFFER_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace cppmicroservices {
+namespace logserviceimpl {
+
+/**
+ * A bounded, lock-free queue for many producers and a single consumer.
+ *
+ * Each cell carries a sequence number which tells producers whether the
+ * cell is free and tells the consumer whether the cell holds a value.
+ * Producers claim a cell with a single compare-and-swap on the enqueue
+ * position and never wait for each other or for the consumer; if the
+ * buffer is full, #TryPush fails immediately.
+ *
+ * \tparam T the element type, which must be default constructible and
+ *         move assignable
+ */
+template<typename T>
+class MPSCRingBuffer
+{
+public:
+  /**
+   * \param capacity the number of elements the buffer can hold. It is
+   *        rounded up to the next power of two.
+   * \throws std::invalid_argument if \c capacity is 0 or larger than the
+   *         largest power of two a \c std::size_t can hold
+   */
+  explicit MPSCRingBuffer(std::size_t capacity)
+    : mask(RoundUpToPowerOfTwo(capacity) - 1)
+    , cells(new Cell[mask + 1])
+    , enqueuePos(0)
+    , dequeuePos(0)
+  {
+    for (std::size_t i = 0; i <= mask; ++i)
+    {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MPSCRingBuffer(const MPSCRingBuffer&) = delete;
+  MPSCRingBuffer(MPSCRingBuffer&&) = delete;
+  MPSCRingBuffer& operator=(const MPSCRingBuffer&) = delete;
+  MPSCRingBuffer& operator=(MPSCRingBuffer&&) = delete;
+  ~MPSCRingBuffer() = default;
+
+  /**
+   * Appends \c value to the buffer. This method is safe to call from
+   * multiple threads concurrently and never blocks.
+   *
+   * \return \c true if the value was appended, \c false if the buffer is full
+   */
+  bool TryPush(T&& value)
+  {
+    auto pos = enqueuePos.value.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      Cell& cell = cells[pos & mask];
+      const auto seq = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0)
+      {
+        if (enqueuePos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          cell.value = std::move(value);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+      {
+        return false; // the consumer has not released this cell yet
+      }
+      else
+      {
+        pos = enqueuePos.value.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Removes the oldest value from the buffer. Must only be called from the
+   * consumer thread.
+   *
+   * \return \c true if a value was moved into \c value, \c false if the
+   *         buffer is empty
+   */
+  bool TryPop(T& value)
+  {
+    Cell& cell = cells[dequeuePos & mask];
+    const auto seq = cell.sequence.load(std::memory_order_acquire);
+    if (seq != dequeuePos + 1)
+    {
+      return false;
+    }
+    value = std::move(cell.value);
+    cell.value = T();
+    cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+    ++dequeuePos;
+    return true;
+  }
+
+  /**
+   * Returns \c true if the next value is not yet available to the
+   * consumer. Must only be called from the consumer thread.
+   */
+  bool Empty() const
+  {
+    return cells[dequeuePos & mask].sequence.load(std::memory_order_acquire) != dequeuePos + 1;
+  }
+
+  /**
+   * Returns the number of elements the buffer can hold
+   */
+  std::size_t Capacity() const { return mask + 1; }
+
+private:
+  static std::size_t RoundUpToPowerOfTwo(std::size_t capacity)
+  {
+    if (capacity == 0)
+    {
+      throw std::invalid_argument("MPSCRingBuffer capacity must be greater than 0");
+    }
+    // the largest power of two a std::size_t can hold
+    constexpr std::size_t maxCapacity = (std::numeric_limits<std::size_t>::max() >> 1) + 1;
+    if (capacity > maxCapacity)
+    {
+      throw std::invalid_argument("MPSCRingBuffer capacity must not exceed " + std::to_string(maxCapacity));
+    }
+    std::size_t result = 1;
+    while (result < capacity)
+    {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  struct Cell
+  {
+    std::atomic<std::size_t> sequence; ///< position for which the cell is free (== pos) or holds a value (== pos + 1)
+    T value;
+  };
+
+  static constexpr std::size_t CacheLineSize = 64;
+
+  /**
+   * Keeps the position written by the producers on its own cache line, away
+   * from the cells and from the position written by the consumer.
+   */
+  struct PaddedPosition
+  {
+    explicit PaddedPosition(std::size_t pos) : value(pos) {}
+    char padBefore[CacheLineSize];
+    std::atomic<std::size_t> value;
+    char padAfter[CacheLineSize - sizeof(std::atomic<std::size_t>)];
+  };
+
+  const std::size_t mask;
+  std::unique_ptr<Cell[]> cells;
+  PaddedPosition enqueuePos; ///< next position claimed by a producer
+  std::size_t dequeuePos;    ///< next position read by the consumer, only accessed by the consumer
+};
+
+} // logserviceimpl
+} // cppmicroservices
+
+#endif // __MPSCRINGBUFFER_HPP__
@@ -0,0 +1,255 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "cppmicroservices/util/FileSystem.h"
+#include "cppmicroservices/logservice/BinaryLog.hpp"
+#include "../src/LogServiceImpl.hpp"
+
+using cppmicroservices::logservice::LogArg;
+using cppmicroservices::logservice::LogFormat;
+using cppmicroservices::logservice::SeverityLevel;
+
+namespace cppmicroservices {
+namespace logserviceimpl {
+
+class LogServiceImplTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    tempDir = util::MakeUniqueTempDirectory();
+    logFile = tempDir + util::DIR_SEP + "log.txt";
+  }
+
+  void TearDown() override
+  {
+    util::RemoveDirectoryRecursive(tempDir);
+  }
+
+  std::vector<std::string> ReadLogLines() const
+  {
+    std::ifstream in(logFile);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line))
+    {
+      lines.push_back(line);
+    }
+    return lines;
+  }
+
+  std::string tempDir;
+  std::string logFile;
+};
+
+TEST_F(LogServiceImplTest, VerifyRecordsWritten)
+{
+  LogServiceImpl logService(logFile, SeverityLevel::LOG_DEBUG);
+  logService.Log(SeverityLevel::LOG_ERROR, "first message");
+  logService.Log(SeverityLevel::LOG_DEBUG, "second message");
+  logService.Flush();
+  auto lines = ReadLogLines();
+  ASSERT_EQ(lines.size(), 2ul);
+  EXPECT_THAT(lines[0], ::testing::HasSubstr("[ERROR] first message"));
+  EXPECT_THAT(lines[1], ::testing::HasSubstr("[DEBUG] second message"));
+  EXPECT_THAT(lines[0], ::testing::MatchesRegex("[0-9]{4}-[0-9]{2}-[0-9]{2}T[0-9]{2}:[0-9]{2}:[0-9]{2}\\.[0-9]{3}Z .*"));
+}
+
+TEST_F(LogServiceImplTest, VerifyThreshold)
+{
+  LogServiceImpl logService(logFile, SeverityLevel::LOG_WARNING);
+  EXPECT_EQ(logService.GetThreshold(), SeverityLevel::LOG_WARNING);
+  logService.Log(SeverityLevel::LOG_INFO, "filtered");
+  logService.Log(SeverityLevel::LOG_WARNING, "logged");
+  logService.SetThreshold(SeverityLevel::LOG_INFO);
+  logService.Log(SeverityLevel::LOG_INFO, "logged after threshold change");
+  logService.Log(SeverityLevel::LOG_DEBUG, "filtered");
+  logService.Flush();
+  auto lines = ReadLogLines();
+  ASSERT_EQ(lines.size(), 2ul);
+  EXPECT_THAT(lines[0], ::testing::HasSubstr("[WARNING] logged"));
+  EXPECT_THAT(lines[1], ::testing::HasSubstr("[INFO] logged after threshold change"));
+}
+
+TEST_F(LogServiceImplTest, VerifyExceptionLogged)
+{
+  LogServiceImpl logService(logFile, SeverityLevel::LOG_ERROR);
+  logService.Log(SeverityLevel::LOG_ERROR, "failure", std::make_exception_ptr(std::runtime_error("bad state")));
+  logService.Log(SeverityLevel::LOG_ERROR, "unknown failure", std::make_exception_ptr(42));
+  logService.Flush();
+  auto lines = ReadLogLines();
+  ASSERT_EQ(lines.size(), 2ul);
+  EXPECT_THAT(lines[0], ::testing::HasSubstr("failure Exception: bad state"));
+  EXPECT_THAT(lines[1], ::testing::HasSubstr("unknown failure Exception: unknown"));
+}
+
+TEST_F(LogServiceImplTest, VerifyRecordsWrittenOnDestruction)
+{
+  {
+    LogServiceImpl logService(logFile, SeverityLevel::LOG_INFO);
+    for (int i = 0; i < 100; ++i)
+    {
+      logService.Log(SeverityLevel::LOG_INFO, "message " + std::to_string(i));
+    }
+  }
+  auto lines = ReadLogLines();
+  ASSERT_EQ(lines.size(), 100ul) << "queued records must be written when the service is destroyed";
+  EXPECT_THAT(lines.back(), ::testing::HasSubstr("message 99"));
+}
+
+TEST_F(LogServiceImplTest, VerifyConcurrentProducers)
+{
+  const int numProducers = 16;
+  const int messagesPerProducer = 1000;
+  // a small buffer forces records to be dropped while the writer catches up
+  LogServiceImpl logService(logFile, SeverityLevel::LOG_INFO, 16);
+  std::vector<std::future<void>> producers;
+  for (int p = 0; p < numProducers; ++p)
+  {
+    producers.push_back(std::async(std::launch::async,
+                                   [&logService, messagesPerProducer]()
+                                   {
+                                     for (int i = 0; i < messagesPerProducer; ++i)
+                                     {
+                                       logService.Log(SeverityLevel::LOG_INFO, "concurrent message");
+                                     }
+                                   }));
+  }
+  for (auto& producer : producers)
+  {
+    producer.get();
+  }
+  logService.Flush();
+  auto lines = ReadLogLines();
+  EXPECT_EQ(lines.size() + logService.GetDroppedCount(), static_cast<std::size_t>(numProducers * messagesPerProducer))
+    << "every record must either be written or counted as dropped";
+  for (const auto& line : lines)
+  {
+    EXPECT_THAT(line, ::testing::HasSubstr("[INFO] concurrent message"));
+  }
+}
+
+TEST_F(LogServiceImplTest, VerifyInvalidFile)
+{
+  EXPECT_THROW(LogServiceImpl(tempDir + util::DIR_SEP + "missing" + util::DIR_SEP + "log.txt", SeverityLevel::LOG_INFO),
+               std::runtime_error);
+}
+
+TEST_F(LogServiceImplTest, VerifyStructuredRecords)
+{
+  static const LogFormat format("bundle {} has {} components, enabled={}, load={}");
+  LogServiceImpl logService(logFile, SeverityLevel::LOG_INFO);
+  EXPECT_TRUE(logService.IsEnabled(SeverityLevel::LOG_INFO));
+  EXPECT_FALSE(logService.IsEnabled(SeverityLevel::LOG_DEBUG));
+  logService.LogStructured(SeverityLevel::LOG_INFO, format, std::string("sample"), 3u, true, 0.5);
+  logService.LogStructured(SeverityLevel::LOG_DEBUG, format, "filtered", -1, false, 0.0);
+  logService.Flush();
+  auto lines = ReadLogLines();
+  ASSERT_EQ(lines.size(), 1ul);
+  EXPECT_THAT(lines[0], ::testing::HasSubstr("[INFO] bundle sample has 3 components, enabled=true, load=0.5"));
+}
+
+TEST_F(LogServiceImplTest, VerifyStructuredRecordsThroughLogService)
+{
+  // a log service without the StructuredLogService extension gets the formatted message
+  class PlainLogService : public cppmicroservices::logservice::LogService
+  {
+  public:
+    MOCK_METHOD2(Log, void(SeverityLevel, const std::string&));
+    MOCK_METHOD3(Log, void(SeverityLevel, const std::string&, const std::exception_ptr));
+    MOCK_METHOD3(Log, void(const ServiceReferenceBase&, SeverityLevel, const std::string&));
+    MOCK_METHOD4(Log, void(const ServiceReferenceBase&, SeverityLevel, const std::string&, const std::exception_ptr));
+  };
+  static const LogFormat format("bundle {} has {} components");
+  PlainLogService plainLogService;
+  EXPECT_CALL(plainLogService, Log(SeverityLevel::LOG_INFO, std::string("bundle sample has 3 components"))).Times(1);
+  cppmicroservices::logservice::LogStructured(plainLogService, SeverityLevel::LOG_INFO, format, "sample", 3);
+
+  LogServiceImpl logService(logFile, SeverityLevel::LOG_INFO);
+  cppmicroservices::logservice::LogService& base = logService;
+  cppmicroservices::logservice::LogStructured(base, SeverityLevel::LOG_INFO, format, "sample", 3);
+  cppmicroservices::logservice::LogStructured(base, SeverityLevel::LOG_DEBUG, format, "filtered", 0);
+  logService.Flush();
+  auto lines = ReadLogLines();
+  ASSERT_EQ(lines.size(), 1ul);
+  EXPECT_THAT(lines[0], ::testing::HasSubstr("[INFO] bundle sample has 3 components"));
+}
+
+TEST_F(LogServiceImplTest, VerifyBinarySink)
+{
+  static const LogFormat format("service {} bound to {}");
+  {
+    LogServiceImpl logService(logFile, SeverityLevel::LOG_DEBUG, LogServiceImpl::DefaultBufferCapacity, LogSinkFormat::Binary);
+    logService.LogStructured(SeverityLevel::LOG_DEBUG, format, 42l, "reference");
+    logService.Log(SeverityLevel::LOG_WARNING, "plain message");
+    logService.LogStructured(SeverityLevel::LOG_ERROR, format, -7, "other");
+  }
+
+  std::ifstream in(logFile, std::ios::binary);
+  cppmicroservices::logservice::BinaryLogReader reader(in);
+  cppmicroservices::logservice::BinaryLogReader::Record record;
+  std::vector<cppmicroservices::logservice::BinaryLogReader::Record> records;
+  while (reader.ReadNext(record))
+  {
+    records.push_back(record);
+  }
+  ASSERT_EQ(records.size(), 3ul);
+  EXPECT_EQ(records[0].level, SeverityLevel::LOG_DEBUG);
+  EXPECT_EQ(records[0].message, "service 42 bound to reference");
+  EXPECT_EQ(records[1].level, SeverityLevel::LOG_WARNING);
+  EXPECT_EQ(records[1].message, "plain message");
+  EXPECT_EQ(records[2].message, "service -7 bound to other");
+}
+
+TEST_F(LogServiceImplTest, VerifyBinarySinkRequiresFile)
+{
+  EXPECT_THROW(LogServiceImpl("", SeverityLevel::LOG_INFO, LogServiceImpl::DefaultBufferCapacity, LogSinkFormat::Binary),
+               std::invalid_argument);
+}
+
+TEST(StructuredLogTest, VerifyFormatLogMessage)
+{
+  const std::string text("text");
+  const LogArg args[] = { LogArg(1), LogArg(text) };
+  EXPECT_EQ(cppmicroservices::logservice::FormatLogMessage("{} and {}", args, 2), "1 and text");
+  EXPECT_EQ(cppmicroservices::logservice::FormatLogMessage("{} and {} and {}", args, 2), "1 and text and {}")
+    << "placeholders without an argument are kept";
+  EXPECT_EQ(cppmicroservices::logservice::FormatLogMessage("no placeholder", args, 2), "no placeholder");
+
+  LogFormat first("same pattern {}");
+  LogFormat second("same pattern {}");
+  EXPECT_NE(first.GetId(), 0u);
+  EXPECT_EQ(first.GetId(), second.GetId());
+  EXPECT_EQ(LogFormat::GetPattern(first.GetId()), "same pattern {}");
+  EXPECT_THROW(LogFormat::GetPattern(0), std::out_of_range);
+}
+
+} // logserviceimpl
+} // cppmicroservices
@@ -0,0 +1,115 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "../src/MPSCRingBuffer.hpp"
+
+namespace cppmicroservices {
+namespace logserviceimpl {
+
+TEST(MPSCRingBufferTest, VerifyCapacity)
+{
+  EXPECT_THROW(MPSCRingBuffer<int>(0), std::invalid_argument);
+  EXPECT_EQ(MPSCRingBuffer<int>(1).Capacity(), 1ul);
+  EXPECT_EQ(MPSCRingBuffer<int>(5).Capacity(), 8ul);
+  EXPECT_EQ(MPSCRingBuffer<int>(64).Capacity(), 64ul);
+  // capacities which cannot be rounded up to a power of two
+  const auto maxCapacity = (std::numeric_limits<std::size_t>::max() >> 1) + 1;
+  EXPECT_THROW(MPSCRingBuffer<int>(maxCapacity + 1), std::invalid_argument);
+  EXPECT_THROW(MPSCRingBuffer<int>(std::numeric_limits<std::size_t>::max()), std::invalid_argument);
+}
+
+TEST(MPSCRingBufferTest, VerifyPushPop)
+{
+  MPSCRingBuffer<std::string> buffer(4);
+  std::string value;
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_FALSE(buffer.TryPop(value));
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_TRUE(buffer.TryPush(std::to_string(i)));
+  }
+  EXPECT_FALSE(buffer.TryPush("overflow")) << "push must fail when the buffer is full";
+  for (int i = 0; i < 4; ++i)
+  {
+    ASSERT_TRUE(buffer.TryPop(value));
+    EXPECT_EQ(value, std::to_string(i)) << "values must be popped in FIFO order";
+  }
+  EXPECT_TRUE(buffer.Empty());
+  // the buffer wraps around
+  EXPECT_TRUE(buffer.TryPush("wrapped"));
+  ASSERT_TRUE(buffer.TryPop(value));
+  EXPECT_EQ(value, "wrapped");
+}
+
+TEST(MPSCRingBufferTest, VerifyConcurrentProducers)
+{
+  const int numProducers = 8;
+  const int valuesPerProducer = 2000;
+  MPSCRingBuffer<int> buffer(128);
+  std::vector<std::future<void>> producers;
+  for (int p = 0; p < numProducers; ++p)
+  {
+    producers.push_back(std::async(std::launch::async,
+                                   [&buffer, p, valuesPerProducer]()
+                                   {
+                                     for (int i = 0; i < valuesPerProducer; ++i)
+                                     {
+                                       int value = p * valuesPerProducer + i;
+                                       while (!buffer.TryPush(std::move(value)))
+                                       {
+                                         std::this_thread::yield();
+                                       }
+                                     }
+                                   }));
+  }
+
+  // every value arrives exactly once, and in order for each producer
+  std::vector<int> lastSeen(numProducers, -1);
+  int received = 0;
+  int value = 0;
+  while (received < numProducers * valuesPerProducer)
+  {
+    if (buffer.TryPop(value))
+    {
+      const int producer = value / valuesPerProducer;
+      EXPECT_GT(value % valuesPerProducer, lastSeen[producer]);
+      lastSeen[producer] = value % valuesPerProducer;
+      ++received;
+    }
+  }
+  for (auto& producer : producers)
+  {
+    producer.get();
+  }
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_TRUE(std::all_of(lastSeen.begin(), lastSeen.end(), [valuesPerProducer](int last) { return last == valuesPerProducer - 1; }));
+}
+
+} // logserviceimpl
+} // cppmicroservices
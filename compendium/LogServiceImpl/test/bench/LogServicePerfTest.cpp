@@ -0,0 +1,107 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "benchmark/benchmark.h"
+
+#include "../../src/LogServiceImpl.hpp"
+
+#include <memory>
+
+using cppmicroservices::logservice::SeverityLevel;
+using cppmicroservices::logserviceimpl::LogServiceImpl;
+
+namespace {
+
+std::unique_ptr<LogServiceImpl> logService;
+
+#if defined(_WIN32)
+const char* const NullDevice = "NUL";
+#else
+const char* const NullDevice = "/dev/null";
+#endif
+
+/// Creates the log service shared by all benchmark threads. The sink is the
+/// null device so that the writer thread is never the bottleneck because
+/// of disk speed.
+void CreateLogService(SeverityLevel threshold)
+{
+  logService = std::make_unique<LogServiceImpl>(NullDevice, threshold);
+}
+
+/// Reports the records dropped because the ring buffer was full and
+/// destroys the log service
+void DestroyLogService(benchmark::State& state)
+{
+  state.counters["dropped"] = static_cast<double>(logService->GetDroppedCount());
+  logService.reset();
+}
+
+} // namespace
+
+/// Benchmark the latency of a Log() call which passes the severity threshold,
+/// called concurrently from many producer threads.
+static void LogAcceptedMessage(benchmark::State& state)
+{
+  if (state.thread_index == 0) {
+    CreateLogService(SeverityLevel::LOG_INFO);
+  }
+
+  // The log service is only guaranteed to be created once all threads
+  // entered the benchmark loop.
+  LogServiceImpl* service = nullptr;
+  const std::string message("a log message of typical length, about sixty characters");
+  for (auto _ : state) {
+    if (!service) {
+      service = logService.get();
+    }
+    service->Log(SeverityLevel::LOG_INFO, message);
+  }
+
+  if (state.thread_index == 0) {
+    DestroyLogService(state);
+  }
+}
+
+/// Benchmark the latency of a Log() call which is discarded by the severity
+/// threshold, called concurrently from many producer threads.
+static void LogFilteredMessage(benchmark::State& state)
+{
+  if (state.thread_index == 0) {
+    CreateLogService(SeverityLevel::LOG_WARNING);
+  }
+
+  LogServiceImpl* service = nullptr;
+  const std::string message("a log message of typical length, about sixty characters");
+  for (auto _ : state) {
+    if (!service) {
+      service = logService.get();
+    }
+    service->Log(SeverityLevel::LOG_DEBUG, message);
+  }
+
+  if (state.thread_index == 0) {
+    DestroyLogService(state);
+  }
+}
+
+BENCHMARK(LogAcceptedMessage)->Threads(1)->Threads(64)->UseRealTime();
+BENCHMARK(LogFilteredMessage)->Threads(1)->Threads(64)->UseRealTime();
@@ -69,15 +69,44 @@ class US_ServiceComponent_EXPORT ComponentInstance {
   virtual void Modified() = 0;
 
   /**
-   * This method is called by the runtime to bind a reference with dynamic policy
+   * This method is called by the runtime to unbind a service from a reference with
+   * dynamic policy while the component configuration stays active
    */
   virtual void InvokeUnbindMethod(const std::string& refName, const cppmicroservices::ServiceReferenceBase& sRef) = 0;
 
   /**
-   * This method is called by the runtime to unbind a reference with dynamic policy
+   * This method is called by the runtime to bind a service to a reference with
+   * dynamic policy while the component configuration stays active
    */
   virtual void InvokeBindMethod(const std::string& refName, const cppmicroservices::ServiceReferenceBase& sRef) = 0;
 
+  /**
+   * This method is called by the runtime to unbind \c service, the service object bound for
+   * \c sRef, from a reference with dynamic policy while the component configuration stays active.
+   * The default implementation calls {@code #InvokeUnbindMethod}, which retrieves the service
+   * object again.
+   */
+  virtual void InvokeUnbindMethodWithService(const std::string& refName,
+                                             const cppmicroservices::ServiceReferenceBase& sRef,
+                                             const cppmicroservices::InterfaceMapConstPtr& /*service*/)
+  {
+    InvokeUnbindMethod(refName, sRef);
+  }
+
+  /**
+   * This method is called by the runtime to bind \c service, the service object it retrieved for
+   * \c sRef, to a reference with dynamic policy while the component configuration stays active.
+   * The runtime passes the object it also returns from the component context, so that both
+   * refer to the same object for references with prototype scope. The default implementation
+   * calls {@code #InvokeBindMethod}, which retrieves the service object again.
+   */
+  virtual void InvokeBindMethodWithService(const std::string& refName,
+                                           const cppmicroservices::ServiceReferenceBase& sRef,
+                                           const cppmicroservices::InterfaceMapConstPtr& /*service*/)
+  {
+    InvokeBindMethod(refName, sRef);
+  }
+
   /**
    * This method is called when a call to @{code ServiceFactory#GetService} is received by the runtime.
    */
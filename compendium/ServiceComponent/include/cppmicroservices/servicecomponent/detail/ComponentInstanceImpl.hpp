@@ -25,6 +25,8 @@
 
 #include <cassert>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include <array>
 #include <tuple>
@@ -142,6 +144,22 @@ public:
     refBinders.at(index)->Bind(mContext->GetBundleContext(), sRef, mServiceImpl);
   };
 
+  void InvokeUnbindMethodWithService(const std::string& refName
+                                     , const cppmicroservices::ServiceReferenceBase& /*sRef*/
+                                     , const cppmicroservices::InterfaceMapConstPtr& service) override
+  {
+    auto& binder = refBinders.at(refBinderMap.at(refName));
+    binder->Unbind(ExtractService(service, binder->GetReferenceType()), mServiceImpl);
+  };
+
+  void InvokeBindMethodWithService(const std::string& refName
+                                   , const cppmicroservices::ServiceReferenceBase& /*sRef*/
+                                   , const cppmicroservices::InterfaceMapConstPtr& service) override
+  {
+    auto& binder = refBinders.at(refBinderMap.at(refName));
+    binder->Bind(ExtractService(service, binder->GetReferenceType()), mServiceImpl);
+  };
+
   virtual std::shared_ptr<T> GetInstance() const { return mServiceImpl; };
 
   cppmicroservices::InterfaceMapPtr GetInterfaceMap() override
@@ -159,6 +177,22 @@ public:
     return iMap;
   }
 
+  /**
+   * Returns the interface \c interfaceId of the service object \c service
+   *
+   * \throws std::runtime_error if \c service does not provide the interface
+   */
+  static std::shared_ptr<void> ExtractService(const cppmicroservices::InterfaceMapConstPtr& service
+                                              , const std::string& interfaceId)
+  {
+    auto serviceObj = cppmicroservices::ExtractInterface(service, interfaceId);
+    if(!serviceObj)
+    {
+      throw std::runtime_error("Invalid service object");
+    }
+    return serviceObj;
+  }
+
   template <class ...Args>
   cppmicroservices::InterfaceMapPtr GetInterfaceMapHelper(Args...)
   {
@@ -115,6 +115,27 @@ struct US_ServiceComponent_EXPORT ComponentConfigurationDTO {
    * empty if the component configuration has no unsatisfied references.
    */
   std::vector<UnsatisfiedReferenceDTO>	unsatisfiedReferences;
+
+  /**
+   * The number of service requests served by a pooled component instance.
+   *
+   * <p>
+   * Only components with prototype service scope and a non-zero
+   * \c instance-pool-size in their component description pool their
+   * instances. The value is zero for all other component configurations.
+   */
+  unsigned long instancePoolHits;
+
+  /**
+   * The number of service requests which created a new component instance
+   * because no pooled instance was available.
+   *
+   * <p>
+   * The hit rate of the instance pool is
+   * {@code instancePoolHits / (instancePoolHits + instancePoolMisses)}.
+   * The value is zero for component configurations without an instance pool.
+   */
+  unsigned long instancePoolMisses;
 };
 }
 }
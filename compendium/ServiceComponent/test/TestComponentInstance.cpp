@@ -373,6 +373,16 @@ TEST(ComponentInstanceImpl, VerifyWithDynamicDependencies)
   EXPECT_NO_THROW(compInstance.InvokeBindMethod("foo", fc.GetServiceReference<ServiceDependency1>()));
   ASSERT_NE(compObj->GetFoo(), nullptr);
 
+  // the runtime may pass the service object to use, the instance must be bound to exactly that object
+  auto fooObj = std::make_shared<ServiceDependency1>();
+  auto fooService = cppmicroservices::MakeInterfaceMap<ServiceDependency1>(fooObj);
+  EXPECT_THROW(compInstance.InvokeBindMethodWithService("bar", fc.GetServiceReference<ServiceDependency2>(), fooService), std::out_of_range);
+  EXPECT_NO_THROW(compInstance.InvokeBindMethodWithService("foo", fc.GetServiceReference<ServiceDependency1>(), fooService));
+  ASSERT_EQ(compObj->GetFoo(), fooObj);
+  EXPECT_THROW(compInstance.InvokeUnbindMethodWithService("foo", fc.GetServiceReference<ServiceDependency1>(), std::make_shared<cppmicroservices::InterfaceMap>()), std::runtime_error);
+  EXPECT_NO_THROW(compInstance.InvokeUnbindMethodWithService("foo", fc.GetServiceReference<ServiceDependency1>(), fooService));
+  ASSERT_EQ(compObj->GetFoo(), nullptr);
+
   f.Stop();
   f.WaitForStop(std::chrono::milliseconds::zero());
 }
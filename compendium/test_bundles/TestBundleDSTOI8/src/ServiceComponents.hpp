@@ -0,0 +1,6 @@
+#ifndef SERVICECOMPONENTS_HPP
+#define SERVICECOMPONENTS_HPP
+
+#include "ServiceImpl.hpp"
+
+#endif
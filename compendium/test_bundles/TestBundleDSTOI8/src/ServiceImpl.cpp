@@ -0,0 +1,39 @@
+#include "ServiceImpl.hpp"
+#include <stdexcept>
+
+namespace sample {
+
+void ServiceComponent8::Activate(const std::shared_ptr<ComponentContext>& /*ctxt*/)
+{
+}
+
+void ServiceComponent8::Deactivate(const std::shared_ptr<ComponentContext>&)
+{
+}
+
+std::string ServiceComponent8::ExtendedDescription()
+{
+  std::lock_guard<std::mutex> lock(fooMutex);
+  if(!foo)
+  {
+    throw std::runtime_error("Dependency not available");
+  }
+  return foo->Description();
+}
+
+void ServiceComponent8::Bindfoo(const std::shared_ptr<test::Interface1>& theFoo)
+{
+  std::lock_guard<std::mutex> lock(fooMutex);
+  foo = theFoo;
+}
+
+void ServiceComponent8::Unbindfoo(const std::shared_ptr<test::Interface1>& theFoo)
+{
+  std::lock_guard<std::mutex> lock(fooMutex);
+  if (foo == theFoo)
+  {
+    foo = nullptr;
+  }
+}
+
+} // namespaces
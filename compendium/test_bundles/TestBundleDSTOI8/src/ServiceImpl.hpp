@@ -0,0 +1,31 @@
+#ifndef _SERVICE_IMPL_HPP_
+#define _SERVICE_IMPL_HPP_
+
+#include <mutex>
+#include "cppmicroservices/servicecomponent/ComponentContext.hpp"
+#include "TestInterfaces/Interfaces.hpp"
+
+using ComponentContext = cppmicroservices::service::component::ComponentContext;
+
+namespace sample {
+
+class ServiceComponent8
+  : public test::Interface2
+{
+public:
+  ServiceComponent8() = default;
+  std::string ExtendedDescription() override;
+  void Activate(const std::shared_ptr<ComponentContext>&);
+  void Deactivate(const std::shared_ptr<ComponentContext>&);
+  ~ServiceComponent8() = default;
+
+  void Bindfoo(const std::shared_ptr<test::Interface1>&);
+  void Unbindfoo(const std::shared_ptr<test::Interface1>&);
+private:
+  std::mutex fooMutex;
+  std::shared_ptr<test::Interface1> foo;
+};
+
+} // namespaces
+
+#endif // _SERVICE_IMPL_HPP_
@@ -0,0 +1,60 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "LogDecoder.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include "cppmicroservices/logservice/BinaryLog.hpp"
+
+using cppmicroservices::logservice::AppendLogLine;
+using cppmicroservices::logservice::BinaryLogReader;
+
+namespace logdecoder {
+
+bool DecodeBinaryLog(std::istream& in, std::ostream& out, std::ostream& err)
+{
+  std::size_t recordCount = 0;
+  try
+  {
+    BinaryLogReader reader(in);
+    BinaryLogReader::Record record;
+    std::string line;
+    while (reader.ReadNext(record))
+    {
+      line.clear();
+      AppendLogLine(line, record.level, record.timestamp, record.message);
+      out << line;
+      ++recordCount;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    out.flush();
+    err << "Error after " << recordCount << " records: " << e.what() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace logdecoder
@@ -0,0 +1,43 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef LOGDECODER_HPP
+#define LOGDECODER_HPP
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+
+namespace logdecoder {
+
+/**
+ * Writes the records of the binary log read from \c in to \c out, one text
+ * line per record. If the log is invalid, the records decoded so far are
+ * written and the error is reported on \c err.
+ *
+ * \return \c true if the whole log was decoded
+ */
+bool DecodeBinaryLog(std::istream& in, std::ostream& out, std::ostream& err);
+
+} // namespace logdecoder
+
+#endif // LOGDECODER_HPP
@@ -0,0 +1,63 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "LogDecoder.hpp"
+
+namespace {
+
+void PrintUsage(const std::string& program)
+{
+  std::cerr << "Usage: " << program << " <binary-log-file>\n"
+            << "Prints the records of a binary log written by the log service as text.\n"
+            << "Use '-' to read the log from the standard input.\n";
+}
+
+}
+
+int main(int argc, const char** argv)
+{
+  const int FailureReturnCode = -1;
+  if (argc != 2)
+  {
+    PrintUsage(argv[0]);
+    return FailureReturnCode;
+  }
+
+  const std::string inputPath(argv[1]);
+  std::ifstream file;
+  if (inputPath != "-")
+  {
+    file.open(inputPath, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+      std::cerr << "Error: cannot open the file " << inputPath << std::endl;
+      return FailureReturnCode;
+    }
+  }
+  std::istream& in = (inputPath == "-") ? std::cin : file;
+
+  return logdecoder::DecodeBinaryLog(in, std::cout, std::cerr) ? 0 : FailureReturnCode;
+}
@@ -0,0 +1,123 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "cppmicroservices/logservice/BinaryLog.hpp"
+#include "../LogDecoder.hpp"
+
+using cppmicroservices::logservice::AppendBinaryLogHeader;
+using cppmicroservices::logservice::AppendLogFormatEntry;
+using cppmicroservices::logservice::AppendLogLine;
+using cppmicroservices::logservice::AppendLogRecordEntry;
+using cppmicroservices::logservice::LogArg;
+using cppmicroservices::logservice::SeverityLevel;
+
+namespace logdecoder {
+
+class LogDecoderTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    timestamp = std::chrono::system_clock::time_point(std::chrono::seconds(1500000000));
+    AppendBinaryLogHeader(log);
+    AppendLogFormatEntry(log, 1, "service {} bound to {}");
+    const LogArg args[] = { LogArg(42l), LogArg("reference") };
+    AppendLogRecordEntry(log, SeverityLevel::LOG_DEBUG, timestamp, 1, args, 2);
+    firstRecordEnd = log.size();
+    AppendLogFormatEntry(log, 2, "{} records dropped");
+    const LogArg dropped[] = { LogArg(7u) };
+    AppendLogRecordEntry(log, SeverityLevel::LOG_WARNING, timestamp, 2, dropped, 1);
+
+    AppendLogLine(expected, SeverityLevel::LOG_DEBUG, timestamp, "service 42 bound to reference");
+    AppendLogLine(expected, SeverityLevel::LOG_WARNING, timestamp, "7 records dropped");
+  }
+
+  std::chrono::system_clock::time_point timestamp;
+  std::string log;            ///< a binary log with two records
+  std::size_t firstRecordEnd; ///< the size of the log up to the end of the first record
+  std::string expected;       ///< the text form of the records in #log
+};
+
+TEST_F(LogDecoderTest, VerifyDecodedRecords)
+{
+  std::istringstream in(log);
+  std::ostringstream out;
+  std::ostringstream err;
+  EXPECT_TRUE(DecodeBinaryLog(in, out, err));
+  EXPECT_EQ(out.str(), expected);
+  EXPECT_TRUE(err.str().empty());
+}
+
+TEST_F(LogDecoderTest, VerifyEmptyLog)
+{
+  std::string header;
+  AppendBinaryLogHeader(header);
+  std::istringstream in(header);
+  std::ostringstream out;
+  std::ostringstream err;
+  EXPECT_TRUE(DecodeBinaryLog(in, out, err));
+  EXPECT_TRUE(out.str().empty());
+}
+
+TEST_F(LogDecoderTest, VerifyMissingHeader)
+{
+  std::istringstream in("plain text log\n");
+  std::ostringstream out;
+  std::ostringstream err;
+  EXPECT_FALSE(DecodeBinaryLog(in, out, err));
+  EXPECT_TRUE(out.str().empty());
+  EXPECT_EQ(err.str().find("Error after 0 records"), 0ul) << err.str();
+}
+
+TEST_F(LogDecoderTest, VerifyTruncatedLog)
+{
+  // the records before the truncated one are still written
+  std::istringstream in(log.substr(0, log.size() - 1));
+  std::ostringstream out;
+  std::ostringstream err;
+  EXPECT_FALSE(DecodeBinaryLog(in, out, err));
+  std::string firstLine;
+  AppendLogLine(firstLine, SeverityLevel::LOG_DEBUG, timestamp, "service 42 bound to reference");
+  EXPECT_EQ(out.str(), firstLine);
+  EXPECT_EQ(err.str().find("Error after 1 records"), 0ul) << err.str();
+}
+
+TEST_F(LogDecoderTest, VerifyUndefinedFormat)
+{
+  // drop the definition of the second format
+  std::string secondFormat;
+  AppendLogFormatEntry(secondFormat, 2, "{} records dropped");
+  auto corrupt = log;
+  corrupt.erase(firstRecordEnd, secondFormat.size());
+  std::istringstream in(corrupt);
+  std::ostringstream out;
+  std::ostringstream err;
+  EXPECT_FALSE(DecodeBinaryLog(in, out, err));
+  EXPECT_EQ(err.str().find("Error after 1 records"), 0ul) << err.str();
+}
+
+} // namespace logdecoder
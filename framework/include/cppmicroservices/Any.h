@@ -39,8 +39,10 @@ DEALINGS IN THE SOFTWARE.
 #include <list>
 #include <map>
 #include <memory>
+#include <new>
 #include <set>
 #include <sstream>
+#include <type_traits>
 #include <typeinfo>
 #include <utility>
 #include <vector>
@@ -177,6 +179,10 @@ std::ostream& any_value_to_json(std::ostream& os, const std::map<K, V>& m);
  * of the internally stored data.
  *
  * Code taken from the Boost 1.46.1 library. Original copyright by Kevlin Henney. Modified for CppMicroServices.
+ *
+ * Trivially copyable values of up to twice the size of a pointer, such as
+ * \c bool, \c int, \c long and \c double, are stored inside the Any
+ * itself, so creating and copying them does not allocate.
  */
 class US_Framework_EXPORT Any
 {
@@ -199,7 +205,7 @@ public:
    */
   template<typename ValueType>
   Any(const ValueType& value)
-    : _content(new Holder<ValueType>(value))
+    : _content(Holder<ValueType>::Create(value, &_buffer))
   {}
 
   /**
@@ -208,7 +214,7 @@ public:
    * \param other The Any to copy
    */
   Any(const Any& other)
-    : _content(other._content ? other._content->Clone() : nullptr)
+    : _content(other._content ? other._content->Clone(&_buffer) : nullptr)
   {}
 
   /**
@@ -217,8 +223,12 @@ public:
    * @param other The Any to move
    */
   Any(Any&& other) noexcept
-    : _content(std::move(other._content))
-  {}
+    : _content(nullptr)
+  {
+    MoveFrom(other);
+  }
+
+  ~Any() { Reset(); }
 
   /**
    * Swaps the content of the two Anys.
@@ -227,7 +237,9 @@ public:
    */
   Any& Swap(Any& rhs)
   {
-    std::swap(_content, rhs._content);
+    Any tmp(std::move(rhs));
+    rhs.MoveFrom(*this);
+    MoveFrom(tmp);
     return *this;
   }
 
@@ -301,7 +313,10 @@ public:
    */
   Any& operator=(Any&& rhs)
   {
-    _content = std::move(rhs._content);
+    if (this != &rhs) {
+      Reset();
+      MoveFrom(rhs);
+    }
     return *this;
   }
 
@@ -320,6 +335,20 @@ public:
    */
   std::string ToString() const;
 
+  /**
+   * Writes a string representation for the content to \c os.
+   *
+   * Unlike ToString(), nested values are written straight to the stream
+   * instead of being collected in temporary strings.
+   *
+   * \param os The stream to write to.
+   * \return \c os
+   * \throws std::logic_error if the Any is empty.
+   *
+   * \see ToString()
+   */
+  std::ostream& ToString(std::ostream& os) const;
+
   /**
    * Returns a string representation for the content. If the Any is
    * empty, an empty string is returned.
@@ -334,7 +363,29 @@ public:
    *
    * Custom types should specialize the any_value_to_json template function for meaningful output.
    */
-  std::string ToJSON() const { return Empty() ? "null" : _content->ToJSON(); }
+  std::string ToJSON() const
+  {
+    std::ostringstream ss;
+    ToJSON(ss);
+    return ss.str();
+  }
+
+  /**
+   * Writes a JSON representation for the content to \c os.
+   *
+   * Nested values are written straight to the stream instead of being
+   * collected in temporary strings, so large property trees are serialized
+   * in one pass.
+   *
+   * \param os The stream to write to.
+   * \return \c os
+   *
+   * \see ToJSON()
+   */
+  std::ostream& ToJSON(std::ostream& os) const
+  {
+    return Empty() ? os << "null" : _content->ToJSON(os);
+  }
 
   /**
    * Returns the type information of the stored content.
@@ -353,13 +404,24 @@ private:
   public:
     virtual ~Placeholder() = default;
 
-    virtual std::string ToString() const = 0;
-    virtual std::string ToJSON() const = 0;
+    virtual std::ostream& ToString(std::ostream& os) const = 0;
+    virtual std::ostream& ToJSON(std::ostream& os) const = 0;
 
     virtual const std::type_info& Type() const = 0;
-    virtual std::unique_ptr<Placeholder> Clone() const = 0;
+
+    /**
+     * Copies this holder into \c buffer if the held type is stored
+     * inline, or onto the heap otherwise.
+     */
+    virtual Placeholder* Clone(void* buffer) const = 0;
   };
 
+  /**
+   * Storage for the holders of small values, see IsStoredInline.
+   */
+  using InlineBuffer =
+    std::aligned_storage<3 * sizeof(void*), alignof(double)>::type;
+
   template<typename ValueType>
   class Holder : public Placeholder
   {
@@ -372,33 +434,93 @@ private:
       : _held(std::move(value))
     {}
 
-    std::string ToString() const override
+    std::ostream& ToString(std::ostream& os) const override
     {
-      std::stringstream ss;
-      any_value_to_string(ss, _held);
-      return ss.str();
+      return any_value_to_string(os, _held);
     }
 
-    std::string ToJSON() const override
+    std::ostream& ToJSON(std::ostream& os) const override
     {
-      std::stringstream ss;
-      any_value_to_json(ss, _held);
-      return ss.str();
+      return any_value_to_json(os, _held);
     }
 
     const std::type_info& Type() const override { return typeid(ValueType); }
 
-    std::unique_ptr<Placeholder> Clone() const override
+    Placeholder* Clone(void* buffer) const override
     {
-      return std::unique_ptr<Placeholder>(new Holder(_held));
+      return Create(_held, buffer);
+    }
+
+    static Placeholder* Create(const ValueType& value, void* buffer)
+    {
+      return Create(value, buffer, IsStoredInline<ValueType>());
     }
 
     ValueType _held;
 
   private: // intentionally left unimplemented
     Holder& operator=(const Holder&) = delete;
+
+    static Placeholder* Create(const ValueType& value,
+                               void* buffer,
+                               std::true_type)
+    {
+      return new (buffer) Holder(value);
+    }
+
+    static Placeholder* Create(const ValueType& value, void*, std::false_type)
+    {
+      return new Holder(value);
+    }
   };
 
+  /**
+   * Holders of trivially copyable values fitting into the buffer next to
+   * the virtual table pointer are stored inline.
+   */
+  template<typename ValueType>
+  using IsStoredInline =
+    std::integral_constant<bool,
+                           std::is_trivially_copyable<ValueType>::value &&
+                             sizeof(ValueType) <= 2 * sizeof(void*) &&
+                             sizeof(Holder<ValueType>) <=
+                               sizeof(InlineBuffer) &&
+                             alignof(Holder<ValueType>) <=
+                               alignof(InlineBuffer)>;
+
+  bool IsInline() const
+  {
+    return static_cast<const void*>(_content) ==
+           static_cast<const void*>(&_buffer);
+  }
+
+  void Reset()
+  {
+    if (IsInline()) {
+      _content->~Placeholder();
+    } else {
+      delete _content;
+    }
+    _content = nullptr;
+  }
+
+  /**
+   * Takes over the content of \c other, which must not share its buffer
+   * with this Any, and leaves \c other empty. The content of this Any
+   * must have been released before.
+   */
+  void MoveFrom(Any& other) noexcept
+  {
+    if (other.IsInline()) {
+      // inline values are trivially copyable, copying them cannot throw
+      _content = other._content->Clone(&_buffer);
+      other.Reset();
+    } else {
+      _content = other._content;
+      other._content = nullptr;
+    }
+  }
+
 private:
   template<typename ValueType>
   friend ValueType* any_cast(Any*);
@@ -406,7 +528,8 @@ private:
   template<typename ValueType>
   friend ValueType* unsafe_any_cast(Any*);
 
-  std::unique_ptr<Placeholder> _content;
+  Placeholder* _content;
+  InlineBuffer _buffer;
 };
 
 /**
@@ -469,7 +592,7 @@ template<typename ValueType>
 ValueType* any_cast(Any* operand)
 {
   return operand && operand->Type() == typeid(ValueType)
-           ? &static_cast<Any::Holder<ValueType>*>(operand->_content.get())
+           ? &static_cast<Any::Holder<ValueType>*>(operand->_content)
                 ->_held
            : nullptr;
 }
@@ -604,7 +727,7 @@ ValueType& ref_any_cast(Any& operand)
 template<typename ValueType>
 ValueType* unsafe_any_cast(Any* operand)
 {
-  return &static_cast<Any::Holder<ValueType>*>(operand->_content.get())->_held;
+  return &static_cast<Any::Holder<ValueType>*>(operand->_content)->_held;
 }
 
 /**
@@ -632,9 +755,9 @@ std::ostream& any_value_to_string(std::ostream& os, const std::map<K, Any>& m)
   const Iterator end = m.end();
   for (; i1 != end; ++i1) {
     if (i1 == begin)
-      os << i1->first << " : " << i1->second.ToString();
+      i1->second.ToString(os << i1->first << " : ");
     else
-      os << ", " << i1->first << " : " << i1->second.ToString();
+      i1->second.ToString(os << ", " << i1->first << " : ");
   }
   os << "}";
   return os;
@@ -658,6 +781,27 @@ std::ostream& any_value_to_string(std::ostream& os, const std::map<K, V>& m)
   return os;
 }
 
+namespace detail {
+
+/**
+ * \internal
+ *
+ * Writes a map key as a quoted and escaped JSON string.
+ */
+inline std::ostream& any_key_to_json(std::ostream& os, const std::string& key)
+{
+  return any_value_to_json(os, key);
+}
+
+template<class K>
+std::ostream& any_key_to_json(std::ostream& os, const K& key)
+{
+  std::ostringstream ss;
+  ss << key;
+  return any_value_to_json(os, ss.str());
+}
+}
+
 template<class K>
 std::ostream& any_value_to_json(std::ostream& os, const std::map<K, Any>& m)
 {
@@ -667,11 +811,10 @@ std::ostream& any_value_to_json(std::ostream& os, const std::map<K, Any>& m)
   const Iterator begin = i1;
   const Iterator end = m.end();
   for (; i1 != end; ++i1) {
-    if (i1 == begin)
-      os << "\"" << i1->first << "\" : " << i1->second.ToJSON();
-    else
-      os << ", "
-         << "\"" << i1->first << "\" : " << i1->second.ToJSON();
+    if (i1 != begin)
+      os << ", ";
+    detail::any_key_to_json(os, i1->first) << " : ";
+    i1->second.ToJSON(os);
   }
   os << "}";
   return os;
@@ -686,11 +829,9 @@ std::ostream& any_value_to_json(std::ostream& os, const std::map<K, V>& m)
   const Iterator begin = i1;
   const Iterator end = m.end();
   for (; i1 != end; ++i1) {
-    if (i1 == begin)
-      os << "\"" << i1->first << "\" : " << i1->second;
-    else
-      os << ", "
-         << "\"" << i1->first << "\" : " << i1->second;
+    if (i1 != begin)
+      os << ", ";
+    detail::any_key_to_json(os, i1->first) << " : " << i1->second;
   }
   os << "}";
   return os;
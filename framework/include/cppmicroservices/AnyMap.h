@@ -25,8 +25,10 @@
 
 #include "cppmicroservices/Any.h"
 
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace cppmicroservices {
 
@@ -279,6 +281,8 @@ protected:
   map_type type;
 
 private:
+  friend class AnyMap;
+
   ordered_any_map const& o_m() const;
   ordered_any_map& o_m();
   unordered_any_map const& uo_m() const;
@@ -298,6 +302,54 @@ private:
   } map;
 };
 
+/**
+ * \ingroup MicroServicesUtils
+ *
+ * A compound key which is split into its key names once.
+ *
+ * AnyMap::AtCompoundKey(const key_type&) const parses the dotted key on
+ * every call. A \c CompoundKey does that once and also converts the numerical
+ * key names used as \c std::vector<Any> indices up front. Create it once and
+ * reuse it for repeated queries, e.g. against maps of the same layout.
+ *
+ * \code
+ * static const CompoundKey key("three.b.1");
+ * map.AtCompoundKey(key);   // returns Any(8)
+ * map.FindCompoundKey(key); // returns a pointer to Any(8)
+ * \endcode
+ *
+ * @see AnyMap::AtCompoundKey(const CompoundKey&) const
+ * @see AnyMap::FindCompoundKey(const CompoundKey&) const
+ */
+class US_Framework_EXPORT CompoundKey
+{
+public:
+  /**
+   * Splits a compound key into its key names.
+   *
+   * @param key The key hierarchy in dot notation.
+   */
+  explicit CompoundKey(const std::string& key);
+
+  /**
+   * @return The key hierarchy in dot notation.
+   */
+  const std::string& ToString() const;
+
+private:
+  friend class AnyMap;
+
+  struct Segment
+  {
+    std::string name;
+    bool isIndex; ///< true if \c name is a valid \c int
+    int index;
+  };
+
+  std::string key;
+  std::vector<Segment> segments;
+};
+
 /**
  * \ingroup MicroServicesUtils
  *
@@ -398,6 +450,123 @@ public:
    */
   mapped_type AtCompoundKey(const key_type& key, mapped_type defaultValue) const
     noexcept;
+
+  /**
+   * Get a key's value, using a precompiled compound key.
+   *
+   * @param key The key hierarchy to query.
+   * @return A reference to the key's value.
+   *
+   * @throws std::invalid_argument if the \c Any value for a given key is not of type \c AnyMap or \c std::vector<Any>,
+   *         or if a key name used to index a \c std::vector<Any> is not a number.
+   * @throws std::out_of_range if the key is not found.
+   *
+   * @see AtCompoundKey(const key_type&) const
+   */
+  const mapped_type& AtCompoundKey(const CompoundKey& key) const;
+
+  /**
+   * Look up a key's value, using a precompiled compound key.
+   *
+   * Unlike AtCompoundKey(const key_type&, mapped_type) const, this neither
+   * throws nor copies the value.
+   *
+   * @param key The key hierarchy to query.
+   * @return A pointer to the key's value, or \c nullptr if the key is not found.
+   */
+  const mapped_type* FindCompoundKey(const CompoundKey& key) const noexcept;
+
+private:
+  /**
+   * Like find(), but without creating an iterator.
+   */
+  const mapped_type* FindValue(const key_type& key) const;
+};
+
+/**
+ * \ingroup MicroServicesUtils
+ *
+ * An immutable AnyMap which is cheap to copy.
+ *
+ * All copies of a \c FrozenAnyMap share one map, including its nested
+ * maps and vectors, so copying takes constant time. The shared map is never
+ * modified. A \c FrozenAnyMap converts implicitly to <code>const AnyMap&</code>,
+ * so it can be passed to read-only APIs without copying.
+ *
+ * Storing a \c FrozenAnyMap in an \c Any makes copies of the \c Any cheap
+ * as well. AnyMap::AtCompoundKey looks into such nested values like into
+ * nested \c AnyMap values.
+ *
+ * @see AnyMap
+ */
+class US_Framework_EXPORT FrozenAnyMap
+{
+public:
+  using key_type = AnyMap::key_type;
+  using mapped_type = AnyMap::mapped_type;
+  using value_type = AnyMap::value_type;
+  using size_type = AnyMap::size_type;
+  using const_iterator = AnyMap::const_iterator;
+  using iterator = const_iterator;
+  using map_type = AnyMap::map_type;
+
+  /**
+   * Creates an empty map of the given type.
+   */
+  explicit FrozenAnyMap(map_type type);
+
+  /**
+   * Freezes a map. Pass an rvalue to avoid copying \c m.
+   *
+   * @param m The map to freeze.
+   */
+  explicit FrozenAnyMap(AnyMap m);
+
+  const_iterator begin() const;
+  const_iterator cbegin() const;
+  const_iterator end() const;
+  const_iterator cend() const;
+
+  bool empty() const;
+  size_type size() const;
+  size_type count(const key_type& key) const;
+
+  const mapped_type& at(const key_type& key) const;
+  const_iterator find(const key_type& key) const;
+
+  /**
+   * @see AnyMap::GetType
+   */
+  map_type GetType() const;
+
+  /**
+   * @see AnyMap::AtCompoundKey(const key_type&) const
+   */
+  const mapped_type& AtCompoundKey(const key_type& key) const;
+
+  /**
+   * @see AnyMap::AtCompoundKey(const key_type&, mapped_type) const
+   */
+  mapped_type AtCompoundKey(const key_type& key, mapped_type defaultValue) const
+    noexcept;
+
+  /**
+   * @see AnyMap::AtCompoundKey(const CompoundKey&) const
+   */
+  const mapped_type& AtCompoundKey(const CompoundKey& key) const;
+
+  /**
+   * @see AnyMap::FindCompoundKey(const CompoundKey&) const
+   */
+  const mapped_type* FindCompoundKey(const CompoundKey& key) const noexcept;
+
+  /**
+   * Returns the shared map.
+   */
+  operator const AnyMap&() const;
+
+private:
+  std::shared_ptr<const AnyMap> m;
 };
 
 template<>
@@ -407,6 +576,14 @@ US_Framework_EXPORT std::ostream& any_value_to_string(std::ostream& os,
 template<>
 US_Framework_EXPORT std::ostream& any_value_to_json(std::ostream& os,
                                                     const AnyMap& m);
+
+template<>
+US_Framework_EXPORT std::ostream& any_value_to_string(std::ostream& os,
+                                                      const FrozenAnyMap& m);
+
+template<>
+US_Framework_EXPORT std::ostream& any_value_to_json(std::ostream& os,
+                                                    const FrozenAnyMap& m);
 }
 
 #endif // CPPMICROSERVICES_ANYMAP_H
@@ -309,6 +309,49 @@ US_Framework_EXPORT extern const std::string
 US_Framework_EXPORT extern const std::string
   FRAMEWORK_LOG; // = "org.cppmicroservices.framework.log";
 
+/**
+ * The framework's diagnostic levels property key name. The value is a
+ * comma separated list of category=level pairs, e.g.
+ * "registry=debug,bundles=warning". The categories are \c general,
+ * \c registry, \c listeners, \c bundles and \c resources, or \c all to set
+ * every category. The levels are \c off, \c error, \c warning, \c info and
+ * \c debug. Categories which are not listed log at the \c debug level if
+ * the diagnostic log is enabled.
+ *
+ * @internal
+ * @see #FRAMEWORK_LOG
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_LOG_LEVELS; // = "org.cppmicroservices.framework.log.levels";
+
+/**
+ * The framework's diagnostic buffer size property key name. If set to a
+ * positive number, the framework keeps that many of the most recent
+ * diagnostic messages in memory, independent of #FRAMEWORK_LOG. The
+ * buffer keeps the messages enabled by #FRAMEWORK_LOG_LEVELS; categories
+ * which are not listed there keep warnings and errors, or all messages
+ * if the diagnostic log is enabled. A value which is not a non-negative
+ * integer makes the framework creation throw \c std::invalid_argument.
+ * This property's default value is 0.
+ *
+ * @internal
+ * @see #FRAMEWORK_LOG_DUMP_ON_TERMINATE
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_LOG_BUFFER_SIZE; // = "org.cppmicroservices.framework.log.buffer_size";
+
+/**
+ * The framework's diagnostic dump property key name. If set to \c true,
+ * the diagnostic messages kept in memory are written to the standard
+ * error stream when the process terminates through \c std::terminate.
+ * This property's default value is off (boolean 'false').
+ *
+ * @internal
+ * @see #FRAMEWORK_LOG_BUFFER_SIZE
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_LOG_DUMP_ON_TERMINATE; // = "org.cppmicroservices.framework.log.dump_on_terminate";
+
 /**
  * Framework environment property identifying the Framework's universally
  * unique identifier (UUID). A UUID represents a 128-bit value. A new UUID
@@ -25,6 +25,8 @@
 
 #include <chrono>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "cppmicroservices/LDAPFilter.h"
 #include "cppmicroservices/ServiceReference.h"
@@ -99,6 +101,21 @@ public:
 
   using TrackingMap = std::unordered_map<ServiceReference<S>, std::shared_ptr<TrackedParamType>>;
 
+  /**
+   * An immutable snapshot of the services tracked by a
+   * <code>ServiceTracker</code>.
+   *
+   * @see GetTrackedSnapshot()
+   */
+  struct TrackedSnapshot
+  {
+    /// The tracking count of the <code>ServiceTracker</code> the snapshot was taken at
+    int trackingCount;
+
+    /// The tracked services and their service objects, highest ranking first
+    std::vector<std::pair<ServiceReference<S>, std::shared_ptr<TrackedParamType>>> services;
+  };
+
   /**
    * Automatically closes the <code>ServiceTracker</code>
    */
@@ -404,6 +421,28 @@ public:
    */
   virtual bool IsEmpty() const;
 
+  /**
+   * Return an immutable snapshot of the <code>ServiceReference</code>s and
+   * service objects for all services being tracked by this
+   * <code>ServiceTracker</code>.
+   *
+   * <p>
+   * The services are sorted in reverse natural order of
+   * <code>ServiceReference</code>. That is, the first entry is the service
+   * with the highest ranking and the lowest service id.
+   *
+   * <p>
+   * The snapshot is created once per tracking count and shared by all
+   * callers until a service is added, modified or removed. Use this method
+   * instead of GetServices() or GetTracked(TrackingMap&) to repeatedly
+   * iterate the tracked services without copying them.
+   *
+   * @return The snapshot of the tracked services. If this
+   *         <code>ServiceTracker</code> is not open, the snapshot is empty
+   *         and its tracking count is -1.
+   */
+  virtual std::shared_ptr<const TrackedSnapshot> GetTrackedSnapshot() const;
+
 protected:
   /**
    * Default implementation of the
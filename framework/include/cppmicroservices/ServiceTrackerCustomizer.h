@@ -25,8 +25,68 @@
 
 #include "cppmicroservices/ServiceReference.h"
 
+#include <exception>
+#include <memory>
+#include <vector>
+
 namespace cppmicroservices {
 
+namespace detail {
+
+/**
+ * \internal
+ *
+ * Thrown by AddEachService if <code>AddingService</code> threw for some of
+ * the references. Carries the service objects created for the other
+ * references and the first exception thrown by <code>AddingService</code>.
+ */
+template<class T>
+struct AddEachServiceError
+{
+  std::vector<std::shared_ptr<T>> services;
+  std::exception_ptr error;
+};
+
+/**
+ * \internal
+ *
+ * The default implementation of ServiceTrackerCustomizer::AddingServices.
+ * Calls <code>AddingService</code> for each reference. A reference for which
+ * it throws gets a <code>nullptr</code> entry, and the result is thrown in an
+ * AddEachServiceError so the service tracker tracks the other services
+ * before the first exception propagates.
+ */
+template<class Customizer, class S>
+std::vector<std::shared_ptr<typename Customizer::TrackedParamType>>
+AddEachService(Customizer& customizer,
+               const std::vector<ServiceReference<S>>& references)
+{
+  std::vector<std::shared_ptr<typename Customizer::TrackedParamType>> services;
+  services.reserve(references.size());
+  std::exception_ptr error;
+  for (const auto& reference : references)
+  {
+    try
+    {
+      services.push_back(customizer.AddingService(reference));
+    }
+    catch (...)
+    {
+      services.push_back(nullptr);
+      if (!error)
+      {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error)
+  {
+    throw AddEachServiceError<typename Customizer::TrackedParamType>{ std::move(services), error };
+  }
+  return services;
+}
+}
+
 /**
  * \ingroup MicroServices
  * \ingroup gr_servicetracker
@@ -101,6 +161,38 @@ struct ServiceTrackerCustomizer
   virtual std::shared_ptr<TrackedParamType> AddingService(
     const ServiceReference<S>& reference) = 0;
 
+  /**
+   * The initial services are being added to the <code>ServiceTracker</code>.
+   *
+   * <p>
+   * This method is called once when the <code>ServiceTracker</code> is
+   * opened, with all services which matched the search parameters of the
+   * <code>ServiceTracker</code> at that time. It is called instead of
+   * <code>AddingService</code> for these services and should return the
+   * service objects to be tracked, one for each reference in the same
+   * order. Missing entries are treated as <code>nullptr</code>.
+   *
+   * <p>
+   * The default implementation calls <code>AddingService</code> for each
+   * reference. If <code>AddingService</code> throws for a reference, only
+   * that service is skipped: the other services are tracked, and the first
+   * exception propagates afterwards. Override this method to create the
+   * service objects for many services at once. If an override throws, none
+   * of the services is tracked, and the override is responsible for
+   * releasing the service objects it created.
+   *
+   * @param references The references to the services being added to the
+   *        <code>ServiceTracker</code>.
+   * @return The service objects to be tracked for the specified referenced
+   *         services. A <code>nullptr</code> entry means that the
+   *         corresponding service should not be tracked.
+   */
+  virtual std::vector<std::shared_ptr<TrackedParamType>> AddingServices(
+    const std::vector<ServiceReference<S>>& references)
+  {
+    return detail::AddEachService(*this, references);
+  }
+
   /**
    * A service tracked by the <code>ServiceTracker</code> has been modified.
    *
@@ -152,6 +244,11 @@ struct ServiceTrackerCustomizer<S, S>
 
   virtual std::shared_ptr<TrackedParamType> AddingService(
     const ServiceReference<S>& reference) = 0;
+  virtual std::vector<std::shared_ptr<TrackedParamType>> AddingServices(
+    const std::vector<ServiceReference<S>>& references)
+  {
+    return detail::AddEachService(*this, references);
+  }
   virtual void ModifiedService(
     const ServiceReference<S>& reference,
     const std::shared_ptr<TrackedParamType>& service) = 0;
@@ -183,6 +280,11 @@ struct ServiceTrackerCustomizer<void, T>
   virtual ~ServiceTrackerCustomizer() = default;
   virtual std::shared_ptr<TrackedParamType> AddingService(
     const ServiceReference<S>& reference) = 0;
+  virtual std::vector<std::shared_ptr<TrackedParamType>> AddingServices(
+    const std::vector<ServiceReference<S>>& references)
+  {
+    return detail::AddEachService(*this, references);
+  }
   virtual void ModifiedService(
     const ServiceReference<S>& reference,
     const std::shared_ptr<TrackedParamType>& service) = 0;
@@ -215,6 +317,11 @@ struct ServiceTrackerCustomizer<void, void>
   virtual ~ServiceTrackerCustomizer() = default;
   virtual std::shared_ptr<TrackedParamType> AddingService(
     const ServiceReference<S>& reference) = 0;
+  virtual std::vector<std::shared_ptr<TrackedParamType>> AddingServices(
+    const std::vector<ServiceReference<S>>& references)
+  {
+    return detail::AddEachService(*this, references);
+  }
   virtual void ModifiedService(
     const ServiceReference<S>& reference,
     const std::shared_ptr<TrackedParamType>& service) = 0;
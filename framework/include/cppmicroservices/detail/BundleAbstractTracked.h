@@ -28,6 +28,8 @@
 #include "cppmicroservices/detail/WaitCondition.h"
 
 #include <atomic>
+#include <exception>
+#include <utility>
 #include <vector>
 
 namespace cppmicroservices {
@@ -85,6 +87,9 @@ public:
    * Track the initial list of items. This is called after events can begin to
    * be received.
    *
+   * All initial items are moved to the adding list in a single synchronized
+   * block and passed to the customizer in one batch.
+   *
    * This method must be called from Tracker's open method while not
    * synchronized on this object after the add listener call.
    *
@@ -179,6 +184,17 @@ public:
    */
   void CopyEntries_unlocked(TrackingMap& map) const;
 
+  /**
+   * Copy the tracked items and associated values into the specified vector.
+   * Items whose customized object has not been set yet are skipped.
+   *
+   * @param entries The vector to which to append the tracked items and
+   *        associated values.
+   * @GuardedBy this
+   */
+  void CopyEntries_unlocked(
+    std::vector<std::pair<S, std::shared_ptr<TrackedParamType>>>& entries) const;
+
   /**
    * Call the specific customizer adding method. This method must not be
    * called while synchronized on this object.
@@ -192,6 +208,23 @@ public:
     S item,
     const R& related) = 0;
 
+  /**
+   * Call the specific customizer adding method for several items at once.
+   * This method must not be called while synchronized on this object.
+   *
+   * @param items The items to be tracked.
+   * @param related Action related object.
+   * @param error Set to the exception of an item which could not be
+   *        customized. The other items are still returned and tracked
+   *        before the exception propagates.
+   * @return Customized objects for the tracked items, in the same order.
+   *         A <code>null</code> entry means the item is not to be tracked.
+   */
+  virtual std::vector<std::shared_ptr<TrackedParamType>> CustomizerAddingBatch(
+    const std::vector<S>& items,
+    const R& related,
+    std::exception_ptr& error) = 0;
+
   /**
    * Call the specific customizer modified method. This method must not be
    * called while synchronized on this object.
@@ -268,6 +301,17 @@ public:
    */
   void TrackAdding(S item, R related);
 
+  /**
+   * Add several items to the tracker with a single call of the customizer
+   * and a single synchronized block to store the customized objects. The
+   * specified items must have been placed in the adding list before calling
+   * this method.
+   *
+   * @param items The items to be tracked.
+   * @param related Action related object.
+   */
+  void TrackAddingBatch(const std::vector<S>& items, R related);
+
 private:
   using Self = BundleAbstractTracked<S, TTT, R>;
 
@@ -23,7 +23,9 @@
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/detail/Log.h"
 
+#include <exception>
 #include <iterator>
+#include <unordered_set>
 
 namespace cppmicroservices {
 
@@ -31,7 +33,7 @@ namespace detail {
 
 template<class S, class TTT, class R>
 BundleAbstractTracked<S,TTT,R>::BundleAbstractTracked(BundleContext* bc)
-  : closed(false), bc(bc)
+  : closed(false), trackingCount(0), bc(bc)
 {
 }
 
@@ -44,12 +46,12 @@ void BundleAbstractTracked<S,TTT,R>::SetInitial(const std::vector<S>& initiallis
 {
   std::copy(initiallist.begin(), initiallist.end(), std::back_inserter(initial));
 
-  if (bc->GetLogSink()->Enabled())
+  if (bc->GetLogSink()->IsEnabled(detail::DiagCategory::Listeners, detail::DiagLevel::Debug))
   {
     for(typename std::list<S>::const_iterator item = initial.begin();
       item != initial.end(); ++item)
     {
-      DIAG_LOG(*bc->GetLogSink()) << "BundleAbstractTracked::setInitial: " << (*item);
+      DIAG_LOG_AT(*bc->GetLogSink(), Listeners, Debug) << "BundleAbstractTracked::setInitial: " << (*item);
     }
   }
 }
@@ -57,48 +59,51 @@ void BundleAbstractTracked<S,TTT,R>::SetInitial(const std::vector<S>& initiallis
 template<class S, class TTT, class R>
 void BundleAbstractTracked<S,TTT,R>::TrackInitial()
 {
-  while (true)
+  std::vector<S> items;
   {
-    S item;
+    auto l = this->Lock(); US_UNUSED(l);
+    if (closed || initial.empty())
     {
-      auto l = this->Lock(); US_UNUSED(l);
-      if (closed || (initial.size() == 0))
-      {
-        /*
-         * if there are no more initial items
-         */
-        return; /* we are done */
-      }
       /*
-       * move the first item from the initial list to the adding list
-       * within this synchronized block.
+       * if there are no initial items
        */
-      item = initial.front();
-      initial.pop_front();
-      if (tracked[item])
+      return; /* we are done */
+    }
+    /*
+     * move all initial items to the adding list within this synchronized
+     * block.
+     */
+    std::unordered_set<S> skipped(adding.begin(), adding.end());
+    items.reserve(initial.size());
+    for (auto& item : initial)
+    {
+      auto trackedIter = tracked.find(item);
+      if (trackedIter != tracked.end() && trackedIter->second)
       {
         /* if we are already tracking this item */
-        DIAG_LOG(*bc->GetLogSink()) << "BundleAbstractTracked::trackInitial[already tracked]: " << item;
+        DIAG_LOG_AT(*bc->GetLogSink(), Listeners, Debug) << "BundleAbstractTracked::trackInitial[already tracked]: " << item;
         continue; /* skip this item */
       }
-      if (std::find(adding.begin(), adding.end(), item) != adding.end())
+      if (!skipped.insert(item).second)
       {
         /*
          * if this item is already in the process of being added.
          */
-        DIAG_LOG(*bc->GetLogSink()) << "BundleAbstractTracked::trackInitial[already adding]: " << item;
+        DIAG_LOG_AT(*bc->GetLogSink(), Listeners, Debug) << "BundleAbstractTracked::trackInitial[already adding]: " << item;
         continue; /* skip this item */
       }
-      adding.push_back(item);
+      DIAG_LOG_AT(*bc->GetLogSink(), Listeners, Debug) << "BundleAbstractTracked::trackInitial: " << item;
+      items.push_back(item);
     }
-    DIAG_LOG(*bc->GetLogSink()) << "BundleAbstractTracked::trackInitial: " << item;
-    TrackAdding(item, R());
-    /*
-     * Begin tracking it. We call trackAdding
-     * since we have already put the item in the
-     * adding list.
-     */
+    initial.clear();
+    adding.insert(adding.end(), items.begin(), items.end());
   }
+  /*
+   * Begin tracking them. We call trackAddingBatch
+   * since we have already put the items in the
+   * adding list.
+   */
+  TrackAddingBatch(items, R());
 }
 
 template<class S, class TTT, class R>
@@ -123,14 +128,14 @@ void BundleAbstractTracked<S,TTT,R>::Track(S item, R related)
       if (std::find(adding.begin(), adding.end(),item) != adding.end())
       {
         /* if this item is already in the process of being added. */
-        DIAG_LOG(*bc->GetLogSink()) << "BundleAbstractTracked::track[already adding]: " << item;
+        DIAG_LOG_AT(*bc->GetLogSink(), Listeners, Debug) << "BundleAbstractTracked::track[already adding]: " << item;
         return;
       }
       adding.push_back(item); /* mark this item is being added */
     }
     else
     { /* we are currently tracking this item */
-      DIAG_LOG(*bc->GetLogSink()) << "BundleAbstractTracked::track[modified]: " << item;
+      DIAG_LOG_AT(*bc->GetLogSink(), Listeners, Debug) << "BundleAbstractTracked::track[modified]: " << item;
       Modified(); /* increment modification count */
     }
   }
@@ -162,7 +167,7 @@ void BundleAbstractTracked<S,TTT,R>::Untrack(S item, R related)
     { /* if this item is already in the list
        * of initial references to process
        */
-      DIAG_LOG(*bc->GetLogSink()) << "BundleAbstractTracked::untrack[removed from initial]: " << item;
+      DIAG_LOG_AT(*bc->GetLogSink(), Listeners, Debug) << "BundleAbstractTracked::untrack[removed from initial]: " << item;
       return; /* we have removed it from the list and it will not be
                * processed
                */
@@ -174,7 +179,7 @@ void BundleAbstractTracked<S,TTT,R>::Untrack(S item, R related)
     { /* if the item is in the process of
        * being added
        */
-      DIAG_LOG(*bc->GetLogSink()) << "BundleAbstractTracked::untrack[being added]: " << item;
+      DIAG_LOG_AT(*bc->GetLogSink(), Listeners, Debug) << "BundleAbstractTracked::untrack[being added]: " << item;
       return; /*
            * in case the item is untracked while in the process of
            * adding
@@ -192,7 +197,7 @@ void BundleAbstractTracked<S,TTT,R>::Untrack(S item, R related)
     }
     Modified(); /* increment modification count */
   }
-  DIAG_LOG(*bc->GetLogSink()) << "BundleAbstractTracked::untrack[removed]: " << item;
+  DIAG_LOG_AT(*bc->GetLogSink(), Listeners, Debug) << "BundleAbstractTracked::untrack[removed]: " << item;
   /* Call customizer outside of synchronized region */
   CustomizerRemoved(item, related, object);
   /*
@@ -251,6 +256,20 @@ void BundleAbstractTracked<S,TTT,R>::CopyEntries_unlocked(TrackingMap& map) cons
   map.insert(tracked.begin(), tracked.end());
 }
 
+template<class S, class TTT, class R>
+void BundleAbstractTracked<S,TTT,R>::CopyEntries_unlocked(
+  std::vector<std::pair<S, std::shared_ptr<TrackedParamType>>>& entries) const
+{
+  entries.reserve(entries.size() + tracked.size());
+  for (auto& entry : tracked)
+  {
+    if (entry.second)
+    {
+      entries.push_back(entry);
+    }
+  }
+}
+
 template<class S, class TTT, class R>
 bool BundleAbstractTracked<S,TTT,R>::CustomizerAddingFinal(S item, const std::shared_ptr<TrackedParamType>& custom)
 {
@@ -280,7 +299,7 @@ bool BundleAbstractTracked<S,TTT,R>::CustomizerAddingFinal(S item, const std::sh
 template<class S, class TTT, class R>
 void BundleAbstractTracked<S,TTT,R>::TrackAdding(S item, R related)
 {
-  DIAG_LOG(*bc->GetLogSink()) << "BundleAbstractTracked::trackAdding:" << item;
+  DIAG_LOG_AT(*bc->GetLogSink(), Listeners, Debug) << "BundleAbstractTracked::trackAdding:" << item;
   std::shared_ptr<TrackedParamType> object;
   bool becameUntracked = false;
   /* Call customizer outside of synchronized region */
@@ -304,7 +323,7 @@ void BundleAbstractTracked<S,TTT,R>::TrackAdding(S item, R related)
    */
   if (becameUntracked && object)
   {
-    DIAG_LOG(*bc->GetLogSink()) << "BundleAbstractTracked::trackAdding[removed]: " << item;
+    DIAG_LOG_AT(*bc->GetLogSink(), Listeners, Debug) << "BundleAbstractTracked::trackAdding[removed]: " << item;
     /* Call customizer outside of synchronized region */
     CustomizerRemoved(item, related, object);
     /*
@@ -314,6 +333,112 @@ void BundleAbstractTracked<S,TTT,R>::TrackAdding(S item, R related)
   }
 }
 
+template<class S, class TTT, class R>
+void BundleAbstractTracked<S,TTT,R>::TrackAddingBatch(const std::vector<S>& items, R related)
+{
+  std::vector<std::shared_ptr<TrackedParamType>> objects;
+  std::vector<std::size_t> untracked;
+  std::exception_ptr addingError;
+  /* Call customizer outside of synchronized region */
+  try
+  {
+    objects = CustomizerAddingBatch(items, related, addingError);
+  }
+  catch (...)
+  {
+    /*
+     * If the customizer throws an exception, none of the
+     * items is tracked. The exception will propagate after
+     * the items are removed from the adding list.
+     */
+    auto l = this->Lock(); US_UNUSED(l);
+    std::unordered_set<S> batch(items.begin(), items.end());
+    adding.remove_if([&batch](const S& item) { return batch.count(item) != 0; });
+    throw;
+  }
+  objects.resize(items.size());
+
+  {
+    auto l = this->Lock(); US_UNUSED(l);
+    /*
+     * Remove the items from the adding list. Items which are no longer
+     * in the adding list were untracked during the customizer callback.
+     */
+    std::unordered_set<S> missing(items.begin(), items.end());
+    for (auto iter = adding.begin(); iter != adding.end();)
+    {
+      if (missing.erase(*iter) != 0)
+      {
+        iter = adding.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+
+    bool added = false;
+    tracked.reserve(tracked.size() + items.size());
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+      if (!closed && missing.count(items[i]) == 0)
+      {
+        if (objects[i])
+        {
+          tracked[items[i]] = objects[i];
+          Modified(); /* increment modification count */
+          added = true;
+        }
+      }
+      else if (objects[i])
+      {
+        untracked.push_back(i);
+      }
+    }
+    if (added)
+    {
+      this->NotifyAll(); /* notify any waiters */
+    }
+  }
+
+  /*
+   * The items became untracked during the customizer callback.
+   */
+  std::exception_ptr removedError;
+  for (auto i : untracked)
+  {
+    DIAG_LOG_AT(*bc->GetLogSink(), Listeners, Debug) << "BundleAbstractTracked::trackAddingBatch[removed]: " << items[i];
+    /* Call customizer outside of synchronized region */
+    try
+    {
+      CustomizerRemoved(items[i], related, objects[i]);
+    }
+    catch (...)
+    {
+      /*
+       * If the customizer throws an exception, it will propagate
+       * after the remaining items are removed.
+       */
+      if (!removedError)
+      {
+        removedError = std::current_exception();
+      }
+    }
+  }
+  /*
+   * An item which could not be customized is skipped, its exception
+   * propagates after the other items are tracked.
+   */
+  if (addingError)
+  {
+    std::rethrow_exception(addingError);
+  }
+  if (removedError)
+  {
+    std::rethrow_exception(removedError);
+  }
+}
+
 } // namespace detail
 
 } // namespace cppmicroservices
@@ -24,28 +24,83 @@
 #define CPPMICROSERVICES_LOG_H
 
 #include "cppmicroservices/FrameworkConfig.h"
+#include "cppmicroservices/FrameworkExport.h"
 #include "cppmicroservices/detail/Threads.h"
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <string>
+#include <vector>
 
 namespace cppmicroservices {
 
 namespace detail {
 
+/**
+ * The areas of the framework which emit diagnostic messages. Each
+ * category has its own diagnostic level.
+ */
+enum class DiagCategory : int
+{
+  General = 0,
+  Registry,
+  Listeners,
+  Bundles,
+  Resources
+};
+
+constexpr std::size_t DiagCategoryCount = 5;
+
+/**
+ * The severity of a diagnostic message. A message is recorded if its
+ * level is less than or equal to the level of its category.
+ */
+enum class DiagLevel : int
+{
+  Off = 0,
+  Error,
+  Warning,
+  Info,
+  Debug
+};
+
 class LogSink
   : public MultiThreaded<>
   , public std::enable_shared_from_this<LogSink>
 {
 public:
-  explicit LogSink(std::ostream* sink, bool enable = false)
+  /**
+   * Creates a sink writing to \c sink if \c enable is true. If
+   * \c ringBufferSize is not zero, the sink additionally keeps that many
+   * of the most recent messages in memory, see Dump().
+   *
+   * All categories start at DiagLevel::Debug if the sink writes to a
+   * stream. A sink which only keeps messages in memory starts at
+   * DiagLevel::Warning, so that debug messages on hot paths are not
+   * formatted unless a category is explicitly set to a higher level.
+   * Otherwise, the categories start at DiagLevel::Off.
+   */
+  explicit LogSink(std::ostream* sink,
+                   bool enable = false,
+                   std::size_t ringBufferSize = 0)
     : _enable(enable)
     , _sink(sink)
+    , _ring(ringBufferSize)
+    , _ringNext(0)
+    , _ringCount(0)
   {
     if (_sink == nullptr)
       _enable = false;
+    const auto level = _enable ? DiagLevel::Debug
+                               : (_ring.empty() ? DiagLevel::Off : DiagLevel::Warning);
+    for (auto& categoryLevel : _levels) {
+      categoryLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
   }
 
   LogSink() = delete;
@@ -55,20 +110,112 @@ public:
 
   bool Enabled() { return _enable; }
 
+  /**
+   * Returns true if messages of \c category with \c level are recorded.
+   * This is the check guarding every diagnostic message and is a single
+   * relaxed atomic load.
+   */
+  bool IsEnabled(DiagCategory category, DiagLevel level) const
+  {
+    return static_cast<int>(level) <=
+           _levels[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+  }
+
+  void SetLevel(DiagCategory category, DiagLevel level)
+  {
+    _levels[static_cast<std::size_t>(category)].store(static_cast<int>(level),
+                                                      std::memory_order_relaxed);
+  }
+
+  DiagLevel GetLevel(DiagCategory category) const
+  {
+    return static_cast<DiagLevel>(
+      _levels[static_cast<std::size_t>(category)].load(std::memory_order_relaxed));
+  }
+
+  std::size_t GetRingBufferSize() const { return _ring.size(); }
+
   void Log(const std::string& msg)
   {
-    if (!_enable)
+    if (!_enable && _ring.empty())
       return;
     auto l = Lock();
     US_UNUSED(l);
-    *_sink << msg;
+    if (_enable)
+      *_sink << msg;
+    if (!_ring.empty()) {
+      _ring[_ringNext] = msg;
+      _ringNext = (_ringNext + 1) % _ring.size();
+      if (_ringCount < _ring.size())
+        ++_ringCount;
+    }
+  }
+
+  /**
+   * Writes the messages kept in memory to \c out, oldest first.
+   */
+  void Dump(std::ostream& out) const
+  {
+    auto l = Lock();
+    US_UNUSED(l);
+    DumpUnlocked(out);
+  }
+
+  /**
+   * Like Dump(), but writes nothing and returns false if the sink is
+   * locked. Used where blocking could deadlock, e.g. in a std::terminate
+   * handler running while a thread is logging.
+   */
+  bool TryDump(std::ostream& out) const
+  {
+#ifdef US_ENABLE_THREADING_SUPPORT
+    std::unique_lock<MutexType> l(m_Mtx, std::try_to_lock);
+    if (!l.owns_lock())
+      return false;
+#endif
+    DumpUnlocked(out);
+    return true;
   }
 
 private:
+  void DumpUnlocked(std::ostream& out) const
+  {
+    const auto first = (_ringNext + _ring.size() - _ringCount) % (_ring.empty() ? 1 : _ring.size());
+    for (std::size_t i = 0; i < _ringCount; ++i) {
+      out << _ring[(first + i) % _ring.size()];
+    }
+  }
+
   bool _enable;
   std::ostream* const _sink;
+  std::array<std::atomic<int>, DiagCategoryCount> _levels;
+  std::vector<std::string> _ring;
+  std::size_t _ringNext;
+  std::size_t _ringCount;
 };
 
+/**
+ * Parses a comma separated list of category=level pairs, e.g.
+ * "registry=debug,bundles=warning", and applies it to \c sink. The
+ * category "all" sets every category. Unknown names are ignored.
+ */
+US_Framework_EXPORT void ApplyDiagLevels(LogSink& sink,
+                                         const std::string& levels);
+
+/**
+ * Dumps the messages kept in memory by \c sink to the standard error
+ * stream if the process terminates through std::terminate, for
+ * instance because of an uncaught exception. The sink is only referenced
+ * weakly.
+ */
+US_Framework_EXPORT void DumpOnTerminate(const std::shared_ptr<LogSink>& sink);
+
+/**
+ * Writes the in-memory messages of all sinks registered with
+ * DumpOnTerminate() to \c out.
+ */
+US_Framework_EXPORT void DumpDiagnostics(std::ostream& out);
+
 struct LogMsg
 {
 
@@ -77,7 +224,7 @@ struct LogMsg
     , buffer()
     , _sink(sink)
   {
-    enabled = _sink.Enabled();
+    enabled = _sink.Enabled() || _sink.GetRingBufferSize() != 0;
     if (enabled) {
       buffer << "In " << func << " at " << file << ":" << ln << " : ";
     }
@@ -109,12 +256,53 @@ private:
   LogSink& _sink;
 };
 
+/**
+ * Evaluates the sink expression of DIAG_LOG_AT once and converts to true
+ * if the message is filtered out.
+ */
+class DiagGuard
+{
+public:
+  DiagGuard(LogSink& sink, DiagCategory category, DiagLevel level)
+    : _sink(sink)
+    , _disabled(!sink.IsEnabled(category, level))
+  {}
+
+  explicit operator bool() const { return _disabled; }
+
+  LogSink& Sink() const { return _sink; }
+
+private:
+  LogSink& _sink;
+  const bool _disabled;
+};
+
 } // namespace detail
 
 } // namespace cppmicroservices
 
-// Write a log line using a <code>LogSink</code> reference.
-#define DIAG_LOG(log_sink)                                                     \
-  cppmicroservices::detail::LogMsg(log_sink, __FILE__, __LINE__, __FUNCTION__)
+// Write a log line of the given category and level using a
+// <code>LogSink</code> reference. Neither the message nor its arguments
+// are evaluated unless the category is enabled at that level. If the
+// framework is built without US_ENABLE_DIAGNOSTICS, the statement is
+// compiled out entirely.
+#ifdef US_ENABLE_DIAGNOSTICS
+#  define DIAG_LOG_AT(log_sink, category, level)                               \
+    if (const cppmicroservices::detail::DiagGuard us_diag_guard_{             \
+          log_sink,                                                            \
+          cppmicroservices::detail::DiagCategory::category,                    \
+          cppmicroservices::detail::DiagLevel::level }) {                      \
+    } else                                                                     \
+      cppmicroservices::detail::LogMsg(                                        \
+        us_diag_guard_.Sink(), __FILE__, __LINE__, __FUNCTION__)
+#else
+#  define DIAG_LOG_AT(log_sink, category, level)                               \
+    if (true) {                                                                \
+    } else                                                                     \
+      cppmicroservices::detail::LogMsg(log_sink, __FILE__, __LINE__, __FUNCTION__)
+#endif
+
+// Write a general informational log line using a <code>LogSink</code> reference.
+#define DIAG_LOG(log_sink) DIAG_LOG_AT(log_sink, General, Info)
 
 #endif // CPPMICROSERVICES_LOG_H
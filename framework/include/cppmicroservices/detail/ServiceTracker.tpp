@@ -27,6 +27,7 @@
 #include "cppmicroservices/detail/ServiceTrackerPrivate.h"
 #include "cppmicroservices/detail/TrackedService.h"
 
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
 #include <string>
@@ -97,7 +98,7 @@ void ServiceTracker<S,T>::Open()
       return;
     }
 
-    DIAG_LOG(*d->context.GetLogSink()) << "ServiceTracker<S,TTT>::Open: " << d->filter;
+    DIAG_LOG_AT(*d->context.GetLogSink(), Listeners, Debug) << "ServiceTracker<S,TTT>::Open: " << d->filter;
 
     t.reset(new _TrackedService(this, d->customizer));
     try
@@ -149,7 +150,7 @@ void ServiceTracker<S,T>::Close()
     return;
   }
 
-  DIAG_LOG(*d->context.GetLogSink()) << "ServiceTracker<S,TTT>::close:" << d->filter;
+  DIAG_LOG_AT(*d->context.GetLogSink(), Listeners, Debug) << "ServiceTracker<S,TTT>::close:" << d->filter;
   outgoing->Close();
   references = GetServiceReferences();
   try
@@ -168,12 +169,12 @@ void ServiceTracker<S,T>::Close()
     outgoing->Untrack(ref, ServiceEvent());
   }
 
-  if (d->context.GetLogSink()->Enabled())
+  if (d->context.GetLogSink()->IsEnabled(detail::DiagCategory::Listeners, detail::DiagLevel::Debug))
   {
     if (!d->cachedReference.Load().GetBundle() &&
         d->cachedService.Load() == nullptr)
     {
-      DIAG_LOG(*d->context.GetLogSink()) << "ServiceTracker<S,TTT>::close[cached cleared]:"
+      DIAG_LOG_AT(*d->context.GetLogSink(), Listeners, Debug) << "ServiceTracker<S,TTT>::close[cached cleared]:"
                     << d->filter;
     }
   }
@@ -258,11 +259,11 @@ ServiceTracker<S,T>::GetServiceReference() const
   ServiceReference<S> reference = d->cachedReference.Load();
   if (reference.GetBundle())
   {
-    DIAG_LOG(*d->context.GetLogSink()) << "ServiceTracker<S,TTT>::getServiceReference[cached]:"
+    DIAG_LOG_AT(*d->context.GetLogSink(), Listeners, Debug) << "ServiceTracker<S,TTT>::getServiceReference[cached]:"
                   << d->filter;
     return reference;
   }
-  DIAG_LOG(*d->context.GetLogSink()) << "ServiceTracker<S,TTT>::getServiceReference:" << d->filter;
+  DIAG_LOG_AT(*d->context.GetLogSink(), Listeners, Debug) << "ServiceTracker<S,TTT>::getServiceReference:" << d->filter;
   auto references = GetServiceReferences();
   std::size_t length = references.size();
   if (length == 0)
@@ -370,11 +371,11 @@ ServiceTracker<S,T>::GetService() const
   auto service = d->cachedService.Load();
   if (service)
   {
-    DIAG_LOG(*d->context.GetLogSink()) << "ServiceTracker<S,TTT>::getService[cached]:"
+    DIAG_LOG_AT(*d->context.GetLogSink(), Listeners, Debug) << "ServiceTracker<S,TTT>::getService[cached]:"
                   << d->filter;
     return service;
   }
-  DIAG_LOG(*d->context.GetLogSink()) << "ServiceTracker<S,TTT>::getService:" << d->filter;
+  DIAG_LOG_AT(*d->context.GetLogSink(), Listeners, Debug) << "ServiceTracker<S,TTT>::getService:" << d->filter;
 
   try
   {
@@ -448,6 +449,68 @@ bool ServiceTracker<S,T>::IsEmpty() const
   return (t->Lock(), t->IsEmpty_unlocked());
 }
 
+template<class S, class T>
+std::shared_ptr<const typename ServiceTracker<S,T>::TrackedSnapshot>
+ServiceTracker<S,T>::GetTrackedSnapshot() const
+{
+  auto snapshot = d->LoadSnapshot();
+  if (snapshot)
+  {
+    return snapshot;
+  }
+
+  /* read the version first, so a concurrent change invalidates the new snapshot */
+  const int version = d->snapshotVersion.load();
+  auto t = d->Tracked();
+  if (!t)
+  { /* if ServiceTracker is not open */
+    static const auto emptySnapshot = std::make_shared<const TrackedSnapshot>(TrackedSnapshot{ -1, {} });
+    return emptySnapshot;
+  }
+
+  auto newSnapshot = std::make_shared<TrackedSnapshot>();
+  {
+    auto l = t->Lock(); US_UNUSED(l);
+    newSnapshot->trackingCount = t->GetTrackingCount();
+    t->CopyEntries_unlocked(newSnapshot->services);
+  }
+
+  // Sort outside of the lock. The ranking and id of each service are read
+  // once instead of in every comparison.
+  struct RankedEntry
+  {
+    int ranking;
+    long int id;
+    std::size_t index;
+  };
+  auto& services = newSnapshot->services;
+  std::vector<RankedEntry> order;
+  order.reserve(services.size());
+  for (std::size_t i = 0; i < services.size(); ++i)
+  {
+    Any rankingAny = services[i].first.GetProperty(Constants::SERVICE_RANKING);
+    int ranking = 0;
+    if (rankingAny.Type() == typeid(int))
+    {
+      ranking = any_cast<int>(rankingAny);
+    }
+    order.push_back({ ranking, any_cast<long int>(services[i].first.GetProperty(Constants::SERVICE_ID)), i });
+  }
+  std::sort(order.begin(), order.end(), [](const RankedEntry& a, const RankedEntry& b) {
+    return a.ranking != b.ranking ? a.ranking > b.ranking : a.id < b.id;
+  });
+  decltype(newSnapshot->services) sorted;
+  sorted.reserve(services.size());
+  for (auto& entry : order)
+  {
+    sorted.push_back(std::move(services[entry.index]));
+  }
+  services.swap(sorted);
+
+  d->StoreSnapshot(version, newSnapshot);
+  return newSnapshot;
+}
+
 template<class S, class T>
 std::shared_ptr<typename ServiceTracker<S,T>::TrackedParamType>
 ServiceTracker<S,T>::AddingService(const ServiceReference<S>& reference)
@@ -28,6 +28,9 @@
 #include "cppmicroservices/ServiceReference.h"
 #include "cppmicroservices/detail/Threads.h"
 
+#include <atomic>
+#include <memory>
+
 namespace cppmicroservices {
 
 namespace detail {
@@ -156,6 +159,40 @@ public:
    */
   mutable Atomic<std::shared_ptr<TrackedParamType>> cachedService;
 
+  using TrackedSnapshot = typename ServiceTracker<S, T>::TrackedSnapshot;
+
+  /**
+   * A snapshot published for GetTrackedSnapshot, together with the
+   * snapshotVersion it was taken at.
+   */
+  struct CachedSnapshot
+  {
+    int version;
+    std::shared_ptr<const TrackedSnapshot> snapshot;
+  };
+
+  /**
+   * Incremented by Modified(). A cached snapshot is only valid while its
+   * version matches.
+   */
+  std::atomic<int> snapshotVersion;
+
+  /**
+   * Cached snapshot for GetTrackedSnapshot. Readers copy the shared_ptr,
+   * so a replaced snapshot is released as soon as its last reader drops it.
+   */
+  mutable Atomic<std::shared_ptr<const CachedSnapshot>> cachedSnapshot;
+
+  /**
+   * Return the cached snapshot if it is still valid, or nullptr otherwise.
+   */
+  std::shared_ptr<const TrackedSnapshot> LoadSnapshot() const;
+
+  /**
+   * Publish a new snapshot, or clear the cache if \c snapshot is nullptr.
+   */
+  void StoreSnapshot(int version, std::shared_ptr<const TrackedSnapshot> snapshot);
+
 private:
   inline ServiceTracker<S, T>* q_func()
   {
@@ -42,7 +42,7 @@ ServiceTrackerPrivate<S,TTT>::ServiceTrackerPrivate(
     ServiceTrackerCustomizer<S,T>* customizer
     )
   : context(std::move(context)), customizer(customizer), listenerToken(), trackReference(reference),
-    trackedService(), cachedReference(), cachedService(), q_ptr(st)
+    trackedService(), cachedReference(), cachedService(), snapshotVersion(0), cachedSnapshot(), q_ptr(st)
 {
   this->customizer = customizer ? customizer : q_func();
   std::stringstream ss;
@@ -73,7 +73,7 @@ ServiceTrackerPrivate<S,TTT>::ServiceTrackerPrivate(
     )
   : context(std::move(context)), customizer(customizer), listenerToken(), trackClass(clazz),
     trackReference(), trackedService(), cachedReference(),
-    cachedService(), q_ptr(st)
+    cachedService(), snapshotVersion(0), cachedSnapshot(), q_ptr(st)
 {
   this->customizer = customizer ? customizer : q_func();
   this->listenerFilter = std::string("(") + cppmicroservices::Constants::OBJECTCLASS + "="
@@ -103,7 +103,7 @@ ServiceTrackerPrivate<S,TTT>::ServiceTrackerPrivate(
     )
   : context(context), filter(filter), customizer(customizer),
     listenerFilter(filter.ToString()), listenerToken(), trackReference(),
-    trackedService(), cachedReference(), cachedService(), q_ptr(st)
+    trackedService(), cachedReference(), cachedService(), snapshotVersion(0), cachedSnapshot(), q_ptr(st)
 {
   this->customizer = customizer ? customizer : q_func();
   if (!context)
@@ -155,7 +155,35 @@ void ServiceTrackerPrivate<S,TTT>::Modified()
 {
   cachedReference.Store(ServiceReference<S>()); /* clear cached value */
   cachedService.Store(std::shared_ptr<TrackedParamType>()); /* clear cached value */
-  DIAG_LOG(*context.GetLogSink()) << "ServiceTracker::Modified(): " << filter;
+  ++snapshotVersion;
+  if (cachedSnapshot.Load())
+  {
+    StoreSnapshot(0, nullptr); /* clear cached value */
+  }
+  DIAG_LOG_AT(*context.GetLogSink(), Listeners, Debug) << "ServiceTracker::Modified(): " << filter;
+}
+
+template<class S, class TTT>
+std::shared_ptr<const typename ServiceTrackerPrivate<S,TTT>::TrackedSnapshot>
+ServiceTrackerPrivate<S,TTT>::LoadSnapshot() const
+{
+  auto cached = cachedSnapshot.Load();
+  if (cached && cached->version == snapshotVersion.load())
+  {
+    return cached->snapshot;
+  }
+  return nullptr;
+}
+
+template<class S, class TTT>
+void ServiceTrackerPrivate<S,TTT>::StoreSnapshot(int version, std::shared_ptr<const TrackedSnapshot> snapshot)
+{
+  std::shared_ptr<const CachedSnapshot> cached;
+  if (snapshot)
+  {
+    cached = std::make_shared<const CachedSnapshot>(CachedSnapshot{ version, std::move(snapshot) });
+  }
+  cachedSnapshot.Store(cached);
 }
 
 } // namespace detail
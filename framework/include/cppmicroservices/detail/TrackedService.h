@@ -84,6 +84,21 @@ private:
     ServiceReference<S> item,
     const ServiceEvent& related) override;
 
+  /**
+   * Call the specific customizer adding method for the initial items. This
+   * method must not be called while synchronized on this object.
+   *
+   * @param items Items to be tracked.
+   * @param related Action related object.
+   * @param error Set to the first exception thrown by the default
+   *        <code>AddingServices</code> implementation for a single service.
+   * @return Customized objects for the tracked items, in the same order.
+   */
+  std::vector<std::shared_ptr<TrackedParamType>> CustomizerAddingBatch(
+    const std::vector<ServiceReference<S>>& items,
+    const ServiceEvent& related,
+    std::exception_ptr& error) override;
+
   /**
    * Call the specific customizer modified method. This method must not be
    * called while synchronized on this object.
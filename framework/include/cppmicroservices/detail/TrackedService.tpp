@@ -46,7 +46,7 @@ void TrackedService<S,TTT>::ServiceChanged(const ServiceEvent& event)
 
   ServiceReference<S> reference = event.GetServiceReference<S>();
 
-  DIAG_LOG(*serviceTracker->d->context.GetLogSink()) << "TrackedService::ServiceChanged["
+  DIAG_LOG_AT(*serviceTracker->d->context.GetLogSink(), Listeners, Debug) << "TrackedService::ServiceChanged["
                                                     << event.GetType() << "]: " << reference;
   if (!reference)
   {
@@ -113,6 +113,24 @@ TrackedService<S,TTT>::CustomizerAdding(ServiceReference<S> item,
   return customizer->AddingService(item);
 }
 
+template<class S, class TTT>
+std::vector<std::shared_ptr<typename TrackedService<S,TTT>::TrackedParamType>>
+TrackedService<S,TTT>::CustomizerAddingBatch(const std::vector<ServiceReference<S>>& items,
+                                             const ServiceEvent& /*related*/,
+                                             std::exception_ptr& error)
+{
+  try
+  {
+    return customizer->AddingServices(items);
+  }
+  catch (AddEachServiceError<TrackedParamType>& e)
+  {
+    /* AddingService threw for some of the services, track the others */
+    error = e.error;
+    return std::move(e.services);
+  }
+}
+
 template<class S, class TTT>
 void TrackedService<S,TTT>::CustomizerModified(ServiceReference<S> item,
                                                const ServiceEvent& /*related*/,
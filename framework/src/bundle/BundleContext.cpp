@@ -243,8 +243,8 @@ struct ServiceHolder
     } catch (...) {
       // Make sure that we don't crash if the shared_ptr service object outlives
       // the BundlePrivate or CoreBundleContext objects.
-      if (!b.expired()) {
-        DIAG_LOG(*b.lock()->coreCtx->sink)
+      if (auto bundle = b.lock()) {
+        DIAG_LOG_AT(*bundle->coreCtx->sink, Registry, Error)
           << "UngetService threw an exception. " << util::GetLastExceptionStr();
       }
       // don't throw exceptions from the destructor. For an explanation, see:
@@ -264,6 +264,14 @@ std::shared_ptr<void> BundleContext::GetService(
   }
 
   d->CheckValid();
+
+  // Fast path for services without a service factory: the bundle of a
+  // context never changes, so it is read without the lock, and the cached
+  // use of the service is shared without allocating.
+  if (auto service = reference.d.load()->GetSingletonService(d->bundle)) {
+    return service;
+  }
+
   auto b = (d->Lock(), d->bundle);
 
   // CONCURRENCY NOTE: This is a check-then-act situation,
@@ -285,6 +293,13 @@ InterfaceMapConstPtr BundleContext::GetService(
   }
 
   d->CheckValid();
+
+  // see GetService(const ServiceReferenceBase&)
+  if (auto serviceInterfaceMap =
+        reference.d.load()->GetSingletonServiceInterfaceMap(d->bundle)) {
+    return serviceInterfaceMap;
+  }
+
   auto b = (d->Lock(), d->bundle);
 
   // CONCURRENCY NOTE: This is a check-then-act situation,
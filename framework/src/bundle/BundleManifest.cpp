@@ -24,8 +24,9 @@
 
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
-#include <rapidjson/istreamwrapper.h>
 
+#include <algorithm>
+#include <cctype>
 #include <stdexcept>
 #include <typeinfo>
 
@@ -135,17 +136,66 @@ void ParseJsonArray(const rapidjson::Value& jsonArray, AnyVector& anyVector, boo
   }
 }
 
+/**
+ * Returns true if ParseJsonValue creates a non-empty Any for the value,
+ * i.e. if the value becomes a header.
+ */
+bool IsHeaderValue(const rapidjson::Value& jsonValue)
+{
+  return jsonValue.IsObject() || jsonValue.IsArray() || jsonValue.IsString() ||
+         jsonValue.IsBool() || jsonValue.IsInt() || jsonValue.IsDouble();
+}
+
+/**
+ * Finds the value of a header in the parsed manifest, comparing keys
+ * case-insensitively like the headers AnyMap does. Like emplacing into the
+ * AnyMap, the first of several matching keys wins.
+ */
+const rapidjson::Value* FindHeaderValue(const rapidjson::Value& root,
+                                        const std::string& key)
+{
+  for (const auto& m : root.GetObject()) {
+    if (m.name.GetStringLength() != key.size() || !IsHeaderValue(m.value)) {
+      continue;
+    }
+    const char* name = m.name.GetString();
+    if (std::equal(key.begin(), key.end(), name, [](char a, char b) {
+          return tolower(static_cast<unsigned char>(a)) ==
+                 tolower(static_cast<unsigned char>(b));
+        })) {
+      return &m.value;
+    }
+  }
+  return nullptr;
+}
+
 }
 
+struct BundleManifest::Json
+{
+  // holds the strings of the document, which is parsed in place
+  std::string buffer;
+  rapidjson::Document document;
+};
+
 BundleManifest::BundleManifest()
   : m_Headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
 {}
 
+BundleManifest::~BundleManifest() = default;
+
 void BundleManifest::Parse(std::istream& is)
 {
-  rapidjson::IStreamWrapper jsonStream(is);
-  rapidjson::Document root;
-  if (root.ParseStream(jsonStream).HasParseError()) {
+  auto json = std::make_unique<Json>();
+  char chunk[4096];
+  while (is.read(chunk, sizeof(chunk)) || is.gcount() > 0) {
+    json->buffer.append(chunk, static_cast<std::size_t>(is.gcount()));
+  }
+
+  // Parsing in place decodes the strings inside the buffer instead of
+  // copying each of them into the document.
+  auto& root = json->document;
+  if (root.ParseInsitu(&json->buffer[0]).HasParseError()) {
     throw std::runtime_error(rapidjson::GetParseError_En(root.GetParseError()));
   }
 
@@ -153,22 +203,46 @@ void BundleManifest::Parse(std::istream& is)
     throw std::runtime_error("The Json root element must be an object.");
   }
 
-  
-  ParseJsonObject(root, m_Headers);
+  std::lock_guard<std::mutex> lock(m_JsonMutex);
+  m_Json = std::move(json);
+}
+
+void BundleManifest::CreateHeaders() const
+{
+  std::call_once(m_DidCreateHeaders, [this]() {
+    std::lock_guard<std::mutex> lock(m_JsonMutex);
+    if (m_Json) {
+      AnyMap headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+      ParseJsonObject(m_Json->document, headers);
+      m_Headers = FrozenAnyMap(std::move(headers));
+      m_Json.reset();
+    }
+  });
 }
 
 const AnyMap& BundleManifest::GetHeaders() const
 {
+  CreateHeaders();
   return m_Headers;
 }
 
 bool BundleManifest::Contains(const std::string& key) const
 {
+  std::lock_guard<std::mutex> lock(m_JsonMutex);
+  if (m_Json) {
+    return FindHeaderValue(m_Json->document, key) != nullptr;
+  }
   return m_Headers.count(key) > 0;
 }
 
 Any BundleManifest::GetValue(const std::string& key) const
 {
+  std::lock_guard<std::mutex> lock(m_JsonMutex);
+  if (m_Json) {
+    // converts only the requested value, the headers may never be needed
+    auto value = FindHeaderValue(m_Json->document, key);
+    return value ? ParseJsonValue(*value, true) : Any();
+  }
   auto iter = m_Headers.find(key);
   if (m_Headers.cend() != iter)
   {
@@ -180,7 +254,7 @@ Any BundleManifest::GetValue(const std::string& key) const
 void BundleManifest::CopyDeprecatedProperties() const
 {
   std::call_once(m_DidCopyDeprecatedProperties
-                 , [&]() { copy_deprecated_properties(m_Headers, m_PropertiesDeprecated); });
+                 , [&]() { copy_deprecated_properties(GetHeaders(), m_PropertiesDeprecated); });
 }
 
 Any BundleManifest::GetValueDeprecated(const std::string& key) const
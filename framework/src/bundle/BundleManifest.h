@@ -25,6 +25,7 @@
 
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/AnyMap.h"
+#include <memory>
 #include <mutex>
 
 namespace cppmicroservices {
@@ -34,7 +35,12 @@ class BundleManifest
 
 public:
   BundleManifest();
+  ~BundleManifest();
 
+  /**
+   * Parses the manifest in place and keeps the parsed document. The
+   * headers are converted to an AnyMap on the first call of GetHeaders().
+   */
   void Parse(std::istream& is);
 
   const AnyMap& GetHeaders() const;
@@ -53,7 +59,19 @@ private:
   // GetPropertiesDeprecated() is called.
   mutable std::map<std::string, Any> m_PropertiesDeprecated;
   mutable std::once_flag m_DidCopyDeprecatedProperties;
-  AnyMap m_Headers;
+
+  struct Json;
+
+  // The parsed manifest, until m_Headers is created from it. Guarded by
+  // m_JsonMutex, which also guards writing m_Headers.
+  mutable std::unique_ptr<Json> m_Json;
+  mutable std::mutex m_JsonMutex;
+  mutable std::once_flag m_DidCreateHeaders;
+  mutable FrozenAnyMap m_Headers;
+
+  /** creates m_Headers from m_Json exactly once and releases m_Json.
+   */
+  void CreateHeaders() const;
 
   /** copies m_Headers to m_PropertiesDeprecated exactly once per BundleManifest using
    * std::call_once. Needs to be a const method because it's called from other const
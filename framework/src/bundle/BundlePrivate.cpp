@@ -353,7 +353,7 @@ void BundlePrivate::FinalizeActivation(LockType& l)
       state = Bundle::STATE_STARTING;
       operation = OP_ACTIVATING;
       if (coreCtx->debug.lazyActivation) {
-        DIAG_LOG(*coreCtx->sink) << "activating #" << id;
+        DIAG_LOG_AT(*coreCtx->sink, Bundles, Info) << "activating #" << id;
       }
       // 7:
       std::shared_ptr<BundleContextPrivate> null_expected;
@@ -555,11 +555,9 @@ std::exception_ptr BundlePrivate::Start0()
   coreCtx->listeners.BundleChanged(
     BundleEvent(BundleEvent::BUNDLE_STARTING, thisBundle));
 
-  auto headers = thisBundle.GetHeaders();
-  Any bundleActivatorVal;
-  if (headers.count(Constants::BUNDLE_ACTIVATOR) > 0) {
-    bundleActivatorVal = headers.find(Constants::BUNDLE_ACTIVATOR)->second;
-  }
+  // looked up in the manifest, so that starting a bundle does not
+  // create its headers
+  Any bundleActivatorVal = bundleManifest.GetValue(Constants::BUNDLE_ACTIVATOR);
 
   bool useActivator = false;
   if (!bundleActivatorVal.Empty()) {
@@ -670,7 +668,7 @@ std::exception_ptr BundlePrivate::Start0()
   }
 
   if (coreCtx->debug.lazyActivation) {
-    DIAG_LOG(*coreCtx->sink) << "activating #" << id << " completed.";
+    DIAG_LOG_AT(*coreCtx->sink, Bundles, Info) << "activating #" << id << " completed.";
   }
 
   if (res == nullptr) {
@@ -914,6 +912,9 @@ void BundlePrivate::RemoveBundleResources()
       .d.load()
       ->UngetService(this->shared_from_this(), false);
   }
+  // cached uses without outstanding service objects are not reported as
+  // used above, but their slots must be freed as well
+  coreCtx->services.RemoveSingletonUses(this);
 }
 
 void BundlePrivate::Purge()
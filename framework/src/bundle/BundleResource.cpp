@@ -294,9 +294,9 @@ std::unique_ptr<void, void (*)(void*)> BundleResource::GetData() const
   auto data = d->archive->GetResourceContainer()->GetData(d->stat.index);
   if (!data) {
     auto sink = GetBundleContext().GetLogSink();
-    DIAG_LOG(*sink) << "Error uncompressing resource data for "
-                    << this->GetResourcePath() << " from "
-                    << d->archive->GetBundleLocation();
+    DIAG_LOG_AT(*sink, Resources, Error)
+      << "Error uncompressing resource data for " << this->GetResourcePath()
+      << " from " << d->archive->GetBundleLocation();
   }
 
   return data;
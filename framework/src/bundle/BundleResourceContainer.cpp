@@ -195,8 +195,8 @@ void BundleResourceContainer::InitMiniz()
   }
   catch (const std::exception& ex) {
     auto sink = GetBundleContext().GetLogSink();
-    DIAG_LOG(*sink) << "Exception thrown creating BundleFileObj : "
-                    << ex.what();
+    DIAG_LOG_AT(*sink, Resources, Error)
+      << "Exception thrown creating BundleFileObj : " << ex.what();
   }
 
   if (!rawBundleResourceData || 
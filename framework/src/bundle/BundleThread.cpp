@@ -243,7 +243,7 @@ std::exception_ptr BundleThread::StartAndWait(BundlePrivate* b,
     std::string reason = timeout ? "Time-out during bundle " + opType + "()"
                                  : "Bundle uninstalled during " + opType + "()";
 
-    DIAG_LOG(*b->coreCtx->sink)
+    DIAG_LOG_AT(*b->coreCtx->sink, Bundles, Warning)
       << "bundle thread aborted during " << opType << " of bundle #" << b->id;
 
     if (timeout) {
@@ -99,7 +99,8 @@ void* GetSymbol(void* libHandle, const char* symbol)
   void* addr = libHandle ? dlsym(libHandle, symbol) : nullptr;
   if (!addr) {
     const char* dlerrorMsg = dlerror();
-    DIAG_LOG(*GetFrameworkLogSink())
+    auto sink = GetFrameworkLogSink();
+    DIAG_LOG_AT(*sink, Bundles, Error)
       << "GetSymbol() failed to find (" << symbol
       << ") with error : " << (dlerrorMsg ? dlerrorMsg : "unknown");
   }
@@ -53,6 +53,12 @@ const std::string FRAMEWORK_THREADING_SUPPORT =
 const std::string FRAMEWORK_THREADING_SINGLE = "single";
 const std::string FRAMEWORK_THREADING_MULTI = "multi";
 const std::string FRAMEWORK_LOG = "org.cppmicroservices.framework.log";
+const std::string FRAMEWORK_LOG_LEVELS =
+  "org.cppmicroservices.framework.log.levels";
+const std::string FRAMEWORK_LOG_BUFFER_SIZE =
+  "org.cppmicroservices.framework.log.buffer_size";
+const std::string FRAMEWORK_LOG_DUMP_ON_TERMINATE =
+  "org.cppmicroservices.framework.log.dump_on_terminate";
 const std::string FRAMEWORK_UUID = "org.cppmicroservices.framework.uuid";
 const std::string FRAMEWORK_WORKING_DIR =
   "org.cppmicroservices.framework.working.dir";
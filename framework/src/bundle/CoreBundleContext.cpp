@@ -39,6 +39,7 @@ US_MSVC_DISABLE_WARNING(4355)
 
 #include <iomanip>
 #include <memory>
+#include <stdexcept>
 
 #ifdef US_PLATFORM_POSIX
 #include <dlfcn.h>
@@ -96,7 +97,37 @@ CoreBundleContext::CoreBundleContext(const std::unordered_map<std::string, Any>&
 {
   auto enableDiagLog = any_cast<bool>(frameworkProperties.at(Constants::FRAMEWORK_LOG));
   std::ostream* diagnosticLogger = (logger) ? logger : &std::clog;
-  sink = std::make_shared<detail::LogSink>(diagnosticLogger, enableDiagLog);
+  std::size_t diagBufferSize = 0;
+  auto bufferSizeProp = frameworkProperties.find(Constants::FRAMEWORK_LOG_BUFFER_SIZE);
+  if (bufferSizeProp != frameworkProperties.end()) {
+    // integral values and decimal strings are both accepted
+    const auto sizeStr = bufferSizeProp->second.ToStringNoExcept();
+    std::size_t parsed = 0;
+    long long size = -1;
+    try {
+      size = std::stoll(sizeStr, &parsed);
+    } catch (const std::exception&) {
+    }
+    if (size < 0 || parsed != sizeStr.size()) {
+      throw std::invalid_argument("Invalid value '" + sizeStr +
+                                  "' for the framework property '" +
+                                  Constants::FRAMEWORK_LOG_BUFFER_SIZE +
+                                  "'. Expected a non-negative integer.");
+    }
+    diagBufferSize = static_cast<std::size_t>(size);
+  }
+  sink = std::make_shared<detail::LogSink>(diagnosticLogger, enableDiagLog, diagBufferSize);
+  auto levelsProp = frameworkProperties.find(Constants::FRAMEWORK_LOG_LEVELS);
+  if (levelsProp != frameworkProperties.end()) {
+    detail::ApplyDiagLevels(*sink, levelsProp->second.ToStringNoExcept());
+  }
+  auto dumpProp = frameworkProperties.find(Constants::FRAMEWORK_LOG_DUMP_ON_TERMINATE);
+  if (diagBufferSize != 0 && dumpProp != frameworkProperties.end() &&
+      (dumpProp->second.Type() == typeid(bool)
+         ? any_cast<bool>(dumpProp->second)
+         : dumpProp->second.ToStringNoExcept() == "true")) {
+    detail::DumpOnTerminate(sink);
+  }
   systemBundle = std::shared_ptr<FrameworkPrivate>(new FrameworkPrivate(this));
   DIAG_LOG(*sink) << "created";
 }
@@ -148,8 +179,9 @@ void CoreBundleContext::Init()
   try {
     dataStorage = GetPersistentStoragePath(this, "data", /*create=*/false);
   } catch (const std::exception& e) {
-    DIAG_LOG(*sink) << "Ignored runtime exception with message'" << e.what()
-                    << "' from the GetPersistentStoragePath function.\n";
+    DIAG_LOG_AT(*sink, General, Warning)
+      << "Ignored runtime exception with message'" << e.what()
+      << "' from the GetPersistentStoragePath function.\n";
   }
 
   systemBundle->InitSystemBundle();
@@ -167,7 +199,7 @@ void CoreBundleContext::Init()
   try {
     execPath = util::GetExecutablePath();
   } catch (const std::exception& e) {
-    DIAG_LOG(*sink) << e.what();
+    DIAG_LOG_AT(*sink, General, Error) << e.what();
     // Let the exception propagate all the way up to the
     // call site of Framework::Init().
     throw;
@@ -183,15 +215,16 @@ void CoreBundleContext::Init()
 
   DIAG_LOG(*sink) << "inited\nInstalled bundles: ";
   for (auto b : bundleRegistry.GetBundles()) {
-    DIAG_LOG(*sink) << " #" << b->id << " " << b->symbolicName << ":"
-                    << b->version << " location:" << b->location;
+    DIAG_LOG_AT(*sink, Bundles, Info)
+      << " #" << b->id << " " << b->symbolicName << ":" << b->version
+      << " location:" << b->location;
   }
 
 #ifdef US_PLATFORM_POSIX
   try {
       libraryLoadOptions = any_cast<int>(frameworkProperties[Constants::LIBRARY_LOAD_OPTIONS]);
   } catch (...) {
-      DIAG_LOG(*sink) << "Unable to read default library load options from config.";
+      DIAG_LOG_AT(*sink, General, Warning) << "Unable to read default library load options from config.";
       libraryLoadOptions = RTLD_LAZY | RTLD_LOCAL;
   }
   DIAG_LOG(*sink) << "Library Load Options = " << libraryLoadOptions;
@@ -0,0 +1,151 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "InternedInterfaceId.h"
+
+#include <atomic>
+#include <limits>
+#include <mutex>
+
+namespace cppmicroservices {
+
+/**
+ * An interned interface id. Entries are immutable once published and are
+ * never freed.
+ */
+struct InternedInterfaceIdEntry
+{
+  InternedInterfaceIdEntry(const std::string& interfaceId,
+                           std::size_t hash,
+                           std::size_t index,
+                           const InternedInterfaceIdEntry* next)
+    : interfaceId(interfaceId)
+    , hash(hash)
+    , index(index)
+    , next(next)
+  {}
+
+  const std::string interfaceId;
+  const std::size_t hash;
+  const std::size_t index;
+
+  /**
+   * The entry interned before this one in the same bucket.
+   */
+  const InternedInterfaceIdEntry* const next;
+};
+
+namespace {
+
+/**
+ * A hash table which only grows. Each bucket is a list of entries, a new
+ * entry is published at its head with a release store, so readers walk
+ * the lists without locking. Writers are serialized by the mutex.
+ */
+struct InterfaceIdTable
+{
+  static const std::size_t BucketCount = 1024;
+
+  InterfaceIdTable()
+    : size(0)
+  {
+    for (auto& bucket : buckets) {
+      bucket.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  const InternedInterfaceIdEntry* Find(const std::string& interfaceId,
+                                       std::size_t hash) const
+  {
+    const auto& bucket = buckets[hash % BucketCount];
+    for (auto entry = bucket.load(std::memory_order_acquire); entry != nullptr;
+         entry = entry->next) {
+      if (entry->hash == hash && entry->interfaceId == interfaceId) {
+        return entry;
+      }
+    }
+    return nullptr;
+  }
+
+  std::mutex mutex;
+  std::size_t size;
+  std::atomic<const InternedInterfaceIdEntry*> buckets[BucketCount];
+};
+
+InterfaceIdTable& GetInterfaceIdTable()
+{
+  // Never destroyed, a framework may still be stopped by a static
+  // destructor which runs after the table would have been destroyed.
+  static auto* table = new InterfaceIdTable();
+  return *table;
+}
+
+const std::string& EmptyInterfaceId()
+{
+  static const std::string empty;
+  return empty;
+}
+}
+
+InternedInterfaceId::InternedInterfaceId(const std::string& interfaceId)
+{
+  auto& table = GetInterfaceIdTable();
+  const std::size_t hash = std::hash<std::string>()(interfaceId);
+  entry = table.Find(interfaceId, hash);
+  if (entry != nullptr) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(table.mutex);
+  // another thread may have interned it meanwhile
+  entry = table.Find(interfaceId, hash);
+  if (entry == nullptr) {
+    auto& bucket = table.buckets[hash % InterfaceIdTable::BucketCount];
+    entry = new InternedInterfaceIdEntry(
+      interfaceId, hash, table.size++, bucket.load(std::memory_order_relaxed));
+    bucket.store(entry, std::memory_order_release);
+  }
+}
+
+bool InternedInterfaceId::Find(const std::string& interfaceId,
+                               InternedInterfaceId& id)
+{
+  auto entry = GetInterfaceIdTable().Find(
+    interfaceId, std::hash<std::string>()(interfaceId));
+  if (entry == nullptr) {
+    return false;
+  }
+  id.entry = entry;
+  return true;
+}
+
+std::size_t InternedInterfaceId::GetIndex() const
+{
+  return entry != nullptr ? entry->index
+                          : std::numeric_limits<std::size_t>::max();
+}
+
+const std::string& InternedInterfaceId::GetInterfaceId() const
+{
+  return entry != nullptr ? entry->interfaceId : EmptyInterfaceId();
+}
+}
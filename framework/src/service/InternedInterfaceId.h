@@ -0,0 +1,106 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_INTERNEDINTERFACEID_H
+#define CPPMICROSERVICES_INTERNEDINTERFACEID_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace cppmicroservices {
+
+struct InternedInterfaceIdEntry;
+
+/**
+ * A handle to an interface id in the process-wide table of interned
+ * interface ids.
+ *
+ * Each distinct interface id is interned once and numbered in the order
+ * it is first seen, so maps keyed by handles hash and compare small
+ * integers instead of the id strings. Entries are never removed from
+ * the table, which lets lookups run without locking; only interning a
+ * new id takes a lock.
+ */
+class InternedInterfaceId
+{
+public:
+  /**
+   * Creates a handle which is unequal to the handle of every interned
+   * interface id.
+   */
+  InternedInterfaceId()
+    : entry(nullptr)
+  {}
+
+  /**
+   * Interns the given interface id.
+   *
+   * @param interfaceId The interface id to intern.
+   */
+  explicit InternedInterfaceId(const std::string& interfaceId);
+
+  /**
+   * Looks up an interface id without interning it, so that looking up
+   * arbitrary class names does not grow the table. Does not lock.
+   *
+   * @param interfaceId The interface id to look up.
+   * @param id Set to the handle of \c interfaceId if it was interned.
+   * @return \c true if \c interfaceId was interned before, \c false otherwise.
+   */
+  static bool Find(const std::string& interfaceId, InternedInterfaceId& id);
+
+  std::size_t GetIndex() const;
+
+  /**
+   * The interned interface id, empty for a default constructed handle.
+   */
+  const std::string& GetInterfaceId() const;
+
+  bool operator==(const InternedInterfaceId& other) const
+  {
+    return entry == other.entry;
+  }
+
+  bool operator!=(const InternedInterfaceId& other) const
+  {
+    return entry != other.entry;
+  }
+
+private:
+  const InternedInterfaceIdEntry* entry;
+};
+}
+
+namespace std {
+
+template<>
+struct hash<cppmicroservices::InternedInterfaceId>
+{
+  std::size_t operator()(const cppmicroservices::InternedInterfaceId& id) const
+  {
+    return id.GetIndex();
+  }
+};
+}
+
+#endif // CPPMICROSERVICES_INTERNEDINTERFACEID_H
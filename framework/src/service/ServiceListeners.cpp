@@ -37,6 +37,7 @@ US_MSVC_PUSH_DISABLE_WARNING(
 #include "CoreBundleContext.h"
 #include "Properties.h"
 #include "ServiceReferenceBasePrivate.h"
+#include "ServiceRegistrationBasePrivate.h"
 
 #include <cassert>
 
@@ -59,8 +60,9 @@ void ServiceListeners::Clear()
     serviceSet.clear();
     hashedServiceKeys.clear();
     complicatedListeners.clear();
-    cache[0].clear();
-    cache[1].clear();
+    objectClassCache.clear();
+    uninternedObjectClassCache.clear();
+    serviceIdCache.clear();
   }
 
   frameworkListenerMap.Lock(), frameworkListenerMap.value.clear();
@@ -277,8 +279,9 @@ void ServiceListeners::SendFrameworkEvent(const FrameworkEvent& evt)
         // do not send a FrameworkEvent as that could cause a deadlock or an infinite loop.
         // Instead, log to the internal logger
         // @todo send this to the LogService instead when its supported.
-        DIAG_LOG(*coreCtx->sink) << "A Framework Listener threw an exception: "
-                                 << util::GetLastExceptionStr() << "\n";
+        DIAG_LOG_AT(*coreCtx->sink, Listeners, Error)
+          << "A Framework Listener threw an exception: "
+          << util::GetLastExceptionStr() << "\n";
       }
     }
   }
@@ -415,17 +418,21 @@ void ServiceListeners::GetMatchingServiceListeners(const ServiceEvent& evt,
     }
 
     // Check the cache
-    const auto c = any_cast<std::vector<std::string>>(
-      props->Value_unlocked(Constants::OBJECTCLASS));
-    for (auto& objClass : c) {
-      AddToSet_unlocked(set, receivers, OBJECTCLASS_IX, objClass);
+    for (auto& objClass : ref.d.load()->registration->interfaceIds) {
+      AddToSet_unlocked(set, receivers, objectClassCache, objClass);
+      if (!uninternedObjectClassCache.empty()) {
+        AddToSet_unlocked(set,
+                          receivers,
+                          uninternedObjectClassCache,
+                          objClass.GetInterfaceId());
+      }
     }
 
     auto service_id =
       any_cast<long>(props->Value_unlocked(Constants::SERVICE_ID));
     AddToSet_unlocked(set,
                       receivers,
-                      SERVICE_ID_IX,
+                      serviceIdCache,
                       cppmicroservices::util::ToString((service_id)));
   }
 }
@@ -447,13 +454,17 @@ void ServiceListeners::RemoveFromCache_unlocked(const ServiceListenerEntry& sle)
 {
   if (!sle.GetLocalCache().empty()) {
     for (std::size_t i = 0; i < hashedServiceKeys.size(); ++i) {
-      CacheType& keymap = cache[i];
       std::vector<std::string>& filters = sle.GetLocalCache()[i];
       for (auto const& filter : filters) {
-        std::list<ServiceListenerEntry>& sles = keymap[filter];
-        sles.remove(sle);
-        if (sles.empty()) {
-          keymap.erase(filter);
+        if (i == OBJECTCLASS_IX) {
+          // the class may have been interned since the listener was added
+          InternedInterfaceId objClass;
+          if (InternedInterfaceId::Find(filter, objClass)) {
+            RemoveFromCache_unlocked(objectClassCache, objClass, sle);
+          }
+          RemoveFromCache_unlocked(uninternedObjectClassCache, filter, sle);
+        } else {
+          RemoveFromCache_unlocked(serviceIdCache, filter, sle);
         }
       }
     }
@@ -475,8 +486,14 @@ void ServiceListeners::CheckSimple_unlocked(const ServiceListenerEntry& sle)
                local_cache[i].begin();
              it != local_cache[i].end();
              ++it) {
-          std::list<ServiceListenerEntry>& sles = cache[i][*it];
-          sles.push_back(sle);
+          InternedInterfaceId objClass;
+          if (i != OBJECTCLASS_IX) {
+            serviceIdCache[*it].push_back(sle);
+          } else if (InternedInterfaceId::Find(*it, objClass)) {
+            objectClassCache[objClass].push_back(sle);
+          } else {
+            uninternedObjectClassCache[*it].push_back(sle);
+          }
         }
       }
     } else {
@@ -485,15 +502,31 @@ void ServiceListeners::CheckSimple_unlocked(const ServiceListenerEntry& sle)
   }
 }
 
+template<class Cache>
+void ServiceListeners::RemoveFromCache_unlocked(
+  Cache& cache,
+  const typename Cache::key_type& key,
+  const ServiceListenerEntry& sle)
+{
+  auto iter = cache.find(key);
+  if (iter != cache.end()) {
+    iter->second.remove(sle);
+    if (iter->second.empty()) {
+      cache.erase(iter);
+    }
+  }
+}
+
+template<class Cache>
 void ServiceListeners::AddToSet_unlocked(
   ServiceListenerEntries& set,
   const ServiceListenerEntries& receivers,
-  int cache_ix,
-  const std::string& val)
+  const Cache& cache,
+  const typename Cache::key_type& key)
 {
-  std::list<ServiceListenerEntry>& l = cache[cache_ix][val];
-  if (!l.empty()) {
-
+  auto iter = cache.find(key);
+  if (iter != cache.end()) {
+    const std::list<ServiceListenerEntry>& l = iter->second;
     for (std::list<ServiceListenerEntry>::const_iterator entry = l.begin();
          entry != l.end();
          ++entry) {
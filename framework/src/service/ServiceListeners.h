@@ -26,6 +26,7 @@
 #include "cppmicroservices/GlobalConfig.h"
 #include "cppmicroservices/detail/Threads.h"
 
+#include "InternedInterfaceId.h"
 #include "ServiceListenerEntry.h"
 
 #include <list>
@@ -59,6 +60,7 @@ public:
   } bundleListenerMap;
 
   using CacheType = std::unordered_map<std::string, std::list<ServiceListenerEntry>>;
+  using ObjectClassCacheType = std::unordered_map<InternedInterfaceId, std::list<ServiceListenerEntry>>;
   using ServiceListenerEntries = std::unordered_set<ServiceListenerEntry>;
 
   using FrameworkListenerEntry = std::tuple<FrameworkListener, void*>;
@@ -81,7 +83,13 @@ private:
   std::list<ServiceListenerEntry> complicatedListeners;
 
   /* Service listeners with "simple" filters are cached. */
-  CacheType cache[2];
+  ObjectClassCacheType objectClassCache;
+  CacheType serviceIdCache;
+
+  /* Listeners on object classes which were not interned when the listener
+   * was added. Filters are not interned, so that arbitrary class names do
+   * not grow the process-wide table. */
+  CacheType uninternedObjectClassCache;
 
   ServiceListenerEntries serviceSet;
 
@@ -246,10 +254,24 @@ private:
    */
   void CheckSimple_unlocked(const ServiceListenerEntry& sle);
 
+  /**
+   * Adds the service listeners cached under a key to \c set, or does
+   * nothing if no listeners are cached under the key.
+   */
+  template<class Cache>
   void AddToSet_unlocked(ServiceListenerEntries& set,
                          const ServiceListenerEntries& receivers,
-                         int cache_ix,
-                         const std::string& val);
+                         const Cache& cache,
+                         const typename Cache::key_type& key);
+
+  /**
+   * Removes a service listener from the listeners cached under a key, and
+   * the key once no listener is left.
+   */
+  template<class Cache>
+  void RemoveFromCache_unlocked(Cache& cache,
+                                const typename Cache::key_type& key,
+                                const ServiceListenerEntry& sle);
 };
 }
 
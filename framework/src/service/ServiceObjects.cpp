@@ -120,8 +120,8 @@ struct UngetHelper
     } catch (...) {
       // Make sure that we don't crash if the shared_ptr service object outlives
       // the BundlePrivate or CoreBundleContext objects.
-      if (!b.expired()) {
-        DIAG_LOG(*b.lock()->coreCtx->sink)
+      if (auto bundle = b.lock()) {
+        DIAG_LOG_AT(*bundle->coreCtx->sink, Registry, Error)
           << "UngetHelper threw an exception. " << util::GetLastExceptionStr();
       }
       // don't throw exceptions from the destructor. For an explanation, see:
@@ -54,7 +54,11 @@ void ServiceReferenceBase::SetInterfaceId(const std::string& interfaceId)
     --d.load()->ref;
     d = new ServiceReferenceBasePrivate(d.load()->registration);
   }
-  d.load()->interfaceId = interfaceId;
+  if (d.load()->interfaceId != interfaceId) {
+    d.load()->interfaceId = interfaceId;
+    // the cached interface belongs to the previous id
+    d.load()->singletonInterface.store(nullptr);
+  }
 }
 
 ServiceReferenceBase::operator bool() const
@@ -116,6 +120,14 @@ std::vector<Bundle> ServiceReferenceBase::GetUsingBundles() const
   for (auto& iter : d.load()->registration->dependents) {
     bundles.push_back(MakeBundle(iter.first->shared_from_this()));
   }
+  for (auto& use : d.load()->registration->singletonUses) {
+    auto bundle = use.bundle.load();
+    if (bundle != nullptr &&
+        d.load()->registration->IsSingletonUsedByBundle_unlocked(bundle) &&
+        d.load()->registration->dependents.count(bundle) == 0) {
+      bundles.push_back(MakeBundle(bundle->shared_from_this()));
+    }
+  }
   return bundles;
 }
 
@@ -46,6 +46,7 @@ ServiceReferenceBasePrivate::ServiceReferenceBasePrivate(
   ServiceRegistrationBasePrivate* reg)
   : ref(1)
   , registration(reg)
+  , singletonInterface(nullptr)
 {
   if (registration)
     ++registration->ref;
@@ -136,6 +137,45 @@ std::shared_ptr<void> ServiceReferenceBasePrivate::GetService(
   return ExtractInterface(GetServiceInterfaceMap(bundle), interfaceId);
 }
 
+std::shared_ptr<void> ServiceReferenceBasePrivate::GetSingletonService(
+  BundlePrivate* bundle)
+{
+  auto s = GetSingletonServiceInterfaceMap(bundle);
+  if (!s) {
+    return nullptr;
+  }
+  // the interface map of a service without a factory never changes
+  void* service = singletonInterface.load();
+  if (service == nullptr) {
+    service = ExtractInterface(s, interfaceId).get();
+    if (service == nullptr) {
+      return nullptr;
+    }
+    singletonInterface.store(service);
+  }
+  return std::shared_ptr<void>(s, service);
+}
+
+InterfaceMapConstPtr
+ServiceReferenceBasePrivate::GetSingletonServiceInterfaceMap(
+  BundlePrivate* bundle)
+{
+  if (registration->isServiceFactory || !registration->available) {
+    return nullptr;
+  }
+  if (auto s = registration->GetSingletonUse(bundle)) {
+    return s;
+  }
+
+  auto l = registration->Lock();
+  US_UNUSED(l);
+  if (!registration->available || !registration->service ||
+      registration->service->empty()) {
+    return nullptr;
+  }
+  return registration->AddSingletonUse_unlocked(bundle);
+}
+
 InterfaceMapConstPtr ServiceReferenceBasePrivate::GetServiceInterfaceMap(
   BundlePrivate* bundle)
 {
@@ -321,6 +361,9 @@ bool ServiceReferenceBasePrivate::UngetService(
   {
     auto l = registration->Lock();
     US_UNUSED(l);
+    if (!checkRefCounter) {
+      registration->RemoveSingletonUses_unlocked(bundle.get());
+    }
     auto depIter = registration->dependents.find(bundle.get());
     if (registration->dependents.end() == depIter) {
       return hadReferences && removeService;
@@ -61,6 +61,21 @@ public:
 
   InterfaceMapConstPtr GetServiceInterfaceMap(BundlePrivate* bundle);
 
+  /**
+    * Get a service registered without a service factory from the cached
+    * use of the bundle, see ServiceRegistrationBasePrivate::SingletonUse.
+    * Once the use is cached, this neither locks nor allocates. The
+    * returned object is not counted in the dependents map and must not be
+    * released with UngetService.
+    *
+    * @param bundle requester of service.
+    * @return Service requested or null if the service has a factory, is
+    *         unregistered or no cache slot is free.
+    */
+  std::shared_ptr<void> GetSingletonService(BundlePrivate* bundle);
+
+  InterfaceMapConstPtr GetSingletonServiceInterfaceMap(BundlePrivate* bundle);
+
   /**
     * Get new service instance.
     *
@@ -116,6 +131,12 @@ public:
    */
   std::string interfaceId;
 
+  /**
+   * The interface of a service without a service factory, looked up once
+   * for GetSingletonService.
+   */
+  std::atomic<void*> singletonInterface;
+
 private:
   InterfaceMapConstPtr GetServiceFromFactory(
     BundlePrivate* bundle,
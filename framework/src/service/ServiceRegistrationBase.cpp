@@ -135,7 +135,6 @@ void ServiceRegistrationBase::SetProperties(const ServiceProperties& props)
 
   int old_rank = 0;
   int new_rank = 0;
-  Any objectClasses;
   {
     auto l = d->Lock();
     US_UNUSED(l);
@@ -148,8 +147,8 @@ void ServiceRegistrationBase::SetProperties(const ServiceProperties& props)
     auto propsCopy(props);
     propsCopy[Constants::SERVICE_ID] =
       d->properties.Value_unlocked(Constants::SERVICE_ID);
-    objectClasses = d->properties.Value_unlocked(Constants::OBJECTCLASS);
-    propsCopy[Constants::OBJECTCLASS] = objectClasses;
+    propsCopy[Constants::OBJECTCLASS] =
+      d->properties.Value_unlocked(Constants::OBJECTCLASS);
     propsCopy[Constants::SERVICE_SCOPE] =
       d->properties.Value_unlocked(Constants::SERVICE_SCOPE);
 
@@ -174,8 +173,7 @@ void ServiceRegistrationBase::SetProperties(const ServiceProperties& props)
     d->properties = Properties(std::move(propsCopy));
   }
   if (old_rank != new_rank) {
-    auto classes = any_cast<std::vector<std::string>>(objectClasses);
-    d->bundle->coreCtx->services.UpdateServiceRegistrationOrder(classes);
+    d->bundle->coreCtx->services.UpdateServiceRegistrationOrder(*this);
   }
 
   // Notify listeners, we must not hold any locks here
@@ -288,6 +286,7 @@ void ServiceRegistrationBase::Unregister()
 
     d->bundle = nullptr;
     d->dependents.clear();
+    d->RemoveSingletonUses_unlocked(nullptr);
     d->service.reset();
     d->prototypeServiceInstances.clear();
     d->bundleServiceInstance.clear();
@@ -22,6 +22,7 @@
 
 #include "ServiceRegistrationBasePrivate.h"
 
+#include <thread>
 #include <utility>
 
 #ifdef _MSC_VER
@@ -31,15 +32,36 @@
 
 namespace cppmicroservices {
 
+namespace {
+
+std::vector<InternedInterfaceId> InternInterfaceIds(
+  const InterfaceMapConstPtr& service)
+{
+  std::vector<InternedInterfaceId> ids;
+  if (service) {
+    ids.reserve(service->size());
+    for (const auto& i : *service) {
+      ids.emplace_back(i.first);
+    }
+  }
+  return ids;
+}
+}
+
 ServiceRegistrationBasePrivate::ServiceRegistrationBasePrivate(
   BundlePrivate* bundle,
   InterfaceMapConstPtr  service,
   Properties&& props)
   : ref(0)
   , service(std::move(service))
+  , isServiceFactory(this->service &&
+                     this->service->find("org.cppmicroservices.factory") !=
+                       this->service->end())
   , bundle(bundle)
   , reference(this)
   , properties(std::move(props))
+  , interfaceIds(InternInterfaceIds(this->service))
+  , registryRanking(0)
   , available(true)
   , unregistering(false)
 {
@@ -58,7 +80,92 @@ bool ServiceRegistrationBasePrivate::IsUsedByBundle(BundlePrivate* bundle) const
   US_UNUSED(l);
   return (dependents.find(bundle) != dependents.end()) ||
          (prototypeServiceInstances.find(bundle) !=
-          prototypeServiceInstances.end());
+          prototypeServiceInstances.end()) ||
+         IsSingletonUsedByBundle_unlocked(bundle);
+}
+
+bool ServiceRegistrationBasePrivate::IsSingletonUsedByBundle_unlocked(
+  BundlePrivate* bundle) const
+{
+  for (auto& use : singletonUses) {
+    if (use.bundle.load() == bundle) {
+      // one reference is held by the slot itself
+      return use.service.use_count() > 1;
+    }
+  }
+  return false;
+}
+
+bool ServiceRegistrationBasePrivate::HasSingletonUse(
+  BundlePrivate* bundle) const
+{
+  for (auto& use : singletonUses) {
+    if (use.bundle.load() == bundle) {
+      return true;
+    }
+  }
+  return false;
+}
+
+InterfaceMapConstPtr ServiceRegistrationBasePrivate::GetSingletonUse(
+  BundlePrivate* bundle)
+{
+  for (auto& use : singletonUses) {
+    if (use.bundle.load() == bundle) {
+      InterfaceMapConstPtr s;
+      ++use.readers;
+      // the slot may have been removed since it was checked, removing it
+      // waits for the readers which still see the bundle
+      if (use.bundle.load() == bundle) {
+        s = use.service;
+      }
+      --use.readers;
+      return s;
+    }
+  }
+  return nullptr;
+}
+
+InterfaceMapConstPtr ServiceRegistrationBasePrivate::AddSingletonUse_unlocked(
+  BundlePrivate* bundle)
+{
+  SingletonUse* freeUse = nullptr;
+  for (auto& use : singletonUses) {
+    auto useBundle = use.bundle.load();
+    if (useBundle == bundle) {
+      return use.service;
+    }
+    if (useBundle == nullptr && freeUse == nullptr) {
+      freeUse = &use;
+    }
+  }
+  if (freeUse == nullptr) {
+    return nullptr;
+  }
+
+  // Give each slot its own control block, so that its use count covers
+  // the service objects of this bundle only. The service is written
+  // before the bundle, readers only read it once they see the bundle.
+  auto s = service;
+  freeUse->service = InterfaceMapConstPtr(s.get(), [s](const InterfaceMap*) {});
+  freeUse->bundle.store(bundle);
+  return freeUse->service;
+}
+
+void ServiceRegistrationBasePrivate::RemoveSingletonUses_unlocked(
+  BundlePrivate* bundle)
+{
+  for (auto& use : singletonUses) {
+    auto useBundle = use.bundle.load();
+    if (useBundle == nullptr || (bundle != nullptr && useBundle != bundle)) {
+      continue;
+    }
+    use.bundle.store(nullptr);
+    while (use.readers.load() != 0) {
+      std::this_thread::yield();
+    }
+    use.service.reset();
+  }
 }
 
 InterfaceMapConstPtr ServiceRegistrationBasePrivate::GetInterfaces() const
@@ -27,9 +27,12 @@
 #include "cppmicroservices/ServiceReference.h"
 #include "cppmicroservices/detail/Threads.h"
 
+#include "InternedInterfaceId.h"
 #include "Properties.h"
 
+#include <array>
 #include <atomic>
+#include <vector>
 
 namespace cppmicroservices {
 
@@ -62,6 +65,11 @@ protected:
    */
   InterfaceMapConstPtr service;
 
+  /**
+   * Is the service object a ServiceFactory.
+   */
+  const bool isServiceFactory;
+
 public:
   using BundleToRefsMap = std::unordered_map<BundlePrivate*, int>;
   using BundleToServiceMap = std::unordered_map<BundlePrivate*, InterfaceMapConstPtr>;
@@ -88,6 +96,40 @@ public:
    */
   BundleToServiceMap bundleServiceInstance;
 
+  /**
+   * A bundle's cached use of a service registered without a service
+   * factory. The service objects handed out from it share the control
+   * block of \c service, so its use count tracks them instead of the
+   * dependents map. A slot is written with the registration locked and
+   * read without the lock.
+   */
+  struct SingletonUse
+  {
+    SingletonUse()
+      : bundle(nullptr)
+      , readers(0)
+    {}
+
+    /**
+     * The using bundle, or \c nullptr if the slot is free.
+     */
+    std::atomic<BundlePrivate*> bundle;
+
+    /**
+     * Number of threads which are copying \c service.
+     */
+    std::atomic<int> readers;
+
+    InterfaceMapConstPtr service;
+  };
+
+  /**
+   * Cached uses of this service, see
+   * ServiceReferenceBasePrivate::GetSingletonServiceInterfaceMap. Bundles
+   * beyond the number of slots use the dependents map.
+   */
+  std::array<SingletonUse, 4> singletonUses;
+
   /**
    * Bundle registering this service.
    */
@@ -103,6 +145,18 @@ public:
    */
   Properties properties;
 
+  /**
+   * The interned ids of the interfaces this service is registered under,
+   * which key the registry and the service listener cache.
+   */
+  const std::vector<InternedInterfaceId> interfaceIds;
+
+  /**
+   * The ranking under which this service is ordered in the registry.
+   * Guarded by the service registry lock.
+   */
+  int registryRanking;
+
   /**
    * Is service available. I.e., if <code>true</code> then holders
    * of a ServiceReference for the service are allowed to get it.
@@ -130,6 +184,37 @@ public:
    */
   bool IsUsedByBundle(BundlePrivate* bundle) const;
 
+  /**
+   * Check if a bundle holds service objects from its cached use of this
+   * service.
+   */
+  bool IsSingletonUsedByBundle_unlocked(BundlePrivate* bundle) const;
+
+  /**
+   * Check if a bundle has a cached use of this service, without locking.
+   */
+  bool HasSingletonUse(BundlePrivate* bundle) const;
+
+  /**
+   * Get the service from the cached use of a bundle, without locking.
+   *
+   * @return The interface map or \c nullptr if the bundle has no cached use.
+   */
+  InterfaceMapConstPtr GetSingletonUse(BundlePrivate* bundle);
+
+  /**
+   * Add a cached use for a bundle, or return the existing one.
+   *
+   * @return The interface map or \c nullptr if no slot is free.
+   */
+  InterfaceMapConstPtr AddSingletonUse_unlocked(BundlePrivate* bundle);
+
+  /**
+   * Remove the cached use of a bundle, or of all bundles if \c bundle is
+   * \c nullptr. Service objects handed out from it stay valid.
+   */
+  void RemoveSingletonUses_unlocked(BundlePrivate* bundle);
+
   InterfaceMapConstPtr GetInterfaces() const;
 
   std::shared_ptr<void> GetService(const std::string& interfaceId) const;
@@ -29,8 +29,7 @@
 #include "CoreBundleContext.h"
 #include "ServiceRegistrationBasePrivate.h"
 
-#include <cassert>
-#include <iterator>
+#include <algorithm>
 #include <stdexcept>
 
 namespace cppmicroservices {
@@ -117,10 +116,10 @@ ServiceRegistrationBase ServiceRegistry::RegisterService(BundlePrivate* bundle
     US_UNUSED(l);
     services.insert(std::make_pair(res, classes));
     serviceRegistrations.push_back(res);
-    for (auto& clazz : classes) {
-      auto& s = classServices[clazz];
-      auto ip = std::lower_bound(s.rbegin(), s.rend(), res);
-      s.insert(ip.base(), res);
+    const auto key = GetRankingKey(res);
+    res.d->registryRanking = key.ranking;
+    for (auto& clazz : res.d->interfaceIds) {
+      classServices[clazz].emplace(key, res);
     }
   }
 
@@ -134,14 +133,35 @@ ServiceRegistrationBase ServiceRegistry::RegisterService(BundlePrivate* bundle
 }
 
 void ServiceRegistry::UpdateServiceRegistrationOrder(
-  const std::vector<std::string>& classes)
+  const ServiceRegistrationBase& sr)
 {
   auto l = this->Lock();
   US_UNUSED(l);
-  for (auto& clazz : classes) {
-    auto& s = classServices[clazz];
-    std::sort(s.rbegin(), s.rend());
+  const auto key = GetRankingKey(sr);
+  const RankingKey oldKey{ sr.d->registryRanking, key.id };
+  if (key.ranking == oldKey.ranking) {
+    return;
+  }
+  for (auto& clazz : sr.d->interfaceIds) {
+    auto i = classServices.find(clazz);
+    // the service may have been unregistered concurrently
+    if (i != classServices.end() && i->second.erase(oldKey) != 0) {
+      i->second.emplace(key, sr);
+    }
   }
+  sr.d->registryRanking = key.ranking;
+}
+
+ServiceRegistry::RankingKey ServiceRegistry::GetRankingKey(
+  const ServiceRegistrationBase& sr)
+{
+  auto l = sr.d->properties.Lock();
+  US_UNUSED(l);
+  const Any ranking =
+    sr.d->properties.Value_unlocked(Constants::SERVICE_RANKING);
+  const Any id = sr.d->properties.Value_unlocked(Constants::SERVICE_ID);
+  return { ranking.Type() == typeid(int) ? any_cast<int>(ranking) : 0,
+           any_cast<long>(id) };
 }
 
 void ServiceRegistry::Get(
@@ -155,9 +175,17 @@ void ServiceRegistry::Get_unlocked(
   const std::string& clazz,
   std::vector<ServiceRegistrationBase>& serviceRegs) const
 {
-  auto i = classServices.find(clazz);
+  InternedInterfaceId id;
+  if (!InternedInterfaceId::Find(clazz, id)) {
+    return;
+  }
+  auto i = classServices.find(id);
   if (i != classServices.end()) {
-    serviceRegs = i->second;
+    serviceRegs.clear();
+    serviceRegs.reserve(i->second.size());
+    for (auto& entry : i->second) {
+      serviceRegs.push_back(entry.second);
+    }
   }
 }
 
@@ -169,9 +197,9 @@ ServiceReferenceBase ServiceRegistry::Get(BundlePrivate* bundle,
   try {
     std::vector<ServiceReferenceBase> srs;
     Get_unlocked(clazz, "", bundle, srs);
-    DIAG_LOG(*core->sink) << "get service ref " << clazz << " for bundle "
-                          << bundle->symbolicName << " = " << srs.size()
-                          << " refs";
+    DIAG_LOG_AT(*core->sink, Registry, Debug)
+      << "get service ref " << clazz << " for bundle " << bundle->symbolicName
+      << " = " << srs.size() << " refs";
 
     if (!srs.empty()) {
       return srs.front();
@@ -195,56 +223,57 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz,
                                    BundlePrivate* bundle,
                                    std::vector<ServiceReferenceBase>& res) const
 {
-  std::vector<ServiceRegistrationBase>::const_iterator s;
-  std::vector<ServiceRegistrationBase>::const_iterator send;
-  std::vector<ServiceRegistrationBase> v;
   LDAPExpr ldap;
+  auto addIfMatching = [&](const ServiceRegistrationBase& sr) {
+    ServiceReferenceBase sri = sr.GetReference(clazz);
+
+    if (filter.empty() ||
+        ldap.Evaluate(PropertiesHandle(sr.d->properties, true), false)) {
+      res.push_back(sri);
+    }
+  };
+
   if (clazz.empty()) {
     if (!filter.empty()) {
       ldap = LDAPExpr(filter);
       LDAPExpr::ObjectClassSet matched;
       if (ldap.GetMatchedObjectClasses(matched)) {
-        v.clear();
         for (auto& className : matched) {
-          auto i = classServices.find(className);
+          InternedInterfaceId id;
+          if (!InternedInterfaceId::Find(className, id)) {
+            continue;
+          }
+          auto i = classServices.find(id);
           if (i != classServices.end()) {
-            std::copy(
-              i->second.begin(), i->second.end(), std::back_inserter(v));
+            for (auto& entry : i->second) {
+              addIfMatching(entry.second);
+            }
           }
         }
-        if (!v.empty()) {
-          s = v.begin();
-          send = v.end();
-        } else {
-          return;
-        }
       } else {
-        s = serviceRegistrations.begin();
-        send = serviceRegistrations.end();
+        for (auto& sr : serviceRegistrations) {
+          addIfMatching(sr);
+        }
       }
     } else {
-      s = serviceRegistrations.begin();
-      send = serviceRegistrations.end();
+      for (auto& sr : serviceRegistrations) {
+        addIfMatching(sr);
+      }
     }
   } else {
-    auto it = classServices.find(clazz);
-    if (it != classServices.end()) {
-      s = it->second.begin();
-      send = it->second.end();
-    } else {
+    InternedInterfaceId id;
+    if (!InternedInterfaceId::Find(clazz, id)) {
+      return;
+    }
+    auto it = classServices.find(id);
+    if (it == classServices.end()) {
       return;
     }
     if (!filter.empty()) {
       ldap = LDAPExpr(filter);
     }
-  }
-
-  for (; s != send; ++s) {
-    ServiceReferenceBase sri = s->GetReference(clazz);
-
-    if (filter.empty() ||
-        ldap.Evaluate(PropertiesHandle(s->d->properties, true), false)) {
-      res.push_back(sri);
+    for (auto& entry : it->second) {
+      addIfMatching(entry.second);
     }
   }
 
@@ -269,25 +298,18 @@ void ServiceRegistry::RemoveServiceRegistration(
 void ServiceRegistry::RemoveServiceRegistration_unlocked(
   const ServiceRegistrationBase& sr)
 {
-  std::vector<std::string> classes;
-  {
-    auto l2 = sr.d->properties.Lock();
-    US_UNUSED(l2);
-    assert(sr.d->properties.Value_unlocked(Constants::OBJECTCLASS).Type() ==
-           typeid(std::vector<std::string>));
-    classes = ref_any_cast<std::vector<std::string>>(
-      sr.d->properties.Value_unlocked(Constants::OBJECTCLASS));
-  }
   services.erase(sr);
   serviceRegistrations.erase(
     std::remove(serviceRegistrations.begin(), serviceRegistrations.end(), sr),
     serviceRegistrations.end());
-  for (auto& clazz : classes) {
-    auto& s = classServices[clazz];
-    if (s.size() > 1) {
-      s.erase(std::remove(s.begin(), s.end(), sr), s.end());
-    } else {
-      classServices.erase(clazz);
+  const RankingKey key{ sr.d->registryRanking, GetRankingKey(sr).id };
+  for (auto& clazz : sr.d->interfaceIds) {
+    auto i = classServices.find(clazz);
+    if (i != classServices.end()) {
+      i->second.erase(key);
+      if (i->second.empty()) {
+        classServices.erase(i);
+      }
     }
   }
 }
@@ -319,4 +341,18 @@ void ServiceRegistry::GetUsedByBundle(
     }
   }
 }
+
+void ServiceRegistry::RemoveSingletonUses(BundlePrivate* bundle) const
+{
+  auto l = this->Lock();
+  US_UNUSED(l);
+
+  for (const auto& serviceRegistration : serviceRegistrations) {
+    if (serviceRegistration.d->HasSingletonUse(bundle)) {
+      auto l2 = serviceRegistration.d->Lock();
+      US_UNUSED(l2);
+      serviceRegistration.d->RemoveSingletonUses_unlocked(bundle);
+    }
+  }
+}
 }
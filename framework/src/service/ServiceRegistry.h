@@ -27,6 +27,10 @@
 #include "cppmicroservices/ServiceRegistration.h"
 #include "cppmicroservices/detail/Threads.h"
 
+#include "InternedInterfaceId.h"
+
+#include <map>
+
 namespace cppmicroservices {
 
 class CoreBundleContext;
@@ -58,8 +62,27 @@ public:
     bool isPrototypeFactory = false,
     long sid = -1);
 
+  /**
+   * The position of a registered service in the ranking order: the
+   * highest ranked service first and, for equal rankings, the service
+   * with the lowest service id first.
+   */
+  struct RankingKey
+  {
+    int ranking;
+    long id;
+
+    bool operator<(const RankingKey& other) const
+    {
+      return ranking != other.ranking ? ranking > other.ranking
+                                      : id < other.id;
+    }
+  };
+
+  using RankedServices = std::map<RankingKey, ServiceRegistrationBase>;
+
   using MapServiceClasses = std::unordered_map<ServiceRegistrationBase, std::vector<std::string>>;
-  using MapClassServices  = std::unordered_map<std::string, std::vector<ServiceRegistrationBase>>;
+  using MapClassServices  = std::unordered_map<InternedInterfaceId, RankedServices>;
 
   /**
    * All registered services in the current framework.
@@ -71,9 +94,10 @@ public:
   std::vector<ServiceRegistrationBase> serviceRegistrations;
 
   /**
-   * Mapping of classname to registered service.
-   * The List of registered services are ordered with the highest
-   * ranked service first.
+   * Mapping of interned classname to registered service.
+   * The registered services are ordered with the highest
+   * ranked service first, so that a ranking change only
+   * repositions the changed service.
    */
   MapClassServices classServices;
 
@@ -104,12 +128,12 @@ public:
                                           const ServiceProperties& properties);
 
   /**
-   * Reorder registered services. Call this method if the ranking for
+   * Reorder a registered service. Call this method if the ranking for
    * a service registration has changed
    *
-   * @param classes is the list of classes whose entries need to be reordered
+   * @param sr The service registration whose ranking has changed.
    */
-  void UpdateServiceRegistrationOrder(const std::vector<std::string>& classes);
+  void UpdateServiceRegistrationOrder(const ServiceRegistrationBase& sr);
 
   /**
    * Get all services implementing a certain class.
@@ -171,10 +195,23 @@ public:
   void GetUsedByBundle(BundlePrivate* bundle,
                        std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
+  /**
+   * Remove the cached uses of all services by a bundle, whether or not the
+   * bundle still holds service objects from them.
+   *
+   * @param bundle The bundle
+   */
+  void RemoveSingletonUses(BundlePrivate* bundle) const;
+
 private:
   friend class ServiceHooks;
   friend class ServiceRegistrationBase;
 
+  /**
+   * Read the ranking key of a service from its current properties.
+   */
+  static RankingKey GetRankingKey(const ServiceRegistrationBase& sr);
+
   void RemoveServiceRegistration_unlocked(const ServiceRegistrationBase& sr);
 
   void Get_unlocked(const std::string& clazz,
@@ -42,21 +42,74 @@ void ThrowBadAnyCastException(const std::string& funcName,
 }
 }
 
+namespace {
+
+/**
+ * The JSON escape sequence of each character: 0 if the character is written
+ * as is, 'u' for a \\u00XX sequence, or the character following the
+ * backslash otherwise.
+ */
+struct JsonEscapeTable
+{
+  char escapes[256];
+
+  JsonEscapeTable()
+    : escapes()
+  {
+    for (int c = 0; c < 0x20; ++c) {
+      escapes[c] = 'u';
+    }
+    escapes[static_cast<unsigned char>('"')] = '"';
+    escapes[static_cast<unsigned char>('\\')] = '\\';
+    escapes[static_cast<unsigned char>('\b')] = 'b';
+    escapes[static_cast<unsigned char>('\f')] = 'f';
+    escapes[static_cast<unsigned char>('\n')] = 'n';
+    escapes[static_cast<unsigned char>('\r')] = 'r';
+    escapes[static_cast<unsigned char>('\t')] = 't';
+  }
+};
+}
+
 std::ostream& any_value_to_string(std::ostream& os, const Any& any)
 {
-  os << any.ToString();
-  return os;
+  return any.ToString(os);
 }
 
 std::ostream& any_value_to_json(std::ostream& os, const Any& val)
 {
-  os << val.ToJSON();
-  return os;
+  return val.ToJSON(os);
 }
 
 std::ostream& any_value_to_json(std::ostream& os, const std::string& val)
 {
-  return os << '"' << val << '"';
+  static const char hexDigits[] = "0123456789abcdef";
+  static const JsonEscapeTable jsonEscapeTable;
+
+  os.put('"');
+  // write the characters between two escaped ones in a single call
+  const char* unescaped = val.data();
+  const char* const end = unescaped + val.size();
+  for (const char* c = unescaped; c != end; ++c) {
+    const auto uc = static_cast<unsigned char>(*c);
+    const char escape = jsonEscapeTable.escapes[uc];
+    if (escape == 0) {
+      continue;
+    }
+    os.write(unescaped, c - unescaped);
+    if (escape == 'u') {
+      const char sequence[] = {
+        '\\', 'u', '0', '0', hexDigits[uc >> 4], hexDigits[uc & 0xf]
+      };
+      os.write(sequence, sizeof(sequence));
+    } else {
+      const char sequence[] = { '\\', escape };
+      os.write(sequence, sizeof(sequence));
+    }
+    unescaped = c + 1;
+  }
+  os.write(unescaped, end - unescaped);
+  os.put('"');
+  return os;
 }
 
 std::ostream& any_value_to_json(std::ostream& os, bool val)
@@ -68,18 +121,32 @@ std::ostream& any_value_to_json(std::ostream& os, bool val)
 // header in order to avoid this error:
 // "default initialization of an object of const type 'const cppmicroservices::Any' without
 // a user-provided default constructor"
-Any::Any() = default;
+Any::Any()
+  : _content(nullptr)
+{}
     
 std::string Any::ToString() const
+{
+  std::ostringstream ss;
+  ToString(ss);
+  return ss.str();
+}
+
+std::ostream& Any::ToString(std::ostream& os) const
 {
   if (Empty()) {
     throw std::logic_error("empty any");
   }
-  return _content->ToString();
+  return _content->ToString(os);
 }
 
 std::string Any::ToStringNoExcept() const
 {
-  return Empty() ? std::string() : _content->ToString();
+  if (Empty()) {
+    return std::string();
+  }
+  std::ostringstream ss;
+  _content->ToString(ss);
+  return ss.str();
 }
 }
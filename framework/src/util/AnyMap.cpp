@@ -47,6 +47,20 @@ bool any_map_ciequal::operator()(const std::string& l,
           }));
 }
 
+/**
+ * Returns the map held by \c h, or \c nullptr if \c h holds neither an
+ * AnyMap nor a FrozenAnyMap.
+ */
+const AnyMap* GetNestedMap(const Any& h)
+{
+  if (h.Type() == typeid(AnyMap)) {
+    return &ref_any_cast<AnyMap>(h);
+  } else if (h.Type() == typeid(FrozenAnyMap)) {
+    return &static_cast<const AnyMap&>(ref_any_cast<FrozenAnyMap>(h));
+  }
+  return nullptr;
+}
+
 const Any& AtCompoundKey(const std::vector<Any>& v,
                          const absl::string_view& key);
 
@@ -58,8 +72,8 @@ const Any& AtCompoundKey(const AnyMap& m, const absl::string_view& key)
     auto tail = key.substr(pos + 1);
 
     auto& h = m.at(std::string(head));
-    if (h.Type() == typeid(AnyMap)) {
-      return AtCompoundKey(ref_any_cast<AnyMap>(h), tail);
+    if (auto nested = GetNestedMap(h)) {
+      return AtCompoundKey(*nested, tail);
     } else if (h.Type() == typeid(std::vector<Any>)) {
       return AtCompoundKey(ref_any_cast<std::vector<Any>>(h), tail);
     }
@@ -81,8 +95,8 @@ const Any& AtCompoundKey(const std::vector<Any>& v,
     const int index = std::stoi(std::string(head));
     auto& h = v.at(index < 0 ? v.size() + index : index);
 
-    if (h.Type() == typeid(AnyMap)) {
-      return AtCompoundKey(ref_any_cast<AnyMap>(h), tail);
+    if (auto nested = GetNestedMap(h)) {
+      return AtCompoundKey(*nested, tail);
     } else if (h.Type() == typeid(std::vector<Any>)) {
       return AtCompoundKey(ref_any_cast<std::vector<Any>>(h), tail);
     }
@@ -108,9 +122,8 @@ Any AtCompoundKey(const AnyMap& m,
     auto itr = m.find(std::string(head));
     if (itr != m.end()) {
       auto& h = itr->second;
-      if (h.Type() == typeid(AnyMap)) {
-        return AtCompoundKey(
-          ref_any_cast<AnyMap>(h), tail, std::move(defaultVal));
+      if (auto nested = GetNestedMap(h)) {
+        return AtCompoundKey(*nested, tail, std::move(defaultVal));
       } else if (h.Type() == typeid(std::vector<Any>)) {
         return AtCompoundKey(
           ref_any_cast<std::vector<Any>>(h), tail, std::move(defaultVal));
@@ -144,9 +157,8 @@ Any AtCompoundKey(const std::vector<Any>& v,
     auto& h = v[(index < 0 ? v.size() + index : index)];
     if (tail.empty()) {
       return h;
-    } else if (h.Type() == typeid(AnyMap)) {
-      return AtCompoundKey(
-        ref_any_cast<AnyMap>(h), tail, std::move(defaultval));
+    } else if (auto nested = GetNestedMap(h)) {
+      return AtCompoundKey(*nested, tail, std::move(defaultval));
     } else if (h.Type() == typeid(std::vector<Any>)) {
       return AtCompoundKey(
         ref_any_cast<std::vector<Any>>(h), tail, std::move(defaultval));
@@ -967,6 +979,208 @@ AnyMap::mapped_type AnyMap::AtCompoundKey(
   return detail::AtCompoundKey(*this, key, std::move(defaultValue));
 }
 
+const AnyMap::mapped_type& AnyMap::AtCompoundKey(const CompoundKey& key) const
+{
+  const AnyMap* map = this;
+  const std::vector<Any>* vec = nullptr;
+  const auto last = key.segments.size() - 1;
+  for (std::size_t i = 0;; ++i) {
+    const auto& segment = key.segments[i];
+    const Any* h = nullptr;
+    if (map) {
+      h = &map->at(segment.name);
+    } else {
+      if (!segment.isIndex) {
+        throw std::invalid_argument("Invalid vector index '" + segment.name +
+                                    "' for dotted get");
+      }
+      h = &vec->at(segment.index < 0 ? vec->size() + segment.index
+                                     : static_cast<std::size_t>(segment.index));
+    }
+    if (i == last) {
+      return *h;
+    }
+
+    map = detail::GetNestedMap(*h);
+    vec = nullptr;
+    if (!map) {
+      if (h->Type() != typeid(std::vector<Any>)) {
+        throw std::invalid_argument("Unsupported Any type at '" +
+                                    segment.name + "' for dotted get");
+      }
+      vec = &ref_any_cast<std::vector<Any>>(*h);
+    }
+  }
+}
+
+const AnyMap::mapped_type* AnyMap::FindCompoundKey(
+  const CompoundKey& key) const noexcept
+{
+  const AnyMap* map = this;
+  const std::vector<Any>* vec = nullptr;
+  const Any* h = nullptr;
+  for (const auto& segment : key.segments) {
+    if (h) {
+      map = detail::GetNestedMap(*h);
+      vec = nullptr;
+      if (!map) {
+        if (h->Type() != typeid(std::vector<Any>)) {
+          return nullptr;
+        }
+        vec = &ref_any_cast<std::vector<Any>>(*h);
+      }
+    }
+
+    if (map) {
+      h = map->FindValue(segment.name);
+      if (!h) {
+        return nullptr;
+      }
+    } else {
+      const auto size = static_cast<long long>(vec->size());
+      const long long index =
+        segment.index < 0 ? size + segment.index : segment.index;
+      if (!segment.isIndex || index < 0 || index >= size) {
+        return nullptr;
+      }
+      h = &(*vec)[static_cast<std::size_t>(index)];
+    }
+  }
+  return h;
+}
+
+const AnyMap::mapped_type* AnyMap::FindValue(const key_type& key) const
+{
+  switch (type) {
+    case map_type::ORDERED_MAP: {
+      auto itr = o_m().find(key);
+      return itr == o_m().end() ? nullptr : &itr->second;
+    }
+    case map_type::UNORDERED_MAP: {
+      auto itr = uo_m().find(key);
+      return itr == uo_m().end() ? nullptr : &itr->second;
+    }
+    case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS: {
+      auto itr = uoci_m().find(key);
+      return itr == uoci_m().end() ? nullptr : &itr->second;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+CompoundKey::CompoundKey(const std::string& key)
+  : key(key)
+{
+  const absl::string_view keyView(this->key);
+  std::size_t begin = 0;
+  for (;;) {
+    const auto pos = keyView.find('.', begin);
+    Segment segment;
+    segment.name = std::string(keyView.substr(begin, pos - begin));
+    segment.index = 0;
+    segment.isIndex = absl::SimpleAtoi(segment.name, &segment.index);
+    segments.push_back(std::move(segment));
+    if (pos == absl::string_view::npos) {
+      break;
+    }
+    begin = pos + 1;
+  }
+}
+
+const std::string& CompoundKey::ToString() const
+{
+  return key;
+}
+
+FrozenAnyMap::FrozenAnyMap(map_type type)
+  : m(std::make_shared<const AnyMap>(type))
+{}
+
+FrozenAnyMap::FrozenAnyMap(AnyMap m)
+  : m(std::make_shared<const AnyMap>(std::move(m)))
+{}
+
+FrozenAnyMap::const_iterator FrozenAnyMap::begin() const
+{
+  return m->begin();
+}
+
+FrozenAnyMap::const_iterator FrozenAnyMap::cbegin() const
+{
+  return m->cbegin();
+}
+
+FrozenAnyMap::const_iterator FrozenAnyMap::end() const
+{
+  return m->end();
+}
+
+FrozenAnyMap::const_iterator FrozenAnyMap::cend() const
+{
+  return m->cend();
+}
+
+bool FrozenAnyMap::empty() const
+{
+  return m->empty();
+}
+
+FrozenAnyMap::size_type FrozenAnyMap::size() const
+{
+  return m->size();
+}
+
+FrozenAnyMap::size_type FrozenAnyMap::count(const key_type& key) const
+{
+  return m->count(key);
+}
+
+const FrozenAnyMap::mapped_type& FrozenAnyMap::at(const key_type& key) const
+{
+  return m->at(key);
+}
+
+FrozenAnyMap::const_iterator FrozenAnyMap::find(const key_type& key) const
+{
+  return m->find(key);
+}
+
+FrozenAnyMap::map_type FrozenAnyMap::GetType() const
+{
+  return m->GetType();
+}
+
+const FrozenAnyMap::mapped_type& FrozenAnyMap::AtCompoundKey(
+  const key_type& key) const
+{
+  return m->AtCompoundKey(key);
+}
+
+FrozenAnyMap::mapped_type FrozenAnyMap::AtCompoundKey(
+  const key_type& key,
+  mapped_type defaultValue) const noexcept
+{
+  return m->AtCompoundKey(key, std::move(defaultValue));
+}
+
+const FrozenAnyMap::mapped_type& FrozenAnyMap::AtCompoundKey(
+  const CompoundKey& key) const
+{
+  return m->AtCompoundKey(key);
+}
+
+const FrozenAnyMap::mapped_type* FrozenAnyMap::FindCompoundKey(
+  const CompoundKey& key) const noexcept
+{
+  return m->FindCompoundKey(key);
+}
+
+FrozenAnyMap::operator const AnyMap&() const
+{
+  return *m;
+}
+
 template<>
 std::ostream& any_value_to_string(std::ostream& os, const AnyMap& m)
 {
@@ -977,9 +1191,9 @@ std::ostream& any_value_to_string(std::ostream& os, const AnyMap& m)
   const Iterator end = m.end();
   for (; i1 != end; ++i1) {
     if (i1 == begin)
-      os << i1->first << " : " << i1->second.ToString();
+      i1->second.ToString(os << i1->first << " : ");
     else
-      os << ", " << i1->first << " : " << i1->second.ToString();
+      i1->second.ToString(os << ", " << i1->first << " : ");
   }
   os << "}";
   return os;
@@ -994,13 +1208,24 @@ std::ostream& any_value_to_json(std::ostream& os, const AnyMap& m)
   const Iterator begin = i1;
   const Iterator end = m.end();
   for (; i1 != end; ++i1) {
-    if (i1 == begin)
-      os << "\"" << i1->first << "\" : " << i1->second.ToJSON();
-    else
-      os << ", "
-         << "\"" << i1->first << "\" : " << i1->second.ToJSON();
+    if (i1 != begin)
+      os << ", ";
+    any_value_to_json(os, i1->first) << " : ";
+    i1->second.ToJSON(os);
   }
   os << "}";
   return os;
 }
+
+template<>
+std::ostream& any_value_to_string(std::ostream& os, const FrozenAnyMap& m)
+{
+  return any_value_to_string(os, static_cast<const AnyMap&>(m));
+}
+
+template<>
+std::ostream& any_value_to_json(std::ostream& os, const FrozenAnyMap& m)
+{
+  return any_value_to_json(os, static_cast<const AnyMap&>(m));
+}
 }
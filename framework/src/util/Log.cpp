@@ -0,0 +1,202 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "cppmicroservices/detail/Log.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <list>
+#include <mutex>
+
+namespace cppmicroservices {
+
+namespace detail {
+
+namespace {
+
+struct TerminateDumpRegistry
+{
+  std::mutex mutex;
+  std::list<std::weak_ptr<LogSink>> sinks;
+  std::terminate_handler previousHandler = nullptr;
+  bool handlerInstalled = false;
+};
+
+TerminateDumpRegistry& GetTerminateDumpRegistry()
+{
+  // intentionally leaked, the terminate handler may run during static destruction
+  static auto* registry = new TerminateDumpRegistry();
+  return *registry;
+}
+
+std::string Trim(const std::string& str)
+{
+  const auto first = str.find_first_not_of(" \t");
+  if (first == std::string::npos) {
+    return std::string();
+  }
+  return str.substr(first, str.find_last_not_of(" \t") - first + 1);
+}
+
+std::string ToLower(std::string str)
+{
+  std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) {
+    return static_cast<char>(std::tolower(c));
+  });
+  return str;
+}
+
+bool ParseCategory(const std::string& name, DiagCategory& category)
+{
+  static const std::pair<const char*, DiagCategory> categories[] = {
+    { "general", DiagCategory::General },
+    { "registry", DiagCategory::Registry },
+    { "listeners", DiagCategory::Listeners },
+    { "bundles", DiagCategory::Bundles },
+    { "resources", DiagCategory::Resources }
+  };
+  for (const auto& entry : categories) {
+    if (name == entry.first) {
+      category = entry.second;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ParseLevel(const std::string& name, DiagLevel& level)
+{
+  static const std::pair<const char*, DiagLevel> levels[] = {
+    { "off", DiagLevel::Off },
+    { "error", DiagLevel::Error },
+    { "warning", DiagLevel::Warning },
+    { "info", DiagLevel::Info },
+    { "debug", DiagLevel::Debug }
+  };
+  for (const auto& entry : levels) {
+    if (name == entry.first) {
+      level = entry.second;
+      return true;
+    }
+  }
+  return false;
+}
+
+void DumpRegisteredSinks(std::ostream& out)
+{
+  auto& registry = GetTerminateDumpRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (const auto& weakSink : registry.sinks) {
+    if (auto sink = weakSink.lock()) {
+      sink->Dump(out);
+    }
+  }
+}
+
+// std::terminate may be called while this or another thread holds the
+// lock of the registry or of a sink, so the handler never blocks on them
+void TryDumpRegisteredSinks(std::ostream& out)
+{
+  auto& registry = GetTerminateDumpRegistry();
+  std::unique_lock<std::mutex> lock(registry.mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    out << "(diagnostic messages unavailable, the sink registry is locked)\n";
+    return;
+  }
+  for (const auto& weakSink : registry.sinks) {
+    if (auto sink = weakSink.lock()) {
+      if (!sink->TryDump(out)) {
+        out << "(diagnostic messages unavailable, the sink is locked)\n";
+      }
+    }
+  }
+}
+
+void TerminateHandler()
+{
+  std::cerr << "Framework diagnostic messages before termination:\n";
+  TryDumpRegisteredSinks(std::cerr);
+  std::cerr.flush();
+
+  auto previousHandler = GetTerminateDumpRegistry().previousHandler;
+  if (previousHandler) {
+    previousHandler();
+  }
+  std::abort();
+}
+}
+
+void ApplyDiagLevels(LogSink& sink, const std::string& levels)
+{
+  std::size_t pos = 0;
+  while (pos <= levels.size()) {
+    auto end = levels.find(',', pos);
+    if (end == std::string::npos) {
+      end = levels.size();
+    }
+    const auto entry = levels.substr(pos, end - pos);
+    pos = end + 1;
+
+    const auto separator = entry.find('=');
+    if (separator == std::string::npos) {
+      continue;
+    }
+    const auto categoryName = ToLower(Trim(entry.substr(0, separator)));
+    DiagLevel level;
+    if (!ParseLevel(ToLower(Trim(entry.substr(separator + 1))), level)) {
+      continue;
+    }
+    DiagCategory category;
+    if (categoryName == "all") {
+      for (std::size_t i = 0; i < DiagCategoryCount; ++i) {
+        sink.SetLevel(static_cast<DiagCategory>(i), level);
+      }
+    } else if (ParseCategory(categoryName, category)) {
+      sink.SetLevel(category, level);
+    }
+  }
+}
+
+void DumpOnTerminate(const std::shared_ptr<LogSink>& sink)
+{
+  auto& registry = GetTerminateDumpRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.sinks.remove_if(
+    [](const std::weak_ptr<LogSink>& weakSink) { return weakSink.expired(); });
+  registry.sinks.push_back(sink);
+  if (!registry.handlerInstalled) {
+    registry.previousHandler = std::set_terminate(&TerminateHandler);
+    registry.handlerInstalled = true;
+  }
+}
+
+void DumpDiagnostics(std::ostream& out)
+{
+  DumpRegisteredSinks(out);
+}
+
+} // namespace detail
+
+} // namespace cppmicroservices
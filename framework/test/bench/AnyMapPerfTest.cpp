@@ -156,6 +156,61 @@ BENCHMARK_DEFINE_F(AnyMapPerfTestFixture, ErrorPath_NoThrowOverload)(benchmark::
 }
 
 
+BENCHMARK_DEFINE_F(AnyMapPerfTestFixture, HappyPath_Precompiled)(benchmark::State& state)
+{
+  auto         bundleProps = testBundle.GetHeaders();
+  Any&         testData    = bundleProps.at("Test_AtCompoundKey");
+  assert(!testData.Empty());
+  AnyMap&      testAnyMap  = ref_any_cast<AnyMap>(testData);
+  unsigned int depth       = static_cast<unsigned int>(state.range(0));
+  CompoundKey  key(constructNestedKey(depth, "relativelylongkeyname_map", "relativelylongkeyname_element"));
+
+  for (auto _ : state) {
+    try {
+      (void)testAnyMap.AtCompoundKey(key);
+    }
+    catch (...) {
+      state.SkipWithError("Exception thrown from AtCompoundKey");
+      break;
+    }
+  }
+}
+
+BENCHMARK_DEFINE_F(AnyMapPerfTestFixture, HappyPath_Find)(benchmark::State& state)
+{
+  auto         bundleProps = testBundle.GetHeaders();
+  Any&         testData    = bundleProps.at("Test_AtCompoundKey");
+  assert(!testData.Empty());
+  AnyMap&      testAnyMap  = ref_any_cast<AnyMap>(testData);
+  unsigned int depth       = static_cast<unsigned int>(state.range(0));
+  CompoundKey  key(constructNestedKey(depth, "relativelylongkeyname_map", "relativelylongkeyname_element"));
+
+  for (auto _ : state) {
+    if (!testAnyMap.FindCompoundKey(key)) {
+      state.SkipWithError("Key not found by FindCompoundKey");
+      break;
+    }
+  }
+}
+
+BENCHMARK_DEFINE_F(AnyMapPerfTestFixture, ErrorPath_Find)(benchmark::State& state)
+{
+  auto         bundleProps = testBundle.GetHeaders();
+  Any&         testData    = bundleProps.at("Test_AtCompoundKey");
+  assert(!testData.Empty());
+  AnyMap&      testAnyMap  = ref_any_cast<AnyMap>(testData);
+  unsigned int depth       = static_cast<unsigned int>(state.range(0));
+  CompoundKey  key(constructNestedKey(depth, "relativelylongkeyname_map", "relativelylongkeyname_unknown"));
+
+  for (auto _ : state) {
+    if (testAnyMap.FindCompoundKey(key)) {
+      state.SkipWithError("Unknown key found by FindCompoundKey");
+      break;
+    }
+  }
+}
+
+
 
 // Register functions as benchmarrk
 BENCHMARK_REGISTER_F(AnyMapPerfTestFixture, HappyPath)->Arg(1)
@@ -186,3 +241,47 @@ BENCHMARK_REGISTER_F(AnyMapPerfTestFixture, ErrorPath_NoThrowOverload)->Arg(1)
                                                                       ->Arg(15)
                                                                       ->Arg(18)
                                                                       ->Arg(20);
+BENCHMARK_REGISTER_F(AnyMapPerfTestFixture, HappyPath_Precompiled)->Arg(1)
+                                                                  ->Arg(3)
+                                                                  ->Arg(7)
+                                                                  ->Arg(11)
+                                                                  ->Arg(15)
+                                                                  ->Arg(18)
+                                                                  ->Arg(20);
+BENCHMARK_REGISTER_F(AnyMapPerfTestFixture, HappyPath_Find)->Arg(1)
+                                                           ->Arg(3)
+                                                           ->Arg(7)
+                                                           ->Arg(11)
+                                                           ->Arg(15)
+                                                           ->Arg(18)
+                                                           ->Arg(20);
+BENCHMARK_REGISTER_F(AnyMapPerfTestFixture, ErrorPath_Find)->Arg(1)
+                                                           ->Arg(3)
+                                                           ->Arg(7)
+                                                           ->Arg(11)
+                                                           ->Arg(15)
+                                                           ->Arg(18)
+                                                           ->Arg(20);
+
+// Copying the bundle headers, a nested map, into a service property or a
+// DTO deep copies every element unless the map is frozen.
+BENCHMARK_DEFINE_F(AnyMapPerfTestFixture, CopyHeaders)(benchmark::State& state)
+{
+  const AnyMap& headers = testBundle.GetHeaders();
+  for (auto _ : state) {
+    AnyMap copy(headers);
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+BENCHMARK_DEFINE_F(AnyMapPerfTestFixture, CopyFrozenHeaders)(benchmark::State& state)
+{
+  FrozenAnyMap headers(testBundle.GetHeaders());
+  for (auto _ : state) {
+    FrozenAnyMap copy(headers);
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+BENCHMARK_REGISTER_F(AnyMapPerfTestFixture, CopyHeaders);
+BENCHMARK_REGISTER_F(AnyMapPerfTestFixture, CopyFrozenHeaders);
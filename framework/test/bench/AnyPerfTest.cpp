@@ -0,0 +1,129 @@
+#include "benchmark/benchmark.h"
+
+#include <cppmicroservices/Any.h>
+#include <cppmicroservices/AnyMap.h>
+
+#include <sstream>
+#include <string>
+
+using namespace cppmicroservices;
+
+// Benchmarks for creating, copying and extracting values of an Any.
+// Scalars are stored inside the Any, strings are stored on the heap.
+
+template<class T>
+T MakeValue();
+
+template<>
+bool MakeValue<bool>()
+{
+  return true;
+}
+
+template<>
+int MakeValue<int>()
+{
+  return 42;
+}
+
+template<>
+long MakeValue<long>()
+{
+  return 42L;
+}
+
+template<>
+double MakeValue<double>()
+{
+  return 4.2;
+}
+
+template<>
+std::string MakeValue<std::string>()
+{
+  return "a string value which does not fit into a small string buffer";
+}
+
+template<class T>
+static void ConstructAny(benchmark::State& state)
+{
+  const T value = MakeValue<T>();
+  for (auto _ : state) {
+    Any any(value);
+    benchmark::DoNotOptimize(any);
+  }
+}
+
+template<class T>
+static void CopyAny(benchmark::State& state)
+{
+  const Any any(MakeValue<T>());
+  for (auto _ : state) {
+    Any copy(any);
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+template<class T>
+static void AnyCast(benchmark::State& state)
+{
+  const Any any(MakeValue<T>());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ref_any_cast<T>(any));
+  }
+}
+
+BENCHMARK_TEMPLATE(ConstructAny, bool);
+BENCHMARK_TEMPLATE(ConstructAny, int);
+BENCHMARK_TEMPLATE(ConstructAny, long);
+BENCHMARK_TEMPLATE(ConstructAny, double);
+BENCHMARK_TEMPLATE(ConstructAny, std::string);
+
+BENCHMARK_TEMPLATE(CopyAny, bool);
+BENCHMARK_TEMPLATE(CopyAny, int);
+BENCHMARK_TEMPLATE(CopyAny, long);
+BENCHMARK_TEMPLATE(CopyAny, double);
+BENCHMARK_TEMPLATE(CopyAny, std::string);
+
+BENCHMARK_TEMPLATE(AnyCast, bool);
+BENCHMARK_TEMPLATE(AnyCast, int);
+BENCHMARK_TEMPLATE(AnyCast, long);
+BENCHMARK_TEMPLATE(AnyCast, double);
+BENCHMARK_TEMPLATE(AnyCast, std::string);
+
+// A property tree with the given number of entries, each holding a small
+// nested map, as serialized by the web console and the DS DTOs.
+static AnyMap MakePropertyTree(int64_t entries)
+{
+  AnyMap tree(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  for (int64_t i = 0; i < entries; ++i) {
+    AnyMap entry(AnyMap::ORDERED_MAP);
+    entry["id"] = i;
+    entry["name"] = std::string("component \"") + std::to_string(i) + "\"";
+    entry["enabled"] = (i % 2 == 0);
+    entry["ranks"] = std::vector<Any>{ Any(1), Any(2.5), Any(std::string("three")) };
+    tree["entry." + std::to_string(i)] = std::move(entry);
+  }
+  return tree;
+}
+
+static void AnyMapToJSON(benchmark::State& state)
+{
+  const Any tree(MakePropertyTree(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tree.ToJSON());
+  }
+}
+
+static void AnyMapToJSONStream(benchmark::State& state)
+{
+  const Any tree(MakePropertyTree(state.range(0)));
+  std::ostringstream os;
+  for (auto _ : state) {
+    os.str(std::string());
+    tree.ToJSON(os);
+  }
+}
+
+BENCHMARK(AnyMapToJSON)->Arg(10000);
+BENCHMARK(AnyMapToJSONStream)->Arg(10000);
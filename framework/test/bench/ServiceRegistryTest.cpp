@@ -11,6 +11,7 @@
 
 #include <chrono>
 #include <iostream>
+#include <memory>
 
 using namespace cppmicroservices;
 
@@ -184,3 +185,73 @@ BENCHMARK_REGISTER_F(ServiceRegistryFixture, UnregisterServices)
   ->RangeMultiplier(4)
   ->Ranges({ { 1, 1000 }, { 1, 1000 } })
   ->UseManualTime();
+
+BENCHMARK_DEFINE_F(ServiceRegistryFixture, UpdateServiceRanking)
+(benchmark::State& state)
+{
+  auto fc = framework->GetBundleContext();
+  auto regCount = state.range(0);
+  auto interfaceMap = MakeInterfaceMapWithNInterfaces(1);
+
+  std::vector<ServiceRegistrationU> regs;
+  for (auto i = regCount; i > 0; --i) {
+    InterfaceMapPtr iMapCopy(std::make_shared<InterfaceMap>(*interfaceMap));
+    regs.push_back(fc.RegisterService(
+      iMapCopy, { { Constants::SERVICE_RANKING, Any(static_cast<int>(i)) } }));
+  }
+
+  int64_t next = 0;
+  for (auto _ : state) {
+    // move a service to the other end of the ranking order
+    auto& reg = regs[static_cast<std::size_t>(next % regCount)];
+    reg.SetProperties(
+      { { Constants::SERVICE_RANKING,
+          Any(static_cast<int>((next % 2) ? regCount + next : -next)) } });
+    ++next;
+  }
+}
+
+// the parameter specifies the number of services registered under the same interface
+BENCHMARK_REGISTER_F(ServiceRegistryFixture, UpdateServiceRanking)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Arg(50000);
+
+namespace {
+std::unique_ptr<Framework> singletonFramework;
+}
+
+// Benchmark getting and releasing a singleton service concurrently from
+// several threads of the same bundle.
+static void GetSingletonServiceConcurrently(benchmark::State& state)
+{
+  if (state.thread_index == 0) {
+    singletonFramework =
+      std::make_unique<Framework>(FrameworkFactory().NewFramework());
+    singletonFramework->Start();
+    singletonFramework->GetBundleContext().RegisterService<TestInterface>(
+      std::make_shared<TestInterface>());
+  }
+
+  // all threads wait for thread 0 before entering the loop
+  BundleContext fc;
+  ServiceReference<TestInterface> sRef;
+  for (auto _ : state) {
+    if (!sRef) {
+      fc = singletonFramework->GetBundleContext();
+      sRef = fc.GetServiceReference<TestInterface>();
+    }
+    auto service = fc.GetService(sRef);
+    benchmark::DoNotOptimize(service);
+  }
+
+  if (state.thread_index == 0) {
+    singletonFramework->Stop();
+    singletonFramework->WaitForStop(std::chrono::milliseconds::zero());
+    singletonFramework.reset();
+  }
+}
+
+BENCHMARK(GetSingletonServiceConcurrently)
+  ->ThreadRange(1, 32)
+  ->UseRealTime();
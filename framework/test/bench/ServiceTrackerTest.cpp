@@ -128,6 +128,73 @@ BENCHMARK_DEFINE_F(ServiceTrackerFixture, ServiceTrackerScalability)(benchmark::
   }
 }
 
+/// Benchmark how long it takes to open a service tracker which initially tracks many services
+BENCHMARK_DEFINE_F(ServiceTrackerFixture, OpenServiceTrackerWithManyServices)(benchmark::State& state)
+{
+  using namespace std::chrono;
+  using namespace benchmark::test;
+  using namespace cppmicroservices;
+
+  auto fc = framework->GetBundleContext();
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    fc.RegisterService<Foo>(std::make_shared<FooImpl>());
+  }
+  ServiceTracker<Foo> fooTracker(fc);
+  for (auto _ : state) {
+    auto start = high_resolution_clock::now();
+    fooTracker.Open();
+    auto end = high_resolution_clock::now();
+    auto elapsed_seconds = duration_cast<duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    fooTracker.Close();
+  }
+}
+
+/// Benchmark iterating all tracked services by copying them with GetServices
+BENCHMARK_DEFINE_F(ServiceTrackerFixture, IterateGetServices)(benchmark::State& state)
+{
+  using namespace benchmark::test;
+  using namespace cppmicroservices;
+
+  auto fc = framework->GetBundleContext();
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    fc.RegisterService<Foo>(std::make_shared<FooImpl>());
+  }
+  ServiceTracker<Foo> fooTracker(fc);
+  fooTracker.Open();
+
+  for (auto _ : state) {
+    for (auto& service : fooTracker.GetServices()) {
+      benchmark::DoNotOptimize(service);
+    }
+  }
+
+  fooTracker.Close();
+}
+
+/// Benchmark iterating all tracked services using the shared snapshot
+BENCHMARK_DEFINE_F(ServiceTrackerFixture, IterateTrackedSnapshot)(benchmark::State& state)
+{
+  using namespace benchmark::test;
+  using namespace cppmicroservices;
+
+  auto fc = framework->GetBundleContext();
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    fc.RegisterService<Foo>(std::make_shared<FooImpl>());
+  }
+  ServiceTracker<Foo> fooTracker(fc);
+  fooTracker.Open();
+
+  for (auto _ : state) {
+    auto snapshot = fooTracker.GetTrackedSnapshot();
+    for (auto& entry : snapshot->services) {
+      benchmark::DoNotOptimize(entry.second);
+    }
+  }
+
+  fooTracker.Close();
+}
+
 // Register benchmark functions
 BENCHMARK_REGISTER_F(ServiceTrackerFixture, OpenServiceTrackerWithSvcRef)->UseManualTime();
 BENCHMARK_REGISTER_F(ServiceTrackerFixture, OpenServiceTrackerWithBundleContext)->UseManualTime();
@@ -137,3 +204,11 @@ BENCHMARK_REGISTER_F(ServiceTrackerFixture, OpenServiceTrackerWithInterfaceName)
 BENCHMARK_REGISTER_F(ServiceTrackerFixture, ServiceTrackerScalability)->Arg(1)
                                                                       ->Arg(4000)
                                                                       ->Arg(10000);
+
+BENCHMARK_REGISTER_F(ServiceTrackerFixture, OpenServiceTrackerWithManyServices)->UseManualTime()
+                                                                               ->Arg(1000)
+                                                                               ->Arg(10000)
+                                                                               ->Arg(50000);
+
+BENCHMARK_REGISTER_F(ServiceTrackerFixture, IterateGetServices)->Arg(10)->Arg(1000);
+BENCHMARK_REGISTER_F(ServiceTrackerFixture, IterateTrackedSnapshot)->Arg(10)->Arg(1000);
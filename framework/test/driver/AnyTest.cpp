@@ -25,6 +25,7 @@
 #include "TestingMacros.h"
 
 #include <limits>
+#include <sstream>
 #include <stdexcept>
 
 using namespace cppmicroservices;
@@ -100,6 +101,25 @@ int AnyTest(int /*argc*/, char* /*argv*/ [])
                     "Any[std::string].ToJSON()")
   TestUnsafeAnyCast<std::string>(anyString, std::string("hello"));
 
+  Any anyEscapedString = std::string("say \"hi\"\\\n\t\x01");
+  US_TEST_CONDITION(anyEscapedString.ToJSON() ==
+                      "\"say \\\"hi\\\"\\\\\\n\\t\\u0001\"",
+                    "Any[std::string].ToJSON() escaping")
+
+  std::ostringstream anyStringStream;
+  anyString.ToJSON(anyStringStream << "json: ");
+  US_TEST_CONDITION(anyStringStream.str() == "json: \"hello\"",
+                    "Any[std::string].ToJSON(std::ostream&)")
+  anyStringStream.str("");
+  anyString.ToString(anyStringStream);
+  US_TEST_CONDITION(anyStringStream.str() == "hello",
+                    "Any[std::string].ToString(std::ostream&)")
+  anyStringStream.str("");
+  Any().ToJSON(anyStringStream);
+  US_TEST_CONDITION(anyStringStream.str() == "null",
+                    "Any[empty].ToJSON(std::ostream&)")
+  US_TEST_FOR_EXCEPTION(std::logic_error, Any().ToString(anyStringStream))
+
   std::vector<int> vecInts;
   vecInts.push_back(1);
   vecInts.push_back(2);
@@ -20,6 +20,9 @@
 
 =============================================================================*/
 
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkFactory.h"
 #include "cppmicroservices/detail/Log.h"
 
 #include "TestingMacros.h"
@@ -29,6 +32,7 @@
 #include <iostream>
 #include <ostream>
 #include <regex>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
@@ -139,7 +143,7 @@ void testLogRedirection()
     "Test redirected std::cerr log sink.");
 }
 
-#ifdef US_ENABLE_THREADING_SUPPORT
+#if defined(US_ENABLE_DIAGNOSTICS) && defined(US_ENABLE_THREADING_SUPPORT)
 // hammer the logger from multiple threads. A failure in
 // thread safety will most likely manifest as either a crash
 // or the output validation will see splicing of log lines.
@@ -237,15 +241,121 @@ void testLogMultiThreaded()
 }
 #endif
 
+void testLogCategoryLevels()
+{
+  std::ostringstream stream;
+  detail::LogSink sink(&stream, true);
+  detail::ApplyDiagLevels(sink, "all=warning, registry = debug,bundles=off,unknown=debug,listeners=bogus");
+  US_TEST_CONDITION(sink.GetLevel(detail::DiagCategory::General) == detail::DiagLevel::Warning,
+                    "Test level of a category set through all");
+  US_TEST_CONDITION(sink.GetLevel(detail::DiagCategory::Registry) == detail::DiagLevel::Debug,
+                    "Test level of a named category");
+  US_TEST_CONDITION(sink.GetLevel(detail::DiagCategory::Bundles) == detail::DiagLevel::Off,
+                    "Test disabled category");
+  US_TEST_CONDITION(sink.GetLevel(detail::DiagCategory::Listeners) == detail::DiagLevel::Warning,
+                    "Test invalid level is ignored");
+
+  int evaluated = 0;
+  auto evaluate = [&evaluated]() { return ++evaluated; };
+  DIAG_LOG_AT(sink, Bundles, Error) << "bundles message " << evaluate();
+  DIAG_LOG_AT(sink, General, Info) << "general info message " << evaluate();
+  DIAG_LOG_AT(sink, General, Warning) << "general warning message " << evaluate();
+  DIAG_LOG_AT(sink, Registry, Debug) << "registry message " << evaluate();
+
+  US_TEST_CONDITION(evaluated == 2,
+                    "Test arguments of filtered messages are not evaluated");
+  US_TEST_CONDITION(stream.str().find("bundles message") == std::string::npos,
+                    "Test message of a disabled category");
+  US_TEST_CONDITION(stream.str().find("general info message") == std::string::npos,
+                    "Test message below the category level");
+  US_TEST_CONDITION(stream.str().find("general warning message") != std::string::npos,
+                    "Test message at the category level");
+  US_TEST_CONDITION(stream.str().find("registry message") != std::string::npos,
+                    "Test message of a debug category");
+}
+
+void testLogRingBuffer()
+{
+  // the ring buffer captures messages even if the sink does not write them
+  std::ostringstream stream;
+  auto sink = std::make_shared<detail::LogSink>(&stream, false, 3);
+  US_TEST_CONDITION(sink->IsEnabled(detail::DiagCategory::Registry, detail::DiagLevel::Warning) &&
+                      !sink->IsEnabled(detail::DiagCategory::Registry, detail::DiagLevel::Info),
+                    "Test ring buffer captures warnings by default");
+  detail::ApplyDiagLevels(*sink, "registry=debug,bundles=off");
+  US_TEST_CONDITION(sink->GetLevel(detail::DiagCategory::Registry) == detail::DiagLevel::Debug &&
+                      sink->GetLevel(detail::DiagCategory::Bundles) == detail::DiagLevel::Off &&
+                      sink->GetLevel(detail::DiagCategory::General) == detail::DiagLevel::Warning,
+                    "Test ring buffer keeps the configured levels");
+  for (int i = 0; i < 5; ++i) {
+    DIAG_LOG_AT(*sink, Registry, Debug) << "message " << i << "\n";
+  }
+  US_TEST_CONDITION(stream.str().empty(), "Test disabled sink with ring buffer");
+
+  std::ostringstream dump;
+  sink->Dump(dump);
+  US_TEST_CONDITION(dump.str().find("message 1") == std::string::npos,
+                    "Test ring buffer drops the oldest messages");
+  const auto pos2 = dump.str().find("message 2");
+  const auto pos4 = dump.str().find("message 4");
+  US_TEST_CONDITION(pos2 != std::string::npos && pos4 != std::string::npos && pos2 < pos4,
+                    "Test ring buffer dumps the most recent messages in order");
+
+  std::ostringstream registeredDump;
+  detail::DumpOnTerminate(sink);
+  detail::DumpDiagnostics(registeredDump);
+  US_TEST_CONDITION(registeredDump.str() == dump.str(),
+                    "Test dumping the registered sinks");
+
+  std::ostringstream tryDump;
+  US_TEST_CONDITION(sink->TryDump(tryDump) && tryDump.str() == dump.str(),
+                    "Test dumping an unlocked sink without blocking");
+#ifdef US_ENABLE_THREADING_SUPPORT
+  {
+    std::ostringstream lockedDump;
+    auto l = sink->Lock();
+    US_UNUSED(l);
+    bool dumped = true;
+    // try from another thread, the owner must not try to lock again
+    std::thread([&]() { dumped = sink->TryDump(lockedDump); }).join();
+    US_TEST_CONDITION(!dumped && lockedDump.str().empty(),
+                      "Test dumping a locked sink does not block");
+  }
+#endif
+
+  std::ostringstream emptyDump;
+  detail::LogSink noRing(&stream, true);
+  noRing.Dump(emptyDump);
+  US_TEST_CONDITION(emptyDump.str().empty(), "Test dumping a sink without ring buffer");
+}
+
+void testLogBufferSizeProperty()
+{
+  auto newFramework = [](const Any& size) {
+    FrameworkConfiguration config{ { Constants::FRAMEWORK_LOG_BUFFER_SIZE, size } };
+    return FrameworkFactory().NewFramework(config);
+  };
+  US_TEST_NO_EXCEPTION(newFramework(std::string("16")));
+  US_TEST_NO_EXCEPTION(newFramework(16));
+  US_TEST_FOR_EXCEPTION(std::invalid_argument, newFramework(std::string("-1")));
+  US_TEST_FOR_EXCEPTION(std::invalid_argument, newFramework(std::string("16 messages")));
+  US_TEST_FOR_EXCEPTION(std::invalid_argument, newFramework(std::string("many")));
+}
+
 int LogTest(int /*argc*/, char* /*argv*/ [])
 {
   US_TEST_BEGIN("usLogTest");
 
-  testDefaultLogMessages();
   testLogDisabled();
+  testLogBufferSizeProperty();
+#ifdef US_ENABLE_DIAGNOSTICS
+  testDefaultLogMessages();
   testLogRedirection();
-#ifdef US_ENABLE_THREADING_SUPPORT
+  testLogCategoryLevels();
+  testLogRingBuffer();
+#  ifdef US_ENABLE_THREADING_SUPPORT
   testLogMultiThreaded();
+#  endif
 #endif
   US_TEST_END()
 }
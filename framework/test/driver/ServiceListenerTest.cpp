@@ -515,6 +515,47 @@ void frameSL25a(const Framework& framework)
   }
 }
 
+namespace ServiceListenerTestNS {
+struct NotYetRegistered
+{
+  virtual ~NotYetRegistered() = default;
+};
+}
+
+// A listener on an object class which was never registered before is
+// still notified once a service of that class is registered.
+void frameSL30a(const Framework& framework)
+{
+  using ServiceListenerTestNS::NotYetRegistered;
+  auto context = framework.GetBundleContext();
+
+  int registered = 0;
+  int neverRegistered = 0;
+  auto token = context.AddServiceListener(
+    [&registered](const ServiceEvent&) { ++registered; },
+    std::string("(") + Constants::OBJECTCLASS + "=" +
+      us_service_interface_iid<NotYetRegistered>() + ")");
+  auto otherToken = context.AddServiceListener(
+    [&neverRegistered](const ServiceEvent&) { ++neverRegistered; },
+    std::string("(") + Constants::OBJECTCLASS + "=ServiceListenerTestNS::" +
+      "NeverRegistered)");
+
+  auto reg = context.RegisterService<NotYetRegistered>(
+    std::make_shared<NotYetRegistered>());
+  reg.Unregister();
+  US_TEST_CONDITION(registered == 2,
+                    "Listener on a class registered after it was added")
+  US_TEST_CONDITION(neverRegistered == 0,
+                    "Listener on a class which is never registered")
+
+  context.RemoveListener(std::move(token));
+  context.RemoveListener(std::move(otherToken));
+  reg = context.RegisterService<NotYetRegistered>(
+    std::make_shared<NotYetRegistered>());
+  reg.Unregister();
+  US_TEST_CONDITION(registered == 2, "No event after removing the listener")
+}
+
 int ServiceListenerTest(int /*argc*/, char* /*argv*/ [])
 {
   US_TEST_BEGIN("ServiceListenerTest");
@@ -530,6 +571,7 @@ int ServiceListenerTest(int /*argc*/, char* /*argv*/ [])
   frameSL05a(framework);
   frameSL10a(framework);
   frameSL25a(framework);
+  frameSL30a(framework);
 
   US_TEST_END()
 }
@@ -225,6 +225,72 @@ void TestServicePropertiesUpdate(BundleContext context)
     "Testing service count")
 }
 
+void TestServiceRankingOrder(BundleContext context)
+{
+  struct TestServiceA : public ITestServiceA
+  {};
+
+  std::vector<ServiceRegistration<ITestServiceA>> regs;
+  std::vector<long> ids;
+  for (int ranking : { 3, 1, 3, 2, 0 }) {
+    regs.push_back(context.RegisterService<ITestServiceA>(
+      std::make_shared<TestServiceA>(),
+      { { Constants::SERVICE_RANKING, Any(ranking) } }));
+    ids.push_back(any_cast<long>(
+      regs.back().GetReference().GetProperty(Constants::SERVICE_ID)));
+  }
+
+  auto order = [](const std::vector<ServiceReferenceU>& refs) {
+    std::vector<long> result;
+    for (auto& ref : refs) {
+      result.push_back(any_cast<long>(ref.GetProperty(Constants::SERVICE_ID)));
+    }
+    return result;
+  };
+  auto classOrder = [&context, &order]() {
+    auto refs = context.GetServiceReferences<ITestServiceA>();
+    return order(std::vector<ServiceReferenceU>(refs.begin(), refs.end()));
+  };
+  auto filterOrder = [&context, &order]() {
+    return order(context.GetServiceReferences(
+      "", "(" + Constants::OBJECTCLASS + "=" +
+            us_service_interface_iid<ITestServiceA>() + ")"));
+  };
+
+  US_TEST_CONDITION(
+    classOrder() == std::vector<long>({ ids[0], ids[2], ids[3], ids[1], ids[4] }),
+    "Services are ordered by ranking and service id")
+  US_TEST_CONDITION(filterOrder() == classOrder(),
+                    "Object class filter returns the ranking order")
+
+  // move the lowest ranked service to the top
+  regs[4].SetProperties({ { Constants::SERVICE_RANKING, Any(10) } });
+  // move a service down to an existing ranking
+  regs[0].SetProperties({ { Constants::SERVICE_RANKING, Any(1) } });
+  US_TEST_CONDITION(
+    classOrder() == std::vector<long>({ ids[4], ids[2], ids[3], ids[0], ids[1] }),
+    "Services are reordered after a ranking change")
+  US_TEST_CONDITION(
+    context.GetServiceReference<ITestServiceA>() == regs[4].GetReference(),
+    "Highest ranked service after a ranking change")
+
+  // setting properties without changing the ranking keeps the order
+  regs[2].SetProperties({ { Constants::SERVICE_RANKING, Any(3) },
+                          { "key", Any(std::string("value")) } });
+  regs[3].Unregister();
+  US_TEST_CONDITION(
+    classOrder() == std::vector<long>({ ids[4], ids[2], ids[0], ids[1] }),
+    "Services stay ordered after an unregistration")
+
+  for (std::size_t i = 0; i < regs.size(); ++i) {
+    if (i != 3) {
+      regs[i].Unregister();
+    }
+  }
+  US_TEST_CONDITION(context.GetServiceReferences<ITestServiceA>().empty(),
+                    "Testing service count")
+}
+
 int ServiceRegistryTest(int /*argc*/, char* /*argv*/ [])
 {
   US_TEST_BEGIN("ServiceRegistryTest");
@@ -238,6 +304,7 @@ int ServiceRegistryTest(int /*argc*/, char* /*argv*/ [])
   TestServiceInterfaceId();
   TestMultipleServiceRegistrations(context);
   TestServicePropertiesUpdate(context);
+  TestServiceRankingOrder(context);
   TestUnregisterFix(context);
   TestServiceReferenceMemberFunctions(context);
 
@@ -33,9 +33,13 @@
 #include "TestingConfig.h"
 #include "TestingMacros.h"
 
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 using namespace cppmicroservices;
 
@@ -64,6 +68,11 @@ struct MyInterfaceTwo
   virtual ~MyInterfaceTwo() {}
 };
 
+struct MyInterfaceThree
+{
+  virtual ~MyInterfaceThree() {}
+};
+
 class MyCustomizer
   : public cppmicroservices::ServiceTrackerCustomizer<MyInterfaceOne>
 {
@@ -312,6 +321,375 @@ void TestServiceTracker(BundleContext context)
                              "Checking WaitForService method");
 }
 
+void TestTrackedSnapshot(BundleContext context)
+{
+  struct MyServiceOne : public MyInterfaceThree
+  {};
+
+  ServiceTracker<MyInterfaceThree> tracker(context);
+  auto snapshot = tracker.GetTrackedSnapshot();
+  US_TEST_CONDITION_REQUIRED(snapshot && snapshot->services.empty(),
+                             "Empty snapshot of a closed tracker")
+  US_TEST_CONDITION(snapshot->trackingCount == -1,
+                    "Tracking count of a closed tracker")
+  auto closedSnapshot = snapshot;
+
+  auto low = context.RegisterService<MyInterfaceThree>(
+    std::make_shared<MyServiceOne>(),
+    { { Constants::SERVICE_RANKING, Any(1) } });
+  auto high = context.RegisterService<MyInterfaceThree>(
+    std::make_shared<MyServiceOne>(),
+    { { Constants::SERVICE_RANKING, Any(5) } });
+  auto sameAsLow = context.RegisterService<MyInterfaceThree>(
+    std::make_shared<MyServiceOne>(),
+    { { Constants::SERVICE_RANKING, Any(1) } });
+
+  tracker.Open();
+  snapshot = tracker.GetTrackedSnapshot();
+  US_TEST_CONDITION_REQUIRED(snapshot->services.size() == 3,
+                             "Snapshot contains all tracked services")
+  US_TEST_CONDITION(snapshot->trackingCount == tracker.GetTrackingCount(),
+                    "Snapshot tracking count")
+  US_TEST_CONDITION(snapshot->services[0].first == high.GetReference<MyInterfaceThree>() &&
+                    snapshot->services[1].first == low.GetReference<MyInterfaceThree>() &&
+                    snapshot->services[2].first == sameAsLow.GetReference<MyInterfaceThree>(),
+                    "Snapshot is sorted by ranking and service id")
+  US_TEST_CONDITION(snapshot->services[0].second == tracker.GetService(),
+                    "Snapshot contains the tracked service objects")
+  US_TEST_CONDITION(tracker.GetTrackedSnapshot() == snapshot,
+                    "Unchanged snapshot is shared")
+
+  sameAsLow.SetProperties({ { Constants::SERVICE_RANKING, Any(10) } });
+  auto modified = tracker.GetTrackedSnapshot();
+  US_TEST_CONDITION_REQUIRED(modified != snapshot && modified->services.size() == 3,
+                             "Snapshot is recreated after a modification")
+  US_TEST_CONDITION(modified->services[0].first == sameAsLow.GetReference<MyInterfaceThree>(),
+                    "Recreated snapshot reflects the new ranking")
+  US_TEST_CONDITION(snapshot->services[0].first == high.GetReference<MyInterfaceThree>(),
+                    "Previous snapshot is unchanged")
+
+  high.Unregister();
+  US_TEST_CONDITION(tracker.GetTrackedSnapshot()->services.size() == 2,
+                    "Snapshot is recreated after a removal")
+
+  tracker.Close();
+  US_TEST_CONDITION(tracker.GetTrackedSnapshot()->services.empty(),
+                    "Snapshot of a closed tracker is empty")
+  US_TEST_CONDITION(tracker.GetTrackedSnapshot() == closedSnapshot,
+                    "Closed trackers share one empty snapshot")
+  low.Unregister();
+  sameAsLow.Unregister();
+}
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+void TestConcurrentTrackedSnapshot(BundleContext context)
+{
+  struct MyServiceOne : public MyInterfaceThree
+  {};
+
+  ServiceTracker<MyInterfaceThree> tracker(context);
+  tracker.Open();
+
+  // Readers share and replace snapshots while services come and go. Each
+  // snapshot must stay intact for as long as it is referenced.
+  std::atomic<bool> done(false);
+  std::atomic<bool> consistent(true);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i)
+  {
+    readers.emplace_back([&tracker, &done, &consistent] {
+      while (!done)
+      {
+        auto snapshot = tracker.GetTrackedSnapshot();
+        for (auto& entry : snapshot->services)
+        {
+          if (!entry.second)
+          {
+            consistent = false;
+          }
+        }
+      }
+    });
+  }
+
+  for (int i = 0; i < 200; ++i)
+  {
+    auto reg = context.RegisterService<MyInterfaceThree>(std::make_shared<MyServiceOne>());
+    reg.Unregister();
+  }
+  done = true;
+  for (auto& reader : readers)
+  {
+    reader.join();
+  }
+
+  US_TEST_CONDITION(consistent, "Concurrently read snapshots are intact")
+  US_TEST_CONDITION(tracker.GetTrackedSnapshot()->services.empty(),
+                    "Snapshot is current after concurrent changes")
+}
+
+void TestTrackedSnapshotsAreReleased(BundleContext context)
+{
+  struct MyServiceOne : public MyInterfaceThree
+  {};
+
+  ServiceTracker<MyInterfaceThree> tracker(context);
+  tracker.Open();
+
+  // Replaced snapshots must be released while readers keep reading, not
+  // only once all readers are gone.
+  const std::size_t readerCount = 4;
+  std::atomic<bool> done(false);
+  std::vector<std::thread> readers;
+  for (std::size_t i = 0; i < readerCount; ++i)
+  {
+    readers.emplace_back([&tracker, &done] {
+      while (!done)
+      {
+        tracker.GetTrackedSnapshot();
+      }
+    });
+  }
+
+  std::vector<std::weak_ptr<const ServiceTracker<MyInterfaceThree>::TrackedSnapshot>> replaced;
+  for (int i = 0; i < 200; ++i)
+  {
+    auto reg = context.RegisterService<MyInterfaceThree>(std::make_shared<MyServiceOne>());
+    replaced.push_back(tracker.GetTrackedSnapshot());
+    reg.Unregister();
+    replaced.push_back(tracker.GetTrackedSnapshot());
+  }
+  std::size_t retained = 0;
+  for (auto& snapshot : replaced)
+  {
+    if (!snapshot.expired())
+    {
+      ++retained;
+    }
+  }
+  done = true;
+  for (auto& reader : readers)
+  {
+    reader.join();
+  }
+
+  // each reader holds at most one snapshot, plus the cached one
+  US_TEST_CONDITION(retained <= readerCount + 1, "Replaced snapshots are released while readers are active")
+}
+#endif
+
+class MyBatchCustomizer
+  : public cppmicroservices::ServiceTrackerCustomizer<MyInterfaceTwo>
+{
+
+public:
+  MyBatchCustomizer(const BundleContext& context)
+    : m_context(context)
+  {}
+
+  std::vector<std::shared_ptr<MyInterfaceTwo>> AddingServices(
+    const std::vector<ServiceReference<MyInterfaceTwo>>& references) override
+  {
+    ++batchCount;
+    std::vector<std::shared_ptr<MyInterfaceTwo>> services;
+    for (auto& reference : references)
+    {
+      if (reference == skipped)
+      {
+        services.push_back(nullptr);
+      }
+      else
+      {
+        services.push_back(m_context.GetService(reference));
+      }
+    }
+    if (unregisterDuringBatch)
+    {
+      unregisterDuringBatch.Unregister();
+    }
+    return services;
+  }
+
+  std::shared_ptr<MyInterfaceTwo> AddingService(
+    const ServiceReference<MyInterfaceTwo>& reference) override
+  {
+    ++addingCount;
+    return m_context.GetService(reference);
+  }
+
+  void ModifiedService(const ServiceReference<MyInterfaceTwo>&,
+                       const std::shared_ptr<MyInterfaceTwo>&) override
+  {}
+
+  void RemovedService(const ServiceReference<MyInterfaceTwo>&,
+                      const std::shared_ptr<MyInterfaceTwo>&) override
+  {
+    ++removedCount;
+  }
+
+  int batchCount = 0;
+  int addingCount = 0;
+  int removedCount = 0;
+  ServiceReference<MyInterfaceTwo> skipped;
+  ServiceRegistration<MyInterfaceTwo> unregisterDuringBatch;
+
+private:
+  BundleContext m_context;
+};
+
+void TestAddingServicesBatch(BundleContext context)
+{
+  struct MyServiceTwo : public MyInterfaceTwo
+  {};
+
+  // TestFilterString leaves one MyInterfaceTwo service registered
+  const auto previous = context.GetServiceReferences<MyInterfaceTwo>().size();
+
+  std::vector<ServiceRegistration<MyInterfaceTwo>> registrations;
+  for (int i = 0; i < 4; ++i)
+  {
+    registrations.push_back(
+      context.RegisterService<MyInterfaceTwo>(std::make_shared<MyServiceTwo>()));
+  }
+
+  MyBatchCustomizer customizer(context);
+  customizer.skipped = registrations[0].GetReference<MyInterfaceTwo>();
+  customizer.unregisterDuringBatch = registrations[1];
+  ServiceTracker<MyInterfaceTwo> tracker(context, &customizer);
+  tracker.Open();
+
+  US_TEST_CONDITION(customizer.batchCount == 1,
+                    "Initial services are added in one batch")
+  US_TEST_CONDITION(customizer.addingCount == 0,
+                    "AddingService is not called for the initial services")
+  US_TEST_CONDITION(customizer.removedCount == 1,
+                    "Service unregistered during the batch is removed")
+  US_TEST_CONDITION(tracker.Size() == static_cast<int>(previous + 2),
+                    "Skipped and unregistered services are not tracked")
+  US_TEST_CONDITION(!tracker.GetService(registrations[0].GetReference<MyInterfaceTwo>()),
+                    "Skipped service is not tracked")
+  US_TEST_CONDITION(tracker.GetTrackingCount() == static_cast<int>(previous + 2),
+                    "Tracking count is incremented for each added service")
+
+  registrations.push_back(
+    context.RegisterService<MyInterfaceTwo>(std::make_shared<MyServiceTwo>()));
+  US_TEST_CONDITION(customizer.addingCount == 1 && customizer.batchCount == 1,
+                    "Services registered after opening are added one by one")
+  US_TEST_CONDITION(tracker.Size() == static_cast<int>(previous + 3),
+                    "Service registered after opening is tracked")
+
+  tracker.Close();
+  for (std::size_t i = 0; i < registrations.size(); ++i)
+  {
+    if (i != 1) // already unregistered by the customizer
+    {
+      registrations[i].Unregister();
+    }
+  }
+}
+
+class MyThrowingCustomizer
+  : public cppmicroservices::ServiceTrackerCustomizer<MyInterfaceTwo>
+{
+
+public:
+  MyThrowingCustomizer(const BundleContext& context)
+    : m_context(context)
+  {}
+
+  std::vector<std::shared_ptr<MyInterfaceTwo>> AddingServices(
+    const std::vector<ServiceReference<MyInterfaceTwo>>& references) override
+  {
+    if (throwFromBatch)
+    {
+      throw std::runtime_error("AddingServices failed");
+    }
+    return ServiceTrackerCustomizer<MyInterfaceTwo>::AddingServices(references);
+  }
+
+  std::shared_ptr<MyInterfaceTwo> AddingService(
+    const ServiceReference<MyInterfaceTwo>& reference) override
+  {
+    if (++addingCount == throwAt)
+    {
+      throw std::runtime_error("AddingService failed");
+    }
+    return m_context.GetService(reference);
+  }
+
+  void ModifiedService(const ServiceReference<MyInterfaceTwo>&,
+                       const std::shared_ptr<MyInterfaceTwo>&) override
+  {}
+
+  void RemovedService(const ServiceReference<MyInterfaceTwo>&,
+                      const std::shared_ptr<MyInterfaceTwo>&) override
+  {
+    ++removedCount;
+  }
+
+  bool throwFromBatch = false;
+  int throwAt = 0;
+  int addingCount = 0;
+  int removedCount = 0;
+
+private:
+  BundleContext m_context;
+};
+
+void TestAddingServicesThrows(BundleContext context)
+{
+  struct MyServiceTwo : public MyInterfaceTwo
+  {};
+
+  // TestFilterString leaves one MyInterfaceTwo service registered
+  const auto previous = static_cast<int>(context.GetServiceReferences<MyInterfaceTwo>().size());
+
+  std::vector<ServiceRegistration<MyInterfaceTwo>> registrations;
+  for (int i = 0; i < 3; ++i)
+  {
+    registrations.push_back(
+      context.RegisterService<MyInterfaceTwo>(std::make_shared<MyServiceTwo>()));
+  }
+
+  {
+    MyThrowingCustomizer customizer(context);
+    customizer.throwAt = previous + 2;
+    ServiceTracker<MyInterfaceTwo> tracker(context, &customizer);
+    US_TEST_FOR_EXCEPTION(std::runtime_error, tracker.Open())
+    US_TEST_CONDITION(customizer.addingCount == previous + 3 && customizer.removedCount == 0,
+                      "AddingService is called for the services after the failing one")
+    US_TEST_CONDITION(tracker.Size() == previous + 2,
+                      "Only the service for which AddingService threw is skipped")
+
+    for (auto& registration : registrations)
+    {
+      registration.SetProperties(ServiceProperties());
+    }
+    US_TEST_CONDITION(tracker.Size() == previous + 3,
+                      "Skipped service is tracked later")
+    tracker.Close();
+  }
+
+  {
+    MyThrowingCustomizer customizer(context);
+    customizer.throwFromBatch = true;
+    ServiceTracker<MyInterfaceTwo> tracker(context, &customizer);
+    US_TEST_FOR_EXCEPTION(std::runtime_error, tracker.Open())
+    US_TEST_CONDITION(customizer.addingCount == 0 && tracker.Size() == 0,
+                      "No service is tracked after an overridden AddingServices threw")
+
+    registrations[1].SetProperties(ServiceProperties());
+    US_TEST_CONDITION(tracker.Size() == 1,
+                      "Failed AddingServices does not block tracking the service later")
+    tracker.Close();
+  }
+
+  for (auto& registration : registrations)
+  {
+    registration.Unregister();
+  }
+}
+
 int ServiceTrackerTest(int /*argc*/, char* /*argv*/ [])
 {
   US_TEST_BEGIN("ServiceTrackerTest")
@@ -322,6 +700,13 @@ int ServiceTrackerTest(int /*argc*/, char* /*argv*/ [])
 
   TestFilterString(framework.GetBundleContext());
   TestServiceTracker(framework.GetBundleContext());
+  TestTrackedSnapshot(framework.GetBundleContext());
+#ifdef US_ENABLE_THREADING_SUPPORT
+  TestConcurrentTrackedSnapshot(framework.GetBundleContext());
+  TestTrackedSnapshotsAreReleased(framework.GetBundleContext());
+#endif
+  TestAddingServicesBatch(framework.GetBundleContext());
+  TestAddingServicesThrows(framework.GetBundleContext());
 
   US_TEST_END()
 }
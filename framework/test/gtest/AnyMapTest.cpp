@@ -253,3 +253,105 @@ TEST(AnyMapTest, CIHashUnique)
   
   ASSERT_EQ(true, hashV1 != hashV2);
 }
+
+TEST(AnyMapTest, FrozenAnyMapSharesContent)
+{
+  AnyMap m(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  m["Bundle.Name"] = std::string("test");
+  FrozenAnyMap frozen(std::move(m));
+  FrozenAnyMap copy(frozen);
+
+  // copies refer to the same map instead of deep copying it
+  const AnyMap& original = frozen;
+  const AnyMap& copied = copy;
+  ASSERT_EQ(&original, &copied);
+  ASSERT_EQ(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS, copy.GetType());
+  ASSERT_EQ(1u, copy.size());
+  ASSERT_EQ(1u, copy.count("bundle.name"));
+  ASSERT_EQ(std::string("test"), any_cast<std::string>(copy.at("BUNDLE.NAME")));
+  ASSERT_THROW(copy.at("missing"), std::out_of_range);
+  ASSERT_TRUE(copy.find("missing") == copy.end());
+}
+
+TEST(AnyMapTest, FrozenAnyMapAtCompoundKey)
+{
+  AnyMap inner(AnyMap::ORDERED_MAP);
+  inner["leaf"] = 42;
+  AnyMap outer(AnyMap::ORDERED_MAP);
+  outer["nested"] = FrozenAnyMap(std::move(inner));
+
+  // compound keys descend into frozen maps stored as values
+  ASSERT_EQ(42, any_cast<int>(outer.AtCompoundKey("nested.leaf")));
+  FrozenAnyMap frozen(std::move(outer));
+  ASSERT_EQ(42, any_cast<int>(frozen.AtCompoundKey("nested.leaf")));
+  ASSERT_THROW(frozen.AtCompoundKey("nested.missing"), std::out_of_range);
+  ASSERT_EQ(7,
+            any_cast<int>(frozen.AtCompoundKey("nested.missing", Any(7))));
+  ASSERT_EQ("{\"nested\" : {\"leaf\" : 42}}", Any(frozen).ToJSON());
+}
+
+TEST(AnyMapTest, PrecompiledCompoundKey)
+{
+  AnyMap three(AnyMap::ORDERED_MAP);
+  three["a"] = std::string("anton");
+  three["b"] = std::vector<Any>{ Any(3), Any(8) };
+  AnyMap m(AnyMap::UNORDERED_MAP);
+  m["one"] = 1;
+  m["three"] = three;
+
+  const CompoundKey b1("three.b.1");
+  ASSERT_EQ("three.b.1", b1.ToString());
+  ASSERT_EQ(8, any_cast<int>(m.AtCompoundKey(b1)));
+  ASSERT_EQ(3, any_cast<int>(m.AtCompoundKey(CompoundKey("three.b.-2"))));
+  ASSERT_EQ(1, any_cast<int>(m.AtCompoundKey(CompoundKey("one"))));
+  ASSERT_EQ(&m.AtCompoundKey("three.a"),
+            &m.AtCompoundKey(CompoundKey("three.a")));
+
+  // the key can be reused against other maps of the same layout
+  AnyMap other(m);
+  ref_any_cast<AnyMap>(other["three"])["b"] =
+    std::vector<Any>{ Any(4), Any(9) };
+  ASSERT_EQ(9, any_cast<int>(other.AtCompoundKey(b1)));
+
+  ASSERT_THROW(m.AtCompoundKey(CompoundKey("three.c")), std::out_of_range);
+  ASSERT_THROW(m.AtCompoundKey(CompoundKey("three.b.2")), std::out_of_range);
+  ASSERT_THROW(m.AtCompoundKey(CompoundKey("three.b.x")),
+               std::invalid_argument);
+  ASSERT_THROW(m.AtCompoundKey(CompoundKey("one.a")), std::invalid_argument);
+  ASSERT_THROW(m.AtCompoundKey(CompoundKey("")), std::out_of_range);
+}
+
+TEST(AnyMapTest, FindCompoundKey)
+{
+  AnyMap three(AnyMap::ORDERED_MAP);
+  three["b"] = std::vector<Any>{ Any(3), Any(8) };
+  AnyMap m(AnyMap::UNORDERED_MAP);
+  m["one"] = 1;
+  m["three"] = three;
+
+  const Any* value = m.FindCompoundKey(CompoundKey("three.b.1"));
+  ASSERT_NE(nullptr, value);
+  ASSERT_EQ(8, any_cast<int>(*value));
+  ASSERT_EQ(3, any_cast<int>(*m.FindCompoundKey(CompoundKey("three.b.-2"))));
+
+  ASSERT_EQ(nullptr, m.FindCompoundKey(CompoundKey("two")));
+  ASSERT_EQ(nullptr, m.FindCompoundKey(CompoundKey("three.a")));
+  ASSERT_EQ(nullptr, m.FindCompoundKey(CompoundKey("three.b.2")));
+  ASSERT_EQ(nullptr, m.FindCompoundKey(CompoundKey("three.b.-3")));
+  ASSERT_EQ(nullptr, m.FindCompoundKey(CompoundKey("three.b.x")));
+  ASSERT_EQ(nullptr, m.FindCompoundKey(CompoundKey("one.a")));
+  ASSERT_EQ(nullptr, m.FindCompoundKey(CompoundKey("three.b.1.a")));
+
+  FrozenAnyMap frozen(std::move(m));
+  ASSERT_EQ(1, any_cast<int>(*frozen.FindCompoundKey(CompoundKey("one"))));
+  ASSERT_EQ(8, any_cast<int>(frozen.AtCompoundKey(CompoundKey("three.b.1"))));
+}
+
+TEST(AnyMapTest, ToJSONEscapesKeys)
+{
+  AnyMap m(AnyMap::ORDERED_MAP);
+  m["a \"quoted\" key"] = std::string("C:\\temp");
+  std::ostringstream os;
+  any_value_to_json(os, m);
+  ASSERT_EQ("{\"a \\\"quoted\\\" key\" : \"C:\\\\temp\"}", os.str());
+}
@@ -0,0 +1,316 @@
+/*=============================================================================
+
+Library: CppMicroServices
+
+Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+file at the top-level directory of this distribution and at
+https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+=============================================================================*/
+
+#include "cppmicroservices/Any.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace cppmicroservices;
+
+namespace {
+
+/// Fits into the inline buffer of an Any
+struct Small
+{
+  void* a;
+  void* b;
+
+  bool operator==(const Small& o) const { return a == o.a && b == o.b; }
+};
+
+/// Trivially copyable, but too large for the inline buffer
+struct Large
+{
+  char data[64];
+
+  bool operator==(const Large& o) const
+  {
+    return std::string(data) == std::string(o.data);
+  }
+};
+
+/// Counts its live instances, which are stored on the heap
+struct Counted
+{
+  explicit Counted(int value)
+    : value(value)
+  {
+    ++alive;
+  }
+  Counted(const Counted& o)
+    : value(o.value)
+  {
+    ++alive;
+  }
+  ~Counted() { --alive; }
+  Counted& operator=(const Counted&) = default;
+
+  bool operator==(const Counted& o) const { return value == o.value; }
+
+  int value;
+  static int alive;
+};
+
+int Counted::alive = 0;
+
+std::ostream& operator<<(std::ostream& os, const Small&)
+{
+  return os << "Small";
+}
+
+std::ostream& operator<<(std::ostream& os, const Large& l)
+{
+  return os << l.data;
+}
+
+std::ostream& operator<<(std::ostream& os, const Counted& c)
+{
+  return os << c.value;
+}
+
+Large MakeLarge(const char* text)
+{
+  Large l = {};
+  std::strncpy(l.data, text, sizeof(l.data) - 1);
+  return l;
+}
+
+/// Whether the value held by \c any lives inside the Any itself
+template<typename T>
+bool IsInline(Any& any)
+{
+  const char* value = reinterpret_cast<const char*>(any_cast<T>(&any));
+  const char* begin = reinterpret_cast<const char*>(&any);
+  return value >= begin && value < begin + sizeof(Any);
+}
+}
+
+TEST(AnyTest, InlineAndHeapStorage)
+{
+  Any i(42);
+  Any d(1.5);
+  Any s(Small{ &i, &d });
+  Any l(MakeLarge("large"));
+  Any str(std::string("text"));
+  Any c(Counted(1));
+
+  ASSERT_TRUE(IsInline<int>(i));
+  ASSERT_TRUE(IsInline<double>(d));
+  ASSERT_TRUE(IsInline<Small>(s));
+  ASSERT_FALSE(IsInline<Large>(l));
+  ASSERT_FALSE(IsInline<std::string>(str));
+  ASSERT_FALSE(IsInline<Counted>(c));
+  ASSERT_EQ(1, Counted::alive);
+}
+
+TEST(AnyTest, Copy)
+{
+  Any i(42);
+  Any copy(i);
+  ASSERT_EQ(42, any_cast<int>(copy));
+  ASSERT_TRUE(IsInline<int>(copy));
+  *any_cast<int>(&copy) = 7;
+  ASSERT_EQ(42, any_cast<int>(i)) << "A copy must not share inline storage";
+
+  Any str(std::string("text"));
+  Any strCopy(str);
+  ASSERT_EQ(std::string("text"), any_cast<std::string>(strCopy));
+  ASSERT_NE(any_cast<std::string>(&str), any_cast<std::string>(&strCopy))
+    << "A copy must not share heap storage";
+
+  {
+    Any c(Counted(1));
+    Any cCopy(c);
+    ASSERT_EQ(2, Counted::alive);
+  }
+  ASSERT_EQ(0, Counted::alive);
+
+  Any empty;
+  Any emptyCopy(empty);
+  ASSERT_TRUE(emptyCopy.Empty());
+}
+
+TEST(AnyTest, Move)
+{
+  Any i(42);
+  Any movedInt(std::move(i));
+  ASSERT_TRUE(i.Empty());
+  ASSERT_EQ(42, any_cast<int>(movedInt));
+  ASSERT_TRUE(IsInline<int>(movedInt));
+
+  {
+    Any c(Counted(3));
+    const Counted* held = any_cast<Counted>(&c);
+    Any movedCounted(std::move(c));
+    ASSERT_TRUE(c.Empty());
+    ASSERT_EQ(held, any_cast<Counted>(&movedCounted))
+      << "Moving must take over the heap value without copying it";
+    ASSERT_EQ(1, Counted::alive);
+  }
+  ASSERT_EQ(0, Counted::alive);
+
+  Any empty;
+  Any movedEmpty(std::move(empty));
+  ASSERT_TRUE(movedEmpty.Empty());
+}
+
+TEST(AnyTest, Assign)
+{
+  {
+    Any a(42);
+    Any c(Counted(5));
+
+    // heap over inline and inline over heap
+    a = c;
+    ASSERT_EQ(5, any_cast<Counted>(a).value);
+    ASSERT_EQ(2, Counted::alive);
+    c = 7;
+    ASSERT_EQ(7, any_cast<int>(c));
+    ASSERT_EQ(1, Counted::alive);
+
+    // move assignment in both directions
+    Any b(Small{ nullptr, &a });
+    b = std::move(a);
+    ASSERT_TRUE(a.Empty());
+    ASSERT_FALSE(IsInline<Counted>(b));
+    a = std::move(c);
+    ASSERT_TRUE(c.Empty());
+    ASSERT_TRUE(IsInline<int>(a));
+    ASSERT_EQ(7, any_cast<int>(a));
+    ASSERT_EQ(1, Counted::alive);
+
+    // assigning empty Anys releases the value
+    b = Any();
+    ASSERT_TRUE(b.Empty());
+    ASSERT_EQ(0, Counted::alive);
+    b = Counted(8);
+    c = b;
+    ASSERT_EQ(2, Counted::alive);
+  }
+  ASSERT_EQ(0, Counted::alive);
+}
+
+TEST(AnyTest, SelfAssign)
+{
+  Any i(42);
+  Any& iRef = i;
+  i = iRef;
+  ASSERT_EQ(42, any_cast<int>(i));
+  i = std::move(iRef);
+  ASSERT_EQ(42, any_cast<int>(i));
+
+  {
+    Any c(Counted(9));
+    Any& cRef = c;
+    c = cRef;
+    ASSERT_EQ(9, any_cast<Counted>(c).value);
+    c = std::move(cRef);
+    ASSERT_EQ(9, any_cast<Counted>(c).value);
+    ASSERT_EQ(1, Counted::alive);
+  }
+  ASSERT_EQ(0, Counted::alive);
+}
+
+TEST(AnyTest, Swap)
+{
+  {
+    Any i(42);
+    Any c(Counted(1));
+    const Counted* held = any_cast<Counted>(&c);
+
+    // inline and heap
+    i.Swap(c);
+    ASSERT_EQ(held, any_cast<Counted>(&i));
+    ASSERT_EQ(42, any_cast<int>(c));
+    ASSERT_TRUE(IsInline<int>(c));
+
+    // inline and inline
+    Any d(2.5);
+    c.Swap(d);
+    ASSERT_EQ(2.5, any_cast<double>(c));
+    ASSERT_EQ(42, any_cast<int>(d));
+
+    // heap and heap
+    Any l(MakeLarge("large"));
+    i.Swap(l);
+    ASSERT_EQ(std::string("large"), any_cast<Large>(i).data);
+    ASSERT_EQ(held, any_cast<Counted>(&l));
+
+    // empty and heap, empty and inline
+    Any empty;
+    empty.Swap(l);
+    ASSERT_TRUE(l.Empty());
+    ASSERT_EQ(held, any_cast<Counted>(&empty));
+    l.Swap(d);
+    ASSERT_TRUE(d.Empty());
+    ASSERT_EQ(42, any_cast<int>(l));
+    ASSERT_EQ(1, Counted::alive);
+  }
+  ASSERT_EQ(0, Counted::alive);
+}
+
+TEST(AnyTest, SelfSwap)
+{
+  Any i(42);
+  i.Swap(i);
+  ASSERT_EQ(42, any_cast<int>(i));
+  ASSERT_TRUE(IsInline<int>(i));
+
+  {
+    Any c(Counted(4));
+    const Counted* held = any_cast<Counted>(&c);
+    c.Swap(c);
+    ASSERT_EQ(held, any_cast<Counted>(&c));
+    ASSERT_EQ(1, Counted::alive);
+  }
+  ASSERT_EQ(0, Counted::alive);
+
+  Any empty;
+  empty.Swap(empty);
+  ASSERT_TRUE(empty.Empty());
+}
+
+TEST(AnyTest, MapToJSONEscapesKeys)
+{
+  std::map<std::string, Any> anyMap;
+  anyMap["a \"quoted\"\nkey"] = 1;
+  anyMap["C:\\temp"] = std::string("dir");
+  ASSERT_EQ("{\"C:\\\\temp\" : \"dir\", \"a \\\"quoted\\\"\\nkey\" : 1}",
+            Any(anyMap).ToJSON());
+
+  std::map<std::string, int> intMap;
+  intMap["tab\tkey"] = 2;
+  std::ostringstream os;
+  any_value_to_json(os, intMap);
+  ASSERT_EQ("{\"tab\\tkey\" : 2}", os.str());
+
+  std::map<int, int> intKeys;
+  intKeys[3] = 4;
+  ASSERT_EQ("{\"3\" : 4}", Any(intKeys).ToJSON());
+}
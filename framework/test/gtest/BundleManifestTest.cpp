@@ -191,3 +191,28 @@ TEST(BundleManifestTest, ParseManifest)
   framework.Stop();
   framework.WaitForStop(std::chrono::milliseconds::zero());
 }
+
+TEST(BundleManifestTest, HeadersCreatedOnce)
+{
+  auto framework = FrameworkFactory().NewFramework();
+  framework.Start();
+
+  auto bundleM = cppmicroservices::testing::InstallLib(framework.GetBundleContext()
+                                                       , "TestBundleM");
+  ASSERT_TRUE(bundleM) << "Failed to install TestBundleM";
+
+  // values needed while installing and starting are read from the
+  // manifest before the headers exist
+  EXPECT_EQ(bundleM.GetVersion(), BundleVersion(1, 0, 0));
+  bundleM.Start();
+
+  // the deprecated properties create the headers if needed
+  auto deprecatedProperties = bundleM.GetProperties();
+  const AnyMap& headers = bundleM.GetHeaders();
+  EXPECT_EQ(&headers, &bundleM.GetHeaders());
+  EXPECT_EQ(any_cast<int>(headers.at("NUMBER")), 5);
+  ASSERT_TRUE(compare_deprecated_properties(headers, deprecatedProperties)) << "Deprecated properties mismatch";
+
+  framework.Stop();
+  framework.WaitForStop(std::chrono::milliseconds::zero());
+}
@@ -20,6 +20,8 @@ limitations under the License.
 
 =============================================================================*/
 
+#include "TestUtils.h"
+#include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/Constants.h"
 #include "cppmicroservices/Framework.h"
@@ -29,6 +31,9 @@ limitations under the License.
 #include "cppmicroservices/ServiceRegistration.h"
 #include "gtest/gtest.h"
 #include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 using namespace cppmicroservices;
 
@@ -238,3 +243,127 @@ TEST_F(ServiceReferenceTest, TestGetServiceReferenceWithModifiedProperties)
   ASSERT_EQ(context.GetServiceReference<ServiceNS::ITestServiceA>(),
             regArr[1].GetReference());
 }
+
+// Services without a service factory are handed out without taking the
+// registry locks, check that their use is still tracked per bundle.
+TEST_F(ServiceReferenceTest, TestUsingBundlesOfSingletonService)
+{
+  auto context = framework.GetBundleContext();
+  auto reg = context.RegisterService<ServiceNS::ITestServiceA>(
+    std::make_shared<TestServiceA>());
+  auto ref = reg.GetReference();
+  ASSERT_TRUE(ref.GetUsingBundles().empty());
+
+  auto service = context.GetService(ref);
+  auto otherService = context.GetService(ref);
+  ASSERT_TRUE(service);
+  ASSERT_EQ(service, otherService);
+  ASSERT_EQ(service->getValue(), 42);
+  ASSERT_EQ(ref.GetUsingBundles().size(), 1u);
+  ASSERT_EQ(ref.GetUsingBundles().front(), framework);
+  ASSERT_EQ(framework.GetServicesInUse().size(), 1u);
+
+  service.reset();
+  ASSERT_EQ(ref.GetUsingBundles().size(), 1u);
+  otherService.reset();
+  ASSERT_TRUE(ref.GetUsingBundles().empty());
+  ASSERT_TRUE(framework.GetServicesInUse().empty());
+
+  // a service object stays valid after the service is unregistered
+  service = context.GetService(ref);
+  reg.Unregister();
+  ASSERT_TRUE(ref.GetUsingBundles().empty());
+  ASSERT_EQ(service->getValue(), 42);
+  ASSERT_FALSE(ref);
+}
+
+// A bundle's cached use of a service takes one of four slots. The service
+// objects handed out from a slot share its control block, while those of
+// the fallback path through the dependents map have their own one, which
+// tells the two paths apart.
+TEST_F(ServiceReferenceTest, TestSingletonUseSlotsFreedOnBundleStop)
+{
+  auto context = framework.GetBundleContext();
+  auto reg = context.RegisterService<ServiceNS::ITestServiceA>(
+    std::make_shared<TestServiceA>());
+  auto ref = reg.GetReference();
+  auto isCachedUse = [&ref](BundleContext ctx) {
+    auto service = ctx.GetService(ref);
+    return service && service.use_count() == 2;
+  };
+
+  std::vector<Bundle> bundles;
+  for (auto name :
+       { "TestBundleA", "TestBundleA2", "TestBundleM", "TestBundleR" }) {
+    auto bundle = cppmicroservices::testing::InstallLib(context, name);
+    bundle.Start();
+    ASSERT_TRUE(isCachedUse(bundle.GetBundleContext())) << name;
+    bundles.push_back(bundle);
+  }
+  ASSERT_FALSE(isCachedUse(context))
+    << "A fifth bundle must fall back to the dependents map";
+
+  // The slot of a stopped bundle is freed even though the bundle holds no
+  // service objects and is therefore not counted as using the service.
+  ASSERT_TRUE(bundles[0].GetServicesInUse().empty());
+  bundles[0].Stop();
+  ASSERT_TRUE(isCachedUse(context));
+
+  // the same holds for an uninstalled bundle, and for a bundle which still
+  // holds a service object when it stops
+  bundles[1].Uninstall();
+  bundles[0].Start();
+  ASSERT_TRUE(isCachedUse(bundles[0].GetBundleContext()));
+
+  auto service = bundles[3].GetBundleContext().GetService(ref);
+  ASSERT_EQ(ref.GetUsingBundles().size(), 1u);
+  bundles[3].Stop();
+  ASSERT_TRUE(ref.GetUsingBundles().empty());
+  ASSERT_EQ(service->getValue(), 42)
+    << "A service object stays valid after its bundle stopped";
+  bundles[3].Start();
+  ASSERT_TRUE(isCachedUse(bundles[3].GetBundleContext()));
+}
+
+TEST_F(ServiceReferenceTest, TestConcurrentSingletonGetAndUnget)
+{
+  auto context = framework.GetBundleContext();
+  auto reg = context.RegisterService<ServiceNS::ITestServiceA>(
+    std::make_shared<TestServiceA>());
+  auto ref = reg.GetReference();
+
+  // more bundles than slots, so that both paths are taken
+  std::vector<BundleContext> contexts{ context };
+  for (auto name : { "TestBundleA",
+                     "TestBundleA2",
+                     "TestBundleM",
+                     "TestBundleR",
+                     "TestBundleLQ" }) {
+    auto bundle = cppmicroservices::testing::InstallLib(context, name);
+    bundle.Start();
+    contexts.push_back(bundle.GetBundleContext());
+  }
+
+  std::atomic<int> failures(0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 12; ++i) {
+    auto ctx = contexts[i % contexts.size()];
+    threads.emplace_back([ctx, ref, &failures]() mutable {
+      for (int j = 0; j < 2000; ++j) {
+        auto service = ctx.GetService(ref);
+        auto other = ctx.GetService(ref);
+        if (!service || service != other || service->getValue() != 42) {
+          ++failures;
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  ASSERT_EQ(failures.load(), 0);
+  ASSERT_TRUE(ref.GetUsingBundles().empty())
+    << "All uses must be released once the service objects are gone";
+  ASSERT_TRUE(framework.GetServicesInUse().empty());
+}
@@ -132,6 +132,15 @@ public:
    */
   void ReadParts(void* callback(IHttpServletPart*) = 0) override;
 
+  /*!
+   * Reads the parts of a form request while the request body arrives
+   *
+   * \sa IHttpServletRequest::ReadParts(IHttpServletPartReader&, const HttpServletPartLimits&)
+   */
+  void ReadParts(
+    IHttpServletPartReader& reader,
+    const HttpServletPartLimits& limits = HttpServletPartLimits()) override;
+
   HttpServletRequest(HttpServletRequestPrivate* d);
 
 private:
@@ -149,13 +158,19 @@ private:
                          char* path,
                          size_t pathlen,
                          void* user_data);
-  static int field_store(const char* path,
-                         long long file_size,
-                         void* user_data);
   static int field_get(const char* key,
                        const char* value,
                        size_t valuelen,
                        void* user_data);
+
+  // Runs the form handler of civetweb and ends the last part
+  int ReadForm(void* user_data);
+
+  // Completes the part being read when the next one starts
+  static void EndPart(void* user_data);
+
+  // Makes a completely read part available through GetPart()
+  static void AddPart(void* user_data, HttpServletPartPrivate* privatePart);
 };
 }
 
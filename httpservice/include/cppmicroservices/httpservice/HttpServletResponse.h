@@ -91,6 +91,13 @@ public:
 
   void SendRedirect(const std::string& location) override;
 
+  void SendFile(const std::string& path) override;
+
+  void SendData(const std::shared_ptr<const std::string>& data,
+                const std::string& etag = std::string()) override;
+
+  void SendResource(const BundleResource& resource) override;
+
 protected:
   virtual std::streambuf* GetOutputStreamBuffer();
 
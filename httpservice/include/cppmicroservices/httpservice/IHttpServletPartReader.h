@@ -0,0 +1,99 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_IHTTPSERVLETPARTREADER_H
+#define CPPMICROSERVICES_IHTTPSERVLETPARTREADER_H
+
+#include "cppmicroservices/httpservice/HttpServiceExport.h"
+
+#include <cstddef>
+#include <string>
+
+namespace cppmicroservices {
+
+/**
+ * Limits applied while the parts of a request are read. A value of 0
+ * means unlimited.
+ */
+struct HttpServletPartLimits
+{
+  /**
+   * The maximum size of the content of a single part, in bytes.
+   */
+  std::size_t maxPartSize = 0;
+
+  /**
+   * The maximum size of the request body, in bytes. A request announcing a
+   * larger Content-Length is rejected before its body is read.
+   */
+  std::size_t maxRequestSize = 0;
+
+  /**
+   * The maximum number of parts of a request.
+   */
+  std::size_t maxPartCount = 0;
+};
+
+/**
+ * Receives the parts of a form request while its body is read from the
+ * connection. See IHttpServletRequest::ReadParts(IHttpServletPartReader&,
+ * const HttpServletPartLimits&).
+ */
+class US_HttpService_EXPORT IHttpServletPartReader
+{
+public:
+  /**
+   * How the content of a part is processed.
+   */
+  enum class Disposition
+  {
+    Skip,   ///< discard the content
+    Stream, ///< pass the content to ReadPartData as it arrives
+    Store   ///< stage the content in a temporary file, like ReadParts(callback)
+  };
+
+  virtual ~IHttpServletPartReader() = default;
+
+  /**
+   * Called when the part named \c name starts. \c submittedFileName is
+   * empty unless the part is a file upload.
+   *
+   * A stored part is available through IHttpServletRequest::GetPart once
+   * its content has been read.
+   */
+  virtual Disposition BeginPart(const std::string& name,
+                                const std::string& submittedFileName) = 0;
+
+  /**
+   * Called with the next piece of the content of a streamed part. The data
+   * is only valid during the call.
+   */
+  virtual void ReadPartData(const char* data, std::size_t size) = 0;
+
+  /**
+   * Called after the last piece of the content of a streamed part.
+   */
+  virtual void EndPart() = 0;
+};
+}
+
+#endif // CPPMICROSERVICES_IHTTPSERVLETPARTREADER_H
@@ -27,6 +27,7 @@
 #include "cppmicroservices/SharedData.h"
 #include "cppmicroservices/httpservice/HttpServiceExport.h"
 #include "cppmicroservices/httpservice/IHttpServletPart.h"
+#include "cppmicroservices/httpservice/IHttpServletPartReader.h"
 
 #include <string>
 #include <vector>
@@ -128,6 +129,28 @@ public:
    */
   virtual void ReadParts(void* callback(IHttpServletPart*) = 0) = 0;
 
+  /*!
+   * Reads the parts of a multipart/form-data or url-encoded form request
+   * while the request body arrives, and hands each part to \c reader.
+   * Unlike ReadParts(callback), content is only staged in a temporary file
+   * for parts the reader stores.
+   *
+   * Reading stops at the first part exceeding one of the \c limits; the
+   * part is not ended, its content beyond the limit is neither passed on
+   * nor written to disk, and the remaining parts are skipped. An exception
+   * thrown by the reader stops reading as well and is rethrown.
+   *
+   * The default implementation stages all parts with ReadParts(callback)
+   * first, then checks the limits and hands the staged parts to \c reader.
+   * Skipped parts stay available through GetPart.
+   *
+   * \throws std::length_error if the request exceeds one of the limits
+   * \throws std::runtime_error if the request body is not a valid form
+   */
+  virtual void ReadParts(
+    IHttpServletPartReader& reader,
+    const HttpServletPartLimits& limits = HttpServletPartLimits());
+
 private:
   friend class HttpServlet;
   virtual void* RawData() = 0;
@@ -32,6 +32,8 @@
 
 namespace cppmicroservices {
 
+class BundleResource;
+
 class US_HttpService_EXPORT IHttpServletResponse
 {
 public:
@@ -327,6 +329,54 @@ public:
                          const std::string& msg = std::string()) = 0;
 
   virtual void SendRedirect(const std::string& location) = 0;
+
+  /**
+   * Sends the contents of the file at \c path as the response body,
+   * bypassing the output stream. Where the platform supports it, a
+   * complete file is passed to the connection with \c sendfile.
+   *
+   * The Content-Length, ETag, Last-Modified and Accept-Ranges headers are
+   * set automatically, as is the Content-Type if it was not set before.
+   * A matching If-None-Match header yields a 304 response and a single
+   * byte range in a Range header a 206 response.
+   *
+   * The default implementation writes the file through GetOutputStream()
+   * and ignores conditional and range requests.
+   *
+   * @throws std::logic_error if the response is already committed.
+   * @throws std::invalid_argument if \c path is not a readable file.
+   */
+  virtual void SendFile(const std::string& path);
+
+  /**
+   * Sends \c data as the response body, bypassing the output stream, and
+   * handles conditional and range requests like SendFile. The buffer is
+   * shared, not copied, so callers can keep immutable buffers of static
+   * content and send them to any number of responses.
+   *
+   * The default implementation writes \c data through GetOutputStream()
+   * and ignores conditional and range requests.
+   *
+   * @param data The response body.
+   * @param etag The quoted entity tag of \c data. If empty, it is
+   *        computed from the contents.
+   * @throws std::logic_error if the response is already committed.
+   */
+  virtual void SendData(const std::shared_ptr<const std::string>& data,
+                        const std::string& etag = std::string());
+
+  /**
+   * Sends a bundle resource as the response body like SendData. The
+   * entity tag is derived from the checksum of the resource, so a
+   * conditional request is answered without extracting the resource.
+   *
+   * The default implementation writes the resource through
+   * GetOutputStream() and ignores conditional and range requests.
+   *
+   * @throws std::logic_error if the response is already committed.
+   * @throws std::invalid_argument if \c resource is not a valid file resource.
+   */
+  virtual void SendResource(const BundleResource& resource);
 };
 
 } // namespace cppmicroservices
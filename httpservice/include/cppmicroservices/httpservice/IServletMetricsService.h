@@ -0,0 +1,83 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_ISERVLETMETRICSSERVICE_H
+#define CPPMICROSERVICES_ISERVLETMETRICSSERVICE_H
+
+#include "cppmicroservices/httpservice/HttpServiceExport.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cppmicroservices {
+
+/**
+ * The request counters and the latency histogram of one servlet context
+ */
+struct ServletMetrics
+{
+  /// The context root the servlet is registered for
+  std::string contextPath;
+
+  /// The number of requests handled, including failed and rejected ones
+  std::uint64_t requestCount = 0;
+
+  /// Requests the servlet threw an exception for or answered with a 5xx status
+  std::uint64_t errorCount = 0;
+
+  /// Requests rejected without calling the servlet, e.g. for their body size
+  std::uint64_t rejectedCount = 0;
+
+  /// The sum of the latencies of all requests
+  std::chrono::microseconds totalLatency{ 0 };
+
+  /**
+   * The upper bounds of the latency buckets. \c latencyCounts has one more
+   * element, which counts the requests slower than the last bound.
+   */
+  std::vector<std::chrono::microseconds> latencyBounds;
+
+  /// The number of requests per latency bucket
+  std::vector<std::uint64_t> latencyCounts;
+};
+
+/**
+ * A service registered by a started ServletContainer, which reports the
+ * request metrics of its servlets. The latency of a request is measured
+ * from the start of its dispatch until the response is completed.
+ */
+class US_HttpService_EXPORT IServletMetricsService
+{
+public:
+  virtual ~IServletMetricsService() = default;
+
+  /**
+   * Returns the metrics of the servlets currently registered with the
+   * container, in no particular order.
+   */
+  virtual std::vector<ServletMetrics> GetServletMetrics() const = 0;
+};
+}
+
+#endif // CPPMICROSERVICES_ISERVLETMETRICSSERVICE_H
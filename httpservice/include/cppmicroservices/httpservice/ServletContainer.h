@@ -37,9 +37,44 @@ struct ServletContainerPrivate;
 class ServletContext;
 class BundleContext;
 
+/*!
+ * Serves the registered HttpServlet services with a CivetWeb server.
+ *
+ * The server is tuned through the framework properties below. Options
+ * passed to Start(const std::vector<std::string>&) take precedence over
+ * them. While started, the container registers an IServletMetricsService.
+ */
 class US_HttpService_EXPORT ServletContainer
 {
 public:
+  /// The ports to listen on, in the format of the "listening_ports" option
+  static const std::string PROP_LISTENING_PORTS;
+
+  /// The number of worker threads, which bounds the concurrent requests
+  static const std::string PROP_NUM_THREADS;
+
+  /// Whether connections are kept alive, true by default
+  static const std::string PROP_KEEP_ALIVE;
+
+  /// The time in milliseconds an idle kept-alive connection stays open
+  static const std::string PROP_KEEP_ALIVE_TIMEOUT_MS;
+
+  /// The time in milliseconds to wait for a request to arrive
+  static const std::string PROP_REQUEST_TIMEOUT_MS;
+
+  /// The maximum size in bytes of the request line and headers
+  static const std::string PROP_MAX_REQUEST_HEADER_SIZE;
+
+  /*!
+   * The maximum size in bytes of a request body. A request announcing a
+   * larger Content-Length is answered with 413 without calling the
+   * servlet. Unlimited by default.
+   */
+  static const std::string PROP_MAX_REQUEST_BODY_SIZE;
+
+  /// Whether Nagle's algorithm is disabled, true by default
+  static const std::string PROP_TCP_NODELAY;
+
   ServletContainer(BundleContext bundleCtx,
                    const std::string& contextPath = std::string());
   ~ServletContainer();
@@ -51,16 +86,28 @@ public:
   * Pass an options collection to the underlying CivetWeb server
   *
   * See CivetWeb documentation for available parameters
+  *
+  * \throws std::invalid_argument if a framework property above has an
+  *         invalid value
   */
   void Start(const std::vector<std::string>& options);
 
   /*!
-  * Start server with default options
+  * Start server with the options given by the framework properties
+  *
+  * \throws std::invalid_argument if a framework property above has an
+  *         invalid value
   */
   void Start();
 
   void Stop();
 
+  /*!
+   * The ports the server is bound to, empty if it is not running. Useful
+   * when it was started with port "0" to let the system pick a free one.
+   */
+  std::vector<int> GetListeningPorts() const;
+
   std::shared_ptr<ServletContext> GetContext(const std::string& uripath) const;
   std::string GetContextPath(const ServletContext* context) const;
 
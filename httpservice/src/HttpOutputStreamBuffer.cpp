@@ -26,20 +26,32 @@
 
 #include "civetweb/civetweb.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <functional>
 
 namespace cppmicroservices {
 
+namespace {
+
+// room for the hex chunk size and its CRLF in front of the put area
+const std::size_t ChunkHeaderSize = 2 * sizeof(std::size_t) + 2;
+// room for the character passed to overflow(), the CRLF ending a chunk and
+// the terminating chunk behind the put area
+const std::size_t ChunkTrailerSize = 1 + 2 + 5;
+}
+
+const std::size_t HttpOutputStreamBuffer::MaxAdaptiveBufferSize;
+
 HttpOutputStreamBuffer::HttpOutputStreamBuffer(
   HttpServletResponsePrivate* response,
   std::size_t bufferSize)
-  : m_Buffer(bufferSize + 1)
+  : m_BufferSize(0)
   , m_Response(response)
   , m_ChunkedCoding(true)
 {
-  char* base = &m_Buffer.front();
-  setp(base, base + m_Buffer.size() - 1);
+  allocate(bufferSize > 0 ? bufferSize : 1);
 }
 
 HttpOutputStreamBuffer::~HttpOutputStreamBuffer()
@@ -57,20 +69,31 @@ HttpOutputStreamBuffer::~HttpOutputStreamBuffer()
     m_Response->m_Headers["Content-Length"] =
       m_Response->LexicalCast(static_cast<long>(pptr() - pbase()));
   }
-  sync();
+  sendBuffer(true);
+}
+
+void HttpOutputStreamBuffer::allocate(std::size_t bufferSize)
+{
+  std::vector<char>(ChunkHeaderSize + bufferSize + ChunkTrailerSize)
+    .swap(m_Buffer);
+  m_BufferSize = bufferSize;
+  char* base = &m_Buffer.front() + ChunkHeaderSize;
+  setp(base, base + bufferSize);
+}
+
+void HttpOutputStreamBuffer::selectTransferCoding()
+{
+  m_ChunkedCoding = m_Response->m_Headers.find("Content-Length") ==
+                    m_Response->m_Headers.end();
   if (m_ChunkedCoding) {
-    mg_write(m_Response->m_Connection, "0\r\n\r\n", 5);
+    m_Response->m_Headers["Transfer-Encoding"] = "chunked";
   }
 }
 
 bool HttpOutputStreamBuffer::CommitStream()
 {
   if (!m_Response->m_IsCommited) {
-    m_ChunkedCoding = m_Response->m_Headers.find("Content-Length") ==
-                      m_Response->m_Headers.end();
-    if (m_ChunkedCoding) {
-      m_Response->m_Headers["Transfer-Encoding"] = "chunked";
-    }
+    selectTransferCoding();
     // this writes the headers if not already written
     return m_Response->Commit();
   }
@@ -84,6 +107,11 @@ std::streambuf::int_type HttpOutputStreamBuffer::overflow(int_type ch)
     *pptr() = ch;
     pbump(1);
     if (sendBuffer()) {
+      // the servlet writes more than fits into the buffer, so use
+      // larger chunks for the rest of the response
+      if (m_BufferSize < MaxAdaptiveBufferSize) {
+        allocate(std::min(2 * m_BufferSize, MaxAdaptiveBufferSize));
+      }
       return ch;
     }
   }
@@ -95,30 +123,57 @@ int HttpOutputStreamBuffer::sync()
   return sendBuffer() ? 0 : -1;
 }
 
-bool HttpOutputStreamBuffer::sendBuffer()
+bool HttpOutputStreamBuffer::sendBuffer(bool lastChunk)
 {
   if (!m_Response->m_Connection)
     return false;
 
-  // commit the response by writing the headers
-  if (!CommitStream())
-    return false;
+  const bool committed = m_Response->m_IsCommited;
+  if (!committed) {
+    selectTransferCoding();
+  }
 
-  // write the buffer contents
-  std::ptrdiff_t n = pptr() - pbase();
-  pbump(static_cast<int>(-n));
-  int bytesSend = 0;
-  if (m_ChunkedCoding) {
-    // send chunk size
-    std::string chunkSize =
-      m_Response->LexicalCastHex(static_cast<long>(n)) + "\r\n";
-    bytesSend +=
-      mg_write(m_Response->m_Connection, &chunkSize[0], chunkSize.size());
+  if (m_Response->m_OmitsBody) {
+    // discard the buffer contents, including the terminating chunk
+    setp(pbase(), epptr());
+    return committed || m_Response->Commit();
   }
-  bytesSend += mg_write(m_Response->m_Connection, pbase(), n);
+
+  // frame the buffer contents in place
+  char* begin = pbase();
+  char* end = pptr();
+  const std::size_t n = static_cast<std::size_t>(end - begin);
+  pbump(static_cast<int>(-static_cast<std::ptrdiff_t>(n)));
   if (m_ChunkedCoding) {
-    bytesSend += mg_write(m_Response->m_Connection, "\r\n", 2);
+    // an empty chunk would terminate the body
+    if (n > 0) {
+      static const char hexDigits[] = "0123456789abcdef";
+      *--begin = '\n';
+      *--begin = '\r';
+      std::size_t size = n;
+      do {
+        *--begin = hexDigits[size & 0xf];
+        size >>= 4;
+      } while (size != 0);
+      *end++ = '\r';
+      *end++ = '\n';
+    }
+    if (lastChunk) {
+      std::memcpy(end, "0\r\n\r\n", 5);
+      end += 5;
+    }
+  }
+
+  const std::size_t size = static_cast<std::size_t>(end - begin);
+  if (!committed) {
+    // send the headers and the first chunk with a single write
+    if (size <= HttpServletResponsePrivate::MaxCoalescedBodySize) {
+      return m_Response->Commit(begin, size);
+    }
+    if (!m_Response->Commit()) {
+      return false;
+    }
   }
-  return bytesSend > 0;
+  return size == 0 || mg_write(m_Response->m_Connection, begin, size) > 0;
 }
 }
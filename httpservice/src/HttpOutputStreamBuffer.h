@@ -32,6 +32,17 @@ namespace cppmicroservices {
 
 struct HttpServletResponsePrivate;
 
+/**
+ * The stream buffer of a response body. A chunk of the chunked transfer
+ * coding is framed in place, with room for the size line in front of and
+ * the trailing CRLF behind the put area, so each chunk takes a single
+ * write. The first chunk is sent together with the response headers and
+ * the last one together with the terminating chunk.
+ *
+ * The buffer starts with the size requested by the servlet and doubles
+ * each time it runs full, up to MaxAdaptiveBufferSize, so large responses
+ * are sent in few large chunks while small ones use little memory.
+ */
 class HttpOutputStreamBuffer : public std::streambuf
 {
 public:
@@ -39,6 +50,8 @@ public:
                                   std::size_t bufferSize = 1024);
   ~HttpOutputStreamBuffer();
 
+  static const std::size_t MaxAdaptiveBufferSize = 64 * 1024;
+
 protected:
   bool CommitStream();
 
@@ -47,13 +60,18 @@ private:
 
   int sync();
 
-  bool sendBuffer();
+  bool sendBuffer(bool lastChunk = false);
+
+  void allocate(std::size_t bufferSize);
+
+  void selectTransferCoding();
 
   HttpOutputStreamBuffer(const HttpOutputStreamBuffer&);
   HttpOutputStreamBuffer& operator=(const HttpOutputStreamBuffer&);
 
 private:
   std::vector<char> m_Buffer;
+  std::size_t m_BufferSize;
   HttpServletResponsePrivate* m_Response;
   bool m_ChunkedCoding;
 };
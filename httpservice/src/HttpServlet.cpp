@@ -231,13 +231,12 @@ void HttpServlet::DoGet(IHttpServletRequest& request,
 }
 
 void HttpServlet::DoHead(IHttpServletRequest& request,
-                         IHttpServletResponse& /*response*/)
+                         IHttpServletResponse& response)
 {
-  void* data = request.RawData();
-  if (nullptr != data) {
-    HttpServletResponsePrivate* responseData;
-    responseData = static_cast<HttpServletResponsePrivate*>(data);
-    NoBodyResponse noBodyResponse(responseData);
+  // the NoBodyResponse shares the data of the response
+  auto httpResponse = dynamic_cast<HttpServletResponse*>(&response);
+  if (nullptr != httpResponse) {
+    NoBodyResponse noBodyResponse(httpResponse->d.Data());
     DoGet(request, noBodyResponse);
     noBodyResponse.SetContentLength();
   }
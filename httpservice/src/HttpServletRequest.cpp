@@ -36,6 +36,9 @@
 #include <cassert>
 #include <cstring>
 #include <ctime>
+#include <exception>
+#include <fstream>
+#include <memory>
 #include <utility>
 
 #include <iostream>
@@ -57,13 +60,37 @@ HttpServletRequestPrivate::HttpServletRequestPrivate(
   std::shared_ptr<ServletContext> servletContext,
   CivetServer* server,
   mg_connection* conn)
-  : m_ServletContext(servletContext)
-  , m_Server(server)
-  , m_Connection(conn)
-  , m_Scheme("http")
-  , m_ServerPort("80")
+  : m_Server(nullptr)
+  , m_Connection(nullptr)
   , m_PartsMap()
 {
+  Reset(std::move(servletContext), server, conn);
+}
+
+HttpServletRequestPrivate::~HttpServletRequestPrivate()
+{
+  Release();
+}
+
+void HttpServletRequestPrivate::Reset(
+  std::shared_ptr<ServletContext> servletContext,
+  CivetServer* server,
+  mg_connection* conn)
+{
+  m_ServletContext = std::move(servletContext);
+  m_Server = server;
+  m_Connection = conn;
+  m_Scheme = "http";
+  m_ServerName.clear();
+  m_ServerPort = "80";
+  m_Uri.clear();
+  m_ContextPath.clear();
+  m_ServletPath.clear();
+  m_PathInfo.clear();
+  m_QueryString.clear();
+  m_Url.clear();
+  m_TempDirname.clear();
+
   const char* headerHostLine = mg_get_header(m_Connection, "Host");
   std::string host;
   if (headerHostLine) {
@@ -132,11 +159,15 @@ HttpServletRequestPrivate::HttpServletRequestPrivate(
   }
 }
 
-HttpServletRequestPrivate::~HttpServletRequestPrivate()
+void HttpServletRequestPrivate::Release()
 {
   for (auto partMapElement : m_PartsMap) {
     delete partMapElement.second;
   }
+  m_PartsMap.clear();
+  m_Attributes.clear();
+  m_Parameters.clear();
+  m_ServletContext.reset();
 }
 
 HttpServletRequest::~HttpServletRequest() {}
@@ -430,154 +461,319 @@ void HttpServletRequest::RemoveAttribute(const std::string& name)
   }
 }
 
-struct UserData
+namespace {
+
+/*!
+ * How the content of the part being read is processed
+ */
+enum class PartStorage
 {
-  HttpServletPartPrivate* PrivatePart;
-  void* Callback;
-  HttpServletRequest* request;
+  Skip,
+  Memory, ///< collected into a MemoryHttpServletPartPrivate
+  Stream, ///< passed to an IHttpServletPartReader
+  Store   ///< written to a temporary file while the limits allow it
+};
 
-  UserData()
-    : PrivatePart(nullptr)
-    , Callback(nullptr)
-    , request(nullptr)
-  {}
+/*!
+ * The state of a ReadParts() call, passed to the civetweb callbacks
+ */
+struct UserData
+{
+  HttpServletRequestPrivate* request = nullptr;
+  void* (*callback)(IHttpServletPart*) = nullptr;
+  IHttpServletPartReader* reader = nullptr;
+  HttpServletPartLimits limits;
+
+  PartStorage storage = PartStorage::Skip;
+  std::string partName;
+  MemoryHttpServletPartPrivate* memoryPart = nullptr;
+  FileHttpServletPartPrivate* filePart = nullptr;
+  std::ofstream file;
+  std::size_t partSize = 0;
+  std::size_t requestSize = 0;
+  std::size_t partCount = 0;
+
+  // the first error, reading stops once it is set
+  std::exception_ptr error;
 };
 
+void Fail(UserData& data, std::exception_ptr error)
+{
+  if (!data.error) {
+    data.error = error;
+  }
+  data.storage = PartStorage::Skip;
+}
+
+void CheckLimits(const UserData& data)
+{
+  const HttpServletPartLimits& limits = data.limits;
+  if (limits.maxPartSize > 0 && data.partSize > limits.maxPartSize) {
+    throw std::length_error("The part '" + data.partName +
+                            "' exceeds the limit of " +
+                            std::to_string(limits.maxPartSize) + " bytes");
+  }
+  if (limits.maxRequestSize > 0 && data.requestSize > limits.maxRequestSize) {
+    throw std::length_error("The request exceeds the limit of " +
+                            std::to_string(limits.maxRequestSize) +
+                            " bytes");
+  }
+}
+}
+
+void HttpServletRequest::AddPart(void* user_data,
+                                 HttpServletPartPrivate* privatePart)
+{
+  UserData& data = *static_cast<UserData*>(user_data);
+  std::unique_ptr<IHttpServletPart> part(new HttpServletPart(privatePart));
+  auto& parts = data.request->m_PartsMap;
+  if (!parts.insert(std::make_pair(privatePart->m_Name, part.get())).second) {
+    // the first part of a name wins, a later one is dropped with its storage
+    return;
+  }
+  IHttpServletPart* addedPart = part.release();
+  if (data.callback != nullptr) {
+    data.callback(addedPart);
+  }
+}
+
+void HttpServletRequest::EndPart(void* user_data)
+{
+  UserData& data = *static_cast<UserData*>(user_data);
+  const PartStorage storage = data.storage;
+  data.storage = PartStorage::Skip;
+  // parts which are not completed are discarded
+  std::unique_ptr<MemoryHttpServletPartPrivate> memoryPart(data.memoryPart);
+  std::unique_ptr<FileHttpServletPartPrivate> filePart(data.filePart);
+  data.memoryPart = nullptr;
+  data.filePart = nullptr;
+  if (data.file.is_open()) {
+    data.file.close();
+  }
+
+  if (storage == PartStorage::Memory) {
+    data.request->m_Parameters[memoryPart->m_Name] = memoryPart->m_Value;
+    AddPart(user_data, memoryPart.release());
+  } else if (storage == PartStorage::Stream) {
+    data.reader->EndPart();
+  } else if (storage == PartStorage::Store) {
+    if (data.file.fail()) {
+      filePart->Delete();
+      throw std::runtime_error("Writing the part '" + filePart->m_Name +
+                               "' to '" + filePart->m_TemporaryFileName +
+                               "' failed");
+    }
+    filePart->m_Size = static_cast<long long>(data.partSize);
+    AddPart(user_data, filePart.release());
+  } else if (filePart) {
+    filePart->Delete();
+  }
+}
+
 int HttpServletRequest::field_found(const char* key,
                                     const char* filename,
-                                    char* path,
+                                    char* /* path */,
                                     size_t /* pathlen */,
                                     void* user_data)
 {
-  int resultCode = -1;
-  HttpServletPartPrivate* privatePart;
-
-  UserData* user_data_parsed = static_cast<UserData*>(user_data);
-  HttpServletRequest* request = user_data_parsed->request;
-
-  if (filename != nullptr && strlen(filename) > 0) {
-    // this is a file upload
-    FileHttpServletPartPrivate* filePrivatePart;
-    filePrivatePart =
-      new FileHttpServletPartPrivate(request->d->m_ServletContext,
-                                     request->d->m_Server,
-                                     request->d->m_Connection);
-    util::File file = util::MakeUniqueTempFile(request->d->m_TempDirname);
-    filePrivatePart->m_TemporaryFileName = file.Path;
-
-    filePrivatePart->m_SubmittedFileName = std::string(filename);
-    strncpy(path,
-            filePrivatePart->m_TemporaryFileName.c_str(),
-            filePrivatePart->m_TemporaryFileName.size());
-
-    privatePart = filePrivatePart;
-    resultCode = MG_FORM_FIELD_STORAGE_STORE;
-  } else {
-    // This is a simple HTTP form parameter
-    MemoryHttpServletPartPrivate* memoryPrivatePart;
-    memoryPrivatePart =
-      new MemoryHttpServletPartPrivate(request->d->m_ServletContext,
-                                       request->d->m_Server,
-                                       request->d->m_Connection);
+  UserData& data = *static_cast<UserData*>(user_data);
+  HttpServletRequestPrivate* request = data.request;
+  try {
+    EndPart(user_data);
+    if (data.error) {
+      return MG_FORM_FIELD_STORAGE_ABORT;
+    }
+    if (strlen(key) == 0) {
+      return MG_FORM_FIELD_STORAGE_SKIP;
+    }
+    ++data.partCount;
+    if (data.limits.maxPartCount > 0 &&
+        data.partCount > data.limits.maxPartCount) {
+      throw std::length_error("The request has more than " +
+                              std::to_string(data.limits.maxPartCount) +
+                              " parts");
+    }
 
-    privatePart = memoryPrivatePart;
-    resultCode = MG_FORM_FIELD_STORAGE_GET;
+    const bool isFile = (filename != nullptr && strlen(filename) > 0);
+    PartStorage storage = isFile ? PartStorage::Store : PartStorage::Memory;
+    if (data.reader != nullptr) {
+      switch (data.reader->BeginPart(key, isFile ? filename : std::string())) {
+        case IHttpServletPartReader::Disposition::Skip:
+          storage = PartStorage::Skip;
+          break;
+        case IHttpServletPartReader::Disposition::Stream:
+          storage = PartStorage::Stream;
+          break;
+        case IHttpServletPartReader::Disposition::Store:
+          storage = PartStorage::Store;
+          break;
+      }
+    }
+    data.partName = key;
+    data.partSize = 0;
+
+    if (storage == PartStorage::Store) {
+      std::unique_ptr<FileHttpServletPartPrivate> filePart(
+        new FileHttpServletPartPrivate(
+          request->m_ServletContext, request->m_Server, request->m_Connection));
+      filePart->m_Name = key;
+      filePart->m_SubmittedFileName = isFile ? filename : std::string();
+      filePart->m_TemporaryFileName =
+        util::MakeUniqueTempFile(request->m_TempDirname).Path;
+      filePart->m_Size = 0;
+      // The content is written in field_get rather than by civetweb, which
+      // would store the whole part before its size could be checked.
+      data.file.clear();
+      data.file.open(filePart->m_TemporaryFileName,
+                     std::ios::binary | std::ios::trunc);
+      if (!data.file) {
+        filePart->Delete();
+        throw std::runtime_error("The temporary file '" +
+                                 filePart->m_TemporaryFileName +
+                                 "' cannot be opened");
+      }
+      data.filePart = filePart.release();
+    } else if (storage == PartStorage::Memory) {
+      data.memoryPart = new MemoryHttpServletPartPrivate(
+        request->m_ServletContext, request->m_Server, request->m_Connection);
+      data.memoryPart->m_Name = key;
+    }
+    data.storage = storage;
+    return (storage == PartStorage::Skip) ? MG_FORM_FIELD_STORAGE_SKIP
+                                          : MG_FORM_FIELD_STORAGE_GET;
+  } catch (...) {
+    // exceptions must not unwind through civetweb, ReadParts rethrows it
+    Fail(data, std::current_exception());
+    return MG_FORM_FIELD_STORAGE_ABORT;
   }
-  privatePart->m_Name = std::string(key);
-  user_data_parsed->PrivatePart = privatePart;
-
-  return resultCode;
 }
 
-int HttpServletRequest::field_get(const char* key,
+int HttpServletRequest::field_get(const char* /* key */,
                                   const char* value,
                                   size_t valuelen,
                                   void* user_data)
 {
-  if (strlen(key) == 0) {
+  // The content of a multipart part arrives in several calls, only the
+  // first one carries the key.
+  UserData& data = *static_cast<UserData*>(user_data);
+  if (data.storage == PartStorage::Skip) {
     return 0;
   }
-  UserData* user_data_parsed = static_cast<UserData*>(user_data);
-  HttpServletRequest* request = user_data_parsed->request;
-  request->d->m_Parameters[key] = std::string(value).substr(0, valuelen);
-
-  MemoryHttpServletPartPrivate* privatePart;
-  privatePart =
-    dynamic_cast<MemoryHttpServletPartPrivate*>(user_data_parsed->PrivatePart);
-  if (nullptr != privatePart) {
-    privatePart->m_Value = std::string(value).substr(0, valuelen);
-    IHttpServletPart* part = new HttpServletPart(privatePart);
-
-#ifdef _MSC_VER
-    void (*callback)(IHttpServletPart*) =
-      static_cast<void (*)(IHttpServletPart*)>(user_data_parsed->Callback);
-#else
-    void (*callback)(IHttpServletPart*) =
-      reinterpret_cast<decltype(callback)>(user_data_parsed->Callback);
-#endif
-
-    HttpServletRequest* httpRequest;
-    httpRequest = static_cast<HttpServletRequest*>(user_data_parsed->request);
-    httpRequest->d->m_PartsMap.insert(
-      std::pair<std::string, IHttpServletPart*>(privatePart->m_Name, part));
-
-    if (callback != NULL) {
-      callback(part);
+  try {
+    // nothing beyond the limits is kept, in memory or on disk
+    data.partSize += valuelen;
+    data.requestSize += valuelen;
+    CheckLimits(data);
+    if (data.storage == PartStorage::Memory) {
+      data.memoryPart->m_Value.append(value, valuelen);
+    } else if (data.storage == PartStorage::Store) {
+      data.file.write(value, static_cast<std::streamsize>(valuelen));
+    } else {
+      data.reader->ReadPartData(value, valuelen);
     }
+  } catch (...) {
+    Fail(data, std::current_exception());
   }
   return 0;
 }
 
-int HttpServletRequest::field_store(const char* path,
-                                    long long file_size,
-                                    void* user_data)
+int HttpServletRequest::ReadForm(void* user_data)
 {
-  UserData* user_data_parsed = static_cast<UserData*>(user_data);
+  mg_form_data_handler fdh = {
+    HttpServletRequest::field_found,
+    HttpServletRequest::field_get,
+    nullptr,
+    user_data,
+  };
 
-  FileHttpServletPartPrivate* privatePart;
-  privatePart =
-    dynamic_cast<FileHttpServletPartPrivate*>(user_data_parsed->PrivatePart);
-  if (nullptr != privatePart) {
-    IHttpServletPart* part = new HttpServletPart(privatePart);
+  const int fieldCount = mg_handle_form_request(d->m_Connection, &fdh);
 
-    privatePart->m_TemporaryFileName = std::string(path);
-    privatePart->m_Size = file_size;
+  UserData& data = *static_cast<UserData*>(user_data);
+  if (fieldCount < 0 && data.reader != nullptr) {
+    // The last part may be incomplete. ReadParts(callback) has always kept
+    // it, since civetweb also fails on a closing boundary without CRLF.
+    data.storage = PartStorage::Skip;
+  }
+  try {
+    EndPart(user_data);
+  } catch (...) {
+    Fail(data, std::current_exception());
+  }
+  return fieldCount;
+}
 
-#ifdef _MSC_VER
-    void (*callback)(IHttpServletPart*) =
-      static_cast<void (*)(IHttpServletPart*)>(user_data_parsed->Callback);
-#else
-    void (*callback)(IHttpServletPart*) =
-      reinterpret_cast<decltype(callback)>(user_data_parsed->Callback);
-#endif
+void IHttpServletRequest::ReadParts(IHttpServletPartReader& reader,
+                                    const HttpServletPartLimits& limits)
+{
+  if (limits.maxRequestSize > 0 &&
+      GetContentLength() > limits.maxRequestSize) {
+    throw std::length_error("The request exceeds the limit of " +
+                            std::to_string(limits.maxRequestSize) + " bytes");
+  }
 
-    HttpServletRequest* httpRequest;
-    httpRequest = static_cast<HttpServletRequest*>(user_data_parsed->request);
-    httpRequest->d->m_PartsMap.insert(
-      std::pair<std::string, IHttpServletPart*>(privatePart->m_Name, part));
+  ReadParts();
+  const std::vector<IHttpServletPart*> parts = GetParts();
+  if (limits.maxPartCount > 0 && parts.size() > limits.maxPartCount) {
+    throw std::length_error("The request has more than " +
+                            std::to_string(limits.maxPartCount) + " parts");
+  }
+  for (IHttpServletPart* part : parts) {
+    if (limits.maxPartSize > 0 &&
+        static_cast<unsigned long long>(part->GetSize()) >
+          limits.maxPartSize) {
+      throw std::length_error("The part '" + part->GetName() +
+                              "' exceeds the limit of " +
+                              std::to_string(limits.maxPartSize) + " bytes");
+    }
+  }
 
-    if (callback != NULL) {
-      callback(part);
+  for (IHttpServletPart* part : parts) {
+    if (reader.BeginPart(part->GetName(), part->GetSubmittedFileName()) !=
+        IHttpServletPartReader::Disposition::Stream) {
+      continue;
+    }
+    std::unique_ptr<std::istream> in(part->GetInputStream());
+    char buffer[4096];
+    while (in && in->read(buffer, sizeof(buffer)).gcount() > 0) {
+      reader.ReadPartData(buffer, static_cast<std::size_t>(in->gcount()));
     }
+    reader.EndPart();
   }
-  return 0;
 }
 
 void HttpServletRequest::ReadParts(void* callback(IHttpServletPart*))
 {
-  UserData user_data;
-  user_data.PrivatePart = nullptr;
-  user_data.Callback = reinterpret_cast<decltype(user_data.Callback)>(callback);
-  user_data.request = this;
+  UserData data;
+  data.request = d.Data();
+  data.callback = callback;
 
-  mg_form_data_handler fdh = {
-    HttpServletRequest::field_found,
-    HttpServletRequest::field_get,
-    HttpServletRequest::field_store,
-    &user_data,
-  };
+  ReadForm(&data);
+  if (data.error) {
+    std::rethrow_exception(data.error);
+  }
+}
+
+void HttpServletRequest::ReadParts(IHttpServletPartReader& reader,
+                                   const HttpServletPartLimits& limits)
+{
+  if (limits.maxRequestSize > 0 &&
+      GetContentLength() > limits.maxRequestSize) {
+    throw std::length_error("The request exceeds the limit of " +
+                            std::to_string(limits.maxRequestSize) + " bytes");
+  }
+
+  UserData data;
+  data.request = d.Data();
+  data.reader = &reader;
+  data.limits = limits;
 
-  mg_handle_form_request(d->m_Connection, &fdh);
+  const int fieldCount = ReadForm(&data);
+  if (data.error) {
+    std::rethrow_exception(data.error);
+  }
+  if (fieldCount < 0) {
+    throw std::runtime_error("The request body is not a valid form");
+  }
 }
 
 HttpServletRequest::HttpServletRequest(HttpServletRequestPrivate* d)
@@ -48,9 +48,24 @@ struct HttpServletRequestPrivate : public SharedData
 
   ~HttpServletRequestPrivate();
 
-  const std::shared_ptr<ServletContext> m_ServletContext;
-  CivetServer* const m_Server;
-  struct mg_connection* const m_Connection;
+  /*!
+   * Prepares this object for the request on \c conn. The state of a
+   * previous request is discarded, but string capacities are kept so a
+   * pooled object serves further requests without reallocating.
+   */
+  void Reset(std::shared_ptr<ServletContext> servletContext,
+             CivetServer* server,
+             mg_connection* conn);
+
+  /*!
+   * Drops the parts, attributes and the servlet context of the served
+   * request before the object goes back into a pool.
+   */
+  void Release();
+
+  std::shared_ptr<ServletContext> m_ServletContext;
+  CivetServer* m_Server;
+  struct mg_connection* m_Connection;
 
   std::string m_Scheme;
   std::string m_ServerName;
@@ -26,97 +26,386 @@
 #include "cppmicroservices/httpservice/HttpServletRequest.h"
 #include "cppmicroservices/httpservice/ServletContext.h"
 
+#include "cppmicroservices/BundleResource.h"
+#include "cppmicroservices/BundleResourceStream.h"
+
 #include "civetweb/civetweb.h"
 
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <ctime>
+#include <fstream>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
 
 namespace cppmicroservices {
 
+const std::size_t HttpServletResponsePrivate::MaxCoalescedBodySize;
+
+namespace {
+
+bool ParseRangeBound(const std::string& str, std::uint64_t& value)
+{
+  if (str.empty() || str.size() > 19 ||
+      str.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  value = std::stoull(str);
+  return true;
+}
+
+/*
+ * Parses a Range header with a single "bytes=first-last", "bytes=first-"
+ * or "bytes=-suffix" range of a body of size bytes. Returns 1 for a
+ * satisfiable range, 0 for an unsatisfiable one and -1 if the header is
+ * malformed or asks for several ranges, in which case it is ignored.
+ */
+int ParseByteRange(const std::string& header,
+                   std::uint64_t size,
+                   std::uint64_t& first,
+                   std::uint64_t& last)
+{
+  static const std::string unit = "bytes=";
+  if (header.compare(0, unit.size(), unit) != 0 ||
+      header.find(',') != std::string::npos) {
+    return -1;
+  }
+  std::size_t dash = header.find('-', unit.size());
+  if (dash == std::string::npos) {
+    return -1;
+  }
+  const std::string firstStr = header.substr(unit.size(), dash - unit.size());
+  const std::string lastStr = header.substr(dash + 1);
+
+  if (firstStr.empty()) {
+    std::uint64_t suffix = 0;
+    if (!ParseRangeBound(lastStr, suffix)) {
+      return -1;
+    }
+    if (suffix == 0 || size == 0) {
+      return 0;
+    }
+    first = suffix >= size ? 0 : size - suffix;
+    last = size - 1;
+    return 1;
+  }
+
+  if (!ParseRangeBound(firstStr, first)) {
+    return -1;
+  }
+  if (lastStr.empty()) {
+    last = size - 1;
+  } else if (!ParseRangeBound(lastStr, last) || last < first) {
+    return -1;
+  }
+  if (first >= size) {
+    return 0;
+  }
+  if (last >= size) {
+    last = size - 1;
+  }
+  return 1;
+}
+
+/*
+ * Checks whether an If-None-Match header lists the entity tag. Weak tags
+ * match their strong counterpart, as required for If-None-Match.
+ */
+bool MatchesEntityTag(const std::string& header, const std::string& etag)
+{
+  auto stripWeak = [](const std::string& tag) {
+    return tag.compare(0, 2, "W/") == 0 ? tag.substr(2) : tag;
+  };
+  const std::string strongTag = stripWeak(etag);
+  std::size_t pos = 0;
+  while (pos < header.size()) {
+    std::size_t end = header.find(',', pos);
+    if (end == std::string::npos) {
+      end = header.size();
+    }
+    std::size_t first = header.find_first_not_of(' ', pos);
+    std::size_t last = header.find_last_not_of(' ', end - 1);
+    if (first < end && last != std::string::npos && last >= first) {
+      const std::string tag = header.substr(first, last - first + 1);
+      if (tag == "*" || stripWeak(tag) == strongTag) {
+        return true;
+      }
+    }
+    pos = end + 1;
+  }
+  return false;
+}
+
+std::string MakeEntityTag(std::uint64_t first, std::uint64_t second)
+{
+  char etag[40];
+  std::snprintf(etag,
+                sizeof(etag),
+                "\"%llx-%llx\"",
+                static_cast<unsigned long long>(first),
+                static_cast<unsigned long long>(second));
+  return etag;
+}
+
+/// The FNV-1a hash of data, used as entity tag of buffers sent without one
+std::uint64_t HashData(const std::string& data)
+{
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : data) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+}
+
+void IHttpServletResponse::SendFile(const std::string& path)
+{
+  if (this->IsCommitted()) {
+    throw std::logic_error("Response already committed.");
+  }
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::invalid_argument("Cannot send '" + path +
+                                "', it is not a readable file.");
+  }
+  if (!this->ContainsHeader("Content-Type")) {
+    this->SetContentType(mg_get_builtin_mime_type(path.c_str()));
+  }
+  // streaming an empty buffer would set the failbit of the output stream
+  if (file.peek() != std::ifstream::traits_type::eof()) {
+    this->GetOutputStream() << file.rdbuf();
+  }
+}
+
+void IHttpServletResponse::SendData(
+  const std::shared_ptr<const std::string>& data,
+  const std::string& /*etag*/)
+{
+  if (this->IsCommitted()) {
+    throw std::logic_error("Response already committed.");
+  }
+  if (data) {
+    this->GetOutputStream().write(data->data(),
+                                  static_cast<std::streamsize>(data->size()));
+  }
+}
+
+void IHttpServletResponse::SendResource(const BundleResource& resource)
+{
+  if (this->IsCommitted()) {
+    throw std::logic_error("Response already committed.");
+  }
+  if (!resource || !resource.IsFile()) {
+    throw std::invalid_argument("Cannot send an invalid or directory resource.");
+  }
+  if (!this->ContainsHeader("Content-Type")) {
+    this->SetContentType(mg_get_builtin_mime_type(resource.GetName().c_str()));
+  }
+  BundleResourceStream resStream(resource, std::ios::binary);
+  if (resStream.peek() != std::istream::traits_type::eof()) {
+    this->GetOutputStream() << resStream.rdbuf();
+  }
+}
+
 HttpServletResponsePrivate::HttpServletResponsePrivate(
   HttpServletRequest* request,
   CivetServer* server,
   mg_connection* conn)
-  : m_Request(request)
-  , m_Server(server)
-  , m_Connection(conn)
+  : m_Request(nullptr)
+  , m_Server(nullptr)
+  , m_Connection(nullptr)
   , m_StatusCode(HttpServletResponse::SC_NOT_FOUND)
   , m_StreamBuf(nullptr)
   , m_HttpOutputStreamBuf(nullptr)
   , m_HttpOutputStream(nullptr)
   , m_IsCommited(false)
+  , m_OmitsBody(false)
   , m_BufferSize(1024)
   , m_Charset("UTF-8")
-{}
+{
+  Reset(request, server, conn);
+}
 
 HttpServletResponsePrivate::~HttpServletResponsePrivate()
 {
+  CloseStream();
+}
+
+void HttpServletResponsePrivate::Reset(HttpServletRequest* request,
+                                       CivetServer* server,
+                                       mg_connection* conn)
+{
+  CloseStream();
+  m_Request = request;
+  m_Server = server;
+  m_Connection = conn;
+  m_StatusCode = HttpServletResponse::SC_NOT_FOUND;
+  m_Headers.clear();
+  m_IsCommited = false;
+  // the request may be gone when the response is closed, so the method is
+  // looked up now
+  const mg_request_info* info = conn ? mg_get_request_info(conn) : nullptr;
+  m_OmitsBody = info != nullptr && info->request_method != nullptr &&
+                std::strcmp(info->request_method, "HEAD") == 0;
+  m_BufferSize = 1024;
+  m_Charset = "UTF-8";
+}
+
+void HttpServletResponsePrivate::Finish()
+{
+  if (m_Connection != nullptr && !m_IsCommited && m_StreamBuf == nullptr) {
+    Commit();
+  }
+  Close();
+}
+
+void HttpServletResponsePrivate::Close()
+{
+  CloseStream();
+  m_Request = nullptr;
+  m_Server = nullptr;
+  m_Connection = nullptr;
+}
+
+void HttpServletResponsePrivate::CloseStream()
+{
+  // deleting the stream buffer flushes the pending output
   delete m_StreamBuf;
   if (m_StreamBuf != m_HttpOutputStreamBuf) {
     delete m_HttpOutputStreamBuf;
   }
   delete m_HttpOutputStream;
+  m_StreamBuf = nullptr;
+  m_HttpOutputStreamBuf = nullptr;
+  m_HttpOutputStream = nullptr;
 }
 
-bool HttpServletResponsePrivate::Commit()
+bool HttpServletResponsePrivate::Commit(const char* body, std::size_t bodySize)
 {
   if (m_IsCommited)
     return true;
 
-  std::stringstream ss;
-  if (m_StatusCode >= 200 && m_StatusCode <= 202) {
-    ss << "HTTP/1.1 " << m_StatusCode << " "
-       << mg_get_response_code_text(m_Connection, m_StatusCode) << "\r\n";
+  std::string header;
+  header.reserve(256 + bodySize);
+  header += "HTTP/1.1 ";
+  header += LexicalCast(m_StatusCode);
+  // the reason phrase may be empty, but the space before it is required
+  header += ' ';
+  header += mg_get_response_code_text(m_Connection, m_StatusCode);
+  header += "\r\n";
+  for (const auto& h : m_Headers) {
+    header += h.first;
+    header += ": ";
+    header += h.second;
+    header += "\r\n";
   }
-
-  else
-    ss << "HTTP/1.1 " << m_StatusCode << "\r\n";
-  for (std::map<std::string, std::string>::iterator iter = m_Headers.begin(),
-                                                    endIter = m_Headers.end();
-       iter != endIter;
-       ++iter) {
-    ss << iter->first << ": " << iter->second << "\r\n";
+  // Without framing the client can only detect the end of the body when
+  // the connection closes, which would defeat keep-alive. A response
+  // committed without a body stream carries no body.
+  if (m_StreamBuf == nullptr && m_StatusCode >= 200 &&
+      m_StatusCode != HttpServletResponse::SC_NO_CONTENT &&
+      m_StatusCode != HttpServletResponse::SC_NOT_MODIFIED &&
+      m_Headers.find("Content-Length") == m_Headers.end() &&
+      m_Headers.find("Transfer-Encoding") == m_Headers.end()) {
+    header += "Content-Length: 0\r\n";
+  }
+  header += "\r\n";
+  if (bodySize > 0) {
+    header.append(body, bodySize);
   }
-  ss << "\r\n";
 
-  std::string header = ss.str();
-  int n = mg_write(m_Connection, &header[0], header.size());
+  int n = mg_write(m_Connection, header.data(), header.size());
   m_IsCommited = n > 0;
   return m_IsCommited;
 }
 
-std::string HttpServletResponsePrivate::LexicalCast(long value)
+bool HttpServletResponsePrivate::PrepareEntity(std::uint64_t size,
+                                               const std::string& etag,
+                                               std::uint64_t& offset,
+                                               std::uint64_t& length)
 {
-  char result[100];
-  char* ptr = result;
-  char* ptr1 = ptr;
-  char tmp_char;
+  m_Headers["ETag"] = etag;
+  m_Headers["Accept-Ranges"] = "bytes";
+
+  const std::string ifNoneMatch = m_Request->GetHeader("If-None-Match");
+  if (!ifNoneMatch.empty() && MatchesEntityTag(ifNoneMatch, etag)) {
+    m_StatusCode = HttpServletResponse::SC_NOT_MODIFIED;
+    m_Headers.erase("Content-Length");
+    return false;
+  }
 
-  int tmp_value;
+  offset = 0;
+  length = size;
+  const std::string range = m_Request->GetHeader("Range");
+  const std::string ifRange = m_Request->GetHeader("If-Range");
+  if (!range.empty() && (ifRange.empty() || ifRange == etag)) {
+    std::uint64_t first = 0;
+    std::uint64_t last = 0;
+    switch (ParseByteRange(range, size, first, last)) {
+      case 1:
+        m_StatusCode = HttpServletResponse::SC_PARTIAL_CONTENT;
+        m_Headers["Content-Range"] = "bytes " + std::to_string(first) + "-" +
+                                     std::to_string(last) + "/" +
+                                     std::to_string(size);
+        offset = first;
+        length = last - first + 1;
+        break;
+      case 0:
+        m_StatusCode = HttpServletResponse::SC_REQUESTED_RANGE_NOT_SATISFIABLE;
+        m_Headers["Content-Range"] = "bytes */" + std::to_string(size);
+        m_Headers["Content-Length"] = "0";
+        return false;
+      default:
+        break;
+    }
+  }
+  m_Headers["Content-Length"] = std::to_string(length);
+  return !m_OmitsBody;
+}
 
-  do {
-    tmp_value = value;
-    value /= 10;
-    *ptr++ = "0123456789"[tmp_value - value * 10];
-  } while (value);
+void HttpServletResponsePrivate::SendBody(const char* body, std::size_t size)
+{
+  if (size <= MaxCoalescedBodySize) {
+    Commit(body, size);
+  } else if (Commit()) {
+    mg_write(m_Connection, body, size);
+  }
+}
 
-  // Apply negative sign
-  if (tmp_value < 0)
-    *ptr++ = '-';
+void HttpServletResponsePrivate::SendBody(std::istream& in,
+                                          std::uint64_t offset,
+                                          std::uint64_t length)
+{
+  in.seekg(static_cast<std::streamoff>(offset));
+  if (length <= MaxCoalescedBodySize) {
+    std::string body(static_cast<std::size_t>(length), '\0');
+    in.read(&body[0], static_cast<std::streamsize>(length));
+    SendBody(body.data(), static_cast<std::size_t>(in.gcount()));
+    return;
+  }
 
-  *ptr-- = '\0';
-  // Invert the string
-  while (ptr1 < ptr) {
-    tmp_char = *ptr;
-    *ptr-- = *ptr1;
-    *ptr1++ = tmp_char;
+  if (!Commit()) {
+    return;
+  }
+  std::vector<char> buffer(64 * 1024);
+  while (length > 0 && in) {
+    in.read(buffer.data(),
+            static_cast<std::streamsize>(
+              std::min<std::uint64_t>(length, buffer.size())));
+    const auto n = static_cast<std::size_t>(in.gcount());
+    if (n == 0 || mg_write(m_Connection, buffer.data(), n) <= 0) {
+      return;
+    }
+    length -= n;
   }
-  return result;
 }
 
-std::string HttpServletResponsePrivate::LexicalCastHex(long value)
+std::string HttpServletResponsePrivate::LexicalCast(long value)
 {
   char result[100];
   char* ptr = result;
@@ -127,8 +416,8 @@ std::string HttpServletResponsePrivate::LexicalCastHex(long value)
 
   do {
     tmp_value = value;
-    value /= 16;
-    *ptr++ = "0123456789abcdef"[tmp_value - value * 16];
+    value /= 10;
+    *ptr++ = "0123456789"[tmp_value - value * 10];
   } while (value);
 
   // Apply negative sign
@@ -443,6 +732,111 @@ void HttpServletResponse::SetOutputStreamBuffer(std::streambuf* sb)
   d->m_StreamBuf = sb;
 }
 
+void HttpServletResponse::SendFile(const std::string& path)
+{
+  if (this->IsCommitted()) {
+    throw std::logic_error("Response already committed.");
+  }
+#ifdef US_PLATFORM_WINDOWS
+  struct _stat64 fileStat;
+  const bool isFile = _stat64(path.c_str(), &fileStat) == 0 &&
+                      (fileStat.st_mode & _S_IFREG) != 0;
+#else
+  struct stat fileStat;
+  const bool isFile =
+    ::stat(path.c_str(), &fileStat) == 0 && S_ISREG(fileStat.st_mode);
+#endif
+  std::ifstream file;
+  if (isFile) {
+    file.open(path, std::ios::binary);
+  }
+  if (!file) {
+    throw std::invalid_argument("Cannot send '" + path +
+                                "', it is not a readable file.");
+  }
+
+  const auto size = static_cast<std::uint64_t>(fileStat.st_size);
+  const auto lastModified = static_cast<std::uint64_t>(fileStat.st_mtime);
+  if (!this->ContainsHeader("Content-Type")) {
+    this->SetContentType(mg_get_builtin_mime_type(path.c_str()));
+  }
+  this->SetDateHeader("Last-Modified",
+                      static_cast<long long>(lastModified) * 1000);
+
+  std::uint64_t offset = 0;
+  std::uint64_t length = 0;
+  if (!d->PrepareEntity(size, MakeEntityTag(lastModified, size), offset, length)) {
+    d->Commit();
+    return;
+  }
+
+  if (length == size &&
+      length > HttpServletResponsePrivate::MaxCoalescedBodySize) {
+    if (d->Commit()) {
+      // lets civetweb use sendfile where available
+      file.close();
+      mg_send_file_body(d->m_Connection, path.c_str());
+    }
+    return;
+  }
+  d->SendBody(file, offset, length);
+}
+
+void HttpServletResponse::SendData(
+  const std::shared_ptr<const std::string>& data,
+  const std::string& etag)
+{
+  if (this->IsCommitted()) {
+    throw std::logic_error("Response already committed.");
+  }
+  static const std::string empty;
+  const std::string& body = data ? *data : empty;
+
+  std::uint64_t offset = 0;
+  std::uint64_t length = 0;
+  if (!d->PrepareEntity(body.size(),
+                        etag.empty() ? MakeEntityTag(HashData(body), body.size())
+                                     : etag,
+                        offset,
+                        length)) {
+    d->Commit();
+    return;
+  }
+
+  d->SendBody(body.data() + offset, static_cast<std::size_t>(length));
+}
+
+void HttpServletResponse::SendResource(const BundleResource& resource)
+{
+  if (this->IsCommitted()) {
+    throw std::logic_error("Response already committed.");
+  }
+  if (!resource || !resource.IsFile()) {
+    throw std::invalid_argument("Cannot send an invalid or directory resource.");
+  }
+
+  const auto size = static_cast<std::uint64_t>(resource.GetSize());
+  if (!this->ContainsHeader("Content-Type")) {
+    this->SetContentType(mg_get_builtin_mime_type(resource.GetName().c_str()));
+  }
+  if (resource.GetLastModified() > 0) {
+    this->SetDateHeader(
+      "Last-Modified", static_cast<long long>(resource.GetLastModified()) * 1000);
+  }
+
+  const std::string etag = MakeEntityTag(resource.GetCrc32(), size);
+  std::uint64_t offset = 0;
+  std::uint64_t length = 0;
+  if (!d->PrepareEntity(size, etag, offset, length)) {
+    d->Commit();
+    return;
+  }
+
+  // the resource is extracted only when its contents are actually sent
+  BundleResourceStream resStream(resource, std::ios::binary);
+  d->SendBody(resStream, offset, length);
+}
+
 HttpServletResponse::HttpServletResponse(HttpServletResponsePrivate* d)
   : d(d)
 {}
@@ -25,6 +25,8 @@
 
 #include "cppmicroservices/SharedData.h"
 
+#include <cstdint>
+#include <iosfwd>
 #include <map>
 #include <string>
 
@@ -42,14 +44,64 @@ struct HttpServletResponsePrivate : public SharedData
                              mg_connection* conn);
   ~HttpServletResponsePrivate();
 
-  bool Commit();
+  /**
+   * Prepares this object for the response to the request on \c conn,
+   * discarding the state of a previous response.
+   */
+  void Reset(HttpServletRequest* request,
+             CivetServer* server,
+             mg_connection* conn);
+
+  /**
+   * Completes the response after the servlet returned: a response the
+   * servlet never wrote to is committed with an empty body, then the
+   * response is closed. This keeps the connection usable for keep-alive.
+   */
+  void Finish();
+
+  /**
+   * Flushes and closes the output stream and detaches the response from
+   * the connection.
+   */
+  void Close();
+
+  /**
+   * Writes the status line and the headers, followed by \c bodySize bytes
+   * of the already framed body at \c body in the same write.
+   */
+  bool Commit(const char* body = nullptr, std::size_t bodySize = 0);
+
+  /**
+   * Sets the entity headers for a body of \c size bytes and resolves the
+   * conditional and range headers of the request. Returns false if no body
+   * is to be sent, see also m_OmitsBody, otherwise the body range to send
+   * is returned in \c offset and \c length.
+   */
+  bool PrepareEntity(std::uint64_t size,
+                     const std::string& etag,
+                     std::uint64_t& offset,
+                     std::uint64_t& length);
+
+  /**
+   * Commits the response and writes the unframed body of \c size bytes
+   * at \c body.
+   */
+  void SendBody(const char* body, std::size_t size);
+
+  /**
+   * Commits the response and writes \c length bytes of \c in, starting
+   * at \c offset, as the unframed body. Only the requested bytes are read.
+   */
+  void SendBody(std::istream& in, std::uint64_t offset, std::uint64_t length);
+
+  /// Bodies up to this size are sent in the same write as the headers
+  static const std::size_t MaxCoalescedBodySize = 16 * 1024;
 
   std::string LexicalCast(long int value);
-  std::string LexicalCastHex(long int value);
 
-  HttpServletRequest* const m_Request;
-  CivetServer* const m_Server;
-  struct mg_connection* const m_Connection;
+  HttpServletRequest* m_Request;
+  CivetServer* m_Server;
+  struct mg_connection* m_Connection;
 
   int m_StatusCode;
   std::map<std::string, std::string> m_Headers;
@@ -57,8 +109,13 @@ struct HttpServletResponsePrivate : public SharedData
   std::streambuf* m_HttpOutputStreamBuf;
   std::ostream* m_HttpOutputStream;
   bool m_IsCommited;
+  /// True for the response to a HEAD request, which carries no body
+  bool m_OmitsBody;
   std::size_t m_BufferSize;
   std::string m_Charset;
+
+private:
+  void CloseStream();
 };
 }
 
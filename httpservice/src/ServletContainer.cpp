@@ -29,6 +29,7 @@
 #include "HttpServletRequestPrivate.h"
 #include "HttpServletResponsePrivate.h"
 #include "ServletConfigPrivate.h"
+#include "ServletMetricsService.h"
 #include "cppmicroservices/httpservice/HttpServlet.h"
 #include "cppmicroservices/httpservice/HttpServletRequest.h"
 #include "cppmicroservices/httpservice/HttpServletResponse.h"
@@ -40,105 +41,88 @@
 #include "cppmicroservices/util/FileSystem.h"
 
 #include <cassert>
+#include <chrono>
+#include <cstring>
 #include <memory>
+#include <stdexcept>
+#include <typeinfo>
 #include <utility>
 
 namespace cppmicroservices {
 
 using Lock = std::unique_lock<std::mutex>;
 
+namespace {
+
+/**
+ * The request and response objects of a civetweb worker thread. A worker
+ * serves one request at a time, so objects only referenced by the pool
+ * after a request was served are reset and reused for the next request
+ * instead of being reallocated. Objects a servlet kept a copy of are left
+ * to the servlet.
+ */
+struct ServletObjectPool
+{
+  ExplicitlySharedDataPointer<HttpServletRequestPrivate> request;
+  ExplicitlySharedDataPointer<HttpServletResponsePrivate> response;
+};
+
+ServletObjectPool& GetServletObjectPool()
+{
+  static thread_local ServletObjectPool pool;
+  return pool;
+}
+
+bool IsPooled(const SharedData* data)
+{
+  return data != nullptr && data->ref == 1;
+}
+}
+
 class ServletHandler : public CivetHandler
 {
 public:
   ServletHandler(const std::shared_ptr<HttpServlet>& servlet,
                  const std::string& servletPath,
-                 const std::string& tempDirname = "")
+                 const std::string& tempDirname,
+                 std::shared_ptr<ServletMetricsCounters> metrics,
+                 std::size_t maxRequestBodySize)
     : m_Servlet(servlet)
+    , m_ServletContext(servlet->GetServletContext())
+    , m_ContextPath(m_ServletContext->GetContextPath())
     , m_ServletPath(servletPath)
     , m_TempDirname(tempDirname)
+    , m_Metrics(std::move(metrics))
+    , m_MaxRequestBodySize(maxRequestBodySize)
   {}
 
   std::shared_ptr<ServletContext> GetServletContext() const
   {
-    return m_Servlet->GetServletContext();
+    return m_ServletContext;
   }
 
   std::shared_ptr<HttpServlet> GetServlet() const { return m_Servlet; }
 
+  std::shared_ptr<ServletMetricsCounters> GetMetrics() const
+  {
+    return m_Metrics;
+  }
+
 private:
   bool handleGet(CivetServer* server, mg_connection* conn) override
   {
-    auto mg_req_info = mg_get_request_info(conn);
-    if (mg_req_info->local_uri == nullptr) {
-      return true;
-    }
-
-    HttpServletRequest request(new HttpServletRequestPrivate(
-      m_Servlet->GetServletContext(), server, conn));
-    request.d->m_ContextPath = m_Servlet->GetServletContext()->GetContextPath();
-    request.d->m_ServletPath = m_ServletPath;
-
-    std::string uri = mg_req_info->local_uri;
-    std::string pathPrefix =
-      request.d->m_ContextPath + request.d->m_ServletPath;
-    // std::cout << "Checking path prefix: " << pathPrefix << std::endl;
-    // std::cout << "Against uri: " << uri << std::endl;
-    assert(pathPrefix.size() <= uri.size());
-    assert(uri.compare(0, pathPrefix.size(), pathPrefix) == 0);
-    if (uri.size() > pathPrefix.size()) {
-      request.d->m_PathInfo = uri.substr(pathPrefix.size());
-    }
-
-    HttpServletResponse response(
-      new HttpServletResponsePrivate(&request, server, conn));
-    response.SetStatus(HttpServletResponse::SC_OK);
+    return Handle(server, conn, std::string());
+  }
 
-    try {
-      m_Servlet->Service(request, response);
-    } catch (const std::exception& e) {
-      std::cout << e.what() << std::endl;
-      return false;
-    }
-    return true;
+  bool handleHead(CivetServer* server, mg_connection* conn) override
+  {
+    return Handle(server, conn, std::string());
   }
 
   virtual bool handlePost(CivetServer* server,
                           struct mg_connection* conn) override
   {
-    auto mg_req_info = mg_get_request_info(conn);
-    if (mg_req_info->local_uri == nullptr) {
-      return true;
-    }
-
-    HttpServletRequest request(new HttpServletRequestPrivate(
-      m_Servlet->GetServletContext(), server, conn));
-
-    request.d->m_ContextPath = m_Servlet->GetServletContext()->GetContextPath();
-    request.d->m_ServletPath = m_ServletPath;
-    request.d->m_TempDirname = m_TempDirname;
-
-    std::string uri = mg_req_info->local_uri;
-    std::string pathPrefix =
-      request.d->m_ContextPath + request.d->m_ServletPath;
-    // std::cout << "Checking path prefix: " << pathPrefix << std::endl;
-    // std::cout << "Against uri: " << uri << std::endl;
-    assert(pathPrefix.size() <= uri.size());
-    assert(uri.compare(0, pathPrefix.size(), pathPrefix) == 0);
-    if (uri.size() > pathPrefix.size()) {
-      request.d->m_PathInfo = uri.substr(pathPrefix.size());
-    }
-
-    HttpServletResponse response(
-      new HttpServletResponsePrivate(&request, server, conn));
-    response.SetStatus(HttpServletResponse::SC_OK);
-
-    try {
-      m_Servlet->Service(request, response);
-    } catch (const std::exception& e) {
-      std::cout << e.what() << std::endl;
-      return false;
-    }
-    return true;
+    return Handle(server, conn, m_TempDirname);
   }
 
   virtual bool handlePut(CivetServer* server,
@@ -153,10 +137,100 @@ private:
     return handlePost(server, conn);
   }
 
-private:
+  bool Handle(CivetServer* server,
+              mg_connection* conn,
+              const std::string& tempDirname)
+  {
+    auto mg_req_info = mg_get_request_info(conn);
+    if (mg_req_info->local_uri == nullptr) {
+      return true;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (m_MaxRequestBodySize > 0 && mg_req_info->content_length > 0 &&
+        static_cast<unsigned long long>(mg_req_info->content_length) >
+          m_MaxRequestBodySize) {
+      // civetweb closes the connection after sending an error
+      mg_send_http_error(conn, 413, "%s", "Request body too large");
+      m_Metrics->Record(std::chrono::steady_clock::now() - start, false, true);
+      return true;
+    }
+
+    auto& pool = GetServletObjectPool();
+    if (IsPooled(pool.request.Data())) {
+      pool.request->Reset(m_ServletContext, server, conn);
+    } else {
+      pool.request = new HttpServletRequestPrivate(m_ServletContext, server, conn);
+    }
+
+    bool handled = true;
+    bool error = false;
+    {
+      HttpServletRequest request(pool.request.Data());
+      request.d->m_ContextPath = m_ContextPath;
+      request.d->m_ServletPath = m_ServletPath;
+      request.d->m_TempDirname = tempDirname;
+
+      // the handler is registered for the path prefix, so the uri starts
+      // with the context path followed by the servlet path
+      const char* uri = mg_req_info->local_uri;
+      const std::size_t uriSize = std::strlen(uri);
+      const std::size_t prefixSize = m_ContextPath.size() + m_ServletPath.size();
+      assert(prefixSize <= uriSize);
+      assert(m_ContextPath.compare(0, m_ContextPath.size(), uri, m_ContextPath.size()) == 0);
+      assert(m_ServletPath.compare(0, m_ServletPath.size(), uri + m_ContextPath.size(), m_ServletPath.size()) == 0);
+      if (uriSize > prefixSize) {
+        request.d->m_PathInfo.assign(uri + prefixSize, uriSize - prefixSize);
+      }
+
+      if (IsPooled(pool.response.Data())) {
+        pool.response->Reset(&request, server, conn);
+      } else {
+        pool.response = new HttpServletResponsePrivate(&request, server, conn);
+      }
+      HttpServletResponse response(pool.response.Data());
+      response.SetStatus(HttpServletResponse::SC_OK);
+
+      try {
+        m_Servlet->Service(request, response);
+      } catch (const std::exception& e) {
+        // goes to the error log of the server, if one is configured
+        mg_cry(conn,
+               "Servlet at %s failed: %s",
+               mg_req_info->local_uri,
+               e.what());
+        handled = false;
+      }
+      error = !handled || pool.response->m_StatusCode >= 500;
+    }
+
+    if (IsPooled(pool.response.Data())) {
+      // an unhandled request is answered by civetweb, so nothing must be
+      // committed for it
+      if (handled) {
+        pool.response->Finish();
+      } else {
+        pool.response->Close();
+      }
+    } else {
+      pool.response.Reset();
+    }
+    if (IsPooled(pool.request.Data())) {
+      pool.request->Release();
+    } else {
+      pool.request.Reset();
+    }
+    m_Metrics->Record(std::chrono::steady_clock::now() - start, error, false);
+    return handled;
+  }
+
   std::shared_ptr<HttpServlet> m_Servlet;
+  std::shared_ptr<ServletContext> m_ServletContext;
+  std::string m_ContextPath;
   std::string m_ServletPath;
   std::string m_TempDirname;
+  std::shared_ptr<ServletMetricsCounters> m_Metrics;
+  std::size_t m_MaxRequestBodySize;
 };
 
 //-------------------------------------------------------------------
@@ -177,28 +251,199 @@ ServletContainerPrivate::ServletContainerPrivate(BundleContext bundleCtx,
   : m_Context(std::move(bundleCtx))
   , m_Server(nullptr)
   , m_ServletTracker(m_Context, this)
+  , m_Metrics(std::make_shared<ServletMetricsService>())
   , q(q)
 {}
 
 void ServletContainerPrivate::Start()
 {
-  std::vector<std::string> options;
-  options.push_back("listening_ports");
-  options.push_back("8080");
-  options.push_back("num_threads");
-  options.push_back("50");
-  Start(options);
+  // civetweb listens on port 8080 with 50 worker threads, unless the
+  // framework properties say otherwise
+  Start(std::vector<std::string>());
+}
+
+namespace {
+
+/**
+ * How the value of a framework property is checked and passed to civetweb
+ */
+enum class OptionKind
+{
+  Text,   ///< passed as is
+  Number, ///< a non-negative integer
+  YesNo,  ///< a boolean, "yes" or "no" for civetweb
+  Flag    ///< a boolean, "1" or "0" for civetweb
+};
+
+std::invalid_argument InvalidProperty(const std::string& property,
+                                      const Any& value)
+{
+  return std::invalid_argument("Invalid value '" + value.ToString() +
+                               "' of the framework property " + property);
+}
+
+template<typename T>
+bool TryGetNumber(const Any& value, unsigned long long& number)
+{
+  if (value.Type() != typeid(T)) {
+    return false;
+  }
+  const T n = any_cast<T>(value);
+  if (n < static_cast<T>(0)) {
+    throw std::out_of_range("negative");
+  }
+  number = static_cast<unsigned long long>(n);
+  return true;
+}
+
+/**
+ * Returns the value of \c property as a non-negative integer. Integral
+ * values and strings consisting of decimal digits are accepted.
+ *
+ * \throws std::invalid_argument for any other value
+ */
+unsigned long long ToNumber(const std::string& property, const Any& value)
+{
+  unsigned long long number = 0;
+  try {
+    if (TryGetNumber<int>(value, number) ||
+        TryGetNumber<unsigned int>(value, number) ||
+        TryGetNumber<long>(value, number) ||
+        TryGetNumber<unsigned long>(value, number) ||
+        TryGetNumber<long long>(value, number) ||
+        TryGetNumber<unsigned long long>(value, number) ||
+        TryGetNumber<short>(value, number) ||
+        TryGetNumber<unsigned short>(value, number)) {
+      return number;
+    }
+    if (value.Type() == typeid(std::string)) {
+      const std::string& text = ref_any_cast<std::string>(value);
+      if (!text.empty() &&
+          text.find_first_not_of("0123456789") == std::string::npos) {
+        return std::stoull(text);
+      }
+    }
+  } catch (const std::out_of_range&) {
+  }
+  throw InvalidProperty(property, value);
+}
+
+/**
+ * Converts the value of a framework property to a civetweb option value.
+ * Boolean options of civetweb are "yes" or "no", numeric ones "1" or "0";
+ * both also accept the civetweb spelling as a string.
+ *
+ * \throws std::invalid_argument if the value does not fit \c kind
+ */
+std::string ToOptionValue(const std::string& property,
+                          const Any& value,
+                          OptionKind kind)
+{
+  switch (kind) {
+    case OptionKind::Number:
+      return std::to_string(ToNumber(property, value));
+    case OptionKind::YesNo:
+    case OptionKind::Flag: {
+      const bool isYesNo = (kind == OptionKind::YesNo);
+      if (value.Type() == typeid(bool)) {
+        const bool enabled = any_cast<bool>(value);
+        return isYesNo ? (enabled ? "yes" : "no") : (enabled ? "1" : "0");
+      }
+      const std::string text = value.ToString();
+      if ((isYesNo && (text == "yes" || text == "no")) ||
+          (!isYesNo && (text == "1" || text == "0"))) {
+        return text;
+      }
+      throw InvalidProperty(property, value);
+    }
+    case OptionKind::Text:
+      break;
+  }
+  return value.ToString();
+}
+}
+
+std::vector<std::string> ServletContainerPrivate::GetServerOptions(
+  const std::vector<std::string>& options)
+{
+  std::vector<std::string> serverOptions(options);
+  auto addOption = [&serverOptions](const char* name,
+                                    const std::string& value) {
+    for (std::size_t i = 0; i < serverOptions.size(); i += 2) {
+      if (serverOptions[i] == name) {
+        return;
+      }
+    }
+    serverOptions.push_back(name);
+    serverOptions.push_back(value);
+  };
+
+  struct PropertyOption
+  {
+    const std::string& property;
+    const char* option;
+    OptionKind kind;
+  };
+  const PropertyOption propertyOptions[] = {
+    { ServletContainer::PROP_LISTENING_PORTS,
+      "listening_ports",
+      OptionKind::Text },
+    { ServletContainer::PROP_NUM_THREADS, "num_threads", OptionKind::Number },
+    { ServletContainer::PROP_KEEP_ALIVE,
+      "enable_keep_alive",
+      OptionKind::YesNo },
+    { ServletContainer::PROP_KEEP_ALIVE_TIMEOUT_MS,
+      "keep_alive_timeout_ms",
+      OptionKind::Number },
+    { ServletContainer::PROP_REQUEST_TIMEOUT_MS,
+      "request_timeout_ms",
+      OptionKind::Number },
+    { ServletContainer::PROP_MAX_REQUEST_HEADER_SIZE,
+      "max_request_size",
+      OptionKind::Number },
+    { ServletContainer::PROP_TCP_NODELAY, "tcp_nodelay", OptionKind::Flag }
+  };
+  // every property is converted, and so validated, even if an explicit
+  // option overrides it
+  for (const auto& propertyOption : propertyOptions) {
+    Any value = m_Context.GetProperty(propertyOption.property);
+    if (!value.Empty()) {
+      addOption(
+        propertyOption.option,
+        ToOptionValue(propertyOption.property, value, propertyOption.kind));
+    }
+  }
+
+  // Keep connections alive unless configured otherwise; servlet responses
+  // are always framed, so a connection can serve further requests. A
+  // response is written in several pieces, which must not wait for the
+  // delayed acknowledgement of the previous piece on a kept-alive
+  // connection, hence Nagle's algorithm is disabled as well.
+  addOption("enable_keep_alive", "yes");
+  addOption("tcp_nodelay", "1");
+  return serverOptions;
 }
 
 void ServletContainerPrivate::Start(const std::vector<std::string>& options)
 {
+  // all properties are validated before the server starts listening
+  const std::vector<std::string> serverOptions = GetServerOptions(options);
+  const Any maxRequestBodySizeProp =
+    m_Context.GetProperty(ServletContainer::PROP_MAX_REQUEST_BODY_SIZE);
+  const std::size_t maxRequestBodySize =
+    maxRequestBodySizeProp.Empty()
+      ? 0
+      : static_cast<std::size_t>(
+          ToNumber(ServletContainer::PROP_MAX_REQUEST_BODY_SIZE,
+                   maxRequestBodySizeProp));
+
   {
     Lock l(m_Mutex);
     US_UNUSED(l);
     if (m_Server)
       return;
 
-    m_Server.reset(new CivetServer(options));
+    m_Server.reset(new CivetServer(serverOptions));
     const mg_context* serverContext = m_Server->getContext();
     if (serverContext == nullptr) {
       std::cout << "Servlet Container could not be started." << std::endl;
@@ -207,6 +452,7 @@ void ServletContainerPrivate::Start(const std::vector<std::string>& options)
     }
 
     m_TempDirname = cppmicroservices::util::MakeUniqueTempDirectory();
+    m_MaxRequestBodySize = maxRequestBodySize;
 
     std::vector<int> listenedPorts = m_Server->getListeningPorts();
     for (size_t portIndex = 0; portIndex < listenedPorts.size(); ++portIndex) {
@@ -215,12 +461,20 @@ void ServletContainerPrivate::Start(const std::vector<std::string>& options)
     }
   }
   m_ServletTracker.Open();
+  m_MetricsRegistration =
+    m_Context.RegisterService<IServletMetricsService>(m_Metrics);
   m_Started = true;
 }
 
 void ServletContainerPrivate::Stop()
 {
   if (m_Started) {
+    try {
+      m_MetricsRegistration.Unregister();
+    } catch (const std::logic_error&) {
+      // already unregistered by stopping the framework
+    }
+    m_MetricsRegistration = nullptr;
     m_ServletTracker.Close();
 
     std::unique_ptr<CivetServer> server;
@@ -277,8 +531,12 @@ std::shared_ptr<ServletHandler> ServletContainerPrivate::AddingService(
   }
   std::shared_ptr<ServletContext> servletContext(new ServletContext(q));
   servlet->Init(ServletConfigImpl(servletContext));
-  auto handler = std::make_shared<ServletHandler>(
-    servlet, contextRoot.ToString(), m_TempDirname);
+  auto handler =
+    std::make_shared<ServletHandler>(servlet,
+                                     contextRoot.ToString(),
+                                     m_TempDirname,
+                                     m_Metrics->AddServlet(contextRoot.ToString()),
+                                     m_MaxRequestBodySize);
 
   std::string ctxPath;
   {
@@ -310,6 +568,7 @@ void ServletContainerPrivate::RemovedService(
   US_UNUSED(l);
   m_Server->removeHandler(contextPath);
   m_Handler.remove(handler);
+  m_Metrics->RemoveServlet(handler->GetMetrics());
   handler->GetServlet()->Destroy();
   m_ServletContextMap.erase(contextPath);
 }
@@ -318,6 +577,23 @@ void ServletContainerPrivate::RemovedService(
 //-----------            ServletContainer          ------------------
 //-------------------------------------------------------------------
 
+const std::string ServletContainer::PROP_LISTENING_PORTS =
+  "org.cppmicroservices.httpservice.listening_ports";
+const std::string ServletContainer::PROP_NUM_THREADS =
+  "org.cppmicroservices.httpservice.num_threads";
+const std::string ServletContainer::PROP_KEEP_ALIVE =
+  "org.cppmicroservices.httpservice.keep_alive";
+const std::string ServletContainer::PROP_KEEP_ALIVE_TIMEOUT_MS =
+  "org.cppmicroservices.httpservice.keep_alive_timeout_ms";
+const std::string ServletContainer::PROP_REQUEST_TIMEOUT_MS =
+  "org.cppmicroservices.httpservice.request_timeout_ms";
+const std::string ServletContainer::PROP_MAX_REQUEST_HEADER_SIZE =
+  "org.cppmicroservices.httpservice.max_request_header_size";
+const std::string ServletContainer::PROP_MAX_REQUEST_BODY_SIZE =
+  "org.cppmicroservices.httpservice.max_request_body_size";
+const std::string ServletContainer::PROP_TCP_NODELAY =
+  "org.cppmicroservices.httpservice.tcp_nodelay";
+
 ServletContainer::ServletContainer(BundleContext bundleCtx,
                                    const std::string& contextPath)
   : d(new ServletContainerPrivate(std::move(bundleCtx), this))
@@ -369,6 +645,13 @@ void ServletContainer::Stop()
   d->Stop();
 }
 
+std::vector<int> ServletContainer::GetListeningPorts() const
+{
+  Lock l(d->m_Mutex);
+  US_UNUSED(l);
+  return d->m_Server ? d->m_Server->getListeningPorts() : std::vector<int>();
+}
+
 std::shared_ptr<ServletContext> ServletContainer::GetContext(
   const std::string& uripath) const
 {
@@ -27,6 +27,7 @@
 #include "cppmicroservices/ServiceTrackerCustomizer.h"
 
 #include "cppmicroservices/httpservice/HttpServlet.h"
+#include "cppmicroservices/httpservice/IServletMetricsService.h"
 
 #include <string>
 #include <vector>
@@ -40,6 +41,7 @@ class BundleContext;
 class ServletContainer;
 class ServletContext;
 class ServletHandler;
+class ServletMetricsService;
 
 struct ServletContainerPrivate
   : private ServiceTrackerCustomizer<HttpServlet, ServletHandler>
@@ -50,6 +52,13 @@ struct ServletContainerPrivate
   void Start();
   void Stop();
 
+  /**
+   * Adds the options given by the framework properties and the defaults of
+   * the container to \c options, unless they are set already.
+   */
+  std::vector<std::string> GetServerOptions(
+    const std::vector<std::string>& options);
+
   std::string GetMimeType(const ServletContext* context,
                           const std::string& file) const;
 
@@ -68,6 +77,14 @@ private:
    */
   std::string m_TempDirname;
 
+  /**
+   * The limit of request bodies, 0 if unlimited
+   */
+  std::size_t m_MaxRequestBodySize = 0;
+
+  std::shared_ptr<ServletMetricsService> m_Metrics;
+  ServiceRegistration<IServletMetricsService> m_MetricsRegistration;
+
   bool m_Started = false;
   ServletContainer* const q;
   std::list<std::shared_ptr<ServletHandler>> m_Handler;
@@ -0,0 +1,133 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ServletMetricsService.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace cppmicroservices {
+
+const std::array<std::int64_t, ServletMetricsCounters::NumLatencyBounds>
+  ServletMetricsCounters::LatencyBounds = {
+  { 100,
+    250,
+    500,
+    1000,
+    2500,
+    5000,
+    10000,
+    25000,
+    50000,
+    100000,
+    250000,
+    500000,
+    1000000 }
+};
+
+ServletMetricsCounters::ServletMetricsCounters(std::string contextPath)
+  : m_ContextPath(std::move(contextPath))
+  , m_RequestCount(0)
+  , m_ErrorCount(0)
+  , m_RejectedCount(0)
+  , m_TotalLatency(0)
+{
+  for (auto& count : m_LatencyCounts) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+void ServletMetricsCounters::Record(std::chrono::steady_clock::duration latency,
+                                    bool error,
+                                    bool rejected)
+{
+  const auto micros =
+    std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+  const auto bucket =
+    std::lower_bound(LatencyBounds.begin(), LatencyBounds.end(), micros) -
+    LatencyBounds.begin();
+
+  m_RequestCount.fetch_add(1, std::memory_order_relaxed);
+  if (error) {
+    m_ErrorCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (rejected) {
+    m_RejectedCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  m_TotalLatency.fetch_add(static_cast<std::uint64_t>(micros),
+                           std::memory_order_relaxed);
+  m_LatencyCounts[static_cast<std::size_t>(bucket)].fetch_add(
+    1, std::memory_order_relaxed);
+}
+
+ServletMetrics ServletMetricsCounters::GetMetrics() const
+{
+  // The counters are read one by one, so a snapshot taken while requests
+  // are served may be off by the requests in flight.
+  ServletMetrics metrics;
+  metrics.contextPath = m_ContextPath;
+  metrics.requestCount = m_RequestCount.load(std::memory_order_relaxed);
+  metrics.errorCount = m_ErrorCount.load(std::memory_order_relaxed);
+  metrics.rejectedCount = m_RejectedCount.load(std::memory_order_relaxed);
+  metrics.totalLatency = std::chrono::microseconds(
+    m_TotalLatency.load(std::memory_order_relaxed));
+  for (auto bound : LatencyBounds) {
+    metrics.latencyBounds.emplace_back(bound);
+  }
+  for (const auto& count : m_LatencyCounts) {
+    metrics.latencyCounts.push_back(count.load(std::memory_order_relaxed));
+  }
+  return metrics;
+}
+
+std::shared_ptr<ServletMetricsCounters> ServletMetricsService::AddServlet(
+  const std::string& contextPath)
+{
+  auto counters = std::make_shared<ServletMetricsCounters>(contextPath);
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Counters.push_back(counters);
+  return counters;
+}
+
+void ServletMetricsService::RemoveServlet(
+  const std::shared_ptr<ServletMetricsCounters>& counters)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Counters.erase(std::remove(m_Counters.begin(), m_Counters.end(), counters),
+                   m_Counters.end());
+}
+
+std::vector<ServletMetrics> ServletMetricsService::GetServletMetrics() const
+{
+  std::vector<std::shared_ptr<ServletMetricsCounters>> counters;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    counters = m_Counters;
+  }
+  std::vector<ServletMetrics> metrics;
+  metrics.reserve(counters.size());
+  for (const auto& servletCounters : counters) {
+    metrics.push_back(servletCounters->GetMetrics());
+  }
+  return metrics;
+}
+}
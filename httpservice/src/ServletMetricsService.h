@@ -0,0 +1,87 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_SERVLETMETRICSSERVICE_H
+#define CPPMICROSERVICES_SERVLETMETRICSSERVICE_H
+
+#include "cppmicroservices/httpservice/IServletMetricsService.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cppmicroservices {
+
+/**
+ * The counters of one servlet, updated by the worker threads without
+ * locking.
+ */
+class ServletMetricsCounters
+{
+public:
+  explicit ServletMetricsCounters(std::string contextPath);
+
+  void Record(std::chrono::steady_clock::duration latency,
+              bool error,
+              bool rejected);
+
+  ServletMetrics GetMetrics() const;
+
+private:
+  static const std::size_t NumLatencyBounds = 13;
+
+  /// upper bounds of the latency buckets in microseconds
+  static const std::array<std::int64_t, NumLatencyBounds> LatencyBounds;
+
+  const std::string m_ContextPath;
+  std::atomic<std::uint64_t> m_RequestCount;
+  std::atomic<std::uint64_t> m_ErrorCount;
+  std::atomic<std::uint64_t> m_RejectedCount;
+  std::atomic<std::uint64_t> m_TotalLatency;
+  std::array<std::atomic<std::uint64_t>, NumLatencyBounds + 1>
+    m_LatencyCounts;
+};
+
+class ServletMetricsService : public IServletMetricsService
+{
+public:
+  /**
+   * Creates the counters of a servlet registered for \c contextPath.
+   */
+  std::shared_ptr<ServletMetricsCounters> AddServlet(
+    const std::string& contextPath);
+
+  void RemoveServlet(const std::shared_ptr<ServletMetricsCounters>& counters);
+
+  std::vector<ServletMetrics> GetServletMetrics() const override;
+
+private:
+  mutable std::mutex m_Mutex;
+  std::vector<std::shared_ptr<ServletMetricsCounters>> m_Counters;
+};
+}
+
+#endif // CPPMICROSERVICES_SERVLETMETRICSSERVICE_H
@@ -0,0 +1,879 @@
+/*=============================================================================
+
+Library: CppMicroServices
+
+Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+file at the top-level directory of this distribution and at
+https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+=============================================================================*/
+
+#include "gtest/gtest.h"
+
+#include "civetweb/civetweb.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+#include "cppmicroservices/ServiceProperties.h"
+#include "cppmicroservices/httpservice/HttpServlet.h"
+#include "cppmicroservices/httpservice/IHttpServletPartReader.h"
+#include "cppmicroservices/httpservice/IServletMetricsService.h"
+#include "cppmicroservices/httpservice/ServletContainer.h"
+
+#include "cppmicroservices/util/FileSystem.h"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace us = cppmicroservices;
+
+namespace {
+
+/*!
+ * Collects the parts of a request and describes them as
+ * "name:filename:size:pieces:ended:intact;" where intact tells whether the
+ * content equals EchoServlet::StreamedBody(size).
+ */
+class PartCollector : public us::IHttpServletPartReader
+{
+public:
+  explicit PartCollector(Disposition disposition)
+    : m_Disposition(disposition)
+  {}
+
+  Disposition BeginPart(const std::string& name,
+                        const std::string& submittedFileName) override
+  {
+    m_Parts.push_back(Part{ name, submittedFileName, std::string(), 0, false });
+    return m_Disposition;
+  }
+
+  void ReadPartData(const char* data, std::size_t size) override
+  {
+    m_Parts.back().content.append(data, size);
+    ++m_Parts.back().pieces;
+  }
+
+  void EndPart() override { m_Parts.back().ended = true; }
+
+  std::string Describe(const std::function<std::string(std::size_t)>& expected) const
+  {
+    std::string description;
+    for (const auto& part : m_Parts) {
+      description += part.name + ":" + part.fileName + ":" +
+                     std::to_string(part.content.size()) + ":" +
+                     std::to_string(part.pieces) + ":" +
+                     (part.ended ? "1" : "0") + ":" +
+                     (part.content == expected(part.content.size()) ? "1"
+                                                                    : "0") +
+                     ";";
+    }
+    return description;
+  }
+
+private:
+  struct Part
+  {
+    std::string name;
+    std::string fileName;
+    std::string content;
+    std::size_t pieces;
+    bool ended;
+  };
+
+  Disposition m_Disposition;
+  std::vector<Part> m_Parts;
+};
+
+/*!
+ * Answers GET requests with the path info, the parameter "a" and whether
+ * the request attribute set by a previous request is visible. The query
+ * "empty" yields a response without body, "throw" an exception and "stream=<n>" streams n bytes
+ * of StreamedBody(n). The query "data" sends a shared buffer of
+ * StreamedBody(50000) and "file=<path>" the file at path.
+ */
+class EchoServlet : public us::HttpServlet
+{
+public:
+  static std::string StreamedBody(std::size_t size)
+  {
+    std::string body(size, ' ');
+    for (std::size_t i = 0; i < size; ++i) {
+      body[i] = static_cast<char>('a' + i % 26);
+    }
+    return body;
+  }
+
+  void DoGet(us::IHttpServletRequest& request,
+             us::IHttpServletResponse& response) override
+  {
+    if (!request.GetParameter("empty").Empty()) {
+      return;
+    }
+    if (!request.GetParameter("throw").Empty()) {
+      throw std::runtime_error("requested failure");
+    }
+    if (!request.GetParameter("data").Empty()) {
+      static const auto data =
+        std::make_shared<const std::string>(StreamedBody(50000));
+      response.SendData(data);
+      return;
+    }
+    us::Any file = request.GetParameter("file");
+    if (!file.Empty()) {
+      response.SendFile(file.ToString());
+      return;
+    }
+    us::Any stream = request.GetParameter("stream");
+    if (!stream.Empty()) {
+      const std::string body = StreamedBody(std::stoul(stream.ToString()));
+      auto& out = response.GetOutputStream();
+      // flushing twice must not send an empty chunk, which would end the body
+      out << std::flush << std::flush;
+      for (std::size_t pos = 0; pos < body.size(); pos += 100) {
+        out << body.substr(pos, 100);
+      }
+      out << std::flush;
+      return;
+    }
+    std::string body = "pathInfo=" + request.GetPathInfo() + ";a=";
+    us::Any a = request.GetParameter("a");
+    if (!a.Empty()) {
+      body += a.ToString();
+    }
+    body += ";seen=";
+    body += request.GetAttribute("seen").Empty() ? "0" : "1";
+    request.SetAttribute("seen", true);
+
+    response.SetContentType("text/plain");
+    response.SetContentLength(body.size());
+    response.GetOutputStream() << body;
+  }
+
+  /*!
+   * Reads the parts of a form with a PartCollector and answers with their
+   * description. The query "store" stages the parts in temporary files and
+   * describes them through GetParts(), "maxPart=<n>", "maxCount=<n>" and
+   * "maxRequest=<n>" set the limits. A limit violation is answered with 413.
+   * The query "staged" uses the default implementation of ReadParts, which
+   * stages the parts before passing them on.
+   */
+  void DoPost(us::IHttpServletRequest& request,
+              us::IHttpServletResponse& response) override
+  {
+    if (request.GetContentType().find("multipart") == std::string::npos) {
+      response.SetContentLength(0);
+      return;
+    }
+    const bool store = !request.GetParameter("store").Empty();
+    PartCollector collector(store ? PartCollector::Disposition::Store
+                                  : PartCollector::Disposition::Stream);
+    us::HttpServletPartLimits limits;
+    us::Any maxPart = request.GetParameter("maxPart");
+    if (!maxPart.Empty()) {
+      limits.maxPartSize = std::stoul(maxPart.ToString());
+    }
+    us::Any maxCount = request.GetParameter("maxCount");
+    if (!maxCount.Empty()) {
+      limits.maxPartCount = std::stoul(maxCount.ToString());
+    }
+    us::Any maxRequest = request.GetParameter("maxRequest");
+    if (!maxRequest.Empty()) {
+      limits.maxRequestSize = std::stoul(maxRequest.ToString());
+    }
+
+    std::string body;
+    try {
+      if (request.GetParameter("staged").Empty()) {
+        request.ReadParts(collector, limits);
+      } else {
+        request.IHttpServletRequest::ReadParts(collector, limits);
+      }
+    } catch (const std::length_error&) {
+      response.SetStatus(413);
+    }
+    if (store) {
+      for (auto part : request.GetParts()) {
+        std::unique_ptr<std::istream> in(part->GetInputStream());
+        const std::string content{ std::istreambuf_iterator<char>(*in),
+                                   std::istreambuf_iterator<char>() };
+        body += part->GetName() + "=" + std::to_string(part->GetSize()) +
+                ":" + (content == StreamedBody(content.size()) ? "1" : "0") +
+                ";";
+      }
+    } else {
+      body = collector.Describe(&StreamedBody);
+    }
+    response.SetContentType("text/plain");
+    response.SetContentLength(body.size());
+    response.GetOutputStream() << body;
+  }
+};
+
+/*!
+ * Runs a servlet container with an EchoServlet at "/echo"
+ */
+class ServletContainerTest : public ::testing::Test
+{
+protected:
+  void StartContainer()
+  {
+    StartContainer(us::FrameworkConfiguration(), true);
+  }
+
+  /*!
+   * Starts the container with the framework properties \c config, passing
+   * an ephemeral port and the thread count as options if \c useOptions is
+   * set, and remembers the port the server got bound to.
+   */
+  void StartContainer(const us::FrameworkConfiguration& config,
+                      bool useOptions)
+  {
+    m_Framework = std::make_shared<us::Framework>(
+      us::FrameworkFactory().NewFramework(config));
+    m_Framework->Start();
+    auto context = m_Framework->GetBundleContext();
+
+    us::ServiceProperties props;
+    props[us::HttpServlet::PROP_CONTEXT_ROOT] = std::string("/echo");
+    m_Registration = context.RegisterService<us::HttpServlet>(
+      std::make_shared<EchoServlet>(), props);
+
+    m_Container.reset(new us::ServletContainer(context));
+    if (useOptions) {
+      m_Container->Start({ "listening_ports", "0", "num_threads", "1" });
+    } else {
+      m_Container->Start();
+    }
+    auto ports = m_Container->GetListeningPorts();
+    ASSERT_EQ(1u, ports.size());
+    m_Port = ports.front();
+  }
+
+  void TearDown() override
+  {
+    if (m_Registration) {
+      m_Registration.Unregister();
+    }
+    if (m_Container) {
+      m_Container->Stop();
+      m_Container.reset();
+    }
+    if (m_Framework) {
+      m_Framework->Stop();
+      m_Framework->WaitForStop(std::chrono::milliseconds(500));
+    }
+  }
+
+  int m_Port = 0;
+  std::shared_ptr<us::Framework> m_Framework;
+  std::unique_ptr<us::ServletContainer> m_Container;
+  us::ServiceRegistration<us::HttpServlet> m_Registration;
+};
+
+/*!
+ * A client connection to the loopback interface, which sends several
+ * requests on the same connection.
+ */
+class LoopbackClient
+{
+public:
+  explicit LoopbackClient(int port)
+  {
+    char error[256] = { 0 };
+    m_Connection =
+      mg_connect_client("127.0.0.1", port, 0, error, sizeof(error));
+  }
+
+  ~LoopbackClient()
+  {
+    if (m_Connection) {
+      mg_close_connection(m_Connection);
+    }
+  }
+
+  bool IsConnected() const { return m_Connection != nullptr; }
+
+  /*!
+   * Sends a GET request and reads the complete response body. Returns
+   * the status code, or -1 if no response was received.
+   */
+  int Get(const std::string& uri,
+          std::string& body,
+          const std::string& headers = std::string())
+  {
+    std::string request = "GET " + uri +
+                          " HTTP/1.1\r\n"
+                          "Host: 127.0.0.1\r\n"
+                          "Connection: keep-alive\r\n" +
+                          headers + "\r\n";
+    if (mg_write(m_Connection, request.data(), request.size()) <= 0) {
+      return -1;
+    }
+    return ReadResponse(body);
+  }
+
+  /*!
+   * Sends a HEAD request and reads the response headers. Returns the
+   * status code, or -1 if no response was received.
+   */
+  int Head(const std::string& uri, const std::string& headers = std::string())
+  {
+    std::string request = "HEAD " + uri +
+                          " HTTP/1.1\r\n"
+                          "Host: 127.0.0.1\r\n"
+                          "Connection: keep-alive\r\n" +
+                          headers + "\r\n";
+    if (mg_write(m_Connection, request.data(), request.size()) <= 0) {
+      return -1;
+    }
+    char error[256] = { 0 };
+    if (mg_get_response(m_Connection, error, sizeof(error), 5000) < 0) {
+      return -1;
+    }
+    return mg_get_response_info(m_Connection)->status_code;
+  }
+
+  /*!
+   * Reads the response to the last request. Returns the status code, or
+   * -1 if no response was received.
+   */
+  int ReadResponse(std::string& body)
+  {
+    char error[256] = { 0 };
+    if (mg_get_response(m_Connection, error, sizeof(error), 5000) < 0) {
+      return -1;
+    }
+    body.clear();
+    const int status = mg_get_response_info(m_Connection)->status_code;
+    if (status == 304) {
+      // a 304 response never has a body
+      return status;
+    }
+    char buf[256];
+    int n = 0;
+    while ((n = mg_read(m_Connection, buf, sizeof(buf))) > 0) {
+      body.append(buf, static_cast<std::size_t>(n));
+    }
+    return status;
+  }
+
+  /*!
+   * Sends a POST request with a plain \c content body.
+   */
+  int Post(const std::string& uri, const std::string& content, std::string& body)
+  {
+    std::string request = "POST " + uri +
+                          " HTTP/1.1\r\n"
+                          "Host: 127.0.0.1\r\n"
+                          "Connection: keep-alive\r\n"
+                          "Content-Type: text/plain\r\n"
+                          "Content-Length: " +
+                          std::to_string(content.size()) + "\r\n\r\n" +
+                          content;
+    if (mg_write(m_Connection, request.data(), request.size()) <= 0) {
+      return -1;
+    }
+    return ReadResponse(body);
+  }
+
+  /*!
+   * Sends a multipart/form-data POST request with one part per entry of
+   * \c parts, each being a (name, filename, content) triple. A \c chunked
+   * body is sent in chunks of 4 KiB without a Content-Length.
+   */
+  int PostForm(
+    const std::string& uri,
+    const std::vector<std::array<std::string, 3>>& parts,
+    std::string& body,
+    bool chunked = false)
+  {
+    const std::string boundary = "--------PartBoundary7MA4YWxkTrZu0gW";
+    std::string form;
+    for (const auto& part : parts) {
+      form += "--" + boundary +
+              "\r\nContent-Disposition: form-data; name=\"" + part[0] + "\"";
+      if (!part[1].empty()) {
+        form += "; filename=\"" + part[1] +
+                "\"\r\nContent-Type: application/octet-stream";
+      }
+      form += "\r\n\r\n" + part[2] + "\r\n";
+    }
+    form += "--" + boundary + "--\r\n";
+
+    std::string request = "POST " + uri +
+                          " HTTP/1.1\r\n"
+                          "Host: 127.0.0.1\r\n"
+                          "Connection: keep-alive\r\n"
+                          "Content-Type: multipart/form-data; boundary=" +
+                          boundary + "\r\n";
+    if (chunked) {
+      request += "Transfer-Encoding: chunked\r\n\r\n";
+      for (std::size_t pos = 0; pos < form.size(); pos += 4096) {
+        const std::string chunk = form.substr(pos, 4096);
+        std::ostringstream size;
+        size << std::hex << chunk.size();
+        request += size.str() + "\r\n" + chunk + "\r\n";
+      }
+      request += "0\r\n\r\n";
+    } else {
+      request += "Content-Length: " + std::to_string(form.size()) +
+                 "\r\n\r\n" + form;
+    }
+    if (mg_write(m_Connection, request.data(), request.size()) <= 0) {
+      return -1;
+    }
+    return ReadResponse(body);
+  }
+
+  long long GetContentLength() const
+  {
+    return mg_get_response_info(m_Connection)->content_length;
+  }
+
+  std::string GetHeader(const std::string& name) const
+  {
+    auto info = mg_get_response_info(m_Connection);
+    for (int i = 0; i < info->num_headers; ++i) {
+      if (name == info->http_headers[i].name) {
+        return info->http_headers[i].value;
+      }
+    }
+    return std::string();
+  }
+
+private:
+  mg_connection* m_Connection = nullptr;
+};
+}
+
+TEST_F(ServletContainerTest, KeepAlive_requests_share_connection)
+{
+  StartContainer();
+  LoopbackClient client(m_Port);
+  ASSERT_TRUE(client.IsConnected());
+
+  std::string body;
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(200, client.Get("/echo/item?a=" + std::to_string(i), body))
+      << "Request " << i << " must be served on the same connection";
+    ASSERT_EQ("pathInfo=/item;a=" + std::to_string(i) + ";seen=0", body);
+  }
+}
+
+TEST_F(ServletContainerTest, KeepAlive_reused_request_has_no_stale_state)
+{
+  StartContainer();
+  LoopbackClient client(m_Port);
+  ASSERT_TRUE(client.IsConnected());
+
+  std::string body;
+  ASSERT_EQ(200, client.Get("/echo/first/path?a=1", body));
+  ASSERT_EQ("pathInfo=/first/path;a=1;seen=0", body);
+
+  // the attribute, parameter and path info of the first request
+  // must not be visible in the second one
+  ASSERT_EQ(200, client.Get("/echo", body));
+  ASSERT_EQ("pathInfo=;a=;seen=0", body);
+}
+
+TEST_F(ServletContainerTest, KeepAlive_response_without_body)
+{
+  StartContainer();
+  LoopbackClient client(m_Port);
+  ASSERT_TRUE(client.IsConnected());
+
+  std::string body;
+  ASSERT_EQ(200, client.Get("/echo?empty=1", body));
+  ASSERT_TRUE(body.empty());
+  ASSERT_EQ(0, client.GetContentLength());
+  ASSERT_EQ(200, client.Get("/echo?a=2", body))
+    << "A response without body must not close the connection";
+  ASSERT_EQ("pathInfo=;a=2;seen=0", body);
+}
+
+TEST_F(ServletContainerTest, KeepAlive_streamed_response)
+{
+  StartContainer();
+  LoopbackClient client(m_Port);
+  ASSERT_TRUE(client.IsConnected());
+
+  // the buffer grows while the response is written, so the body is sent
+  // in chunks of different sizes
+  std::string body;
+  for (std::size_t size : { 10, 1000, 300000 }) {
+    ASSERT_EQ(200, client.Get("/echo?stream=" + std::to_string(size), body));
+    ASSERT_EQ(EchoServlet::StreamedBody(size), body)
+      << "The chunked body of " << size << " bytes must be received intact";
+  }
+  ASSERT_EQ(200, client.Get("/echo?a=3", body))
+    << "The connection must be usable after a chunked response";
+  ASSERT_EQ("pathInfo=;a=3;seen=0", body);
+}
+
+TEST_F(ServletContainerTest, SendData_conditional_and_range_requests)
+{
+  StartContainer();
+  LoopbackClient client(m_Port);
+  ASSERT_TRUE(client.IsConnected());
+  const std::string data = EchoServlet::StreamedBody(50000);
+
+  std::string body;
+  ASSERT_EQ(200, client.Get("/echo?data=1", body));
+  ASSERT_EQ(data, body);
+  ASSERT_EQ("bytes", client.GetHeader("Accept-Ranges"));
+  const std::string etag = client.GetHeader("ETag");
+  ASSERT_FALSE(etag.empty());
+
+  ASSERT_EQ(304, client.Get("/echo?data=1", body, "If-None-Match: " + etag + "\r\n"));
+  ASSERT_TRUE(body.empty());
+
+  ASSERT_EQ(206, client.Get("/echo?data=1", body, "Range: bytes=10-19\r\n"));
+  ASSERT_EQ(data.substr(10, 10), body);
+  ASSERT_EQ("bytes 10-19/50000", client.GetHeader("Content-Range"));
+
+  ASSERT_EQ(206, client.Get("/echo?data=1", body, "Range: bytes=-5\r\n"));
+  ASSERT_EQ(data.substr(49995), body);
+
+  ASSERT_EQ(206, client.Get("/echo?data=1", body, "Range: bytes=20000-\r\n"));
+  ASSERT_EQ(data.substr(20000), body);
+
+  // a range for an outdated representation yields the full body
+  ASSERT_EQ(200,
+            client.Get("/echo?data=1",
+                       body,
+                       "Range: bytes=0-9\r\nIf-Range: \"outdated\"\r\n"));
+  ASSERT_EQ(data, body);
+
+  ASSERT_EQ(416, client.Get("/echo?data=1", body, "Range: bytes=50000-\r\n"));
+  ASSERT_EQ("bytes */50000", client.GetHeader("Content-Range"));
+
+  ASSERT_EQ(200, client.Get("/echo?a=4", body))
+    << "The connection must be usable after sending data";
+}
+
+TEST_F(ServletContainerTest, SendFile_full_and_range)
+{
+  StartContainer();
+  LoopbackClient client(m_Port);
+  ASSERT_TRUE(client.IsConnected());
+
+  const std::string data = EchoServlet::StreamedBody(100000);
+  const std::string dir = us::util::MakeUniqueTempDirectory();
+  const std::string path = dir + us::util::DIR_SEP + "data.txt";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << data;
+  }
+
+  std::string body;
+  ASSERT_EQ(200, client.Get("/echo?file=" + path, body));
+  ASSERT_EQ(data, body);
+  ASSERT_FALSE(client.GetHeader("ETag").empty());
+  ASSERT_FALSE(client.GetHeader("Last-Modified").empty());
+
+  ASSERT_EQ(206, client.Get("/echo?file=" + path, body, "Range: bytes=1000-70999\r\n"));
+  ASSERT_EQ(data.substr(1000, 70000), body);
+
+  ASSERT_EQ(200, client.Get("/echo?a=5", body))
+    << "The connection must be usable after sending a file";
+
+  us::util::RemoveDirectoryRecursive(dir);
+}
+
+TEST_F(ServletContainerTest, Send_methods_omit_the_body_for_HEAD_requests)
+{
+  StartContainer();
+  LoopbackClient client(m_Port);
+  ASSERT_TRUE(client.IsConnected());
+
+  const std::string data = EchoServlet::StreamedBody(100000);
+  const std::string dir = us::util::MakeUniqueTempDirectory();
+  const std::string path = dir + us::util::DIR_SEP + "data.txt";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << data;
+  }
+
+  // a body sent for a HEAD request would be read as the next response
+  std::string body;
+  ASSERT_EQ(200, client.Head("/echo?data=1"));
+  ASSERT_EQ("50000", client.GetHeader("Content-Length"));
+  ASSERT_EQ(200, client.Get("/echo?a=8", body));
+  ASSERT_EQ("pathInfo=;a=8;seen=0", body);
+
+  ASSERT_EQ(200, client.Head("/echo?file=" + path));
+  ASSERT_EQ("100000", client.GetHeader("Content-Length"));
+  ASSERT_FALSE(client.GetHeader("ETag").empty());
+  ASSERT_EQ(200, client.Get("/echo?a=9", body));
+  ASSERT_EQ("pathInfo=;a=9;seen=0", body);
+
+  ASSERT_EQ(206, client.Head("/echo?file=" + path, "Range: bytes=1000-70999\r\n"));
+  ASSERT_EQ("70000", client.GetHeader("Content-Length"));
+  ASSERT_EQ(200, client.Get("/echo?a=10", body))
+    << "The connection must be usable after a HEAD request";
+  ASSERT_EQ("pathInfo=;a=10;seen=0", body);
+
+  us::util::RemoveDirectoryRecursive(dir);
+}
+
+TEST_F(ServletContainerTest, ReadParts_streams_parts_as_they_arrive)
+{
+  StartContainer();
+  LoopbackClient client(m_Port);
+  ASSERT_TRUE(client.IsConnected());
+
+  const std::string small = EchoServlet::StreamedBody(5);
+  const std::string large = EchoServlet::StreamedBody(300000);
+  std::string body;
+  ASSERT_EQ(200,
+            client.PostForm("/echo",
+                            { { "a", "", small }, { "f", "up.bin", large } },
+                            body));
+  const std::string prefix = "a::5:1:1:1;f:up.bin:300000:";
+  ASSERT_EQ(prefix, body.substr(0, prefix.size()));
+  ASSERT_EQ(":1:1;", body.substr(body.size() - 5))
+    << "The large part must be ended and intact: " << body;
+  ASSERT_GT(std::stoul(body.substr(prefix.size())), 1u)
+    << "The large part must arrive in several pieces";
+
+  // staging in temporary files is still available
+  ASSERT_EQ(200,
+            client.PostForm("/echo?store=1",
+                            { { "a", "", small }, { "f", "up.bin", large } },
+                            body));
+  ASSERT_EQ("a=5:1;f=300000:1;", body);
+
+  ASSERT_EQ(200, client.Get("/echo?a=6", body))
+    << "The connection must be usable after reading parts";
+}
+
+TEST_F(ServletContainerTest, ReadParts_default_implementation_passes_staged_parts)
+{
+  StartContainer();
+  LoopbackClient client(m_Port);
+  ASSERT_TRUE(client.IsConnected());
+
+  const std::string small = EchoServlet::StreamedBody(5);
+  const std::string large = EchoServlet::StreamedBody(300000);
+  std::string body;
+  ASSERT_EQ(200,
+            client.PostForm("/echo?staged=1",
+                            { { "a", "", small }, { "f", "up.bin", large } },
+                            body));
+  const std::string prefix = "a::5:1:1:1;f:up.bin:300000:";
+  ASSERT_EQ(prefix, body.substr(0, prefix.size()));
+  ASSERT_EQ(":1:1;", body.substr(body.size() - 5))
+    << "The large part must be ended and intact: " << body;
+
+  ASSERT_EQ(413,
+            client.PostForm("/echo?staged=1&maxPart=1000",
+                            { { "a", "", small }, { "f", "up.bin", large } },
+                            body));
+  ASSERT_EQ(413,
+            client.PostForm("/echo?staged=1&maxCount=1",
+                            { { "a", "", small }, { "f", "up.bin", large } },
+                            body));
+}
+
+TEST_F(ServletContainerTest, ReadParts_enforces_limits)
+{
+  StartContainer();
+  LoopbackClient client(m_Port);
+  ASSERT_TRUE(client.IsConnected());
+
+  const std::string small = EchoServlet::StreamedBody(5);
+  const std::string large = EchoServlet::StreamedBody(300000);
+  std::string body;
+  ASSERT_EQ(413,
+            client.PostForm("/echo?maxPart=1000",
+                            { { "a", "", small },
+                              { "f", "up.bin", large },
+                              { "b", "", small } },
+                            body));
+  ASSERT_EQ("a::5:1:1:1;f:up.bin:",
+            body.substr(0, std::string("a::5:1:1:1;f:up.bin:").size()));
+  ASSERT_EQ(":0:1;", body.substr(body.size() - 5))
+    << "The oversized part must be cut off without being ended, and no "
+       "later part read: "
+    << body;
+  ASSERT_LE(std::stoul(body.substr(std::string("a::5:1:1:1;f:up.bin:").size())),
+            1000u);
+
+  ASSERT_EQ(413,
+            client.PostForm("/echo?maxCount=1",
+                            { { "a", "", small }, { "b", "", small } },
+                            body));
+  ASSERT_EQ("a::5:1:1:1;", body);
+
+  ASSERT_EQ(413,
+            client.PostForm("/echo?store=1&maxPart=1000",
+                            { { "f", "up.bin", large } },
+                            body));
+  ASSERT_EQ("", body) << "An oversized stored part must be discarded";
+
+  ASSERT_EQ(200, client.Get("/echo?a=7", body))
+    << "The connection must be usable after a rejected request";
+}
+
+TEST_F(ServletContainerTest, ReadParts_enforces_limits_on_chunked_requests)
+{
+  StartContainer();
+  LoopbackClient client(m_Port);
+  ASSERT_TRUE(client.IsConnected());
+
+  // Without a Content-Length the limits can only be enforced while the
+  // parts are read, before an oversized part is written to disk.
+  const std::string small = EchoServlet::StreamedBody(5);
+  const std::string large = EchoServlet::StreamedBody(300000);
+  std::string body;
+  ASSERT_EQ(413,
+            client.PostForm("/echo?store=1&maxPart=1000",
+                            { { "a", "", small },
+                              { "f", "up.bin", large },
+                              { "b", "", small } },
+                            body,
+                            true));
+  ASSERT_EQ("a=5:1;", body)
+    << "The oversized stored part must be discarded and no later part read";
+
+  ASSERT_EQ(413,
+            client.PostForm("/echo?store=1&maxRequest=1000",
+                            { { "a", "", small }, { "f", "up.bin", large } },
+                            body,
+                            true));
+  ASSERT_EQ("a=5:1;", body)
+    << "A request above the limit must be cut off at the offending part";
+
+  ASSERT_EQ(200,
+            client.PostForm("/echo?store=1&maxPart=1000",
+                            { { "a", "", small }, { "b", "", small } },
+                            body,
+                            true));
+  ASSERT_EQ("a=5:1;b=5:1;", body);
+}
+
+TEST_F(ServletContainerTest, Configuration_from_framework_properties)
+{
+  us::FrameworkConfiguration config;
+  config[us::ServletContainer::PROP_LISTENING_PORTS] = std::string("0");
+  config[us::ServletContainer::PROP_NUM_THREADS] = 2;
+  config[us::ServletContainer::PROP_MAX_REQUEST_BODY_SIZE] = 100;
+  StartContainer(config, false);
+
+  std::string body;
+  {
+    LoopbackClient client(m_Port);
+    ASSERT_TRUE(client.IsConnected())
+      << "The container must listen on the port of the framework property";
+    ASSERT_EQ(200, client.Post("/echo", std::string(100, 'x'), body));
+    ASSERT_EQ(413, client.Post("/echo", std::string(101, 'x'), body))
+      << "A body above the configured limit must be rejected";
+  }
+}
+
+TEST_F(ServletContainerTest, Invalid_framework_properties)
+{
+  const std::vector<std::pair<std::string, us::Any>> invalidProperties = {
+    { us::ServletContainer::PROP_MAX_REQUEST_BODY_SIZE, std::string("1k") },
+    { us::ServletContainer::PROP_MAX_REQUEST_BODY_SIZE, -1 },
+    { us::ServletContainer::PROP_NUM_THREADS, std::string("two") },
+    { us::ServletContainer::PROP_REQUEST_TIMEOUT_MS, std::string("-5") },
+    { us::ServletContainer::PROP_KEEP_ALIVE, std::string("maybe") },
+    { us::ServletContainer::PROP_TCP_NODELAY, std::string("yes") }
+  };
+  for (const auto& property : invalidProperties) {
+    us::FrameworkConfiguration config;
+    config[us::ServletContainer::PROP_LISTENING_PORTS] = std::string("0");
+    config[property.first] = property.second;
+    us::Framework framework = us::FrameworkFactory().NewFramework(config);
+    framework.Start();
+    us::ServletContainer container(framework.GetBundleContext());
+    ASSERT_THROW(container.Start(), std::invalid_argument)
+      << property.first << "=" << property.second.ToString();
+    ASSERT_TRUE(container.GetListeningPorts().empty())
+      << "The server must not start with an invalid property";
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds(500));
+  }
+
+  // numbers may be given as strings, booleans in the civetweb spelling
+  us::FrameworkConfiguration config;
+  config[us::ServletContainer::PROP_MAX_REQUEST_BODY_SIZE] = std::string("10");
+  config[us::ServletContainer::PROP_KEEP_ALIVE] = std::string("yes");
+  config[us::ServletContainer::PROP_TCP_NODELAY] = std::string("1");
+  StartContainer(config, true);
+
+  LoopbackClient client(m_Port);
+  std::string body;
+  ASSERT_EQ(413, client.Post("/echo", std::string(11, 'x'), body));
+}
+
+TEST_F(ServletContainerTest, Metrics_per_servlet_context)
+{
+  us::FrameworkConfiguration config;
+  config[us::ServletContainer::PROP_MAX_REQUEST_BODY_SIZE] = 10;
+  StartContainer(config, true);
+
+  std::string body;
+  {
+    LoopbackClient client(m_Port);
+    ASSERT_TRUE(client.IsConnected());
+    for (int i = 0; i < 3; ++i) {
+      ASSERT_EQ(200, client.Get("/echo?a=1", body));
+    }
+  }
+  {
+    LoopbackClient client(m_Port);
+    // a failed servlet leaves the request unhandled, civetweb answers it
+    ASSERT_EQ(404, client.Get("/echo?throw=1", body));
+  }
+  {
+    LoopbackClient client(m_Port);
+    ASSERT_EQ(413, client.Post("/echo", std::string(11, 'x'), body));
+  }
+
+  auto context = m_Framework->GetBundleContext();
+  auto ref = context.GetServiceReference<us::IServletMetricsService>();
+  ASSERT_TRUE(ref) << "The started container must register its metrics";
+  auto metrics = context.GetService(ref)->GetServletMetrics();
+  ASSERT_EQ(1u, metrics.size());
+  ASSERT_EQ("/echo", metrics[0].contextPath);
+  ASSERT_EQ(5u, metrics[0].requestCount);
+  ASSERT_EQ(1u, metrics[0].errorCount);
+  ASSERT_EQ(1u, metrics[0].rejectedCount);
+  ASSERT_EQ(metrics[0].latencyBounds.size() + 1,
+            metrics[0].latencyCounts.size());
+  std::uint64_t histogramCount = 0;
+  for (auto count : metrics[0].latencyCounts) {
+    histogramCount += count;
+  }
+  ASSERT_EQ(metrics[0].requestCount, histogramCount);
+
+  m_Container->Stop();
+  ASSERT_FALSE(context.GetServiceReference<us::IServletMetricsService>())
+    << "A stopped container must unregister its metrics";
+}
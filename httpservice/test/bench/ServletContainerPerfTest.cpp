@@ -0,0 +1,213 @@
+/*=============================================================================
+
+Library: CppMicroServices
+
+Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+file at the top-level directory of this distribution and at
+https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+=============================================================================*/
+
+#include "benchmark/benchmark.h"
+
+#include "civetweb/civetweb.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+#include "cppmicroservices/ServiceProperties.h"
+#include "cppmicroservices/httpservice/HttpServlet.h"
+#include "cppmicroservices/httpservice/ServletContainer.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace us = cppmicroservices;
+
+namespace {
+
+const std::string Request = "GET /bench/item?id=42 HTTP/1.1\r\n"
+                            "Host: 127.0.0.1\r\n"
+                            "Connection: keep-alive\r\n"
+                            "\r\n";
+
+/// Answers GET requests with a short fixed body. The path info "/stream"
+/// streams a body of the size given by the "size" parameter instead, in
+/// pieces and without a Content-Length.
+class BenchServlet : public us::HttpServlet
+{
+public:
+  void DoGet(us::IHttpServletRequest& request,
+             us::IHttpServletResponse& response) override
+  {
+    response.SetContentType("text/plain");
+    if (request.GetPathInfo() == "/stream") {
+      static const std::string piece(256, 'x');
+      auto size = std::stoul(request.GetParameter("size").ToString());
+      auto& out = response.GetOutputStream();
+      for (; size >= piece.size(); size -= piece.size()) {
+        out.write(piece.data(), piece.size());
+      }
+      out.write(piece.data(), size);
+      return;
+    }
+    static const std::string body = "hello from the benchmark servlet";
+    response.SetContentLength(body.size());
+    response.GetOutputStream() << body;
+  }
+};
+
+/// A framework with a servlet container serving a BenchServlet at "/bench"
+/// on an ephemeral loopback port. It is shared by all benchmarks and threads.
+class ServerEnvironment
+{
+public:
+  ServerEnvironment()
+    : m_Framework(us::FrameworkFactory().NewFramework())
+  {
+    m_Framework.Start();
+    auto context = m_Framework.GetBundleContext();
+    us::ServiceProperties props;
+    props[us::HttpServlet::PROP_CONTEXT_ROOT] = std::string("/bench");
+    m_Registration = context.RegisterService<us::HttpServlet>(
+      std::make_shared<BenchServlet>(), props);
+    m_Container.reset(new us::ServletContainer(context));
+    m_Container->Start({ "listening_ports", "0", "num_threads", "16" });
+    auto ports = m_Container->GetListeningPorts();
+    m_Port = ports.empty() ? 0 : ports.front();
+  }
+
+  ~ServerEnvironment()
+  {
+    m_Registration.Unregister();
+    m_Container->Stop();
+    m_Container.reset();
+    m_Framework.Stop();
+    m_Framework.WaitForStop(std::chrono::milliseconds(500));
+  }
+
+  int GetPort() const { return m_Port; }
+
+private:
+  us::Framework m_Framework;
+  us::ServiceRegistration<us::HttpServlet> m_Registration;
+  std::unique_ptr<us::ServletContainer> m_Container;
+  int m_Port = 0;
+};
+
+ServerEnvironment& EnsureServer()
+{
+  static ServerEnvironment server;
+  return server;
+}
+
+mg_connection* Connect()
+{
+  char error[256] = { 0 };
+  return mg_connect_client(
+    "127.0.0.1", EnsureServer().GetPort(), 0, error, sizeof(error));
+}
+
+/// Sends the request and reads the complete response
+bool RoundTrip(mg_connection* conn, const std::string& request = Request)
+{
+  if (mg_write(conn, request.data(), request.size()) <= 0) {
+    return false;
+  }
+  char error[256] = { 0 };
+  if (mg_get_response(conn, error, sizeof(error), 5000) < 0) {
+    return false;
+  }
+  char buf[16 * 1024];
+  while (mg_read(conn, buf, sizeof(buf)) > 0) {
+  }
+  return mg_get_response_info(conn)->status_code == 200;
+}
+
+} // namespace
+
+/// Benchmark GET requests sent one after another on a kept-alive connection
+/// per client thread. This measures the per-request cost of the servlet
+/// container without connection setup.
+static void ServletGetKeepAlive(benchmark::State& state)
+{
+  EnsureServer();
+  mg_connection* conn = Connect();
+  if (conn == nullptr) {
+    state.SkipWithError("Cannot connect to the servlet container");
+    return;
+  }
+  for (auto _ : state) {
+    if (!RoundTrip(conn)) {
+      state.SkipWithError("Request failed");
+      break;
+    }
+  }
+  mg_close_connection(conn);
+  state.SetItemsProcessed(state.iterations());
+}
+
+/// Benchmark GET requests which each open a new connection, for comparison
+/// with ServletGetKeepAlive
+static void ServletGetNewConnection(benchmark::State& state)
+{
+  EnsureServer();
+  for (auto _ : state) {
+    mg_connection* conn = Connect();
+    if (conn == nullptr || !RoundTrip(conn)) {
+      if (conn) {
+        mg_close_connection(conn);
+      }
+      state.SkipWithError("Request failed");
+      break;
+    }
+    mg_close_connection(conn);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(ServletGetKeepAlive)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(ServletGetNewConnection)->ThreadRange(1, 8)->UseRealTime();
+
+/// Benchmark streamed responses of state.range(0) bytes, which the servlet
+/// writes in 256 byte pieces and which are sent with the chunked transfer
+/// coding, on a kept-alive connection
+static void ServletStreamResponse(benchmark::State& state)
+{
+  EnsureServer();
+  mg_connection* conn = Connect();
+  if (conn == nullptr) {
+    state.SkipWithError("Cannot connect to the servlet container");
+    return;
+  }
+  const std::string request = "GET /bench/stream?size=" +
+                              std::to_string(state.range(0)) +
+                              " HTTP/1.1\r\n"
+                              "Host: 127.0.0.1\r\n"
+                              "Connection: keep-alive\r\n"
+                              "\r\n";
+  for (auto _ : state) {
+    if (!RoundTrip(conn, request)) {
+      state.SkipWithError("Request failed");
+      break;
+    }
+  }
+  mg_close_connection(conn);
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(ServletStreamResponse)->Arg(1024)->Arg(1024 * 1024)->UseRealTime();
@@ -323,19 +323,13 @@ bool AbstractWebConsolePlugin::SpoolResource(
       response.SetStatus(IHttpServletResponse::SC_NOT_MODIFIED);
       return true;
     }
-    // have to send, so set the last modified header now
-    response.SetDateHeader("Last-Modified", lastModified);
   }
 
-  cppmicroservices::BundleResourceStream resStream(res, std::ios::binary);
-
-  // describe the contents
+  // describe the contents and send them, the response sets the
+  // Last-Modified, ETag and Content-Length headers and answers range and
+  // ETag validation requests
   response.SetContentType(GetServletContext()->GetMimeType(pi));
-  int size = res.GetSize();
-  response.SetIntHeader("Content-Length", size);
-
-  // spool the actual contents
-  response.GetOutputStream() << resStream.rdbuf();
+  response.SendResource(res);
 
   return true;
 }
@@ -36,6 +36,7 @@
 #include "cppmicroservices/Constants.h"
 
 #include <cmath>
+#include <sstream>
 
 namespace cppmicroservices {
 
@@ -94,8 +95,14 @@ std::string SizeTag(const std::pair<std::size_t, std::size_t>& p)
 
 BundlesPlugin::BundlesPlugin()
   : SimpleWebConsolePlugin("bundles", "Bundles", "")
+  , m_Json([this] { return GetBundlesJson(); })
 {}
 
+void BundlesPlugin::InvalidateJson()
+{
+  m_Json.Invalidate();
+}
+
 void BundlesPlugin::RenderContent(IHttpServletRequest& request,
                                   IHttpServletResponse& response)
 {
@@ -156,6 +163,9 @@ void BundlesPlugin::RenderContent(IHttpServletRequest& request,
       response.GetOutputStream() << rs.rdbuf();
       return;
     }
+    case RequestType::Json:
+      m_Json.Serve(request, response);
+      return;
     case RequestType::Unknown:
     default:
       break;
@@ -173,6 +183,8 @@ bool BundlesPlugin::IsHtmlRequest(IHttpServletRequest& request)
   std::string pathInfo = request.GetPathInfo();
   if (pathInfo == "/bundles") {
     requestType = RequestType::MainPage;
+  } else if (pathInfo == "/bundles/json") {
+    requestType = RequestType::Json;
   } else if (pathInfo.size() > 9 && pathInfo.compare(0, 9, "/bundles/") == 0) {
     try {
       bundleId = std::stol(pathInfo.substr(9));
@@ -198,7 +210,8 @@ bool BundlesPlugin::IsHtmlRequest(IHttpServletRequest& request)
   request.SetAttribute(REQ_BUNDLE_ID, bundleId);
   request.SetAttribute(REQ_BUNDLE_RES_PATH, resPath);
 
-  return requestType != RequestType::Resource;
+  return requestType != RequestType::Resource &&
+         requestType != RequestType::Json;
 }
 
 AbstractWebConsolePlugin::TemplateData BundlesPlugin::GetBundlesData() const
@@ -213,7 +226,7 @@ AbstractWebConsolePlugin::TemplateData BundlesPlugin::GetBundlesData() const
   for (auto& bundle : bundles) {
     TemplateData entry;
 
-    AnyMap headers = bundle.GetHeaders();
+    const AnyMap& headers = bundle.GetHeaders();
 
     entry["id"] = NumToString(bundle.GetBundleId());
     entry["bsn"] = bundle.GetSymbolicName();
@@ -231,6 +244,41 @@ AbstractWebConsolePlugin::TemplateData BundlesPlugin::GetBundlesData() const
   return data;
 }
 
+std::vector<std::string> BundlesPlugin::GetBundlesJson() const
+{
+  auto bundles = GetContext().GetBundles();
+  std::sort(
+    bundles.begin(), bundles.end(), [](Bundle const& b1, Bundle const& b2) {
+      return b1.GetBundleId() < b2.GetBundleId();
+    });
+
+  auto header = [](const AnyMap& headers, const std::string& key) {
+    auto iter = headers.find(key);
+    return JsonSnapshotCache::Quote(
+      iter != headers.end() ? iter->second.ToString() : std::string());
+  };
+
+  std::vector<std::string> items;
+  items.reserve(bundles.size());
+  for (auto& bundle : bundles) {
+    const AnyMap& headers = bundle.GetHeaders();
+    std::stringstream state;
+    state << bundle.GetState();
+
+    std::string json = "{\"id\":" + NumToString(bundle.GetBundleId());
+    json += ",\"bsn\":" + JsonSnapshotCache::Quote(bundle.GetSymbolicName());
+    json += ",\"name\":" + header(headers, Constants::BUNDLE_NAME);
+    json +=
+      ",\"description\":" + header(headers, Constants::BUNDLE_DESCRIPTION);
+    json += ",\"version\":" +
+            JsonSnapshotCache::Quote(bundle.GetVersion().ToString());
+    json += ",\"vendor\":" + header(headers, Constants::BUNDLE_VENDOR);
+    json += ",\"state\":" + JsonSnapshotCache::Quote(state.str()) + "}";
+    items.push_back(std::move(json));
+  }
+  return items;
+}
+
 std::pair<std::size_t, std::size_t> BundlesPlugin::GetResourceJsonTree(
   Bundle& bundle,
   const std::string& parentPath,
@@ -328,13 +376,15 @@ void BundlesPlugin::GetBundleData(long id,
   if (!bundle)
     return;
 
-  auto headers = bundle.GetHeaders();
+  const AnyMap& headers = bundle.GetHeaders();
   SetIfExists(data, "bundle-name", Constants::BUNDLE_NAME, headers);
   data["bundle-bsn"] = bundle.GetSymbolicName();
 
   // ----------------- Get bundle manifest data ---------------------
 
-  data["bundle-manifest"] = Any(bundle.GetHeaders()).ToJSON();
+  std::ostringstream manifest;
+  any_value_to_json(manifest, headers);
+  data["bundle-manifest"] = manifest.str();
 
   // --------------- Get bundle resource information ------------------
 
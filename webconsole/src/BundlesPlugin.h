@@ -23,6 +23,8 @@
 #ifndef CPPMICROSERVICES_BUNDLESPLUGIN_H
 #define CPPMICROSERVICES_BUNDLESPLUGIN_H
 
+#include "JsonSnapshotCache.h"
+
 #include "cppmicroservices/webconsole/SimpleWebConsolePlugin.h"
 
 namespace cppmicroservices {
@@ -32,13 +34,19 @@ class BundlesPlugin : public SimpleWebConsolePlugin
 public:
   BundlesPlugin();
 
+  /**
+   * Discards the cached JSON data, called for every bundle event.
+   */
+  void InvalidateJson();
+
 private:
   enum class RequestType : int
   {
     Unknown = 0,
     MainPage,
     Bundle,
-    Resource
+    Resource,
+    Json
   };
 
   void RenderContent(IHttpServletRequest& request,
@@ -48,6 +56,8 @@ private:
 
   TemplateData GetBundlesData() const;
 
+  std::vector<std::string> GetBundlesJson() const;
+
   void GetBundleData(long id,
                      TemplateData& data,
                      const std::string& pluginRoot) const;
@@ -59,6 +69,8 @@ private:
     std::string& json,
     int level,
     const std::string& pluginRoot) const;
+
+  JsonSnapshotCache m_Json;
 };
 }
 
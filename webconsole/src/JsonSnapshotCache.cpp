@@ -0,0 +1,149 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "JsonSnapshotCache.h"
+
+#include "cppmicroservices/Any.h"
+#include "cppmicroservices/httpservice/IHttpServletRequest.h"
+#include "cppmicroservices/httpservice/IHttpServletResponse.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace cppmicroservices {
+
+namespace {
+
+/*
+ * Reads a non-negative page parameter, throws std::invalid_argument if the
+ * parameter is not a number.
+ */
+std::size_t GetPageParameter(IHttpServletRequest& request,
+                             const std::string& name,
+                             std::size_t defaultValue)
+{
+  Any param = request.GetParameter(name);
+  if (param.Empty()) {
+    return defaultValue;
+  }
+  const std::string& value = ref_any_cast<std::string>(param);
+  if (value.empty() ||
+      value.find_first_not_of("0123456789") != std::string::npos) {
+    throw std::invalid_argument("Invalid " + name + " parameter: " + value);
+  }
+  try {
+    return static_cast<std::size_t>(std::stoull(value));
+  } catch (const std::out_of_range&) {
+    return std::numeric_limits<std::size_t>::max();
+  }
+}
+
+/*
+ * Snapshots of an earlier cache instance must not match, so the entity
+ * tags also carry the creation time of the cache.
+ */
+std::string NewEtagPrefix()
+{
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  return std::to_string(now.count()) + "-";
+}
+}
+
+JsonSnapshotCache::JsonSnapshotCache(Builder builder)
+  : m_Builder(std::move(builder))
+  , m_EtagPrefix(NewEtagPrefix())
+  , m_Generation(1)
+{}
+
+void JsonSnapshotCache::Invalidate()
+{
+  m_Generation.fetch_add(1);
+}
+
+void JsonSnapshotCache::Serve(IHttpServletRequest& request,
+                              IHttpServletResponse& response)
+{
+  std::size_t start = 0;
+  std::size_t count = std::numeric_limits<std::size_t>::max();
+  try {
+    start = GetPageParameter(request, "start", start);
+    count = GetPageParameter(request, "count", count);
+  } catch (const std::invalid_argument&) {
+    response.SetStatus(IHttpServletResponse::SC_BAD_REQUEST);
+    return;
+  }
+
+  auto snapshot = GetSnapshot();
+
+  const auto& items = snapshot->items;
+  if (start > items.size()) {
+    start = items.size();
+  }
+  const std::size_t end = start + std::min(count, items.size() - start);
+
+  auto json = std::make_shared<std::string>(
+    "{\"total\":" + std::to_string(items.size()) +
+    ",\"start\":" + std::to_string(start) + ",\"items\":[");
+  for (std::size_t i = start; i < end; ++i) {
+    if (i != start) {
+      *json += ',';
+    }
+    *json += items[i];
+  }
+  *json += "]}";
+
+  // clients must revalidate, SendData answers with 304 while the snapshot
+  // is unchanged
+  response.SetHeader("Cache-Control", "no-cache");
+  response.SetCharacterEncoding("utf-8");
+  response.SetContentType("application/json");
+  response.SendData(json, snapshot->etag);
+}
+
+std::string JsonSnapshotCache::Quote(const std::string& str)
+{
+  std::ostringstream quoted;
+  any_value_to_json(quoted, str);
+  return quoted.str();
+}
+
+std::shared_ptr<const JsonSnapshotCache::Snapshot>
+JsonSnapshotCache::GetSnapshot()
+{
+  const uint64_t generation = m_Generation.load();
+
+  // building under the lock lets concurrent requests share one rebuild
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (!m_Snapshot || m_Snapshot->generation < generation) {
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->generation = generation;
+    snapshot->etag = "\"" + m_EtagPrefix + std::to_string(generation) + "\"";
+    snapshot->items = m_Builder();
+    m_Snapshot = std::move(snapshot);
+  }
+  return m_Snapshot;
+}
+}
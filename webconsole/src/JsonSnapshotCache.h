@@ -0,0 +1,94 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_JSONSNAPSHOTCACHE_H
+#define CPPMICROSERVICES_JSONSNAPSHOTCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cppmicroservices {
+
+class IHttpServletRequest;
+class IHttpServletResponse;
+
+/**
+ * Serves a JSON array from a cached snapshot.
+ *
+ * The snapshot is built on the first request and rebuilt only after
+ * Invalidate() was called, typically from a service or bundle listener.
+ * Each snapshot has its own entity tag, so polling clients which send
+ * If-None-Match receive 304 responses until the data changes. The
+ * "start" and "count" request parameters select a page of the array.
+ */
+class JsonSnapshotCache
+{
+public:
+  /**
+   * Creates the items of a snapshot, each one a serialized JSON value.
+   */
+  using Builder = std::function<std::vector<std::string>()>;
+
+  explicit JsonSnapshotCache(Builder builder);
+
+  /**
+   * Discards the current snapshot. The next request builds a new one.
+   */
+  void Invalidate();
+
+  /**
+   * Writes the requested page of the current snapshot as
+   * <code>{"total":n,"start":s,"items":[...]}</code>, or answers 304
+   * if the request already names the snapshot's entity tag.
+   */
+  void Serve(IHttpServletRequest& request, IHttpServletResponse& response);
+
+  /**
+   * Returns \c str as a quoted and escaped JSON string.
+   */
+  static std::string Quote(const std::string& str);
+
+private:
+  struct Snapshot
+  {
+    uint64_t generation;
+    std::string etag;
+    std::vector<std::string> items;
+  };
+
+  std::shared_ptr<const Snapshot> GetSnapshot();
+
+  const Builder m_Builder;
+  const std::string m_EtagPrefix;
+  std::atomic<uint64_t> m_Generation;
+
+  std::mutex m_Mutex;
+  std::shared_ptr<const Snapshot> m_Snapshot;
+};
+}
+
+#endif // CPPMICROSERVICES_JSONSNAPSHOTCACHE_H
@@ -34,21 +34,32 @@
 #include "cppmicroservices/Constants.h"
 #include "cppmicroservices/GetBundleContext.h"
 
+#include <algorithm>
 #include <set>
 
 namespace cppmicroservices {
 
 std::string NumToString(int64_t val);
 
+static const std::string JSON_PATH = "/services/json";
+
 ServicesPlugin::ServicesPlugin()
   : SimpleWebConsolePlugin("services", "Services", "")
+  , m_Json([this] { return GetServicesJson(); })
 {}
 
+void ServicesPlugin::InvalidateJson()
+{
+  m_Json.Invalidate();
+}
+
 void ServicesPlugin::RenderContent(IHttpServletRequest& request,
                                    IHttpServletResponse& response)
 {
   std::string pathInfo = request.GetPathInfo();
-  if (pathInfo == "/services") {
+  if (pathInfo == JSON_PATH) {
+    m_Json.Serve(request, response);
+  } else if (pathInfo == "/services") {
     BundleResource res =
       GetBundleContext().GetBundle().GetResource("/templates/services.html");
     if (res) {
@@ -78,6 +89,11 @@ void ServicesPlugin::RenderContent(IHttpServletRequest& request,
   }
 }
 
+bool ServicesPlugin::IsHtmlRequest(IHttpServletRequest& request)
+{
+  return request.GetPathInfo() != JSON_PATH;
+}
+
 AbstractWebConsolePlugin::TemplateData ServicesPlugin::GetIds() const
 {
   std::set<std::string> ids;
@@ -124,4 +140,55 @@ AbstractWebConsolePlugin::TemplateData ServicesPlugin::GetInterface(
 
   return data;
 }
+
+std::vector<std::string> ServicesPlugin::GetServicesJson() const
+{
+  // one query for all services, ordered by id for stable pages
+  auto refs = GetContext().GetServiceReferences("");
+  std::sort(refs.begin(),
+            refs.end(),
+            [](const ServiceReferenceU& r1, const ServiceReferenceU& r2) {
+              return any_cast<long>(r1.GetProperty(Constants::SERVICE_ID)) <
+                     any_cast<long>(r2.GetProperty(Constants::SERVICE_ID));
+            });
+
+  std::vector<std::string> items;
+  items.reserve(refs.size());
+  for (auto& ref : refs) {
+    auto bundle = ref.GetBundle();
+    std::string json = "{\"id\":";
+    json += ref.GetProperty(Constants::SERVICE_ID).ToJSON();
+    json += ",\"bundle-id\":";
+    json += bundle ? NumToString(bundle.GetBundleId()) : "null";
+    json += ",\"bundle\":";
+    json += JsonSnapshotCache::Quote(bundle ? bundle.GetSymbolicName() : "");
+    json += ",\"types\":[";
+    Any objectClass = ref.GetProperty(Constants::OBJECTCLASS);
+    auto const& oc = ref_any_cast<std::vector<std::string>>(objectClass);
+    for (auto iter = oc.begin(); iter != oc.end(); ++iter) {
+      if (iter != oc.begin()) {
+        json += ',';
+      }
+      json += JsonSnapshotCache::Quote(*iter);
+    }
+    json += "],\"ranking\":";
+    json += ref.GetProperty(Constants::SERVICE_RANKING).ToJSON();
+    json += ",\"scope\":";
+    json += ref.GetProperty(Constants::SERVICE_SCOPE).ToJSON();
+    json += ",\"props\":{";
+    bool first = true;
+    for (auto const& key : ref.GetPropertyKeys()) {
+      if (!first) {
+        json += ',';
+      }
+      first = false;
+      json += JsonSnapshotCache::Quote(key);
+      json += ':';
+      json += ref.GetProperty(key).ToJSON();
+    }
+    json += "}}";
+    items.push_back(std::move(json));
+  }
+  return items;
+}
 }
@@ -23,6 +23,8 @@
 #ifndef CPPMICROSERVICES_SERVICESPLUGIN_H
 #define CPPMICROSERVICES_SERVICESPLUGIN_H
 
+#include "JsonSnapshotCache.h"
+
 #include "cppmicroservices/webconsole/SimpleWebConsolePlugin.h"
 
 namespace cppmicroservices {
@@ -32,12 +34,23 @@ class ServicesPlugin : public SimpleWebConsolePlugin
 public:
   ServicesPlugin();
 
+  /**
+   * Discards the cached JSON data, called for every service event.
+   */
+  void InvalidateJson();
+
 private:
   void RenderContent(IHttpServletRequest& /*request*/,
                      IHttpServletResponse& response);
 
+  bool IsHtmlRequest(IHttpServletRequest& request);
+
   TemplateData GetIds() const;
   TemplateData GetInterface(const std::string& iid) const;
+
+  std::vector<std::string> GetServicesJson() const;
+
+  JsonSnapshotCache m_Json;
 };
 }
 
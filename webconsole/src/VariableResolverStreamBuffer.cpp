@@ -24,8 +24,7 @@
 
 #include "cppmicroservices/webconsole/WebConsoleDefaultVariableResolver.h"
 
-#include <cassert>
-#include <functional>
+#include <cstring>
 #include <utility>
 
 namespace cppmicroservices {
@@ -40,51 +39,135 @@ VariableResolverStreamBuffer::VariableResolverStreamBuffer(
   if (!m_Variables) {
     m_Variables = std::make_shared<WebConsoleDefaultVariableResolver>();
   }
-  setp(nullptr, nullptr);
+  setp(m_PutArea, m_PutArea + PutAreaSize);
 }
 
-VariableResolverStreamBuffer::~VariableResolverStreamBuffer() = default;
+VariableResolverStreamBuffer::~VariableResolverStreamBuffer()
+{
+  // the owner of the response deletes this buffer before the one it
+  // writes to, so the pending text can still be rendered
+  try {
+    ParsePutArea();
+  } catch (...) {
+  }
+}
+
+void VariableResolverStreamBuffer::Discard()
+{
+  setp(m_PutArea, m_PutArea + PutAreaSize);
+  m_State = State::NIL;
+  m_Buffer.clear();
+  m_BeginTag.clear();
+  m_EndTag.clear();
+}
 
 std::streambuf::int_type VariableResolverStreamBuffer::overflow(int_type ch)
 {
+  ParsePutArea();
   if (ch != traits_type::eof()) {
-    assert(std::less_equal<char*>()(pptr(), epptr()));
-    if (Parse(ch)) {
-      return ch;
-    }
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
   }
-  return traits_type::eof();
+  return traits_type::not_eof(ch);
+}
+
+std::streamsize VariableResolverStreamBuffer::xsputn(const char* s,
+                                                     std::streamsize n)
+{
+  if (n < epptr() - pptr()) {
+    std::memcpy(pptr(), s, static_cast<std::size_t>(n));
+    pbump(static_cast<int>(n));
+  } else {
+    // large writes are parsed in place instead of being copied
+    ParsePutArea();
+    Parse(s, static_cast<std::size_t>(n));
+  }
+  return n;
 }
 
 int VariableResolverStreamBuffer::sync()
 {
-  return 0;
+  ParsePutArea();
+  m_Out->flush();
+  return m_Out->good() ? 0 : -1;
+}
+
+void VariableResolverStreamBuffer::ParsePutArea()
+{
+  const std::size_t size = static_cast<std::size_t>(pptr() - pbase());
+  setp(m_PutArea, m_PutArea + PutAreaSize);
+  Parse(m_PutArea, size);
 }
 
-bool VariableResolverStreamBuffer::Parse(char c)
+void VariableResolverStreamBuffer::Parse(const char* data, std::size_t size)
+{
+  const char* const end = data + size;
+  while (data != end) {
+    const std::size_t remaining = static_cast<std::size_t>(end - data);
+    const char* delimiter = nullptr;
+    switch (m_State) {
+      case State::NIL:
+        delimiter = static_cast<const char*>(std::memchr(data, '{', remaining));
+        if (delimiter == nullptr) {
+          m_Out->write(data, static_cast<std::streamsize>(remaining));
+          return;
+        }
+        if (delimiter != data) {
+          m_Out->write(data, delimiter - data);
+        }
+        break;
+
+      case State::MUSTACHE_VAR:
+        delimiter = static_cast<const char*>(std::memchr(data, '}', remaining));
+        break;
+
+      case State::MUSTACHE_BLOCK:
+        delimiter = static_cast<const char*>(std::memchr(data, '{', remaining));
+        break;
+
+      default:
+        // the characters around the braces of a tag go one by one
+        Parse(*data++);
+        continue;
+    }
+
+    if (delimiter == nullptr) {
+      m_Buffer.append(data, remaining);
+      return;
+    }
+    if (m_State != State::NIL) {
+      m_Buffer.append(data, static_cast<std::size_t>(delimiter - data));
+    }
+    Parse(*delimiter);
+    data = delimiter + 1;
+  }
+}
+
+void VariableResolverStreamBuffer::Parse(char c)
 {
   switch (m_State) {
     case State::NIL:
       if (c == '{') {
         m_State = State::OBRACE;
       } else {
-        *m_Out << c;
+        m_Out->put(c);
       }
       break;
 
     case State::OBRACE:
       if (c == '{') {
         m_State = State::MUSTACHE;
-        m_Buffer << "{{";
+        m_Buffer += "{{";
       } else {
         m_State = State::NIL;
-        *m_Out << '{';
-        *m_Out << c;
+        const char text[] = { '{', c };
+        m_Out->write(text, sizeof(text));
       }
       break;
 
     case State::MUSTACHE:
-      m_Buffer << c;
+      m_Buffer += c;
       if (c == '#' || c == '^') {
         m_State = State::MUSTACHE_BLOCK_BEGIN;
       } else {
@@ -93,14 +176,14 @@ bool VariableResolverStreamBuffer::Parse(char c)
       break;
 
     case State::MUSTACHE_VAR:
-      m_Buffer << c;
+      m_Buffer += c;
       if (c == '}') {
         m_State = State::MUSTACHE_VAR_CBRACE;
       }
       break;
 
     case State::MUSTACHE_VAR_CBRACE:
-      m_Buffer << c;
+      m_Buffer += c;
       if (c == '}') {
         Translate();
         m_State = State::NIL;
@@ -110,34 +193,34 @@ bool VariableResolverStreamBuffer::Parse(char c)
       break;
 
     case State::MUSTACHE_BLOCK_BEGIN:
-      m_Buffer << c;
+      m_Buffer += c;
       if (c == '}') {
         m_State = State::MUSTACHE_BLOCK_BEGIN_CBRACE;
       } else {
-        m_BeginTag << c;
+        m_BeginTag += c;
       }
       break;
 
     case State::MUSTACHE_BLOCK_BEGIN_CBRACE:
-      m_Buffer << c;
+      m_Buffer += c;
       if (c == '}') {
         m_State = State::MUSTACHE_BLOCK;
       } else {
-        m_BeginTag << '}';
-        m_BeginTag << c;
+        m_BeginTag += '}';
+        m_BeginTag += c;
         m_State = State::MUSTACHE_BLOCK_BEGIN;
       }
       break;
 
     case State::MUSTACHE_BLOCK:
-      m_Buffer << c;
+      m_Buffer += c;
       if (c == '{') {
         m_State = State::MUSTACHE_BLOCK_OBRACE;
       }
       break;
 
     case State::MUSTACHE_BLOCK_OBRACE:
-      m_Buffer << c;
+      m_Buffer += c;
       if (c == '{') {
         m_State = State::MUSTACHE_BLOCK_MUSTACHE;
       } else {
@@ -146,7 +229,7 @@ bool VariableResolverStreamBuffer::Parse(char c)
       break;
 
     case State::MUSTACHE_BLOCK_MUSTACHE:
-      m_Buffer << c;
+      m_Buffer += c;
       if (c == '/') {
         m_State = State::MUSTACHE_BLOCK_END;
       } else {
@@ -155,40 +238,37 @@ bool VariableResolverStreamBuffer::Parse(char c)
       break;
 
     case State::MUSTACHE_BLOCK_END:
-      m_Buffer << c;
+      m_Buffer += c;
       if (c == '}') {
         m_State = State::MUSTACHE_BLOCK_END_CBRACE;
       } else {
-        m_EndTag << c;
+        m_EndTag += c;
       }
       break;
 
     case State::MUSTACHE_BLOCK_END_CBRACE:
-      m_Buffer << c;
+      m_Buffer += c;
       if (c == '}') {
-        if (m_BeginTag.str() == m_EndTag.str()) {
+        if (m_BeginTag == m_EndTag) {
           Translate();
-          m_BeginTag.str(std::string());
+          m_BeginTag.clear();
           m_State = State::NIL;
         } else {
           m_State = State::MUSTACHE_BLOCK;
         }
-        m_EndTag.str(std::string());
+        m_EndTag.clear();
       } else {
-        m_EndTag << '}';
-        m_EndTag << c;
+        m_EndTag += '}';
+        m_EndTag += c;
         m_State = State::MUSTACHE_BLOCK_END;
       }
       break;
   }
-  return true;
 }
 
 void VariableResolverStreamBuffer::Translate()
 {
-  std::string buf = m_Buffer.str();
-  m_Buffer.str(std::string());
-
-  *m_Out << m_Variables->Resolve(buf);
+  *m_Out << m_Variables->Resolve(m_Buffer);
+  m_Buffer.clear();
 }
 }
@@ -26,12 +26,21 @@
 #include "cppmicroservices/GlobalConfig.h"
 #include "cppmicroservices/webconsole/WebConsoleVariableResolver.h"
 
+#include <cstddef>
 #include <memory>
-#include <sstream>
+#include <ostream>
 #include <streambuf>
+#include <string>
 
 namespace cppmicroservices {
 
+/**
+ * Renders the mustache tags of the text written to it with a
+ * WebConsoleVariableResolver and writes the result to an output stream.
+ *
+ * Written text is collected in a put area and parsed in bulk: runs of
+ * literal text are located with memchr and forwarded with a single write.
+ */
 class VariableResolverStreamBuffer : public std::streambuf
 {
 public:
@@ -45,10 +54,30 @@ public:
   VariableResolverStreamBuffer& operator=(const VariableResolverStreamBuffer&) =
     delete;
 
+  /**
+   * Drops the text which has not been rendered yet, including an
+   * incomplete tag, e.g. after the response buffer was reset.
+   */
+  void Discard();
+
 private:
-  int_type overflow(int_type ch);
+  int_type overflow(int_type ch) override;
 
-  int sync();
+  std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+  int sync() override;
+
+  /**
+   * Parses the text in the put area and empties it.
+   */
+  void ParsePutArea();
+
+  /**
+   * Parses \c size characters at \c data. Literal text, the content of a
+   * variable tag and the content of a block are consumed in runs up to the
+   * next brace; the braces are passed to Parse(char).
+   */
+  void Parse(const char* data, std::size_t size);
 
   /**
    * Write a single character following the state machine:
@@ -82,7 +111,7 @@ private:
    *
    * @exception IOException If an I/O error occurs
    */
-  bool Parse(char c);
+  void Parse(char c);
 
   void Translate();
 
@@ -112,9 +141,12 @@ private:
   std::unique_ptr<std::ostream> m_Out;
 
   std::shared_ptr<WebConsoleVariableResolver> m_Variables;
-  std::stringstream m_Buffer;
-  std::stringstream m_BeginTag;
-  std::stringstream m_EndTag;
+  std::string m_Buffer;
+  std::string m_BeginTag;
+  std::string m_EndTag;
+
+  static const std::size_t PutAreaSize = 4096;
+  char m_PutArea[PutAreaSize];
 };
 }
 
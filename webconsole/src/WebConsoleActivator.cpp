@@ -30,6 +30,8 @@
 
 #include "WebConsoleServlet.h"
 #include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/BundleEvent.h"
+#include "cppmicroservices/ServiceEvent.h"
 
 namespace cppmicroservices {
 
@@ -63,6 +65,12 @@ void WebConsoleActivator::Start(BundleContext context)
   m_ServicesPlugin->Register();
   m_BundlesPlugin->Register();
 
+  // the JSON views are cached until the data they show changes
+  context.AddServiceListener(
+    [this](const ServiceEvent&) { m_ServicesPlugin->InvalidateJson(); });
+  context.AddBundleListener(
+    [this](const BundleEvent&) { m_BundlesPlugin->InvalidateJson(); });
+
   //  server->addHandler("/Console/bundles/", new BundlesHtml(context));
   //  server->addHandler("/Console/resources/", new ResourcesHtml(context));
   //  server->addHandler("/Console/", new ConsoleHtmlHandler(context));
@@ -41,7 +41,7 @@ class FilteringResponseWrapper : public HttpServletResponse
 
 public:
   FilteringResponseWrapper(IHttpServletRequest& request,
-                           IHttpServletResponse& response,
+                           HttpServletResponse& response,
                            AbstractWebConsolePlugin* plugin)
     : HttpServletResponse(response)
     , m_StreamBuf(nullptr)
@@ -51,6 +51,17 @@ public:
 
   ~FilteringResponseWrapper() override = default;
 
+  void ResetBuffer() override
+  {
+    // the buffer renders its pending text when it is deleted, which must
+    // not reach the response once the buffer was reset
+    if (m_StreamBuf != nullptr && !this->IsCommitted()) {
+      m_StreamBuf->Discard();
+    }
+    HttpServletResponse::ResetBuffer();
+    m_StreamBuf = nullptr;
+  }
+
 private:
   std::streambuf* GetOutputStreamBuffer() override
   {
@@ -70,7 +81,7 @@ private:
     }
   }
 
-  std::streambuf* m_StreamBuf;
+  VariableResolverStreamBuffer* m_StreamBuf;
   AbstractWebConsolePlugin* m_Plugin;
   IHttpServletRequest& m_Request;
 };
@@ -236,9 +247,14 @@ void WebConsoleServlet::Service(IHttpServletRequest& request,
 
     // wrap the response for localization and template variable replacement
     //request = wrapRequest(request, locale);
-    FilteringResponseWrapper filteringResponse(request, response, plugin);
-
-    plugin->Service(request, filteringResponse);
+    // the wrapper shares the data of the response created by the container
+    auto httpResponse = dynamic_cast<HttpServletResponse*>(&response);
+    if (httpResponse != nullptr) {
+      FilteringResponseWrapper filteringResponse(request, *httpResponse, plugin);
+      plugin->Service(request, filteringResponse);
+    } else {
+      plugin->Service(request, response);
+    }
   } else {
     response.SetCharacterEncoding("utf-8"); //$NON-NLS-1$
     response.SetContentType("text/html");   //$NON-NLS-1$
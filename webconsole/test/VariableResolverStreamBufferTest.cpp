@@ -0,0 +1,139 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "VariableResolverStreamBuffer.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+using cppmicroservices::VariableResolverStreamBuffer;
+using cppmicroservices::WebConsoleVariableResolver;
+
+namespace {
+
+/// Renders a tag as its complete text in square brackets
+struct EchoResolver : WebConsoleVariableResolver
+{
+  std::string Resolve(const std::string& variable) const override
+  {
+    return "[" + variable + "]";
+  }
+};
+
+/// Renders the text written to a VariableResolverStreamBuffer
+class VariableResolverStreamBufferTest : public ::testing::Test
+{
+protected:
+  std::unique_ptr<VariableResolverStreamBuffer> MakeBuffer()
+  {
+    m_Rendered.str(std::string());
+    return std::make_unique<VariableResolverStreamBuffer>(
+      std::make_unique<std::ostream>(&m_Rendered),
+      std::make_shared<EchoResolver>());
+  }
+
+  /// Writes \c text in pieces of \c pieceSize characters and renders it
+  std::string Render(const std::string& text, std::size_t pieceSize)
+  {
+    {
+      auto buffer = MakeBuffer();
+      std::ostream out(buffer.get());
+      for (std::size_t pos = 0; pos < text.size(); pos += pieceSize) {
+        out << text.substr(pos, pieceSize);
+      }
+    }
+    return m_Rendered.str();
+  }
+
+  std::stringbuf m_Rendered;
+};
+}
+
+TEST_F(VariableResolverStreamBufferTest, LiteralText)
+{
+  const std::string text = "<p>a { b } {c} d{ }}</p>";
+  ASSERT_EQ(text, Render(text, text.size()));
+  ASSERT_EQ("", Render("", 1));
+}
+
+TEST_F(VariableResolverStreamBufferTest, Variables)
+{
+  ASSERT_EQ("Hello [{{name}}]!", Render("Hello {{name}}!", 100));
+  ASSERT_EQ("[{{a}}][{{b}}]", Render("{{a}}{{b}}", 100));
+  ASSERT_EQ("[{{a}b}}]", Render("{{a}b}}", 100))
+    << "A single closing brace must not end a tag";
+}
+
+TEST_F(VariableResolverStreamBufferTest, Blocks)
+{
+  ASSERT_EQ("<[{{#list}}<li>{{.}}</li>{{/list}}]>",
+            Render("<{{#list}}<li>{{.}}</li>{{/list}}>", 100));
+  ASSERT_EQ("[{{^a}}{{#b}}x{{/b}}{{/a}}]",
+            Render("{{^a}}{{#b}}x{{/b}}{{/a}}", 100))
+    << "A block must only end at the tag closing it";
+}
+
+TEST_F(VariableResolverStreamBufferTest, EveryPieceSize)
+{
+  const std::string text = "x{y}{{v}}z {{#b}}{ {{w}} }{{/b}}{{u}";
+  const std::string expected = "x{y}[{{v}}]z [{{#b}}{ {{w}} }{{/b}}]";
+  for (std::size_t pieceSize = 1; pieceSize <= text.size(); ++pieceSize) {
+    ASSERT_EQ(expected, Render(text, pieceSize))
+      << "Written in pieces of " << pieceSize;
+  }
+}
+
+TEST_F(VariableResolverStreamBufferTest, LargeWrites)
+{
+  // longer than the put area, so that tags straddle its boundaries and
+  // large writes are parsed in place
+  std::string text;
+  std::string expected;
+  for (int i = 0; i < 2000; ++i) {
+    const std::string n = std::to_string(i);
+    text += "<td>{{v" + n + "}}</td>";
+    expected += "<td>[{{v" + n + "}}]</td>";
+  }
+  ASSERT_EQ(expected, Render(text, text.size()));
+  ASSERT_EQ(expected, Render(text, 4095));
+  ASSERT_EQ(expected, Render(text, 5000));
+}
+
+TEST_F(VariableResolverStreamBufferTest, FlushAndDiscard)
+{
+  auto buffer = MakeBuffer();
+  std::ostream out(buffer.get());
+  out << "a{{v}}b" << std::flush;
+  ASSERT_EQ("a[{{v}}]b", m_Rendered.str())
+    << "Flushing must render the pending text";
+
+  out << "c{{w";
+  buffer->Discard();
+  out << "d{{x}}";
+  buffer.reset();
+  ASSERT_EQ("a[{{v}}]bd[{{x}}]", m_Rendered.str())
+    << "Discarded text and an incomplete tag must not be rendered";
+}